@@ -58,6 +58,32 @@
 
 #define BBIO_PERIPH(addr, bit) \
 	(((addr) & 0x0FFFFF) * 32 + 0x42000000 + (bit) * 4)
+#elif defined(LIBOPENCM3_HOST)
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Built for the machine running the build, see lib/host. Peripheral
+ * addresses are looked up in register files kept in memory by
+ * host_mmio(), other addresses are memory of the program, which has to be
+ * linked below 4 GiB for them to fit in 32 bits.
+ */
+volatile void *host_mmio(uint32_t addr, unsigned size);
+/* Returns the register a model of the program plays at addr for an access
+ * of size bytes, or NULL */
+volatile void *host_mmio_model(uint32_t addr, unsigned size);
+
+#define MMIO8(addr)		(*(volatile uint8_t *)host_mmio(addr, 1))
+#define MMIO16(addr)		(*(volatile uint16_t *)host_mmio(addr, 2))
+#define MMIO32(addr)		(*(volatile uint32_t *)host_mmio(addr, 4))
+#define MMIO64(addr)		(*(volatile uint64_t *)host_mmio(addr, 8))
+
+#define BBIO_SRAM(addr, bit) \
+	MMIO32((((uint32_t)addr) & 0x0FFFFF) * 32 + 0x22000000 + (bit) * 4)
+
+#define BBIO_PERIPH(addr, bit) \
+	MMIO32((((uint32_t)addr) & 0x0FFFFF) * 32 + 0x42000000 + (bit) * 4)
 #else
 
 #include <stdint.h>
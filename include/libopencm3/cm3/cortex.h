@@ -36,6 +36,60 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#if defined(LIBOPENCM3_HOST)
+/*
+ * Built for the machine running the build, see lib/host. Nothing
+ * interrupts the program there, the masks are only kept for the callers.
+ */
+extern uint32_t host_primask;
+extern uint32_t host_faultmask;
+
+static inline void cm_enable_interrupts(void)
+{
+	host_primask = 0;
+}
+
+static inline void cm_disable_interrupts(void)
+{
+	host_primask = 1;
+}
+
+static inline void cm_enable_faults(void)
+{
+	host_faultmask = 0;
+}
+
+static inline void cm_disable_faults(void)
+{
+	host_faultmask = 1;
+}
+
+static inline bool cm_is_masked_interrupts(void)
+{
+	return host_primask;
+}
+
+static inline bool cm_is_masked_faults(void)
+{
+	return host_faultmask;
+}
+
+static inline uint32_t cm_mask_interrupts(uint32_t mask)
+{
+	uint32_t old = host_primask;
+
+	host_primask = mask;
+	return old;
+}
+
+static inline uint32_t cm_mask_faults(uint32_t mask)
+{
+	uint32_t old = host_faultmask;
+
+	host_faultmask = mask;
+	return old;
+}
+#else
 /*---------------------------------------------------------------------------*/
 /** @brief Cortex M Enable interrupts
  *
@@ -150,6 +204,8 @@ static inline uint32_t cm_mask_faults(uint32_t mask)
 }
 #endif
 
+#endif
+
 /**@}*/
 
 /*===========================================================================*/
@@ -193,6 +193,20 @@
 /* API definitions                                                           */
 /*****************************************************************************/
 
+/** Snapshot of the DWT profiling counters.
+ *
+ * All but the cycle counter are 8 bits wide and wrap, so differences of two
+ * snapshots are only meaningful taken modulo 256.
+ */
+struct dwt_counters {
+	uint32_t cycles;	/**< CPU cycles */
+	uint8_t cpi;		/**< Extra cycles of multi-cycle instructions */
+	uint8_t exc;		/**< Cycles of exception overhead */
+	uint8_t sleep;		/**< Cycles asleep */
+	uint8_t lsu;		/**< Extra cycles of loads and stores */
+	uint8_t fold;		/**< Folded instructions */
+};
+
 /*****************************************************************************/
 /* API Functions                                                             */
 /*****************************************************************************/
@@ -201,6 +215,8 @@ BEGIN_DECLS
 
 bool dwt_enable_cycle_counter(void);
 uint32_t dwt_read_cycle_counter(void);
+bool dwt_enable_profiling_counters(void);
+void dwt_read_counters(struct dwt_counters *counters);
 
 END_DECLS
 
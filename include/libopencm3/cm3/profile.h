@@ -0,0 +1,131 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBOPENCM3_CM3_PROFILE_H
+#define LIBOPENCM3_CM3_PROFILE_H
+
+#include <libopencm3/cm3/common.h>
+#include <libopencm3/cm3/dwt.h>
+
+/**
+ * @defgroup cm_profile Cortex-M cycle profiling
+ * @ingroup CM3_defines
+ *
+ * Regions of code are timed with the DWT cycle counter. Each region keeps
+ * the number of runs, the minimum, maximum and total cycles, a histogram of
+ * the cycles in powers of two and the sums of the other DWT counters. The
+ * cost of the measurement itself, as found by profile_init(), is taken off.
+ *
+ * A region is timed from PROFILE_SCOPE() to the end of the enclosing block,
+ * or between profile_begin() and profile_end(). A region must not be timed
+ * from two contexts that preempt each other, time the interrupt handler and
+ * the main loop in regions of their own.
+ *
+ * profile_report() sends the statistics of a region as a binary packet on an
+ * ITM stimulus port, profile_announce() its name. scripts/profile_decode.py
+ * decodes them from the SWO capture.
+ *
+ * The DWT counters are there on ARMv7-M only, on ARMv6-M all regions read 0
+ * cycles. The build of lib/host reads them from a register file, which a
+ * test can fill, see tests/benchmark/main-host.c.
+ *
+ * @code
+ * static struct profile_region rx_region = PROFILE_REGION(1, "rx");
+ *
+ * void usart1_isr(void)
+ * {
+ *	PROFILE_SCOPE(&rx_region);
+ *	...
+ * }
+ *
+ * profile_init();
+ * profile_announce(&rx_region, 1);
+ * ...
+ * profile_report(&rx_region, 1);
+ * @endcode
+ * @{
+ */
+
+/** Number of histogram buckets, bucket n counts the runs of 2^n to
+ * 2^(n+1) - 1 cycles, bucket 0 also those of 0 cycles */
+#define PROFILE_BUCKETS			32
+
+/** @defgroup profile_packet Profile ITM packets
+ * All packets are sent as 32 bit words. The first word holds the type in
+ * bits 31:24 and the region id in bits 23:16.
+ *@{*/
+/** Statistics. Bits 15:8 of the first word are the first histogram bucket
+ * sent, bits 7:0 the last one. Then come the count, min, max, the low and
+ * high words of the total, the CPI, EXC, SLEEP, LSU and FOLD sums and the
+ * buckets from the first to the last. */
+#define PROFILE_PACKET_STATS		0x53
+/** Name. Bits 15:0 of the first word are the length of the name, which
+ * follows in words, the first character in the lowest byte. */
+#define PROFILE_PACKET_NAME		0x4e
+/**@}*/
+
+/** A profiled region of code. Initialise with PROFILE_REGION(). */
+struct profile_region {
+	const char *name;	/**< Name, sent by profile_announce() */
+	uint8_t id;		/**< Identifies the region in the packets */
+	uint32_t count;		/**< Number of runs */
+	uint32_t min;		/**< Fewest cycles of a run */
+	uint32_t max;		/**< Most cycles of a run */
+	uint64_t total;		/**< Sum of the cycles of all runs */
+	uint32_t cpi;		/**< Sum of the DWT CPI counts */
+	uint32_t exc;		/**< Sum of the DWT EXC counts */
+	uint32_t sleep;		/**< Sum of the DWT SLEEP counts */
+	uint32_t lsu;		/**< Sum of the DWT LSU counts */
+	uint32_t fold;		/**< Sum of the DWT FOLD counts */
+	/** Runs by cycles, see @ref PROFILE_BUCKETS */
+	uint32_t histogram[PROFILE_BUCKETS];
+};
+
+/** A running measurement of a region */
+struct profile_scope {
+	/** @cond private */
+	struct profile_region *region;
+	struct dwt_counters start;
+	/** @endcond */
+};
+
+/** Initialiser of a struct profile_region */
+#define PROFILE_REGION(region_id, region_name)				\
+	{ .name = (region_name), .id = (region_id), .min = UINT32_MAX }
+
+BEGIN_DECLS
+
+bool profile_init(void);
+void profile_reset(struct profile_region *region);
+void profile_begin(struct profile_scope *scope, struct profile_region *region);
+void profile_end(struct profile_scope *scope);
+uint32_t profile_mean(const struct profile_region *region);
+void profile_announce(const struct profile_region *region, uint8_t port);
+void profile_report(const struct profile_region *region, uint8_t port);
+
+END_DECLS
+
+/** Times the rest of the enclosing block as @a region, whichever way the
+ * block is left */
+#define PROFILE_SCOPE(region)						\
+	struct profile_scope __profile_scope				\
+		__attribute__((__cleanup__(profile_end)));		\
+	profile_begin(&__profile_scope, (region))
+
+/**@}*/
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBOPENCM3_CM3_RINGBUF_H
+#define LIBOPENCM3_CM3_RINGBUF_H
+
+#include <libopencm3/cm3/common.h>
+
+/**
+ * @defgroup cm_ringbuf Single producer, single consumer ring buffer
+ * @ingroup CM3_defines
+ *
+ * A byte ring that one producer and one consumer can use at the same time
+ * without locking, for instance the main loop on one side and an interrupt
+ * handler or a DMA controller on the other. The producer only ever moves
+ * the head and the consumer only ever moves the tail. Both are free running
+ * counters, so the whole buffer can be used.
+ *
+ * The span functions give direct access to the contiguous part of the free
+ * or used space, so that a DMA can fill or drain the ring in place.
+ * @{
+ */
+
+/** Ring buffer state, the buffer size must be a power of two. */
+struct ringbuf {
+	/** @cond private */
+	uint8_t *buf;
+	uint32_t mask;
+	volatile uint32_t head;
+	volatile uint32_t tail;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void ringbuf_init(struct ringbuf *rb, uint8_t *buf, uint32_t size);
+uint32_t ringbuf_used(const struct ringbuf *rb);
+uint32_t ringbuf_free(const struct ringbuf *rb);
+uint32_t ringbuf_write(struct ringbuf *rb, const void *data, uint32_t len);
+uint32_t ringbuf_read(struct ringbuf *rb, void *data, uint32_t len);
+uint32_t ringbuf_write_span(struct ringbuf *rb, uint8_t **data);
+void ringbuf_commit(struct ringbuf *rb, uint32_t len);
+uint32_t ringbuf_read_span(struct ringbuf *rb, uint8_t **data);
+void ringbuf_consume(struct ringbuf *rb, uint32_t len);
+
+END_DECLS
+
+/**@}*/
+
+#endif
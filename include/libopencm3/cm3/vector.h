@@ -61,8 +61,126 @@ typedef struct {
 	vector_table_entry_t irq[NVIC_IRQ_COUNT];
 } vector_table_t;
 
+/** Entry of the table of sections reset_handler() copies from flash */
+struct vector_copy_entry {
+	const unsigned *src;
+	unsigned *dest;
+	unsigned *end;
+};
+
+/** Entry of the table of sections reset_handler() clears */
+struct vector_zero_entry {
+	unsigned *dest;
+	unsigned *end;
+};
+
 /* Common symbols exported by the linker script(s): */
 extern unsigned _data_loadaddr, _data, _edata, _ebss, _stack;
 extern vector_table_t vector_table;
 
+/** @defgroup vector_reset_hooks Reset hooks
+ *
+ * reset_handler() copies the initialised sections from flash and clears the
+ * zero initialised ones, as listed in the tables of the generated linker
+ * script, four words at a time. On parts with a lot of RAM that takes a
+ * while at the reset clock, so the application can bring the clocks up
+ * before, and have a DMA clear the larger sections while the CPU copies.
+ *
+ * The hooks are weak and do nothing by default. They run before any static
+ * data is set up and before the FPU is enabled: they must not use global or
+ * static variables, nor floating point. Globals they set are overwritten
+ * afterwards, so the rcc_*_frequency variables still have to be set from
+ * main() if the clock setup is done here, with rcc registers directly or the
+ * rcc_clock_setup_*() functions.
+ *
+ * Example, clearing the .bss of an STM32F4 with DMA2 stream 0:
+ * @code
+ * void reset_pre_init(void)
+ * {
+ *	rcc_periph_clock_enable(RCC_DMA2);
+ * }
+ *
+ * bool reset_dma_clear(unsigned *dest, unsigned *end)
+ * {
+ *	if (end - dest < 1024 || end - dest > 65536 ||
+ *	    (DMA_SCR(DMA2, DMA_STREAM0) & DMA_SxCR_EN)) {
+ *		return false;
+ *	}
+ *	dma_start_mem_clear(DMA2, DMA_STREAM0, dest, end - dest);
+ *	return true;
+ * }
+ *
+ * void reset_dma_wait(void)
+ * {
+ *	while (DMA_SCR(DMA2, DMA_STREAM0) & DMA_SxCR_EN);
+ * }
+ * @endcode
+ *@{*/
+
+BEGIN_DECLS
+
+/** Called first thing from reset_handler(), to raise the clocks or enable
+ * the clocks of RAMs */
+void reset_pre_init(void);
+
+/** Offered every zero initialised section by reset_handler()
+ * @param dest start of the section
+ * @param end end of the section
+ * @returns true if a DMA was started to clear it, false to have the CPU
+ * clear it
+ */
+bool reset_dma_clear(unsigned *dest, unsigned *end);
+
+/** Called from reset_handler() once the CPU is done, to wait for the
+ * clearing started by reset_dma_clear() */
+void reset_dma_wait(void);
+
+END_DECLS
+/**@}*/
+
+/** @defgroup vector_placement Placement in the other RAMs
+ *
+ * Code and data can be placed in the RAMs besides the main one, which the
+ * generated linker script knows as ccm (the DTCM on F7 and H7), itcm (F7,
+ * H7) and ram1 to ram5 (the other SRAM banks). The linker script collects
+ * them in sections copied from flash or cleared by reset_handler(), like
+ * .data and .bss. Functions run from there without the flash wait states,
+ * which suits interrupt handlers and inner loops of signal processing. Code
+ * can not run from the CCM of the F4 or the DTCM, and the CCM of the F3 and
+ * F4 is not reachable by DMA.
+ *
+ * @code
+ * ITCM_TEXT void adc_dma_isr(void);
+ * DTCM_BSS static int16_t taps[64];
+ * DTCM_DATA static int16_t coeffs[64] = { ... };
+ * RAM_BSS(2) static uint8_t dma_buffer[4096];
+ * @endcode
+ *
+ * Data without these attributes in the .ccmram and .ramN sections is left
+ * uninitialised, as before.
+ *@{*/
+#define RAM_SECTION_TEXT(name)	__attribute__((long_call, noinline, \
+					       section("." name "text")))
+#define RAM_SECTION_DATA(name)	__attribute__((section("." name "data")))
+#define RAM_SECTION_BSS(name)	__attribute__((section("." name "bss")))
+
+/** Function run from the main RAM, copied with .data */
+#define RAMFUNC			__attribute__((long_call, noinline, \
+					       section(".ramtext")))
+#define CCM_TEXT		RAM_SECTION_TEXT("ccm")
+#define CCM_DATA		RAM_SECTION_DATA("ccm")
+#define CCM_BSS			RAM_SECTION_BSS("ccm")
+#define DTCM_DATA		CCM_DATA
+#define DTCM_BSS		CCM_BSS
+#define ITCM_TEXT		RAM_SECTION_TEXT("itcm")
+#define ITCM_DATA		RAM_SECTION_DATA("itcm")
+#define ITCM_BSS		RAM_SECTION_BSS("itcm")
+/** Function in the SRAM bank ram1 to ram5 */
+#define RAM_TEXT(n)		RAM_SECTION_TEXT("ram" #n)
+/** Initialised data in the SRAM bank ram1 to ram5 */
+#define RAM_DATA(n)		RAM_SECTION_DATA("ram" #n)
+/** Zero initialised data in the SRAM bank ram1 to ram5 */
+#define RAM_BSS(n)		RAM_SECTION_BSS("ram" #n)
+/**@}*/
+
 #endif
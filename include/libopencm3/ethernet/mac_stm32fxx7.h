@@ -729,6 +729,41 @@ enum eth_clk {
 	ETH_CLK_150_168MHZ = ETH_MACMIIAR_CR_HCLK_DIV_102,
 };
 
+/** One buffer of a frame, as used by the zero-copy descriptor API */
+struct eth_frag {
+	void *buf;
+	uint32_t len;
+};
+
+/** Maximum count of buffers of a frame delivered by @ref eth_irq_handler */
+#define ETH_RX_FRAGS_MAX		4
+
+/** Called by @ref eth_irq_handler for every good received frame. The
+ * buffers are owned by the application from now on and have to be given
+ * back (or replaced) with @ref eth_rx_give. */
+typedef void (*eth_rx_callback)(const struct eth_frag *frags, uint32_t n);
+
+/** Called by @ref eth_irq_handler for every transmitted buffer. status is
+ * the TDES0 word: ETH_TDES0_LS marks the last buffer of a frame,
+ * ETH_TDES0_ES a transmit error. */
+typedef void (*eth_tx_done_callback)(void *buf, uint32_t status);
+
+/** Counters kept by the zero-copy descriptor API and @ref eth_irq_handler */
+struct eth_stats {
+	uint32_t rx_frames;		/**< good frames claimed */
+	uint32_t rx_dropped;		/**< frames dropped by the driver */
+	uint32_t rx_crc_errors;		/**< dropped frames with CRC error */
+	uint32_t rx_overruns;		/**< DMA overflow (frame or FIFO) */
+	uint32_t rx_missed;		/**< frames missed for lack of buffers */
+	uint32_t rx_buf_unavail;	/**< RX DMA suspended on empty ring */
+	uint32_t rx_hwm;		/**< most descriptors waiting in one IRQ */
+	uint32_t tx_frames;		/**< frames sent */
+	uint32_t tx_errors;		/**< frames sent with an error status */
+	uint32_t tx_underflows;		/**< TX DMA underflow events */
+	uint32_t tx_hwm;		/**< most descriptors queued at once */
+	uint32_t bus_errors;		/**< fatal DMA bus errors */
+};
+
 /*****************************************************************************/
 /* API Functions                                                             */
 /*****************************************************************************/
@@ -747,6 +782,13 @@ void eth_desc_init(uint8_t *buf, uint32_t nTx, uint32_t nRx, uint32_t cTx,
 bool eth_tx(uint8_t *ppkt, uint32_t n);
 bool eth_rx(uint8_t *ppkt, uint32_t *len, uint32_t maxlen);
 
+void eth_desc_init_zerocopy(uint8_t *desc, uint32_t nTx, uint32_t nRx,
+			    bool isext);
+bool eth_tx_frags(const struct eth_frag *frags, uint32_t n);
+uint32_t eth_tx_reclaim(void **bufs, uint32_t max);
+bool eth_rx_give(void *buf, uint32_t size);
+uint32_t eth_rx_claim(struct eth_frag *frags, uint32_t max);
+
 void eth_init(uint8_t phy, enum eth_clk clock);
 void eth_start(void);
 
@@ -757,6 +799,11 @@ void eth_irq_disable(uint32_t reason);
 bool eth_irq_is_pending(uint32_t reason);
 bool eth_irq_ack_pending(uint32_t reason);
 
+void eth_irq_setup(eth_rx_callback rx_cb, eth_tx_done_callback tx_cb);
+void eth_irq_handler(void);
+const struct eth_stats *eth_get_stats(void);
+void eth_clear_stats(void);
+
 
 END_DECLS
 
@@ -773,6 +820,19 @@ END_DECLS
  *  eth_start();
  *  for (;;)
  *    eth_tx(frame,sizeof(frame));
+ *
+ * Zero-copy usage:
+ *  eth_desc_init_zerocopy(desc, ETH_TXBUFNB, ETH_RXBUFNB, false);
+ *  for (i = 0; i < ETH_RXBUFNB; i++)
+ *    eth_rx_give(rxbuf[i], ETH_RX_BUF_SIZE);
+ *  eth_start();
+ *  for (;;) {
+ *    struct eth_frag tx[2] = { { hdr, hdrlen }, { payload, len } };
+ *    eth_tx_frags(tx, 2);
+ *    n = eth_tx_reclaim(done, 8);         [ recycle done[0..n-1] ]
+ *    n = eth_rx_claim(rx, 4);             [ process rx[0..n-1], then ]
+ *    eth_rx_give(rx[0].buf, ETH_RX_BUF_SIZE);
+ *  }
  */
 
 /**@}*/
@@ -396,10 +396,12 @@ LGPL License Terms @ref lgpl_license
 /* --- CAN_ESR values ------------------------------------------------------ */
 
 /* REC[7:0]: Receive error counter */
-#define CAN_ESR_REC_MASK		(0xF << 24)
+#define CAN_ESR_REC_MASK		(0xFF << 24)
+#define CAN_ESR_REC_SHIFT		24
 
 /* TEC[7:0]: Least significant byte of the 9-bit transmit error counter */
-#define CAN_ESR_TEC_MASK		(0xF << 16)
+#define CAN_ESR_TEC_MASK		(0xFF << 16)
+#define CAN_ESR_TEC_SHIFT		16
 
 /* 15:7 Reserved, forced by hardware to 0 */
 
@@ -676,5 +678,8 @@ void can_fifo_release(uint32_t canport, uint8_t fifo);
 bool can_available_mailbox(uint32_t canport);
 END_DECLS
 
+#include <libopencm3/stm32/can_queue.h>
+#include <libopencm3/stm32/can_filter.h>
+
 /**@}*/
 #endif
@@ -0,0 +1,81 @@
+/** @addtogroup can_defines
+ *
+ * @section can_api_filter Filter compiler
+ *
+ * can_filter_compile() takes the IDs to accept, as ranges of standard or
+ * extended IDs each routed to a receive FIFO, and packs them into filter
+ * banks, so the CAN drops all other frames without bothering the CPU.
+ *
+ * Single standard IDs go four to a bank in 16 bit list mode, and extended
+ * ones two to a bank in 32 bit list mode. Longer ranges are split into
+ * aligned power of two blocks, which take a 16 bit mask filter, two to a
+ * bank, or a 32 bit mask bank each. If that needs more banks than given,
+ * the blocks that cost the fewest extra IDs to cover together are merged
+ * until it fits, and the filters then accept some frames that are not in
+ * the ranges. A merged block may also take frames of IDs routed to the
+ * other FIFO. Only data frames are accepted.
+ *
+ * The filter match index of a frame depends on the banks before, so frames
+ * should be told apart by ID rather than by it.
+ *
+ * @code
+ * static const struct can_filter_range accept[] = {
+ *	{ 0x080, 0x080, 0, 0 },
+ *	{ 0x100, 0x17f, 0, 0 },
+ *	{ 0x700, 0x77f, 0, 1 },
+ *	{ 0x18fe0000, 0x18feffff, CAN_MSG_EXT, 1 },
+ * };
+ *
+ * can_filter_compile(accept, 4, 0, 14, NULL);
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA CAN.H */
+
+#ifndef LIBOPENCM3_CAN_FILTER_H
+#define LIBOPENCM3_CAN_FILTER_H
+
+/** Blocks the compiler works on at a time, more are merged on the way */
+#ifndef CAN_FILTER_MAX_ENTRIES
+#define CAN_FILTER_MAX_ENTRIES	64
+#endif
+
+/** IDs to accept */
+struct can_filter_range {
+	/** First ID */
+	uint32_t first;
+	/** Last ID, the same as first for a single ID */
+	uint32_t last;
+	/** CAN_MSG_EXT for extended IDs, see @ref can_msg_flags */
+	uint8_t flags;
+	/** Receive FIFO the frames go to, 0 or 1 */
+	uint8_t fifo;
+};
+
+BEGIN_DECLS
+
+int can_filter_compile(const struct can_filter_range *ranges, uint32_t count,
+		       uint32_t first_bank, uint32_t banks, bool *exact);
+
+END_DECLS
+
+#endif
+/**@}*/
@@ -0,0 +1,189 @@
+/** @addtogroup can_defines
+ *
+ * @section can_api_queue Interrupt driven message queues
+ *
+ * Frames to send are queued in software, ordered by CAN arbitration
+ * priority, and moved into the three transmit mailboxes from the transmit
+ * interrupt as they free up. The mailboxes are sent by identifier priority,
+ * so the CAN has to be set up with txfp false in can_init(). When all
+ * mailboxes hold frames of lower priority than the first queued one, the
+ * lowest of them is aborted and queued again, so a frame never waits behind
+ * more than the one being sent. A frame stays owned by the queue until its
+ * callback has been called.
+ *
+ * Received frames are copied from both receive FIFOs into ring buffers, one
+ * per filter match index, see @ref cm_ringbuf. Frames of filters without a
+ * ring of their own go to the default ring, and are counted as dropped if
+ * there is none or the ring is full. The rings are read with
+ * can_queue_read().
+ *
+ * The status change interrupt counts the times the CAN went error warning,
+ * error passive and bus-off.
+ *
+ * can_queue_irq_handler() has to be called from the transmit, both receive
+ * and the status change interrupts of the CAN, which must all have the same
+ * priority.
+ *
+ * @code
+ * static struct can_queue can;
+ * static struct ringbuf motor_ring;
+ * static uint8_t motor_buf[8 * sizeof(struct can_rx_msg)];
+ * static struct can_tx_msg status = {
+ *	.id = 0x123, .length = 8, .callback = status_sent,
+ * };
+ *
+ * can_queue_init(&can, CAN1);
+ * ringbuf_init(&motor_ring, motor_buf, sizeof(motor_buf));
+ * can_queue_set_rx_ring(&can, 0, 0, &motor_ring);
+ * nvic_enable_irq(NVIC_CAN1_TX_IRQ);
+ * nvic_enable_irq(NVIC_CAN1_RX0_IRQ);
+ * nvic_enable_irq(NVIC_CAN1_RX1_IRQ);
+ * nvic_enable_irq(NVIC_CAN1_SCE_IRQ);
+ *
+ * void can1_tx_isr(void)
+ * {
+ *	can_queue_irq_handler(&can);
+ * }
+ *
+ * can_queue_submit(&can, &status);
+ * while (can_queue_read(&motor_ring, &msg)) {
+ *	...
+ * }
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA CAN.H */
+
+#ifndef LIBOPENCM3_CAN_QUEUE_H
+#define LIBOPENCM3_CAN_QUEUE_H
+
+#include <libopencm3/cm3/ringbuf.h>
+
+/** Filter match indexes of each FIFO that can have a ring of their own */
+#ifndef CAN_QUEUE_RX_RINGS
+#define CAN_QUEUE_RX_RINGS	16
+#endif
+/** Transmit mailboxes of a CAN */
+#define CAN_QUEUE_MAILBOXES	3
+
+/** @defgroup can_msg_flags Queued frame flags
+ * @{
+ */
+/** Extended ID */
+#define CAN_MSG_EXT		(1 << 0)
+/** Remote transmission request */
+#define CAN_MSG_RTR		(1 << 1)
+/**@}*/
+
+struct can_tx_msg;
+
+/** Called from the interrupt when a frame has been sent, or failed to be
+ * sent if automatic retransmission is disabled */
+typedef void (*can_tx_callback)(struct can_tx_msg *msg, bool ok);
+
+/** A frame to send, filled in by the caller */
+struct can_tx_msg {
+	/** Standard or extended ID */
+	uint32_t id;
+	/** Frame flags, see @ref can_msg_flags */
+	uint8_t flags;
+	/** Payload length, 0 to 8 */
+	uint8_t length;
+	/** Payload */
+	uint8_t data[8];
+	/** Called when the frame is done with, may be NULL */
+	can_tx_callback callback;
+	/** @cond private */
+	struct can_tx_msg *next;
+	/** @endcond */
+};
+
+/** A received frame, as stored in the rings */
+struct can_rx_msg {
+	/** Standard or extended ID */
+	uint32_t id;
+	/** Frame flags, see @ref can_msg_flags */
+	uint8_t flags;
+	/** Payload length */
+	uint8_t length;
+	/** Receive FIFO, 0 or 1 */
+	uint8_t fifo;
+	/** Filter match index within the FIFO */
+	uint8_t fmi;
+	/** Payload */
+	uint8_t data[8];
+};
+
+/** Frame and error counters of a queue */
+struct can_queue_stats {
+	/** Frames sent */
+	uint32_t tx_frames;
+	/** Frames that failed to be sent */
+	uint32_t tx_failed;
+	/** Frames aborted in a mailbox for a frame of higher priority */
+	uint32_t tx_preempted;
+	/** Frames received */
+	uint32_t rx_frames;
+	/** Frames received without room in a ring */
+	uint32_t rx_dropped;
+	/** Receive FIFO overruns, each lost one or more frames */
+	uint32_t rx_lost;
+	/** Times the error warning limit was reached */
+	uint32_t error_warning;
+	/** Times the CAN went error passive */
+	uint32_t error_passive;
+	/** Times the CAN went bus-off */
+	uint32_t bus_off;
+};
+
+/** Queue state of a CAN, allocated by the caller */
+struct can_queue {
+	/** Counters, updated from the interrupt */
+	struct can_queue_stats stats;
+	/** @cond private */
+	uint32_t canport;
+	struct can_tx_msg *head;
+	struct can_tx_msg *mailbox[CAN_QUEUE_MAILBOXES];
+	uint8_t aborting;
+	uint8_t esr;
+	struct ringbuf *rx_ring[2][CAN_QUEUE_RX_RINGS];
+	struct ringbuf *default_ring;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void can_queue_init(struct can_queue *queue, uint32_t canport);
+void can_queue_set_rx_ring(struct can_queue *queue, uint8_t fifo,
+			   uint8_t fmi, struct ringbuf *ring);
+void can_queue_set_default_ring(struct can_queue *queue,
+				struct ringbuf *ring);
+int can_queue_submit(struct can_queue *queue, struct can_tx_msg *msg);
+bool can_queue_busy(struct can_queue *queue);
+bool can_queue_read(struct ringbuf *ring, struct can_rx_msg *msg);
+void can_queue_error_counters(struct can_queue *queue, uint8_t *tec,
+			      uint8_t *rec);
+void can_queue_irq_handler(struct can_queue *queue);
+
+END_DECLS
+
+#endif
+/**@}*/
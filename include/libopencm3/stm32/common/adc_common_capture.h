@@ -0,0 +1,126 @@
+/** @addtogroup adc_defines
+ *
+ * @section adc_api_capture Continuous DMA capture
+ *
+ * An ADC scanning its regular sequence on a hardware trigger can be captured
+ * without gaps into a buffer split in two blocks. While the DMA fills one
+ * block, the other is handed to a callback, so the samples come in at the
+ * trigger rate and the CPU only sees one interrupt per block. Parts with DMA
+ * streams (F4, F7) use the double buffer mode with the two blocks as the two
+ * memory targets, the others run the channel in circular mode and use its
+ * half and full transfer interrupts.
+ *
+ * The ADC itself is set up by the caller as usual: channels and sample times
+ * with adc_set_regular_sequence() and its scan mode, the timer trigger with
+ * adc_enable_external_trigger_regular(), and powered on. adc_capture_start()
+ * then sets up the DMA, switches the ADC to continuous DMA requests and,
+ * where the ADC has to be armed for its trigger, starts the conversions.
+ *
+ * Samples of a block are in conversion order, so with a scan of N channels a
+ * block of a multiple of N samples holds whole sequences. The callback has
+ * the time of one block to take the data, after that the DMA writes the
+ * block again. A block that was overwritten before the interrupt got to it,
+ * or samples dropped by an ADC overrun, count in adc_capture::overruns; after
+ * an ADC overrun the capture restarts with the first block and the next
+ * trigger starts a new sequence.
+ *
+ * adc_capture_irq_handler() has to be called from the interrupt of the DMA
+ * channel and, to pick up overruns, from the ADC interrupt. Select the DMA
+ * request beforehand, with dma_channel_select() on parts with DMA streams,
+ * the CSELR or the DMAMUX on the others.
+ *
+ * On the F4 and F7, adc_capture_start_multi() captures ADC1 with ADC2, or
+ * with ADC2 and ADC3, in an interleaved or the dual regular simultaneous
+ * mode, through the common data register.
+ *
+ * Example, two channels at the rate of TIM2 TRGO on an STM32F4:
+ * @code
+ * static struct adc_capture capture;
+ * static uint16_t samples[2 * 512];
+ * static uint8_t channels[] = { ADC_CHANNEL1, ADC_CHANNEL2 };
+ *
+ * adc_enable_scan_mode(ADC1);
+ * adc_set_regular_sequence(ADC1, 2, channels);
+ * adc_enable_external_trigger_regular(ADC1, ADC_CR2_EXTSEL_TIM2_TRGO,
+ *				       ADC_CR2_EXTEN_RISING_EDGE);
+ * adc_power_on(ADC1);
+ * dma_channel_select(DMA2, DMA_STREAM0, DMA_SxCR_CHSEL_0);
+ * adc_capture_init(&capture, ADC1, DMA2, DMA_STREAM0);
+ * adc_capture_start(&capture, samples, 512, block_ready);
+ * nvic_enable_irq(NVIC_DMA2_STREAM0_IRQ);
+ * timer_enable_counter(TIM2);
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA ADC.H */
+
+/** @cond */
+#if defined(LIBOPENCM3_ADC_H)
+/** @endcond */
+#ifndef LIBOPENCM3_ADC_COMMON_CAPTURE_H
+#define LIBOPENCM3_ADC_COMMON_CAPTURE_H
+
+struct adc_capture;
+
+/** Block ready callback, called from adc_capture_irq_handler()
+ * @param capture the capture
+ * @param block the samples, valid until the DMA comes back to them
+ * @param len number of samples in @a block
+ */
+typedef void (*adc_capture_callback)(struct adc_capture *capture,
+				     uint16_t *block, uint32_t len);
+
+/** State of a continuous ADC capture, allocated by the caller. */
+struct adc_capture {
+	/** Blocks handed to the callback */
+	volatile uint32_t blocks;
+	/** Times samples were lost, see @ref adc_api_capture */
+	volatile uint32_t overruns;
+	/** @cond private */
+	uint32_t adc;
+	uint32_t dma;
+	uint8_t channel;
+	bool multi;
+	uint8_t next;
+	uint16_t *buf;
+	uint32_t block_len;
+	adc_capture_callback callback;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void adc_capture_init(struct adc_capture *capture, uint32_t adc,
+		      uint32_t dma, uint8_t channel);
+void adc_capture_start(struct adc_capture *capture, uint16_t *buf,
+		       uint32_t block_len, adc_capture_callback callback);
+void adc_capture_stop(struct adc_capture *capture);
+void adc_capture_irq_handler(struct adc_capture *capture);
+
+END_DECLS
+
+#endif
+/** @cond */
+#else
+#warning "adc_common_capture.h should not be included directly, only via adc.h"
+#endif
+/** @endcond */
+/**@}*/
@@ -71,6 +71,56 @@ specific memorymap.h header before including this header file.*/
 #define CRC_CR_RESET			(1 << 0)
 /**@}*/
 
+/** Inputs at least this long are fed by DMA when crc_dma_setup() was used */
+#define CRC_DMA_THRESHOLD		64
+
+/**
+ * CRC algorithm description, in the usual "Rocksoft" parametrisation.
+ * The polynomial is given without its top bit, eg. 0x1021 for CCITT.
+ */
+struct crc_params {
+	uint8_t width;		/**< Width of the CRC in bits, 1..32 */
+	bool refin;		/**< Input bytes are processed LSB first */
+	bool refout;		/**< Register is reflected before xorout */
+	uint32_t poly;		/**< Generator polynomial */
+	uint32_t init;		/**< Register value at start of message */
+	uint32_t xorout;	/**< Value xored onto the final register */
+};
+
+/**
+ * Running state of one CRC computation.
+ * Treat as opaque; only one context at a time owns the CRC unit, the others
+ * are carried along in software and can migrate between the two freely.
+ */
+struct crc_context {
+	const struct crc_params *params;
+	uint32_t reg;		/* register, non-reflected, right aligned */
+	uint32_t table[16];	/* nibble table of the left aligned poly */
+	const uint8_t *pending;	/* input not yet fed to the register */
+	uint32_t pending_len;
+	uint8_t carry[4];	/* bytes waiting to complete a word */
+	uint8_t carry_len;
+};
+
+/** @defgroup crc_presets CRC algorithm presets
+ * Check values are for the ASCII string "123456789".
+ @{*/
+/** CRC-32 as used by Ethernet, zlib and PNG, check 0xCBF43926 */
+extern const struct crc_params crc_params_crc32;
+/** CRC-32/MPEG-2, the native CRC of the plain unit, check 0x0376E6E7 */
+extern const struct crc_params crc_params_crc32_mpeg2;
+/** CRC-16/CCITT-FALSE (aka CRC-16/IBM-3740), check 0x29B1 */
+extern const struct crc_params crc_params_crc16_ccitt;
+/** CRC-16/KERMIT, the reflected CCITT variant, check 0x2189 */
+extern const struct crc_params crc_params_crc16_kermit;
+/** CRC-16/MODBUS, check 0x4B37 */
+extern const struct crc_params crc_params_crc16_modbus;
+/** CRC-8/SMBUS, check 0xF4 */
+extern const struct crc_params crc_params_crc8;
+/** CRC-7/MMC as used by SD cards, check 0x75 */
+extern const struct crc_params crc_params_crc7_mmc;
+/**@}*/
+
 BEGIN_DECLS
 
 
@@ -98,6 +148,54 @@ uint32_t crc_calculate(uint32_t data);
  */
 uint32_t crc_calculate_block(uint32_t *datap, int size);
 
+/**
+ * Start a new CRC computation.
+ * The hardware unit is only claimed once data arrives, so any number of
+ * contexts may be live at once.
+ * @param[out] ctx context to initialise
+ * @param[in] params algorithm, eg. one of @ref crc_presets
+ */
+void crc_context_init(struct crc_context *ctx, const struct crc_params *params);
+
+/**
+ * Add a byte buffer to a CRC computation.
+ * Any length and alignment is accepted. Large buffers may be handed to DMA,
+ * in which case this returns early and the buffer must stay untouched until
+ * crc_context_busy() returns false or crc_context_final() is called.
+ * @param[in] ctx context
+ * @param[in] data bytes to add
+ * @param[in] len number of bytes
+ */
+void crc_context_update(struct crc_context *ctx, const void *data,
+			uint32_t len);
+
+/**
+ * Check whether input is still being fed to the CRC unit.
+ * Also advances the computation, so call it when polling.
+ * @param[in] ctx context
+ * @return true while a previous crc_context_update() is still in progress
+ */
+bool crc_context_busy(struct crc_context *ctx);
+
+/**
+ * Finish a CRC computation, waiting for any outstanding input.
+ * Releases the hardware unit; the context must be initialised again before
+ * being reused.
+ * @param[in] ctx context
+ * @return final CRC value, right aligned to the width of the algorithm
+ */
+uint32_t crc_context_final(struct crc_context *ctx);
+
+/**
+ * Compute the CRC of a single buffer.
+ * @param[in] params algorithm, eg. one of @ref crc_presets
+ * @param[in] data bytes to check
+ * @param[in] len number of bytes
+ * @return final CRC value
+ */
+uint32_t crc_compute(const struct crc_params *params, const void *data,
+		     uint32_t len);
+
 END_DECLS
 
 /**@}*/
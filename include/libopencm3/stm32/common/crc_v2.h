@@ -101,6 +101,15 @@ void crc_set_polysize(uint32_t polysize);
 void crc_set_polynomial(uint32_t polynomial);
 void crc_set_initial(uint32_t initial);
 
+/**
+ * Let the CRC context API feed large buffers by memory-to-memory DMA.
+ * The controller clock must be enabled by the caller. On devices with
+ * stream based DMA only DMA2 can do memory-to-memory transfers.
+ * @param[in] dma DMA controller base address, or 0 to stop using DMA
+ * @param[in] channel DMA channel, or stream on stream based controllers
+ */
+void crc_dma_setup(uint32_t dma, uint8_t channel);
+
 END_DECLS
 
 /**@}*/
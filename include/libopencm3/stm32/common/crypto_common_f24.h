@@ -56,18 +56,33 @@
  *
  * @section crypto_api_dma DMA handling API
  *
- * @warning This operation mode is currently not supported.
+ * The message is described by a list of chunks which are streamed through
+ * the CRYP FIFOs by DMA2 (stream 6 for input, stream 5 for output, both on
+ * channel 2). Output may overlap input for in-place operation. Completion
+ * is reported by a callback from crypto_dma_irq_handler(), which has to be
+ * called from both dma2_stream5_isr() and dma2_stream6_isr(): a transfer
+ * error of the input stream stops the output stream, and only the
+ * interrupt of stream 6 reports it. The handler may also be polled instead,
+ * until crypto_dma_busy() returns false.
  *
  * @b Example @b 3: DMA mode
  *
  * @code
- * //[enable-clocks]
+ * //[enable-clocks, including DMA2]
+ * static const struct crypto_dma_chunk msg[] = {
+ *	{ header, header, 16 },                  // in-place
+ *	{ payload, out, 1024 },
+ * };
  * crypto_set_key(CRYPTO_KEY_128BIT,key);
  * crypto_set_iv(iv);                          // only in CBC or CTR mode
- * crypto_set_datatype(CRYPTO_DATA_16BIT);
- * crypto_set_algorithm(ENCRYPT_AES_ECB);
+ * crypto_set_datatype(CRYPTO_DATA_8BIT);
+ * crypto_set_algorithm(ENCRYPT_AES_CTR);
  * crypto_start();
- *	[... API to be described later ...]
+ * nvic_enable_irq(NVIC_DMA2_STREAM5_IRQ);
+ * nvic_enable_irq(NVIC_DMA2_STREAM6_IRQ);
+ * crypto_dma_start(msg, 2, NULL);
+ *	[... other work ...]
+ * while (crypto_dma_busy());
  * crypto_stop();
  * @endcode
  */
@@ -269,6 +284,23 @@ enum crypto_datatype {
 	CRYPTO_DATA_BIT,
 };
 
+/* DMA2 request mapping of the CRYP FIFOs */
+#define CRYPTO_DMA		DMA2
+#define CRYPTO_DMA_IN_STREAM	DMA_STREAM6
+#define CRYPTO_DMA_OUT_STREAM	DMA_STREAM5
+#define CRYPTO_DMA_CHANNEL	DMA_SxCR_CHSEL_2
+
+/** One buffer of a message processed by DMA. Lengths are in 32 bit words
+ * and must be a multiple of the cipher block size. */
+struct crypto_dma_chunk {
+	const uint32_t *inp;
+	uint32_t *outp;
+	uint32_t length;
+};
+
+/** Called once the last chunk was processed, or on a DMA error. */
+typedef void (*crypto_dma_callback)(bool success);
+
 BEGIN_DECLS
 void crypto_wait_busy(void);
 void crypto_set_key(enum crypto_keysize keysize, uint64_t key[]);
@@ -278,6 +310,11 @@ void crypto_set_algorithm(enum crypto_mode mode);
 void crypto_start(void);
 void crypto_stop(void);
 uint32_t crypto_process_block(uint32_t *inp, uint32_t *outp, uint32_t length);
+bool crypto_dma_start(const struct crypto_dma_chunk *chunks, uint32_t count,
+		      crypto_dma_callback callback);
+bool crypto_dma_busy(void);
+void crypto_dma_abort(void);
+void crypto_dma_irq_handler(void);
 END_DECLS
 /**@}*/
 /**@}*/
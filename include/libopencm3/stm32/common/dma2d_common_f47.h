@@ -32,6 +32,7 @@
  *
  */
 
+#include <libopencm3/cm3/common.h>
 #include <libopencm3/stm32/memorymap.h>
 #include <stdint.h>
 
@@ -184,5 +185,93 @@
 /** DMA2D Background Color Lookup table */
 #define DMA2D_BG_CLUT			(uint32_t *)(DMA2D_BASE + 0x800U)
 
+/*
+ * Queued operations
+ *
+ * Operations are prepared in caller owned structures with dma2d_op_fill(),
+ * dma2d_op_copy() or dma2d_op_blend(), which work out all register values up
+ * front, and then queued with dma2d_submit(). The DMA2D runs them one after
+ * the other from its interrupt, so the CPU can go on with the next frame.
+ * dma2d_irq_handler() has to be called from dma2d_isr(), with the DMA2D
+ * clock and interrupt enabled.
+ *
+ * Surfaces are described by their first pixel, line length in pixels and
+ * pixel format, one of DMA2D_xPFCCR_CM_*. Only the ARGB8888, RGB888,
+ * RGB565, ARGB1555 and ARGB4444 formats can be written. L8 and L4 sources
+ * take a CLUT of ARGB8888 colours, which is loaded with each operation; A8
+ * and A4 sources, glyphs for instance, are drawn in the colour of the
+ * surface. Rectangles on 4 bit surfaces start at an even x.
+ */
+
+/** A picture in memory */
+struct dma2d_surface {
+	/** First pixel */
+	void *pixels;
+	/** Pixels per line, including any not drawn */
+	uint16_t width;
+	/** DMA2D_xPFCCR_CM_* */
+	uint8_t format;
+	/** Colour look up table, ARGB8888, for L8 and L4 */
+	const uint32_t *clut;
+	/** Number of entries in @a clut, 1 to 256 */
+	uint16_t clut_len;
+	/** RGB888 colour for A8 and A4 */
+	uint32_t color;
+};
+
+struct dma2d_op;
+
+/** Completion callback, called from dma2d_irq_handler()
+ * @param op the operation
+ * @param ok false if the DMA2D flagged a configuration or bus error
+ */
+typedef void (*dma2d_callback)(struct dma2d_op *op, bool ok);
+
+/** A DMA2D operation, filled in by the dma2d_op_* functions. */
+struct dma2d_op {
+	/** Called when the operation is done, may be NULL */
+	dma2d_callback callback;
+	/** @cond private */
+	uint32_t cr;
+	uint32_t fgmar;
+	uint32_t fgor;
+	uint32_t fgpfccr;
+	uint32_t fgcolr;
+	uint32_t fgcmar;
+	uint32_t bgmar;
+	uint32_t bgor;
+	uint32_t bgpfccr;
+	uint32_t bgcolr;
+	uint32_t bgcmar;
+	uint32_t opfccr;
+	uint32_t ocolr;
+	uint32_t omar;
+	uint32_t oor;
+	uint32_t nlr;
+	struct dma2d_op *next;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void dma2d_op_fill(struct dma2d_op *op, const struct dma2d_surface *dst,
+		   uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+		   uint32_t color);
+void dma2d_op_copy(struct dma2d_op *op,
+		   const struct dma2d_surface *dst, uint16_t x, uint16_t y,
+		   const struct dma2d_surface *src, uint16_t sx, uint16_t sy,
+		   uint16_t w, uint16_t h);
+void dma2d_op_blend(struct dma2d_op *op,
+		    const struct dma2d_surface *dst, uint16_t x, uint16_t y,
+		    const struct dma2d_surface *fg, uint16_t fx, uint16_t fy,
+		    uint8_t alpha,
+		    const struct dma2d_surface *bg, uint16_t bx, uint16_t by,
+		    uint16_t w, uint16_t h);
+void dma2d_submit(struct dma2d_op *op);
+bool dma2d_busy(void);
+void dma2d_irq_handler(void);
+
+END_DECLS
+
 /**@}*/
 #endif
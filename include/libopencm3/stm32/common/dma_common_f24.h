@@ -615,6 +615,8 @@ void dma_set_memory_address(uint32_t dma, uint8_t stream, uint32_t address);
 void dma_set_memory_address_1(uint32_t dma, uint8_t stream, uint32_t address);
 uint16_t dma_get_number_of_data(uint32_t dma, uint8_t stream);
 void dma_set_number_of_data(uint32_t dma, uint8_t stream, uint16_t number);
+void dma_start_mem_clear(uint32_t dma, uint8_t stream, uint32_t *dest,
+			 uint32_t words);
 
 END_DECLS
 /**@}*/
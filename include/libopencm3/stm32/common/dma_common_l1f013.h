@@ -412,6 +412,8 @@ void dma_set_peripheral_address(uint32_t dma, uint8_t channel,
 void dma_set_memory_address(uint32_t dma, uint8_t channel, uint32_t address);
 uint16_t dma_get_number_of_data(uint32_t dma, uint8_t channel);
 void dma_set_number_of_data(uint32_t dma, uint8_t channel, uint16_t number);
+void dma_start_mem_clear(uint32_t dma, uint8_t channel, uint32_t *dest,
+			 uint32_t words);
 
 END_DECLS
 
@@ -0,0 +1,86 @@
+/** @addtogroup fdcan_defines
+ *
+ * @section fdcan_api_filter Filter compiler
+ *
+ * fdcan_filter_compile() takes the IDs to accept, as ranges of standard or
+ * extended IDs each routed to a receive FIFO, and turns them into filter
+ * elements, so the FDCAN drops all other frames without bothering the CPU.
+ *
+ * Single IDs go two to a dual ID element and ranges take a range element
+ * each. Overlapping and adjacent ranges of a FIFO are joined. If that needs
+ * more elements than there are, the ranges of a FIFO with the smallest gap
+ * between them are merged until it fits, and the filters then accept some
+ * frames that are not in the ranges. Elements are ordered single IDs first,
+ * then ranges as given and then merged ranges, each from the shortest, so a
+ * merged range does not take frames of IDs routed to the other FIFO, unless
+ * a merged range of that FIFO holds them as well. Only data frames are
+ * accepted.
+ *
+ * fdcan_filter_compile() is called between fdcan_init() and fdcan_start(),
+ * in place of fdcan_init_filter().
+ *
+ * @code
+ * static const struct fdcan_filter_range accept[] = {
+ *	{ 0x080, 0x080, 0, 0 },
+ *	{ 0x100, 0x17f, 0, 0 },
+ *	{ 0x18fe0000, 0x18feffff, FDCAN_MSG_EXT, 1 },
+ * };
+ *
+ * fdcan_filter_compile(CAN1, accept, 3, NULL);
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA FDCAN.H */
+
+#ifndef LIBOPENCM3_FDCAN_COMMON_FILTER_H
+#define LIBOPENCM3_FDCAN_COMMON_FILTER_H
+
+/** Ranges the compiler works on at a time, more are merged on the way */
+#ifndef FDCAN_FILTER_MAX_ENTRIES
+#define FDCAN_FILTER_MAX_ENTRIES	64
+#endif
+/** Standard ID filter elements set up by fdcan_init_filter() */
+#define FDCAN_FILTER_STD_ELEMENTS	28
+/** Extended ID filter elements set up by fdcan_init_filter() */
+#define FDCAN_FILTER_EXT_ELEMENTS	8
+
+/** IDs to accept */
+struct fdcan_filter_range {
+	/** First ID */
+	uint32_t first;
+	/** Last ID, the same as first for a single ID */
+	uint32_t last;
+	/** FDCAN_MSG_EXT for extended IDs, see @ref fdcan_msg_flags */
+	uint8_t flags;
+	/** Receive FIFO the frames go to, 0 or 1 */
+	uint8_t fifo;
+};
+
+BEGIN_DECLS
+
+int fdcan_filter_compile(uint32_t canport,
+			 const struct fdcan_filter_range *ranges,
+			 uint32_t count, bool *exact);
+
+END_DECLS
+
+#endif
+/**@}*/
@@ -0,0 +1,170 @@
+/** @addtogroup fdcan_defines
+ *
+ * @section fdcan_api_queue Interrupt driven message queues
+ *
+ * Frames to send are queued in software, ordered by priority, and moved into
+ * the transmit buffers of the FDCAN from its interrupt as they free up. With
+ * the transmit queue mode of fdcan_set_can() the FDCAN then sends the buffer
+ * with the highest priority first. A frame stays owned by the queue until its
+ * callback has been called.
+ *
+ * Each frame is sent with a transmit event, which holds the timestamp of the
+ * moment it went out on the bus. The frame gets it in sent_at, next to the
+ * timestamp of when it was queued in queued_at, both in bit times, so
+ * sent_at - queued_at is the latency of the frame. On the STM32H7 the
+ * transmit event FIFO has to be set up with fdcan_init_tx_event_ram(),
+ * without it sent_at is when the interrupt saw the frame sent.
+ *
+ * Received frames are handed to the handler registered for the filter that
+ * accepted them, with a pointer to the frame in message RAM, which is only
+ * valid until the handler returns. Frames without a handler of their own go
+ * to the default handler.
+ *
+ * fdcan_queue_init() is called between fdcan_init() and fdcan_start(), and
+ * fdcan_queue_irq_handler() from the interrupt line 0 of the FDCAN.
+ *
+ * @code
+ * static struct fdcan_queue can;
+ * static struct fdcan_tx_msg status = {
+ *	.id = 0x123, .length = 8, .callback = status_sent,
+ * };
+ *
+ * fdcan_queue_init(&can, CAN1);
+ * fdcan_queue_set_rx_handler(&can, false, 0, motor_command);
+ * fdcan_start(CAN1, FDCAN_CCCR_INIT_TIMEOUT);
+ * nvic_enable_irq(NVIC_FDCAN1_INTR0_IRQ);
+ *
+ * void fdcan1_intr0_isr(void)
+ * {
+ *	fdcan_queue_irq_handler(&can);
+ * }
+ *
+ * fdcan_queue_submit(&can, &status);
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA FDCAN.H */
+
+#ifndef LIBOPENCM3_FDCAN_COMMON_QUEUE_H
+#define LIBOPENCM3_FDCAN_COMMON_QUEUE_H
+
+/** Standard ID filters that can have a handler of their own */
+#ifndef FDCAN_QUEUE_STD_HANDLERS
+#define FDCAN_QUEUE_STD_HANDLERS	28
+#endif
+/** Extended ID filters that can have a handler of their own */
+#ifndef FDCAN_QUEUE_EXT_HANDLERS
+#define FDCAN_QUEUE_EXT_HANDLERS	8
+#endif
+/** Most transmit buffers of an FDCAN */
+#define FDCAN_QUEUE_TX_BUFFERS		32
+
+/** @defgroup fdcan_msg_flags Queued frame flags
+ * @{
+ */
+/** Extended ID */
+#define FDCAN_MSG_EXT			(1 << 0)
+/** Remote transmission request */
+#define FDCAN_MSG_RTR			(1 << 1)
+/** FDCAN frame format */
+#define FDCAN_MSG_FDF			(1 << 2)
+/** Bitrate switching for the data phase */
+#define FDCAN_MSG_BRS			(1 << 3)
+/**@}*/
+
+struct fdcan_queue;
+struct fdcan_tx_msg;
+
+/** Called from the interrupt when a frame has been sent, or failed to be
+ * sent if automatic retransmission is disabled */
+typedef void (*fdcan_tx_callback)(struct fdcan_tx_msg *msg, bool ok);
+
+/** Called from the interrupt for a received frame, which can be read from
+ * message RAM until the handler returns */
+typedef void (*fdcan_rx_handler)(struct fdcan_queue *queue, uint8_t fifo,
+				 const struct fdcan_rx_fifo_element *element);
+
+/** A frame to send, filled in by the caller */
+struct fdcan_tx_msg {
+	/** Standard or extended ID */
+	uint32_t id;
+	/** Frame flags, see @ref fdcan_msg_flags */
+	uint8_t flags;
+	/** Payload length, a valid CAN or FDCAN length */
+	uint8_t length;
+	/** Timestamp counter when the frame was queued */
+	uint16_t queued_at;
+	/** Timestamp counter when the frame was sent */
+	uint16_t sent_at;
+	/** Payload */
+	uint8_t data[64] __attribute__((aligned(4)));
+	/** Called when the frame is done with, may be NULL */
+	fdcan_tx_callback callback;
+	/** @cond private */
+	struct fdcan_tx_msg *next;
+	bool stamped;
+	/** @endcond */
+};
+
+/** Frame counters of a queue */
+struct fdcan_queue_stats {
+	/** Frames sent */
+	uint32_t tx_frames;
+	/** Frames that failed to be sent */
+	uint32_t tx_failed;
+	/** Frames received */
+	uint32_t rx_frames;
+	/** Receive FIFO overruns, each lost one or more frames */
+	uint32_t rx_lost;
+};
+
+/** Queue state of an FDCAN, allocated by the caller */
+struct fdcan_queue {
+	/** Frame counters, updated from the interrupt */
+	struct fdcan_queue_stats stats;
+	/** @cond private */
+	uint32_t canport;
+	struct fdcan_tx_msg *head;
+	struct fdcan_tx_msg *sending[FDCAN_QUEUE_TX_BUFFERS];
+	/* Message marker of the frame in each transmit buffer */
+	uint8_t marker[FDCAN_QUEUE_TX_BUFFERS];
+	uint32_t pending;
+	fdcan_rx_handler std_handler[FDCAN_QUEUE_STD_HANDLERS];
+	fdcan_rx_handler ext_handler[FDCAN_QUEUE_EXT_HANDLERS];
+	fdcan_rx_handler default_handler;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void fdcan_queue_init(struct fdcan_queue *queue, uint32_t canport);
+void fdcan_queue_set_rx_handler(struct fdcan_queue *queue, bool ext,
+				uint8_t filter, fdcan_rx_handler handler);
+void fdcan_queue_set_default_handler(struct fdcan_queue *queue,
+				     fdcan_rx_handler handler);
+int fdcan_queue_submit(struct fdcan_queue *queue, struct fdcan_tx_msg *msg);
+bool fdcan_queue_busy(struct fdcan_queue *queue);
+void fdcan_queue_irq_handler(struct fdcan_queue *queue);
+
+END_DECLS
+
+#endif
+/**@}*/
@@ -155,7 +155,13 @@ void flash_program_double_word(uint32_t address, uint64_t data);
 void flash_program_word(uint32_t address, uint32_t data);
 void flash_program_half_word(uint32_t address, uint16_t data);
 void flash_program_byte(uint32_t address, uint8_t data);
+void flash_set_program_size_limit(uint32_t psize);
 void flash_program(uint32_t address, const uint8_t *data, uint32_t len);
+bool flash_program_async(uint32_t address, const uint8_t *data, uint32_t len,
+			 void (*callback)(bool ok));
+bool flash_erase_sector_async(uint8_t sector, void (*callback)(bool ok));
+bool flash_busy(void);
+void flash_irq_handler(void);
 void flash_program_option_bytes(uint32_t data);
 
 END_DECLS
@@ -0,0 +1,128 @@
+/** @addtogroup flash_defines
+ *
+ * LGPL License Terms @ref lgpl_license
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+/** @cond */
+#ifndef LIBOPENCM3_STM32_COMMON_FLASH_KV_COMMON_F24_H_
+/** @endcond */
+#define LIBOPENCM3_STM32_COMMON_FLASH_KV_COMMON_F24_H_
+
+/*
+ * Key value store
+ *
+ * Small values, such as configuration, kept in two or more flash sectors.
+ * A value is set by appending a record to the active sector, which takes
+ * the time to program it, not the time to erase a sector. A record is only
+ * taken as valid once its commit word, programmed last, is there and its
+ * check matches, so a power failure while setting loses at most the value
+ * being set. A RAM index points to the newest record of each key.
+ *
+ * When the active sector is full, the newest records are copied to the
+ * next sector, which was erased beforehand. Its header is programmed last
+ * and makes it the active one. The sector after it is then erased in the
+ * background with flash_erase_sector_async(), so flash_irq_handler() has to
+ * be called from flash_isr() and the flash interrupt enabled. Setting a
+ * value while that erase runs waits for it.
+ *
+ * The copy is not done in the background: the flash_kv_set() that finds
+ * the sector full programs all live records before it returns, up to a
+ * sector of data, some 65 ms for 16K at x32 on an F4, and waits for the
+ * erase of the spare sector if that is still running. Code that cannot
+ * block that long calls flash_kv_compact() itself at a better time, when
+ * flash_kv_free() runs low.
+ *
+ * The flash has to be unlocked with flash_unlock() while values are set.
+ *
+ * @code
+ * static const struct flash_kv_sector config_sectors[] = {
+ *	{ 0x08008000, 16 * 1024, 2 },
+ *	{ 0x0800c000, 16 * 1024, 3 },
+ * };
+ * flash_kv_init(&config, config_sectors, 2);
+ * flash_kv_set(&config, KEY_BAUD, &baud, sizeof(baud));
+ * flash_kv_get(&config, KEY_BAUD, &baud, sizeof(baud));
+ * @endcode
+ */
+
+/** Keys the index holds, a power of two */
+#ifndef FLASH_KV_MAX_KEYS
+#define FLASH_KV_MAX_KEYS	64
+#endif
+/** Most sectors of a store */
+#define FLASH_KV_MAX_SECTORS	4
+/** Longest value */
+#define FLASH_KV_MAX_VALUE	1024
+
+/** A flash sector of a store */
+struct flash_kv_sector {
+	/** Start address */
+	uint32_t address;
+	/** Size in bytes */
+	uint32_t size;
+	/** Sector number for flash_erase_sector() */
+	uint8_t sector;
+};
+
+/** @cond private */
+struct flash_kv_entry {
+	uint16_t key;
+	uint16_t len;
+	/* Offset of the record in the active sector, 0 if deleted */
+	uint32_t offset;
+};
+/** @endcond */
+
+/** A key value store, set up by flash_kv_init() */
+struct flash_kv {
+	/** @cond private */
+	const struct flash_kv_sector *sectors;
+	uint8_t count;
+	uint8_t active;
+	/* Sector erased and ready to be compacted into */
+	volatile bool spare_erased;
+	/* Generation of the active sector, higher is newer */
+	uint32_t generation;
+	/* Offset of the next record in the active sector */
+	uint32_t end;
+	uint16_t keys;
+	struct flash_kv_entry index[FLASH_KV_MAX_KEYS];
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+bool flash_kv_init(struct flash_kv *kv, const struct flash_kv_sector *sectors,
+		   uint8_t count);
+const void *flash_kv_find(struct flash_kv *kv, uint16_t key, uint16_t *len);
+int flash_kv_get(struct flash_kv *kv, uint16_t key, void *value,
+		 uint16_t size);
+bool flash_kv_set(struct flash_kv *kv, uint16_t key, const void *value,
+		  uint16_t len);
+bool flash_kv_delete(struct flash_kv *kv, uint16_t key);
+bool flash_kv_compact(struct flash_kv *kv);
+uint32_t flash_kv_free(struct flash_kv *kv);
+
+END_DECLS
+
+/** @cond */
+#endif /* LIBOPENCM3_STM32_COMMON_FLASH_KV_COMMON_F24_H_ */
+/** @endcond */
+/**@}*/
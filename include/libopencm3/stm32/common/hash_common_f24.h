@@ -62,8 +62,12 @@
 /* HASH status register (HASH_SR) */
 #define HASH_SR		MMIO32(HASH + 0x28)
 
-/* HASH context swap registers (HASH_CSR[51]) */
-#define HASH_CSR	(&MMIO32(HASH + 0xF8)) /* x51 */
+/* HASH context swap registers (HASH_CSR[51], HASH_CSR[54] with SHA-2) */
+#define HASH_CSR	(&MMIO32(HASH + 0xF8)) /* x54 */
+#define HASH_CSR_COUNT	54
+
+/* HASH digest registers (HASH_HR[8], SHA-2 capable parts only) */
+#define HASH_HRX	(&MMIO32(HASH + 0x310)) /* x8 */
 
 /* --- HASH_CR values ------------------------------------------------------ */
 
@@ -105,8 +109,12 @@
 @{*/
 #define HASH_ALGO_SHA1		(0 << 7)
 #define HASH_ALGO_MD5		(1 << 7)
+/* Only for parts with SHA-2 support (STM32F43x) */
+#define HASH_ALGO_SHA224	((1 << 18) | (0 << 7))
+#define HASH_ALGO_SHA256	((1 << 18) | (1 << 7))
 /**@}*/
 #define HASH_CR_ALGO		(1 << 7)
+#define HASH_CR_ALGO1		(1 << 18)
 
 /* NBW: Number of words already pushed */
 #define HASH_CR_NBW			(15 << 8)
@@ -114,6 +122,9 @@
 /* DINNE: DIN(Data input register) not empty */
 #define HASH_CR_DINNE		(1 << 12)
 
+/* MDMAT: Multiple DMA transfers (STM32F437/F439 only) */
+#define HASH_CR_MDMAT		(1 << 13)
+
 /* LKEY: Long key selection */
 /****************************************************************************/
 /** @defgroup hash_key_length HASH Key length
@@ -156,6 +167,32 @@
 /* BUSY: Busy bit */
 #define HASH_SR_BUSY		(1 << 3)
 
+/* --- HASH streaming contexts --------------------------------------------- */
+
+/* DMA2 request mapping of the HASH input FIFO */
+#define HASH_DMA		DMA2
+#define HASH_DMA_STREAM		DMA_STREAM7
+#define HASH_DMA_CHANNEL	DMA_SxCR_CHSEL_2
+
+/* Updates of at least this many words are fed by DMA */
+#define HASH_DMA_THRESHOLD	16
+
+/** State of one message digest. Several contexts can be in progress at
+ * the same time, the processor state is swapped in and out on demand. */
+struct hash_context {
+	uint32_t cr;
+	const uint8_t *key;
+	uint32_t keylen;
+	uint8_t tail[4];
+	uint8_t tail_len;
+	bool started;
+	/* Saved processor state */
+	uint32_t imr;
+	uint32_t str;
+	uint32_t saved_cr;
+	uint32_t csr[HASH_CSR_COUNT];
+};
+
 /* --- HASH function prototypes -------------------------------------------- */
 
 BEGIN_DECLS
@@ -170,6 +207,13 @@ void hash_add_data(uint32_t data);
 void hash_digest(void);
 void hash_get_result(uint32_t *data);
 
+void hash_context_init(struct hash_context *ctx, uint32_t algorithm,
+		       const uint8_t *key, uint32_t keylen);
+void hash_context_update(struct hash_context *ctx, const void *data,
+			 uint32_t len);
+bool hash_context_busy(void);
+uint8_t hash_context_finish(struct hash_context *ctx, uint32_t *digest);
+
 END_DECLS
 /**@}*/
 #endif
@@ -0,0 +1,152 @@
+/** @addtogroup i2c_defines
+ *
+ * @section i2c_api_queue Queued interrupt driven transactions
+ *
+ * An I2C master can run a queue of transactions from its interrupts, so
+ * several devices on one bus are served without the main loop ever waiting
+ * for the bus. A transaction is a write, a read, or a write followed by a
+ * read with a repeated start, to one 7 bit address, like i2c_transfer7().
+ * The caller owns the transaction structures, which stay linked in the queue
+ * until their callback has been called.
+ *
+ * The callback gets the outcome: done, not acknowledged by the slave,
+ * arbitration lost to another master, bus error or timeout. The next
+ * transaction is started before the callback runs, and transactions can be
+ * queued from the main loop or from the callbacks.
+ *
+ * The I2C is set up (clock, timing) and enabled by the caller.
+ * i2c_queue_irq_handler() has to be called from the event and the error
+ * interrupts of the I2C, or its one interrupt where both are combined. For
+ * timeouts, i2c_queue_tick() is called at a steady rate, every millisecond
+ * for instance, from a context that does not preempt the I2C interrupts. A
+ * timed out transaction is ended by resetting the I2C, which keeps its
+ * configuration.
+ *
+ * Example, polling two sensors from the SysTick interrupt:
+ * @code
+ * static struct i2c_queue bus;
+ * static uint8_t accel_reg = 0x28, gyro_reg = 0x22;
+ * static uint8_t accel[6], gyro[6];
+ * static struct i2c_transaction accel_read = {
+ *	.addr = 0x19, .w = &accel_reg, .wn = 1, .r = accel, .rn = 6,
+ *	.timeout = 2, .callback = sample_done,
+ * };
+ * static struct i2c_transaction gyro_read = {
+ *	.addr = 0x6b, .w = &gyro_reg, .wn = 1, .r = gyro, .rn = 6,
+ *	.timeout = 2, .callback = sample_done,
+ * };
+ *
+ * i2c_queue_init(&bus, I2C1);
+ *
+ * void sys_tick_handler(void)
+ * {
+ *	i2c_queue_tick(&bus);
+ *	if (!i2c_queue_busy(&bus)) {
+ *		i2c_queue_submit(&bus, &accel_read);
+ *		i2c_queue_submit(&bus, &gyro_read);
+ *	}
+ * }
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA I2C.H */
+
+/** @cond */
+#if defined(LIBOPENCM3_I2C_H)
+/** @endcond */
+#ifndef LIBOPENCM3_I2C_COMMON_QUEUE_H
+#define LIBOPENCM3_I2C_COMMON_QUEUE_H
+
+#include <stddef.h>
+
+/** Outcome of a queued I2C transaction */
+enum i2c_transaction_status {
+	I2C_TRANSACTION_OK,
+	/** The slave did not acknowledge its address or a written byte */
+	I2C_TRANSACTION_NACK,
+	/** Another master won the bus */
+	I2C_TRANSACTION_ARB_LOST,
+	/** Misplaced START or STOP on the bus */
+	I2C_TRANSACTION_BUS_ERROR,
+	/** Not done within the timeout */
+	I2C_TRANSACTION_TIMEOUT,
+};
+
+struct i2c_transaction;
+
+/** Transaction completion callback, called from the I2C interrupt, or from
+ * i2c_queue_tick() on a timeout */
+typedef void (*i2c_transaction_callback)(struct i2c_transaction *transaction,
+					 enum i2c_transaction_status status);
+
+/** An I2C transaction, filled in by the caller. */
+struct i2c_transaction {
+	/** 7 bit slave address */
+	uint8_t addr;
+	/** Bytes to write, or NULL */
+	const uint8_t *w;
+	/** Number of bytes to write, up to 255 */
+	size_t wn;
+	/** Buffer for the bytes read, or NULL */
+	uint8_t *r;
+	/** Number of bytes to read, up to 255 */
+	size_t rn;
+	/** Ticks of i2c_queue_tick() the transaction may take once started,
+	 * 0 for no limit */
+	uint16_t timeout;
+	/** Called when the transaction is over, may be NULL */
+	i2c_transaction_callback callback;
+	/** @cond private */
+	struct i2c_transaction *next;
+	/** @endcond */
+};
+
+/** Queue state of an I2C master, allocated by the caller. */
+struct i2c_queue {
+	/** @cond private */
+	uint32_t i2c;
+	struct i2c_transaction *head;
+	struct i2c_transaction *tail;
+	size_t pos;
+	bool reading;
+	volatile uint16_t ticks;
+	enum i2c_transaction_status status;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void i2c_queue_init(struct i2c_queue *queue, uint32_t i2c);
+bool i2c_queue_submit(struct i2c_queue *queue,
+		      struct i2c_transaction *transaction);
+bool i2c_queue_busy(struct i2c_queue *queue);
+void i2c_queue_irq_handler(struct i2c_queue *queue);
+void i2c_queue_tick(struct i2c_queue *queue);
+
+END_DECLS
+
+#endif
+/** @cond */
+#else
+#warning "i2c_common_queue.h should not be included directly, only via i2c.h"
+#endif
+/** @endcond */
+/**@}*/
@@ -0,0 +1,154 @@
+/** @addtogroup ltdc_defines
+ *
+ * LGPL License Terms @ref lgpl_license
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+/** @cond */
+#ifndef LIBOPENCM3_STM32_COMMON_LTDC_FB_COMMON_F47_H_
+/** @endcond */
+#define LIBOPENCM3_STM32_COMMON_LTDC_FB_COMMON_F47_H_
+
+#include <libopencm3/stm32/dma2d.h>
+#include <libopencm3/stm32/fsmc.h>
+
+/*
+ * Framebuffers
+ *
+ * A layer is scanned out of one of two or three buffers in SDRAM while the
+ * next frame is drawn into another one. ltdc_fb_swap() queues the drawn
+ * buffer, which the LTDC takes at its next vertical blanking, so a frame is
+ * never shown half drawn. With three buffers drawing goes on right away,
+ * a frame still waiting when the next one is swapped is dropped for it.
+ *
+ * Only the regions given to ltdc_fb_damage() need drawing. When a buffer is
+ * taken by ltdc_fb_acquire(), the regions that changed since its frame are
+ * copied from the newest frame with the DMA2D, ahead of anything queued
+ * after, instead of drawing the whole frame again.
+ *
+ * ltdc_fb_irq_handler() has to be called from lcd_tft_isr(), and
+ * dma2d_irq_handler() from dma2d_isr(). The SDRAM has to be set up with
+ * sdram_timing() and sdram_command() before ltdc_fb_init().
+ *
+ * @code
+ * ltdc_fb_init(&fb, LTDC_LAYER_1, LTDC_LxPFCR_RGB565, 480, 272, 3,
+ *		SDRAM_BANK1, 0);
+ * while (1) {
+ *	while (!ltdc_fb_acquire(&fb, &surface));
+ *	dma2d_op_fill(&op, &surface, x, y, w, h, color);
+ *	op.callback = frame_drawn;	(calls ltdc_fb_swap())
+ *	dma2d_submit(&op);
+ *	ltdc_fb_damage(&fb, x, y, w, h);
+ *	...
+ * }
+ * @endcode
+ */
+
+/** Most buffers of a layer */
+#define LTDC_FB_MAX_BUFFERS	3
+/** Regions kept per frame, more are merged into their bounding box */
+#define LTDC_FB_MAX_DAMAGE	4
+
+/* Frames of damage history, one more than a buffer can fall behind */
+#define LTDC_FB_HISTORY		(LTDC_FB_MAX_BUFFERS + 1)
+
+/** A rectangle of a frame */
+struct ltdc_fb_rect {
+	uint16_t x;
+	uint16_t y;
+	uint16_t w;
+	uint16_t h;
+};
+
+/** Frame time statistics, in display refreshes */
+struct ltdc_fb_stats {
+	/** Vertical blankings since the statistics were reset */
+	uint32_t refreshes;
+	/** Frames put on screen */
+	uint32_t frames;
+	/** Frames replaced by a newer one before they were shown */
+	uint32_t dropped;
+	/** Fewest refreshes a frame stayed on screen */
+	uint32_t min_refreshes;
+	/** Most refreshes a frame stayed on screen */
+	uint32_t max_refreshes;
+	/** Refreshes that showed the previous frame again */
+	uint32_t repeats;
+};
+
+struct ltdc_fb;
+
+/** @cond private */
+struct ltdc_fb_copy {
+	struct dma2d_op op;
+	struct ltdc_fb *fb;
+};
+/** @endcond */
+
+/** A double or triple buffered layer, set up by ltdc_fb_init() */
+struct ltdc_fb {
+	/** @cond private */
+	uint32_t layer;
+	uint16_t width;
+	uint16_t height;
+	uint8_t format;
+	uint8_t count;
+	uint8_t *buffer[LTDC_FB_MAX_BUFFERS];
+	/* Frame number of the content of each buffer */
+	uint32_t content[LTDC_FB_MAX_BUFFERS];
+	/* Frames swapped so far, the newest is in latest */
+	uint32_t seq;
+	int8_t latest;
+	/* Scanned out, loaded at the next blanking, queued behind it and
+	 * drawn, -1 if none */
+	volatile int8_t front;
+	volatile int8_t loading;
+	volatile int8_t pending;
+	int8_t back;
+	/* Regions drawn into each of the last frames */
+	struct ltdc_fb_rect damage[LTDC_FB_HISTORY][LTDC_FB_MAX_DAMAGE];
+	uint8_t damage_count[LTDC_FB_HISTORY];
+	struct ltdc_fb_copy copy[LTDC_FB_MAX_BUFFERS * LTDC_FB_MAX_DAMAGE];
+	volatile uint8_t copies;
+	/* Refresh count when the front frame was put on screen */
+	uint32_t shown_at;
+	struct ltdc_fb_stats stats;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+bool ltdc_fb_init(struct ltdc_fb *fb, uint32_t layer, uint8_t format,
+		  uint16_t width, uint16_t height, uint8_t count,
+		  enum fmc_sdram_bank bank, uint32_t offset);
+bool ltdc_fb_acquire(struct ltdc_fb *fb, struct dma2d_surface *surface);
+bool ltdc_fb_ready(const struct ltdc_fb *fb);
+void ltdc_fb_damage(struct ltdc_fb *fb, uint16_t x, uint16_t y,
+		    uint16_t w, uint16_t h);
+void ltdc_fb_swap(struct ltdc_fb *fb);
+void ltdc_fb_get_stats(struct ltdc_fb *fb, struct ltdc_fb_stats *stats);
+void ltdc_fb_reset_stats(struct ltdc_fb *fb);
+void ltdc_fb_irq_handler(struct ltdc_fb *fb);
+
+END_DECLS
+
+/** @cond */
+#endif /* LIBOPENCM3_STM32_COMMON_LTDC_FB_COMMON_F47_H_ */
+/** @endcond */
+/**@}*/
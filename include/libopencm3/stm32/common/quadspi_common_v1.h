@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <libopencm3/cm3/common.h>
+
 /** @addtogroup quadspi_registers QuadSPI Registers
  * @{
  */
@@ -48,7 +50,7 @@
 #define QUADSPI_PIR     MMIO32(QUADSPI_BASE + 0x2CU)
 
 /** QUADSPI low power timeout */
-#define QUADSPI_LPTR      MMIO32(QUADSPI_BASE + 0x30U
+#define QUADSPI_LPTR      MMIO32(QUADSPI_BASE + 0x30U)
 /**@}*/
 
 #define QUADSPI_CR_PRESCALE_MASK  0xff
@@ -158,6 +160,65 @@
  * @{
  */
 
+/** A command sequence, as it goes out on the bus. Phases with mode
+ * QUADSPI_CCR_MODE_NONE are left out. */
+struct quadspi_command {
+	/** Instruction byte */
+	uint8_t instruction;
+	/** Lines for the instruction, QUADSPI_CCR_MODE_* */
+	uint8_t instruction_mode;
+	/** Lines for the address, QUADSPI_CCR_MODE_* */
+	uint8_t address_mode;
+	/** Address bytes, 1 to 4 */
+	uint8_t address_size;
+	/** Lines for the alternate bytes, QUADSPI_CCR_MODE_* */
+	uint8_t alternate_mode;
+	/** Alternate bytes, 1 to 4 */
+	uint8_t alternate_size;
+	/** Alternate bytes value */
+	uint32_t alternate;
+	/** Dummy cycles between address (or alternate bytes) and data */
+	uint8_t dummy_cycles;
+	/** Lines for the data, QUADSPI_CCR_MODE_* */
+	uint8_t data_mode;
+	/** Address, alternate bytes and data at double data rate */
+	bool ddr;
+};
+
+/** @defgroup quadspi_nor NOR flash commands
+ * Instructions common to serial NOR flash of the 25 series. The quad enable
+ * bit, which the quad commands need, is set differently by each vendor.
+ * @{
+ */
+#define QUADSPI_NOR_WRITE_ENABLE	0x06
+#define QUADSPI_NOR_WRITE_DISABLE	0x04
+#define QUADSPI_NOR_READ_STATUS		0x05
+#define QUADSPI_NOR_WRITE_STATUS	0x01
+#define QUADSPI_NOR_READ_ID		0x9f
+#define QUADSPI_NOR_READ		0x03
+#define QUADSPI_NOR_FAST_READ		0x0b
+#define QUADSPI_NOR_DUAL_OUTPUT_READ	0x3b
+#define QUADSPI_NOR_QUAD_OUTPUT_READ	0x6b
+#define QUADSPI_NOR_QUAD_IO_READ	0xeb
+#define QUADSPI_NOR_PAGE_PROGRAM	0x02
+#define QUADSPI_NOR_SECTOR_ERASE	0x20
+#define QUADSPI_NOR_BLOCK_ERASE		0xd8
+#define QUADSPI_NOR_CHIP_ERASE		0xc7
+#define QUADSPI_NOR_ENTER_4BYTE		0xb7
+#define QUADSPI_NOR_RESET_ENABLE	0x66
+#define QUADSPI_NOR_RESET		0x99
+
+/** Status register: write in progress */
+#define QUADSPI_NOR_SR_WIP		(1 << 0)
+/** Status register: write enable latch */
+#define QUADSPI_NOR_SR_WEL		(1 << 1)
+
+/** Program page size */
+#define QUADSPI_NOR_PAGE_SIZE		256
+/** Sector erase size */
+#define QUADSPI_NOR_SECTOR_SIZE		4096
+/**@}*/
+
 BEGIN_DECLS
 
 /**
@@ -170,6 +231,169 @@ void quadspi_enable(void);
  */
 void quadspi_disable(void);
 
+/**
+ * Set the clock prescaler, the bus clock is the AHB clock / (prescaler + 1).
+ * @param prescaler 0 to 255
+ */
+void quadspi_set_prescaler(uint8_t prescaler);
+
+/**
+ * Set the flash size.
+ * @param size_log2 log2 of the size in bytes, 24 for 16 MiB
+ */
+void quadspi_set_flash_size(uint8_t size_log2);
+
+/**
+ * Set the least time chip select stays high between commands.
+ * @param cycles 1 to 8 bus clock cycles
+ */
+void quadspi_set_cs_high_time(uint8_t cycles);
+
+/**
+ * Sample the data half a clock cycle later, for fast clocks with long
+ * traces.
+ */
+void quadspi_enable_sample_shift(void);
+
+/**
+ * Sample the data on the clock edge.
+ */
+void quadspi_disable_sample_shift(void);
+
+/**
+ * Abort any command and leave memory-mapped or auto-polling mode.
+ */
+void quadspi_abort(void);
+
+/**
+ * Tell whether a command is running, or memory-mapped mode is on.
+ */
+bool quadspi_is_busy(void);
+
+/**
+ * Send a command without data, and wait until it is out.
+ * @param cmd command sequence
+ * @param address used if the command has an address phase
+ */
+void quadspi_command(const struct quadspi_command *cmd, uint32_t address);
+
+/**
+ * Read data with the CPU, in indirect mode.
+ * @param cmd command sequence, with a data phase
+ * @param address used if the command has an address phase
+ * @param data destination
+ * @param len number of bytes, at least 1
+ */
+void quadspi_read(const struct quadspi_command *cmd, uint32_t address,
+		  void *data, uint32_t len);
+
+/**
+ * Write data with the CPU, in indirect mode.
+ * @param cmd command sequence, with a data phase
+ * @param address used if the command has an address phase
+ * @param data source
+ * @param len number of bytes, at least 1
+ */
+void quadspi_write(const struct quadspi_command *cmd, uint32_t address,
+		   const void *data, uint32_t len);
+
+/**
+ * Start an indirect read through a DMA channel (or stream), which has to be
+ * assigned to the QUADSPI request beforehand. The transfer runs on its own,
+ * it is over when quadspi_is_busy() turns false, or at the TC interrupt.
+ * Not available on H7, whose QUADSPI is served by the MDMA.
+ * @param cmd command sequence, with a data phase
+ * @param address used if the command has an address phase
+ * @param dma DMA controller base address
+ * @param channel DMA channel or stream number
+ * @param data destination, words are moved when it and @p len are word
+ * aligned
+ * @param len number of bytes, 1 to 65535
+ */
+void quadspi_read_dma(const struct quadspi_command *cmd, uint32_t address,
+		      uint32_t dma, uint8_t channel, void *data, uint32_t len);
+
+/**
+ * Start an indirect write through a DMA channel (or stream), like
+ * quadspi_read_dma().
+ * @param cmd command sequence, with a data phase
+ * @param address used if the command has an address phase
+ * @param dma DMA controller base address
+ * @param channel DMA channel or stream number
+ * @param data source, words are moved when it and @p len are word aligned
+ * @param len number of bytes, 1 to 65535
+ */
+void quadspi_write_dma(const struct quadspi_command *cmd, uint32_t address,
+		       uint32_t dma, uint8_t channel, const void *data,
+		       uint32_t len);
+
+/**
+ * Start auto-polling: the command, usually a status register read, is
+ * repeated until the masked status matches. The match is signalled by
+ * quadspi_poll_matched() and the SM interrupt, and ends polling.
+ * @param cmd command sequence, with a data phase of 1 to 4 bytes
+ * @param len status bytes
+ * @param mask status bits to compare
+ * @param match value of those bits to wait for
+ * @param interval bus clock cycles between two polls
+ */
+void quadspi_start_polling(const struct quadspi_command *cmd, uint8_t len,
+			   uint32_t mask, uint32_t match, uint16_t interval);
+
+/**
+ * Tell whether auto-polling found its match, and clear that.
+ */
+bool quadspi_poll_matched(void);
+
+/**
+ * Map the flash into the memory space, at the QUADSPI bank. Reads from
+ * there, code fetches included, send @p cmd with the address. Leave with
+ * quadspi_abort() before sending other commands.
+ * @param cmd read command sequence
+ */
+void quadspi_memory_map(const struct quadspi_command *cmd);
+
+/**
+ * Read the JEDEC ID of a NOR flash.
+ * @param id manufacturer, memory type and capacity bytes
+ */
+void quadspi_nor_read_id(uint8_t id[3]);
+
+/**
+ * Wait until a NOR flash has finished programming or erasing, with
+ * auto-polling of its status register.
+ */
+void quadspi_nor_wait_ready(void);
+
+/**
+ * Erase a 4 KiB sector of a NOR flash with 3 byte addresses.
+ * @param address any address in the sector
+ */
+void quadspi_nor_erase_sector(uint32_t address);
+
+/**
+ * Program a NOR flash with 3 byte addresses, page by page. The area has to
+ * be erased.
+ * @param address first byte
+ * @param data source
+ * @param len number of bytes
+ */
+void quadspi_nor_program(uint32_t address, const void *data, uint32_t len);
+
+/**
+ * Read a NOR flash with 3 byte addresses, on four data lines.
+ * @param address first byte
+ * @param data destination
+ * @param len number of bytes, at least 1
+ */
+void quadspi_nor_read(uint32_t address, void *data, uint32_t len);
+
+/**
+ * Map a NOR flash with 3 byte addresses into the memory space, reading on
+ * four data lines.
+ */
+void quadspi_nor_memory_map(void);
+
 END_DECLS
 
 /**@}*/
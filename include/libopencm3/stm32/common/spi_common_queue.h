@@ -0,0 +1,126 @@
+/** @addtogroup spi_defines
+ *
+ * @section spi_api_queue Queued DMA transactions
+ *
+ * A SPI master can run a queue of transactions with one DMA channel (or
+ * stream) for each direction. A transaction covers the chip select, the data
+ * to send and the buffer to receive into, either of which may be left out,
+ * and a completion callback. The caller owns the transaction structures,
+ * which stay linked in the queue until their callback has been called.
+ *
+ * The next transaction is started from the receive DMA interrupt of the
+ * previous one, before its callback runs, so transactions on the bus follow
+ * each other without waiting for the application. Transactions can be
+ * queued from the main loop or from the callbacks.
+ *
+ * The SPI is set up and enabled by the caller. Its frame size, 8 or 16 bits,
+ * is taken when the queue is initialised. Select the DMA requests, with
+ * dma_channel_select() on parts with DMA streams, the CSELR or the DMAMUX on
+ * the others, before spi_queue_init(). spi_queue_irq_handler() has to be
+ * called from the interrupt of the receive DMA channel.
+ *
+ * Example on an STM32F4, SPI1 on DMA2 streams 0 (RX) and 3 (TX):
+ * @code
+ * static struct spi_queue bus;
+ * static struct spi_transaction cmd = {
+ *	.tx_buf = cmd_bytes, .len = sizeof(cmd_bytes),
+ *	.cs_port = GPIOA, .cs_pins = GPIO4, .flags = SPI_TRANSACTION_CS_HOLD,
+ * };
+ * static struct spi_transaction pixels = {
+ *	.tx_buf = framebuffer, .len = sizeof(framebuffer),
+ *	.cs_port = GPIOA, .cs_pins = GPIO4, .callback = frame_done,
+ * };
+ *
+ * dma_channel_select(DMA2, DMA_STREAM0, DMA_SxCR_CHSEL_3);
+ * dma_channel_select(DMA2, DMA_STREAM3, DMA_SxCR_CHSEL_3);
+ * spi_queue_init(&bus, SPI1, DMA2, DMA_STREAM0, DMA_STREAM3);
+ * spi_queue_submit(&bus, &cmd);
+ * spi_queue_submit(&bus, &pixels);
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA SPI.H */
+
+/** @cond */
+#if defined(LIBOPENCM3_SPI_H)
+/** @endcond */
+#ifndef LIBOPENCM3_SPI_COMMON_QUEUE_H
+#define LIBOPENCM3_SPI_COMMON_QUEUE_H
+
+/** Leave the chip select asserted for the next transaction */
+#define SPI_TRANSACTION_CS_HOLD		(1 << 0)
+
+struct spi_transaction;
+
+/** Transaction completion callback, called from spi_queue_irq_handler() */
+typedef void (*spi_transaction_callback)(struct spi_transaction *transaction);
+
+/** A SPI transaction, filled in by the caller. */
+struct spi_transaction {
+	/** Frames to send, or NULL to send all ones */
+	const void *tx_buf;
+	/** Buffer for the received frames, or NULL to drop them */
+	void *rx_buf;
+	/** Number of frames, at least 1 */
+	uint16_t len;
+	/** GPIO port of the active low chip select, or 0 for none */
+	uint32_t cs_port;
+	/** GPIO pin(s) of the chip select */
+	uint16_t cs_pins;
+	/** 0 or @ref SPI_TRANSACTION_CS_HOLD */
+	uint8_t flags;
+	/** Called when the transaction is done, may be NULL */
+	spi_transaction_callback callback;
+	/** @cond private */
+	struct spi_transaction *next;
+	/** @endcond */
+};
+
+/** Queue state of a SPI master, allocated by the caller. */
+struct spi_queue {
+	/** @cond private */
+	uint32_t spi;
+	uint32_t dma;
+	uint8_t rx_channel;
+	uint8_t tx_channel;
+	struct spi_transaction *head;
+	struct spi_transaction *tail;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void spi_queue_init(struct spi_queue *queue, uint32_t spi, uint32_t dma,
+		    uint8_t rx_channel, uint8_t tx_channel);
+void spi_queue_submit(struct spi_queue *queue,
+		      struct spi_transaction *transaction);
+bool spi_queue_busy(struct spi_queue *queue);
+void spi_queue_irq_handler(struct spi_queue *queue);
+
+END_DECLS
+
+#endif
+/** @cond */
+#else
+#warning "spi_common_queue.h should not be included directly, only via spi.h"
+#endif
+/** @endcond */
+/**@}*/
@@ -273,6 +273,27 @@ LGPL License Terms @ref lgpl_license
 		GET_REG(USB_EP_REG(EP)) & \
 		(USB_EP_NTOGGLE_MSK | USB_EP_RX_DTOG))
 
+/* Macros for toggling DTOG bits, leaving the CTR bits alone */
+#define USB_TOG_EP_TX_DTOG(EP) \
+	SET_REG(USB_EP_REG(EP), \
+		(GET_REG(USB_EP_REG(EP)) & USB_EP_NTOGGLE_MSK) | \
+		USB_EP_RX_CTR | USB_EP_TX_CTR | USB_EP_TX_DTOG)
+
+#define USB_TOG_EP_RX_DTOG(EP) \
+	SET_REG(USB_EP_REG(EP), \
+		(GET_REG(USB_EP_REG(EP)) & USB_EP_NTOGGLE_MSK) | \
+		USB_EP_RX_CTR | USB_EP_TX_CTR | USB_EP_RX_DTOG)
+
+/*
+ * In double buffered mode the DTOG bit of the unused direction becomes
+ * SW_BUF, the buffer owned by the application. The peripheral NAKs while
+ * SW_BUF equals its own DTOG.
+ */
+#define USB_EP_TX_SW_BUF		USB_EP_RX_DTOG
+#define USB_EP_RX_SW_BUF		USB_EP_TX_DTOG
+#define USB_TOG_EP_TX_SW_BUF(EP)	USB_TOG_EP_RX_DTOG(EP)
+#define USB_TOG_EP_RX_SW_BUF(EP)	USB_TOG_EP_TX_DTOG(EP)
+
 
 /* --- USB BTABLE registers ------------------------------------------------ */
 
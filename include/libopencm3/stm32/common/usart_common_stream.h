@@ -0,0 +1,123 @@
+/** @addtogroup usart_defines
+ *
+ * @section usart_api_stream DMA streaming API
+ *
+ * A USART can be run as a byte stream with one DMA channel (or stream) for
+ * each direction, so the CPU is not interrupted for every byte.
+ *
+ * Reception runs in circular mode into a ring of power of two size. The
+ * half and full transfer interrupts and the IDLE line interrupt publish the
+ * bytes received so far, so a frame is delivered as soon as the line goes
+ * quiet, with a callback that tells how many bytes arrived and whether the
+ * line is now idle. The data is taken with usart_stream_read() or directly
+ * from the ring. The ring has to be large enough to hold whatever arrives
+ * before it is read. When the DMA overruns the reader, the overrun is
+ * counted and reception is held until the next usart_stream_read(), which
+ * drops the unread data.
+ *
+ * Transmission is queued: usart_stream_write() copies into a second ring
+ * and the DMA sends it out in as few transfers as the ring wrapping allows.
+ *
+ * usart_stream_irq_handler() has to be called from the USART interrupt and
+ * the interrupts of both DMA channels. Select the DMA request before
+ * starting a direction, with dma_channel_select() on parts with DMA streams,
+ * the CSELR or the DMAMUX on the others; the selection is kept.
+ *
+ * Example, at 3 Mbaud on an STM32F4:
+ * @code
+ * static struct usart_stream stream;
+ * static uint8_t rx_buf[1024], tx_buf[512];
+ *
+ * dma_channel_select(DMA2, DMA_STREAM2, DMA_SxCR_CHSEL_4);
+ * dma_channel_select(DMA2, DMA_STREAM7, DMA_SxCR_CHSEL_4);
+ * usart_stream_init(&stream, USART1, DMA2);
+ * usart_stream_rx_start(&stream, DMA_STREAM2, rx_buf, sizeof(rx_buf),
+ *			 frame_received);
+ * usart_stream_tx_start(&stream, DMA_STREAM7, tx_buf, sizeof(tx_buf));
+ * usart_enable(USART1);
+ * @endcode
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+/* THIS FILE SHOULD NOT BE INCLUDED DIRECTLY, BUT ONLY VIA USART.H */
+
+/** @cond */
+#if defined(LIBOPENCM3_USART_H)
+/** @endcond */
+#ifndef LIBOPENCM3_USART_COMMON_STREAM_H
+#define LIBOPENCM3_USART_COMMON_STREAM_H
+
+#include <libopencm3/cm3/ringbuf.h>
+
+struct usart_stream;
+
+/** Reception callback, called from usart_stream_irq_handler()
+ * @param stream the stream
+ * @param len bytes received since the previous call
+ * @param idle true if the line went idle, which ends a frame
+ */
+typedef void (*usart_stream_rx_callback)(struct usart_stream *stream,
+					 uint32_t len, bool idle);
+
+/** State of a DMA driven USART stream, allocated by the caller. */
+struct usart_stream {
+	/** Received bytes, for reading in place with ringbuf_read_span() */
+	struct ringbuf rx;
+	/** Times the receive DMA overwrote data not read yet */
+	volatile uint32_t rx_overruns;
+	/** @cond private */
+	struct ringbuf tx;
+	uint32_t usart;
+	uint32_t dma;
+	uint8_t rx_channel;
+	uint8_t tx_channel;
+	uint32_t tx_len;
+	usart_stream_rx_callback rx_callback;
+	uint32_t rx_passed;
+	volatile bool rx_hold;
+	/** @endcond */
+};
+
+BEGIN_DECLS
+
+void usart_stream_init(struct usart_stream *stream, uint32_t usart,
+		       uint32_t dma);
+void usart_stream_rx_start(struct usart_stream *stream, uint8_t channel,
+			   uint8_t *buf, uint32_t size,
+			   usart_stream_rx_callback callback);
+void usart_stream_tx_start(struct usart_stream *stream, uint8_t channel,
+			   uint8_t *buf, uint32_t size);
+void usart_stream_stop(struct usart_stream *stream);
+uint32_t usart_stream_read(struct usart_stream *stream, void *data,
+			   uint32_t len);
+uint32_t usart_stream_write(struct usart_stream *stream, const void *data,
+			    uint32_t len);
+bool usart_stream_tx_busy(struct usart_stream *stream);
+void usart_stream_irq_handler(struct usart_stream *stream);
+
+END_DECLS
+
+#endif
+/** @cond */
+#else
+#warning "usart_common_stream.h should not be included directly, only via usart.h"
+#endif
+/** @endcond */
+/**@}*/
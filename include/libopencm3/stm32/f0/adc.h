@@ -35,6 +35,7 @@
 
 #include <libopencm3/stm32/common/adc_common_v2.h>
 #include <libopencm3/stm32/common/adc_common_v2_single.h>
+#include <libopencm3/stm32/common/adc_common_capture.h>
 
 /*****************************************************************************/
 /* Module definitions                                                        */
@@ -33,6 +33,7 @@
 
 #include <libopencm3/stm32/common/usart_common_all.h>
 #include <libopencm3/stm32/common/usart_common_v2.h>
+#include <libopencm3/stm32/common/usart_common_stream.h>
 
 /**@{*/
 
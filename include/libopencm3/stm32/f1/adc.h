@@ -39,6 +39,7 @@ LGPL License Terms @ref lgpl_license
 #define LIBOPENCM3_ADC_H
 
 #include <libopencm3/stm32/common/adc_common_v1.h>
+#include <libopencm3/stm32/common/adc_common_capture.h>
 
 /* --- Convenience macros -------------------------------------------------- */
 
@@ -32,6 +32,7 @@ LGPL License Terms @ref lgpl_license
 #define LIBOPENCM3_I2C_H
 
 #include <libopencm3/stm32/common/i2c_common_v1.h>
+#include <libopencm3/stm32/common/i2c_common_queue.h>
 
 #endif
 
@@ -34,6 +34,7 @@
 #include <libopencm3/stm32/common/flash_common_all.h>
 #include <libopencm3/stm32/common/flash_common_f.h>
 #include <libopencm3/stm32/common/flash_common_f24.h>
+#include <libopencm3/stm32/common/flash_kv_common_f24.h>
 
 #define FLASH_SR_PGSERR			(1 << 7)
 #define FLASH_OPTCR_WDG_SW		(1 << 5)
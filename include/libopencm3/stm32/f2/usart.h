@@ -32,6 +32,7 @@ LGPL License Terms @ref lgpl_license
 #define LIBOPENCM3_USART_H
 
 #include <libopencm3/stm32/common/usart_common_f24.h>
+#include <libopencm3/stm32/common/usart_common_stream.h>
 
 #endif
 
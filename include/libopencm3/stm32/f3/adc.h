@@ -36,6 +36,7 @@
 
 #include <libopencm3/stm32/common/adc_common_v2.h>
 #include <libopencm3/stm32/common/adc_common_v2_multi.h>
+#include <libopencm3/stm32/common/adc_common_capture.h>
 
 /**@{*/
 
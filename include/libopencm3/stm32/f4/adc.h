@@ -40,6 +40,7 @@ LGPL License Terms @ref lgpl_license
 #define LIBOPENCM3_ADC_H
 
 #include <libopencm3/stm32/common/adc_common_v1_multi.h>
+#include <libopencm3/stm32/common/adc_common_capture.h>
 
 /* ADC injected channel data offset register x (ADC_JOFRx) (x=1..4) */
 #define ADC_JOFR1(block)		MMIO32((block) + 0x14)
@@ -192,6 +193,9 @@ LGPL License Terms @ref lgpl_license
 BEGIN_DECLS
 
 void adc_set_multi_mode(uint32_t mode);
+void adc_capture_start_multi(struct adc_capture *capture, uint32_t mode,
+			     uint16_t *buf, uint32_t block_len,
+			     adc_capture_callback callback);
 void adc_enable_vbat_sensor(void);
 void adc_disable_vbat_sensor(void);
 
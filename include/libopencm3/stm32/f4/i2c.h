@@ -33,6 +33,7 @@ LGPL License Terms @ref lgpl_license
 
 #include <libopencm3/stm32/memorymap.h>
 #include <libopencm3/stm32/common/i2c_common_v1.h>
+#include <libopencm3/stm32/common/i2c_common_queue.h>
 
 /**
 @addtogroup i2c_defines
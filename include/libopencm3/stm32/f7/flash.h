@@ -46,6 +46,7 @@
 #include <libopencm3/stm32/common/flash_common_all.h>
 #include <libopencm3/stm32/common/flash_common_f.h>
 #include <libopencm3/stm32/common/flash_common_f24.h>
+#include <libopencm3/stm32/common/flash_kv_common_f24.h>
 
 /**@{*/
 
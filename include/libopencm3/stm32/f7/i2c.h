@@ -31,6 +31,7 @@
 #define LIBOPENCM3_I2C_H
 
 #include <libopencm3/stm32/common/i2c_common_v2.h>
+#include <libopencm3/stm32/common/i2c_common_queue.h>
 
 #endif
 
@@ -25,6 +25,7 @@
 #define LIBOPENCM3_STM32_F7_LTDC_H_
 
 #include <libopencm3/stm32/common/ltdc_common_f47.h>
+#include <libopencm3/stm32/common/ltdc_fb_common_f47.h>
 
 #endif /* LIBOPENCM3_STM32_F7_LTDC_H_ */
 
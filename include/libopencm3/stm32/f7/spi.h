@@ -32,6 +32,7 @@ LGPL License Terms @ref lgpl_license
 #define LIBOPENCM3_SPI_H
 
 #include <libopencm3/stm32/common/spi_common_v2.h>
+#include <libopencm3/stm32/common/spi_common_queue.h>
 
 #endif
 
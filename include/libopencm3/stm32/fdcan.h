@@ -265,64 +265,6 @@
 #define FDCAN_TDCR_TDCO_SHIFT			8
 #define FDCAN_TDCR_TDCO_MASK			0x7F
 
-/** @defgroup fdcan_ir FDCAN interrupt register flags
- * @{
- */
-#define FDCAN_IR_RF0N					(1 << 0)
-#define FDCAN_IR_RF0F					(1 << 1)
-#define FDCAN_IR_RF0L					(1 << 2)
-#define FDCAN_IR_RF1N					(1 << 3)
-#define FDCAN_IR_RF1F					(1 << 4)
-#define FDCAN_IR_RF1L					(1 << 5)
-#define FDCAN_IR_HPM					(1 << 6)
-#define FDCAN_IR_TC						(1 << 7)
-#define FDCAN_IR_TCF					(1 << 8)
-#define FDCAN_IR_TFE					(1 << 9)
-#define FDCAN_IR_TEFN					(1 << 10)
-#define FDCAN_IR_TEFF					(1 << 11)
-#define FDCAN_IR_TEFL					(1 << 12)
-#define FDCAN_IR_TSW					(1 << 13)
-#define FDCAN_IR_MRAF					(1 << 14)
-#define FDCAN_IR_TOO					(1 << 15)
-#define FDCAN_IR_ELO					(1 << 16)
-#define FDCAN_IR_EP						(1 << 17)
-#define FDCAN_IR_EW						(1 << 18)
-#define FDCAN_IR_BO						(1 << 19)
-#define FDCAN_IR_WDI					(1 << 20)
-#define FDCAN_IR_PEA					(1 << 21)
-#define FDCAN_IR_PED					(1 << 22)
-#define FDCAN_IR_ARA					(1 << 23)
-/**@}*/
-
-/** @defgroup fdcan_ie FDCAN interrupt enable flags
- * @{
- */
-#define FDCAN_IE_RF0NE					(1 << 0)
-#define FDCAN_IE_RF0FE					(1 << 1)
-#define FDCAN_IE_RF0LE					(1 << 2)
-#define FDCAN_IE_RF1NE					(1 << 3)
-#define FDCAN_IE_RF1FE					(1 << 4)
-#define FDCAN_IE_RF1LE					(1 << 5)
-#define FDCAN_IE_HPME					(1 << 6)
-#define FDCAN_IE_TCE					(1 << 7)
-#define FDCAN_IE_TCFE					(1 << 8)
-#define FDCAN_IE_TFEE					(1 << 9)
-#define FDCAN_IE_TEFNE					(1 << 10)
-#define FDCAN_IE_TEFFE					(1 << 11)
-#define FDCAN_IE_TEFLE					(1 << 12)
-#define FDCAN_IE_TSWE					(1 << 13)
-#define FDCAN_IE_MRAFE					(1 << 14)
-#define FDCAN_IE_TOOE					(1 << 15)
-#define FDCAN_IE_ELOE					(1 << 16)
-#define FDCAN_IE_EPE					(1 << 17)
-#define FDCAN_IE_EWE					(1 << 18)
-#define FDCAN_IE_BOE					(1 << 19)
-#define FDCAN_IE_WDIE					(1 << 20)
-#define FDCAN_IE_PEAE					(1 << 21)
-#define FDCAN_IE_PEDE					(1 << 22)
-#define FDCAN_IE_ARAE					(1 << 23)
-/**@}*/
-
 /** @defgroup fdcan_ils FDCAN_ILS interrupt line select flags
  * @{
  */
@@ -653,6 +595,22 @@ struct fdcan_extended_filter {
 #define FDCAN_EFID2_SHIFT				0
 #define FDCAN_EFID2_MASK				0x1FFFFFFF
 
+/** @defgroup fdcan_anf Non-matching frame action
+ *
+ * What is done with frames no filter matched, see
+ * @ref fdcan_set_global_filter.
+ * @{
+ */
+/** Accept into FIFO 0 */
+#define FDCAN_ANF_FIFO0					0x0
+
+/** Accept into FIFO 1 */
+#define FDCAN_ANF_FIFO1					0x1
+
+/** Reject */
+#define FDCAN_ANF_REJECT				0x2
+/**@}*/
+
 /** Structure describing receive FIFO element.
  * Receive FIFO element consists of 2 32bit values for header
  * and 16 32bit values for message payload.
@@ -768,6 +726,9 @@ void fdcan_set_test(uint32_t canport, bool testing, bool loopback);
 
 void fdcan_init_filter(uint32_t canport, uint8_t std_filt, uint8_t ext_filt);
 
+void fdcan_set_global_filter(uint32_t canport, uint8_t std_nonmatching,
+		uint8_t ext_nonmatching, bool reject_std_remote, bool reject_ext_remote);
+
 int fdcan_start(uint32_t canport, uint32_t timeout);
 
 int fdcan_get_init_state(uint32_t canport);
@@ -791,6 +752,11 @@ int fdcan_receive(uint32_t canport, uint8_t fifo, bool release, uint32_t *id,
 		uint8_t *data, uint16_t *timestamp);
 
 void fdcan_release_fifo(uint32_t canport, uint8_t fifo);
+const struct fdcan_rx_fifo_element *fdcan_rx_peek(uint32_t canport,
+		uint8_t fifo_id);
+uint32_t fdcan_rx_element_id(const struct fdcan_rx_fifo_element *element,
+		bool *ext);
+uint8_t fdcan_rx_element_length(const struct fdcan_rx_fifo_element *element);
 
 bool fdcan_available_tx(uint32_t canport);
 bool fdcan_available_rx(uint32_t canport, uint8_t fifo);
@@ -812,3 +778,6 @@ uint8_t fdcan_dlc_to_length(uint32_t dlc);
 
 END_DECLS
 
+#include <libopencm3/stm32/common/fdcan_common_queue.h>
+#include <libopencm3/stm32/common/fdcan_common_filter.h>
+
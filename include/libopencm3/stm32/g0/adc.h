@@ -34,6 +34,7 @@
 
 #include <libopencm3/stm32/common/adc_common_v2.h>
 #include <libopencm3/stm32/common/adc_common_v2_single.h>
+#include <libopencm3/stm32/common/adc_common_capture.h>
 
 /** @defgroup adc_reg_base ADC register base addresses
  *@{*/
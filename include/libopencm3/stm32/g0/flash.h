@@ -164,6 +164,9 @@
 
 /**@}*/
 
+/** Bytes of a fast programming row, see flash_program_row() */
+#define FLASH_ROW_SIZE			256
+
 /** @defgroup flash_eccr ECCR Flash ECC register
 @{*/
 /** FLASH_ECCR_ECCD ECC detection **/
@@ -271,7 +274,8 @@ void flash_clear_status_flags(void);
 void flash_wait_for_last_operation(void);
 
 void flash_program_double_word(uint32_t address, uint64_t data);
-void flash_program(uint32_t address, uint8_t *data, uint32_t len);
+void flash_program(uint32_t address, const uint8_t *data, uint32_t len);
+uint32_t flash_program_row(uint32_t address, const uint32_t *data);
 
 void flash_erase_page(uint32_t page);
 void flash_erase_all_pages(void);
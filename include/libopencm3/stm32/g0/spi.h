@@ -30,5 +30,6 @@
 
 #include <libopencm3/stm32/common/spi_common_all.h>
 #include <libopencm3/stm32/common/spi_common_v2.h>
+#include <libopencm3/stm32/common/spi_common_queue.h>
 
 #endif
@@ -115,6 +115,9 @@
 #define FLASH_CR_PNB_SHIFT		3
 #define FLASH_CR_PNB_MASK		0x7f
 
+/* Bytes of a fast programming row, see flash_program_row() */
+#define FLASH_ROW_SIZE			256
+
 /* --- FLASH_ECCR values -------------------------------------------------- */
 
 #define FLASH_ECCR_ECCD			(1 << 31)
@@ -254,7 +257,8 @@ void flash_clear_pgaerr_flag(void);
 void flash_clear_wrperr_flag(void);
 void flash_lock_option_bytes(void);
 void flash_program_double_word(uint32_t address, uint64_t data);
-void flash_program(uint32_t address, uint8_t *data, uint32_t len);
+void flash_program(uint32_t address, const uint8_t *data, uint32_t len);
+uint32_t flash_program_row(uint32_t address, const uint32_t *data);
 void flash_erase_page(uint32_t page);
 void flash_erase_all_pages(void);
 void flash_program_option_bytes(uint32_t data);
@@ -224,6 +224,76 @@ LGPL License Terms @ref lgpl_license
 #define FDCAN_CCU_CCFG_CDIV_SHIFT		16
 #define FDCAN_CCU_CCFG_CDIV_MASK		0xF
 
+/** @defgroup fdcan_ir FDCAN interrupt register flags
+ * @{
+ */
+#define FDCAN_IR_RF0N					(1 << 0)
+#define FDCAN_IR_RF0W					(1 << 1)
+#define FDCAN_IR_RF0F					(1 << 2)
+#define FDCAN_IR_RF0L					(1 << 3)
+#define FDCAN_IR_RF1N					(1 << 4)
+#define FDCAN_IR_RF1W					(1 << 5)
+#define FDCAN_IR_RF1F					(1 << 6)
+#define FDCAN_IR_RF1L					(1 << 7)
+#define FDCAN_IR_HPM					(1 << 8)
+#define FDCAN_IR_TC						(1 << 9)
+#define FDCAN_IR_TCF					(1 << 10)
+#define FDCAN_IR_TFE					(1 << 11)
+#define FDCAN_IR_TEFN					(1 << 12)
+#define FDCAN_IR_TEFW					(1 << 13)
+#define FDCAN_IR_TEFF					(1 << 14)
+#define FDCAN_IR_TEFL					(1 << 15)
+#define FDCAN_IR_TSW					(1 << 16)
+#define FDCAN_IR_MRAF					(1 << 17)
+#define FDCAN_IR_TOO					(1 << 18)
+#define FDCAN_IR_DRX					(1 << 19)
+#define FDCAN_IR_BEC					(1 << 20)
+#define FDCAN_IR_BEU					(1 << 21)
+#define FDCAN_IR_ELO					(1 << 22)
+#define FDCAN_IR_EP						(1 << 23)
+#define FDCAN_IR_EW						(1 << 24)
+#define FDCAN_IR_BO						(1 << 25)
+#define FDCAN_IR_WDI					(1 << 26)
+#define FDCAN_IR_PEA					(1 << 27)
+#define FDCAN_IR_PED					(1 << 28)
+#define FDCAN_IR_ARA					(1 << 29)
+/**@}*/
+
+/** @defgroup fdcan_ie FDCAN interrupt enable flags
+ * @{
+ */
+#define FDCAN_IE_RF0NE					(1 << 0)
+#define FDCAN_IE_RF0WE					(1 << 1)
+#define FDCAN_IE_RF0FE					(1 << 2)
+#define FDCAN_IE_RF0LE					(1 << 3)
+#define FDCAN_IE_RF1NE					(1 << 4)
+#define FDCAN_IE_RF1WE					(1 << 5)
+#define FDCAN_IE_RF1FE					(1 << 6)
+#define FDCAN_IE_RF1LE					(1 << 7)
+#define FDCAN_IE_HPME					(1 << 8)
+#define FDCAN_IE_TCE					(1 << 9)
+#define FDCAN_IE_TCFE					(1 << 10)
+#define FDCAN_IE_TFEE					(1 << 11)
+#define FDCAN_IE_TEFNE					(1 << 12)
+#define FDCAN_IE_TEFWE					(1 << 13)
+#define FDCAN_IE_TEFFE					(1 << 14)
+#define FDCAN_IE_TEFLE					(1 << 15)
+#define FDCAN_IE_TSWE					(1 << 16)
+#define FDCAN_IE_MRAFE					(1 << 17)
+#define FDCAN_IE_TOOE					(1 << 18)
+#define FDCAN_IE_DRXE					(1 << 19)
+#define FDCAN_IE_BECE					(1 << 20)
+#define FDCAN_IE_BEUE					(1 << 21)
+#define FDCAN_IE_ELOE					(1 << 22)
+#define FDCAN_IE_EPE					(1 << 23)
+#define FDCAN_IE_EWE					(1 << 24)
+#define FDCAN_IE_BOE					(1 << 25)
+#define FDCAN_IE_WDIE					(1 << 26)
+#define FDCAN_IE_PEAE					(1 << 27)
+#define FDCAN_IE_PEDE					(1 << 28)
+#define FDCAN_IE_ARAE					(1 << 29)
+/**@}*/
+
 
 
 #define FDCAN_LFSSA_OFFSET(can_base)	\
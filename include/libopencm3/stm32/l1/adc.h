@@ -34,6 +34,7 @@ LGPL License Terms @ref lgpl_license
 #define LIBOPENCM3_ADC_H
 
 #include <libopencm3/stm32/common/adc_common_v1_multi.h>
+#include <libopencm3/stm32/common/adc_common_capture.h>
 
 #define ADC_MAX_REGULAR_SEQUENCE	28
 /* 26 in L/M, but 32 in two banks for M+/H density */
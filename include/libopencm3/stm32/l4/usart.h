@@ -29,6 +29,7 @@
 
 #include <libopencm3/stm32/common/usart_common_all.h>
 #include <libopencm3/stm32/common/usart_common_v2.h>
+#include <libopencm3/stm32/common/usart_common_stream.h>
 
 /** @defgroup usart_reg_base USART register base addresses
  * Holds all the U(S)ART peripherals supported.
@@ -28,7 +28,13 @@
 #define GET_REG(REG)		((uint16_t) *(REG))
 
 /* Set register content. */
+#ifdef LIBOPENCM3_HOST
+/* Seen by the peripheral models of lib/host, for toggle and clear bits */
+void host_set_reg(volatile uint32_t *reg, uint16_t val);
+#define SET_REG(REG, VAL)	host_set_reg((REG), (uint16_t)(VAL))
+#else
 #define SET_REG(REG, VAL)	(*(REG) = (uint16_t)(VAL))
+#endif
 
 /* Clear register bit. */
 #define CLR_REG_BIT(REG, BIT)	SET_REG((REG), (~(BIT)))
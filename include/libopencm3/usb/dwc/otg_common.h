@@ -81,6 +81,9 @@
 #define OTG_DOEPTSIZ0			0xB10
 #define OTG_DOEPTSIZ(x)			(0xB10 + 0x20*(x))
 #define OTG_DTXFSTS(x)			(0x918 + 0x20*(x))
+/* Only on cores with the internal DMA (OTG_HS) */
+#define OTG_DIEPDMA(x)			(0x914 + 0x20*(x))
+#define OTG_DOEPDMA(x)			(0xB14 + 0x20*(x))
 
 /* Power and clock gating control and status register */
 #define OTG_PCGCCTL			0xE00
@@ -112,6 +115,13 @@
 
 /* OTG AHB configuration register (OTG_GAHBCFG) */
 #define OTG_GAHBCFG_GINT		0x0001
+#define OTG_GAHBCFG_HBSTLEN_MASK	(0xf << 1)
+#define OTG_GAHBCFG_HBSTLEN_SINGLE	(0x0 << 1)
+#define OTG_GAHBCFG_HBSTLEN_INCR	(0x1 << 1)
+#define OTG_GAHBCFG_HBSTLEN_INCR4	(0x3 << 1)
+#define OTG_GAHBCFG_HBSTLEN_INCR8	(0x5 << 1)
+#define OTG_GAHBCFG_HBSTLEN_INCR16	(0x7 << 1)
+#define OTG_GAHBCFG_DMAEN		0x0020
 #define OTG_GAHBCFG_TXFELVL		0x0080
 #define OTG_GAHBCFG_PTXFELVL		0x0100
 
@@ -351,11 +361,20 @@
 #define OTG_DIEPSIZ0_STUPCNT_2		(0x2 << 29)
 #define OTG_DIEPSIZ0_STUPCNT_3		(0x3 << 29)
 #define OTG_DIEPSIZ0_STUPCNT_MASK	(0x3 << 29)
+#define OTG_DIEPSIZ0_STUPCNT_SHIFT	29
 /* Bits 28:20 - Reserved */
 #define OTG_DIEPSIZ0_PKTCNT		(1 << 19)
 /* Bits 18:7 - Reserved */
 #define OTG_DIEPSIZ0_XFRSIZ_MASK	(0x7f << 0)
 
+/* OTG Device IN/OUT Endpoint x Transfer Size Register (OTG_DxEPTSIZx) */
+#define OTG_DIEPSIZX_PKTCNT_SHIFT	19
+#define OTG_DIEPSIZX_PKTCNT_MASK	(0x3ff << 19)
+#define OTG_DIEPSIZX_XFRSIZ_MASK	(0x7ffff << 0)
+
+/* OTG Device IN Endpoint x Transmit FIFO Status Register (OTG_DTXFSTSx) */
+#define OTG_DTXFSTS_INEPTFSAV_MASK	(0xffff << 0)
+
 
 
 /* Host-mode CSRs */
@@ -91,6 +91,28 @@ usbd_mass_storage *usb_msc_init(usbd_device *usbd_dev,
 				 int (*read_block)(uint32_t lba, uint8_t *copy_to),
 				 int (*write_block)(uint32_t lba, const uint8_t *copy_from));
 
+/** Completion callback handed to the asynchronous block device backend.
+ *
+ * The backend calls this exactly once for every accepted read_blocks or
+ * write_blocks request, with 0 on success or nonzero on a media error.
+ */
+typedef void (*usb_msc_io_done_callback)(int status);
+
+usbd_mass_storage *usb_msc_init_async(usbd_device *usbd_dev,
+				 uint8_t ep_in, uint8_t ep_in_size,
+				 uint8_t ep_out, uint8_t ep_out_size,
+				 const char *vendor_id,
+				 const char *product_id,
+				 const char *product_revision_level,
+				 const uint32_t block_count,
+				 uint8_t *sector_buf, uint8_t sector_count,
+				 int (*read_blocks)(uint32_t lba, uint32_t count,
+						    uint8_t *copy_to,
+						    usb_msc_io_done_callback done),
+				 int (*write_blocks)(uint32_t lba, uint32_t count,
+						     const uint8_t *copy_from,
+						     usb_msc_io_done_callback done));
+
 #endif
 
 /**@}*/
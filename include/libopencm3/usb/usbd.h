@@ -58,6 +58,9 @@ extern const usbd_driver stm32f207_usb_driver;
 extern const usbd_driver st_usbfs_v2_usb_driver;
 #define otgfs_usb_driver stm32f107_usb_driver
 #define otghs_usb_driver stm32f207_usb_driver
+/* OTG_HS with its internal DMA, buffers must be reachable by the core */
+extern const usbd_driver stm32f207_usb_dma_driver;
+#define otghs_usb_dma_driver stm32f207_usb_dma_driver
 extern const usbd_driver efm32lg_usb_driver;
 extern const usbd_driver efm32hg_usb_driver;
 extern const usbd_driver lm4f_usb_driver;
@@ -181,15 +184,28 @@ extern void usbd_poll(usbd_device *usbd_dev);
  */
 extern void usbd_disconnect(usbd_device *usbd_dev, bool disconnected);
 
+/**
+ * Flag for the type argument of @ref usbd_ep_setup asking for a double
+ * buffered bulk endpoint. Drivers that cannot do this silently ignore it.
+ */
+#define USBD_EP_DOUBLE_BUFFER	0x80
+
 /** Setup an endpoint
  * @param usbd_dev the usb device handle returned from @ref usbd_init
  * @param addr Full EP address including direction (e.g. 0x01 or 0x81)
- * @param type Value for bmAttributes (USB_ENDPOINT_ATTR_*)
+ * @param type Value for bmAttributes (USB_ENDPOINT_ATTR_*), optionally
+ * or'ed with @ref USBD_EP_DOUBLE_BUFFER
  * @param max_size Endpoint max size
  * @param callback your desired callback function
  * @note The stack only supports 8 endpoints, 0..7, so don't try
  * and use arbitrary addresses here, even though USB itself would allow this.
  * Not all backends support arbitrary addressing anyway.
+ * @note On st_usbfs a double buffered endpoint uses the buffer and toggle
+ * bits of both directions, so its number can't be shared with an endpoint
+ * of the other direction.
+ * @note With a driver using DMA, such as otghs_usb_dma_driver, the packet
+ * buffers of all endpoints share 2K of memory. An endpoint whose buffer does
+ * not fit is left disabled.
  */
 extern void usbd_ep_setup(usbd_device *usbd_dev, uint8_t addr, uint8_t type,
 		uint16_t max_size, usbd_endpoint_callback callback);
@@ -213,6 +229,57 @@ extern uint16_t usbd_ep_write_packet(usbd_device *usbd_dev, uint8_t addr,
  */
 extern uint16_t usbd_ep_read_packet(usbd_device *usbd_dev, uint8_t addr,
 			       void *buf, uint16_t len);
+/** Flag for @ref usbd_ep_transfer: don't end an IN transfer whose length is
+ * a multiple of the packet size with a zero length packet */
+#define USBD_TRANSFER_NO_ZLP	(1 << 0)
+
+typedef void (*usbd_transfer_callback)(usbd_device *usbd_dev, uint8_t ep,
+				       uint32_t len);
+
+/** State of a transfer queued with @ref usbd_ep_transfer.
+ * Owned by the stack from usbd_ep_transfer() until the callback runs. */
+struct usbd_transfer {
+	/** @cond private */
+	uint8_t *buf;
+	uint32_t len;
+	uint32_t done;
+	uint32_t queued;
+	usbd_transfer_callback callback;
+	usbd_endpoint_callback saved;
+	bool zlp;
+	bool last;
+	/** @endcond */
+};
+
+/** Queue a transfer of any length on an endpoint
+ *
+ * The buffer is sent or filled packet by packet without further involvement
+ * of the caller, which gets a single callback at the end. IN transfers whose
+ * length is a multiple of the packet size are ended by a zero length packet
+ * unless @ref USBD_TRANSFER_NO_ZLP is given, and a zero length transfer sends
+ * just that. OUT transfers end when the buffer is full or on a short packet,
+ * so @a len should be a multiple of the packet size. An OUT endpoint is left
+ * enabled but NAKing when its transfer completes, until the next transfer or
+ * @ref usbd_ep_nak_set lets the host in again. While a transfer is queued
+ * the endpoint callback given to @ref usbd_ep_setup is not called.
+ * With a driver using DMA, such as otghs_usb_dma_driver, the data moves
+ * straight between @a buf and the core, so @a buf must be 32-bit aligned and
+ * OUT transfers a non-zero multiple of the packet size.
+ * @param usbd_dev the usb device handle returned from @ref usbd_init
+ * @param xfer transfer state, must stay valid until the callback
+ * @param addr Full EP address (with direction bit), not 0
+ * @param buf data to send or buffer to receive into
+ * @param len # of bytes
+ * @param flags 0 or @ref USBD_TRANSFER_NO_ZLP
+ * @param callback called with the # of bytes transferred when done
+ * @return 0 if queued, -1 if the endpoint is busy or not set up, or the
+ * buffer is unsuitable for DMA
+ */
+extern int usbd_ep_transfer(usbd_device *usbd_dev,
+			    struct usbd_transfer *xfer, uint8_t addr,
+			    void *buf, uint32_t len, uint8_t flags,
+			    usbd_transfer_callback callback);
+
 /** Set/clear STALL condition on an endpoint
  * @param usbd_dev the usb device handle returned from @ref usbd_init
  * @param addr Full EP address (with direction bit)
@@ -0,0 +1,40 @@
+/* This file is part of the libopencm3 project.
+ *
+ * It was generated by the irq2nvic_h script.
+ *
+ * These definitions bend every interrupt handler that is defined CMSIS style
+ * to the weak symbol exported by libopencm3.
+ */
+
+#define WWDG_IRQHandler wwdg_isr
+#define PVD_IRQHandler pvd_isr
+#define RTC_IRQHandler rtc_isr
+#define FLASH_IRQHandler flash_isr
+#define RCC_IRQHandler rcc_isr
+#define EXTI0_1_IRQHandler exti0_1_isr
+#define EXTI2_3_IRQHandler exti2_3_isr
+#define EXTI4_15_IRQHandler exti4_15_isr
+#define TSC_IRQHandler tsc_isr
+#define DMA1_CHANNEL1_IRQHandler dma1_channel1_isr
+#define DMA1_CHANNEL2_3_DMA2_CHANNEL1_2_IRQHandler dma1_channel2_3_dma2_channel1_2_isr
+#define DMA1_CHANNEL4_7_DMA2_CHANNEL3_5_IRQHandler dma1_channel4_7_dma2_channel3_5_isr
+#define ADC_COMP_IRQHandler adc_comp_isr
+#define TIM1_BRK_UP_TRG_COM_IRQHandler tim1_brk_up_trg_com_isr
+#define TIM1_CC_IRQHandler tim1_cc_isr
+#define TIM2_IRQHandler tim2_isr
+#define TIM3_IRQHandler tim3_isr
+#define TIM6_DAC_IRQHandler tim6_dac_isr
+#define TIM7_IRQHandler tim7_isr
+#define TIM14_IRQHandler tim14_isr
+#define TIM15_IRQHandler tim15_isr
+#define TIM16_IRQHandler tim16_isr
+#define TIM17_IRQHandler tim17_isr
+#define I2C1_IRQHandler i2c1_isr
+#define I2C2_IRQHandler i2c2_isr
+#define SPI1_IRQHandler spi1_isr
+#define SPI2_IRQHandler spi2_isr
+#define USART1_IRQHandler usart1_isr
+#define USART2_IRQHandler usart2_isr
+#define USART3_4_IRQHandler usart3_4_isr
+#define CEC_CAN_IRQHandler cec_can_isr
+#define USB_IRQHandler usb_isr
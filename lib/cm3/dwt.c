@@ -102,4 +102,61 @@ uint32_t dwt_read_cycle_counter(void)
 #endif /* defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) */
 }
 
-/**@}*/
\ No newline at end of file
+
+/*---------------------------------------------------------------------------*/
+/** @brief DebugTrace Enable the profiling counters
+ *
+ * Enables the cycle counter together with the CPI, exception overhead, sleep,
+ * load store unit and folded instruction counters, and clears them all.
+ *
+ * @return true, if success
+ */
+bool dwt_enable_profiling_counters(void)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+	if (!dwt_enable_cycle_counter() || (DWT_CTRL & DWT_CTRL_NOPRFCCNT)) {
+		return false;
+	}
+
+	DWT_CPICNT = 0;
+	DWT_EXCCNT = 0;
+	DWT_SLEEPCNT = 0;
+	DWT_LSUCNT = 0;
+	DWT_FOLDCNT = 0;
+	DWT_CTRL |= DWT_CTRL_CPIEVTENA | DWT_CTRL_EXCEVTENA |
+		    DWT_CTRL_SLEEPEVTENA | DWT_CTRL_LSUEVTENA |
+		    DWT_CTRL_FOLDEVTENA;
+	return true;
+#else
+	return false;			/* Not supported on ARMv6M */
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DebugTrace Read the profiling counters
+ *
+ * @note The counters must be enabled by @ref dwt_enable_profiling_counters,
+ * the ones not enabled or not supported read as 0.
+ *
+ * @param[out] counters snapshot of the counters
+ */
+void dwt_read_counters(struct dwt_counters *counters)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+	counters->cycles = DWT_CYCCNT;
+	counters->cpi = DWT_CPICNT;
+	counters->exc = DWT_EXCCNT;
+	counters->sleep = DWT_SLEEPCNT;
+	counters->lsu = DWT_LSUCNT;
+	counters->fold = DWT_FOLDCNT;
+#else
+	counters->cycles = 0;
+	counters->cpi = 0;
+	counters->exc = 0;
+	counters->sleep = 0;
+	counters->lsu = 0;
+	counters->fold = 0;
+#endif
+}
+
+/**@}*/
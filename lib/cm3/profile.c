@@ -0,0 +1,257 @@
+/** @defgroup CM3_profile_file Cycle profiling
+ *
+ * @ingroup CM3_files
+ *
+ * @brief <b>libopencm3 Cortex-M cycle profiling</b>
+ *
+ * Timing of code regions with the DWT counters, see @ref cm_profile.
+ *
+ * LGPL License Terms @ref lgpl_license
+ * @{
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <libopencm3/cm3/profile.h>
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#include <libopencm3/cm3/itm.h>
+#endif
+
+/* Cycles of an empty region, taken off every run */
+static uint32_t profile_overhead;
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile Initialise
+ *
+ * Enables the DWT counters and measures the cost of timing an empty region.
+ *
+ * @return true if the cycle counter runs, false if profiling is not
+ * available
+ */
+bool profile_init(void)
+{
+	struct profile_region region = PROFILE_REGION(0, NULL);
+	struct profile_scope scope;
+	int i;
+
+	if (!dwt_enable_profiling_counters() && !dwt_enable_cycle_counter()) {
+		return false;
+	}
+
+	profile_overhead = 0;
+	for (i = 0; i < 8; i++) {
+		profile_begin(&scope, &region);
+		profile_end(&scope);
+	}
+	profile_overhead = region.min;
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile Reset a Region
+ *
+ * Clears the statistics of a region, keeping its name and id.
+ *
+ * @param[in] region Region to reset
+ */
+void profile_reset(struct profile_region *region)
+{
+	region->count = 0;
+	region->min = UINT32_MAX;
+	region->max = 0;
+	region->total = 0;
+	region->cpi = 0;
+	region->exc = 0;
+	region->sleep = 0;
+	region->lsu = 0;
+	region->fold = 0;
+	memset(region->histogram, 0, sizeof(region->histogram));
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile Begin a Run of a Region
+ *
+ * @param[out] scope State of the run, passed to profile_end()
+ * @param[in] region Region being timed
+ */
+void profile_begin(struct profile_scope *scope, struct profile_region *region)
+{
+	scope->region = region;
+	dwt_read_counters(&scope->start);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile End a Run of a Region
+ *
+ * Adds the run to the statistics of its region.
+ *
+ * @param[in] scope State of the run from profile_begin()
+ */
+void profile_end(struct profile_scope *scope)
+{
+	struct profile_region *region = scope->region;
+	struct dwt_counters now;
+	uint32_t cycles;
+	int bucket;
+
+	dwt_read_counters(&now);
+	cycles = now.cycles - scope->start.cycles;
+	cycles = cycles > profile_overhead ? cycles - profile_overhead : 0;
+
+	region->count++;
+	region->total += cycles;
+	if (cycles < region->min) {
+		region->min = cycles;
+	}
+	if (cycles > region->max) {
+		region->max = cycles;
+	}
+	bucket = 31 - __builtin_clz(cycles | 1);
+	region->histogram[bucket]++;
+
+	region->cpi += (uint8_t)(now.cpi - scope->start.cpi);
+	region->exc += (uint8_t)(now.exc - scope->start.exc);
+	region->sleep += (uint8_t)(now.sleep - scope->start.sleep);
+	region->lsu += (uint8_t)(now.lsu - scope->start.lsu);
+	region->fold += (uint8_t)(now.fold - scope->start.fold);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile Mean Cycles of a Region
+ *
+ * @param[in] region Region
+ * @returns mean cycles of a run, 0 without runs
+ */
+uint32_t profile_mean(const struct profile_region *region)
+{
+	if (!region->count) {
+		return 0;
+	}
+	return region->total / region->count;
+}
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+
+static bool profile_port_enabled(uint8_t port)
+{
+	return (ITM_TCR & ITM_TCR_ITMENA) && (ITM_TER[0] & (1 << port));
+}
+
+static void profile_send(uint8_t port, uint32_t word)
+{
+	while (!(ITM_STIM32(port) & ITM_STIM_FIFOREADY));
+	ITM_STIM32(port) = word;
+}
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile Announce a Region
+ *
+ * Sends the name of a region as a @ref PROFILE_PACKET_NAME packet, so the
+ * decoder can label its statistics. Nothing is sent when the stimulus port
+ * is not enabled.
+ *
+ * @param[in] region Region
+ * @param[in] port ITM stimulus port, 0 to 31
+ */
+void profile_announce(const struct profile_region *region, uint8_t port)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+	size_t len, i;
+	uint32_t word = 0;
+
+	if (!profile_port_enabled(port)) {
+		return;
+	}
+
+	len = region->name ? strlen(region->name) : 0;
+	if (len > 0xffff) {
+		len = 0xffff;
+	}
+	profile_send(port, (PROFILE_PACKET_NAME << 24) | (region->id << 16) |
+		     len);
+	for (i = 0; i < len; i++) {
+		word |= (uint32_t)(uint8_t)region->name[i] << ((i % 4) * 8);
+		if (i % 4 == 3) {
+			profile_send(port, word);
+			word = 0;
+		}
+	}
+	if (len % 4) {
+		profile_send(port, word);
+	}
+#else
+	(void)region;
+	(void)port;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Profile Report a Region
+ *
+ * Sends the statistics of a region as a @ref PROFILE_PACKET_STATS packet,
+ * with the histogram buckets from the first to the last one used. Nothing is
+ * sent when the stimulus port is not enabled.
+ *
+ * @param[in] region Region
+ * @param[in] port ITM stimulus port, 0 to 31
+ */
+void profile_report(const struct profile_region *region, uint8_t port)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+	int first = 0, last = PROFILE_BUCKETS - 1, i;
+
+	if (!profile_port_enabled(port)) {
+		return;
+	}
+
+	while (first < PROFILE_BUCKETS && !region->histogram[first]) {
+		first++;
+	}
+	while (last >= first && !region->histogram[last]) {
+		last--;
+	}
+	if (first > last) {
+		/* No runs: an empty range */
+		first = 1;
+		last = 0;
+	}
+
+	profile_send(port, (PROFILE_PACKET_STATS << 24) | (region->id << 16) |
+		     (first << 8) | last);
+	profile_send(port, region->count);
+	profile_send(port, region->min);
+	profile_send(port, region->max);
+	profile_send(port, region->total);
+	profile_send(port, region->total >> 32);
+	profile_send(port, region->cpi);
+	profile_send(port, region->exc);
+	profile_send(port, region->sleep);
+	profile_send(port, region->lsu);
+	profile_send(port, region->fold);
+	for (i = first; i <= last; i++) {
+		profile_send(port, region->histogram[i]);
+	}
+#else
+	(void)region;
+	(void)port;
+#endif
+}
+
+/**@}*/
@@ -0,0 +1,200 @@
+/** @defgroup CM3_ringbuf_file Ring buffer
+ *
+ * @ingroup CM3_files
+ *
+ * @brief <b>libopencm3 lock-free single producer, single consumer ring</b>
+ *
+ * The producer side (ringbuf_write(), ringbuf_write_span() and
+ * ringbuf_commit()) and the consumer side (ringbuf_read(),
+ * ringbuf_read_span() and ringbuf_consume()) may each be used from one
+ * context. The data is made visible with a memory barrier before the index
+ * that publishes it, so the other side may also be a bus master like a DMA.
+ *
+ * LGPL License Terms @ref lgpl_license
+ * @{
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <libopencm3/cm3/sync.h>
+#include <libopencm3/cm3/ringbuf.h>
+
+/*---------------------------------------------------------------------------*/
+/** @brief Initialise an empty ring buffer
+
+@param[in] rb Ring buffer state
+@param[in] buf Storage for the data
+@param[in] size Size of @a buf in bytes, must be a power of two
+*/
+
+void ringbuf_init(struct ringbuf *rb, uint8_t *buf, uint32_t size)
+{
+	rb->buf = buf;
+	rb->mask = size - 1;
+	rb->head = 0;
+	rb->tail = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Number of bytes waiting to be read
+
+@param[in] rb Ring buffer state
+@returns Bytes in the ring
+*/
+
+uint32_t ringbuf_used(const struct ringbuf *rb)
+{
+	return rb->head - rb->tail;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Number of bytes that can be written
+
+@param[in] rb Ring buffer state
+@returns Free bytes in the ring
+*/
+
+uint32_t ringbuf_free(const struct ringbuf *rb)
+{
+	return rb->mask + 1 - (rb->head - rb->tail);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Contiguous free space at the head, for the producer
+
+@param[in] rb Ring buffer state
+@param[out] data Start of the free space
+@returns Bytes that can be stored at @a data before ringbuf_commit()
+*/
+
+uint32_t ringbuf_write_span(struct ringbuf *rb, uint8_t **data)
+{
+	uint32_t head = rb->head & rb->mask;
+	uint32_t len = ringbuf_free(rb);
+
+	if (len > rb->mask + 1 - head) {
+		len = rb->mask + 1 - head;
+	}
+	*data = rb->buf + head;
+	return len;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Publish bytes stored at the head
+
+@param[in] rb Ring buffer state
+@param[in] len Bytes stored, at most what ringbuf_write_span() returned
+*/
+
+void ringbuf_commit(struct ringbuf *rb, uint32_t len)
+{
+	__dmb();
+	rb->head += len;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Contiguous data at the tail, for the consumer
+
+@param[in] rb Ring buffer state
+@param[out] data Start of the data
+@returns Bytes that can be taken from @a data before ringbuf_consume()
+*/
+
+uint32_t ringbuf_read_span(struct ringbuf *rb, uint8_t **data)
+{
+	uint32_t tail = rb->tail & rb->mask;
+	uint32_t len = ringbuf_used(rb);
+
+	/* No data access may be done ahead of reading the head. */
+	__dmb();
+	if (len > rb->mask + 1 - tail) {
+		len = rb->mask + 1 - tail;
+	}
+	*data = rb->buf + tail;
+	return len;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Release bytes taken from the tail
+
+@param[in] rb Ring buffer state
+@param[in] len Bytes taken, at most what ringbuf_read_span() returned
+*/
+
+void ringbuf_consume(struct ringbuf *rb, uint32_t len)
+{
+	__dmb();
+	rb->tail += len;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Copy data into the ring
+
+@param[in] rb Ring buffer state
+@param[in] data Data to store
+@param[in] len Number of bytes
+@returns Bytes stored, less than @a len if the ring is full
+*/
+
+uint32_t ringbuf_write(struct ringbuf *rb, const void *data, uint32_t len)
+{
+	const uint8_t *src = data;
+	uint32_t done = 0;
+	uint32_t span;
+	uint8_t *dst;
+
+	/* At most two pieces, up to the end of the buffer and from its start */
+	while (done < len && (span = ringbuf_write_span(rb, &dst)) != 0) {
+		if (span > len - done) {
+			span = len - done;
+		}
+		memcpy(dst, src + done, span);
+		ringbuf_commit(rb, span);
+		done += span;
+	}
+	return done;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Copy data out of the ring
+
+@param[in] rb Ring buffer state
+@param[out] data Destination
+@param[in] len Maximum number of bytes
+@returns Bytes copied, less than @a len if the ring ran empty
+*/
+
+uint32_t ringbuf_read(struct ringbuf *rb, void *data, uint32_t len)
+{
+	uint8_t *dst = data;
+	uint32_t done = 0;
+	uint32_t span;
+	uint8_t *src;
+
+	while (done < len && (span = ringbuf_read_span(rb, &src)) != 0) {
+		if (span > len - done) {
+			span = len - done;
+		}
+		memcpy(dst + done, src, span);
+		ringbuf_consume(rb, span);
+		done += span;
+	}
+	return done;
+}
+
+/**@}*/
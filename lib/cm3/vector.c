@@ -32,6 +32,16 @@ extern funcp_t __preinit_array_start, __preinit_array_end;
 extern funcp_t __init_array_start, __init_array_end;
 extern funcp_t __fini_array_start, __fini_array_end;
 
+/* Only in the generated linker script, empty with the others */
+extern const struct vector_copy_entry __copy_table_start[]
+	__attribute__((weak));
+extern const struct vector_copy_entry __copy_table_end[]
+	__attribute__((weak));
+extern const struct vector_zero_entry __zero_table_start[]
+	__attribute__((weak));
+extern const struct vector_zero_entry __zero_table_end[]
+	__attribute__((weak));
+
 int main(void);
 void blocking_handler(void);
 void null_handler(void);
@@ -59,20 +69,88 @@ vector_table_t vector_table = {
 	}
 };
 
+/* Four words at a time with LDM/STM, then word by word. Only r0-r7 on
+ * ARMv6-M, so the block registers and the operands all fit in there. */
+static inline void __attribute__((always_inline))
+reset_copy(const volatile unsigned *src, volatile unsigned *dest,
+	   volatile unsigned *end)
+{
+	unsigned blocks = (end - dest) / 4;
+
+	if (blocks) {
+		__asm__ volatile (
+			"1:	ldmia	%0!, {r3, r4, r5, r6}\n"
+			"	stmia	%1!, {r3, r4, r5, r6}\n"
+			"	subs	%2, #1\n"
+			"	bne	1b\n"
+			: "+l" (src), "+l" (dest), "+l" (blocks)
+			:
+			: "r3", "r4", "r5", "r6", "cc", "memory");
+	}
+	while (dest < end) {
+		*dest++ = *src++;
+	}
+}
+
+static inline void __attribute__((always_inline))
+reset_clear(volatile unsigned *dest, volatile unsigned *end)
+{
+	unsigned blocks = (end - dest) / 4;
+
+	if (blocks) {
+		__asm__ volatile (
+			"	movs	r3, #0\n"
+			"	movs	r4, #0\n"
+			"	movs	r5, #0\n"
+			"	movs	r6, #0\n"
+			"1:	stmia	%0!, {r3, r4, r5, r6}\n"
+			"	subs	%1, #1\n"
+			"	bne	1b\n"
+			: "+l" (dest), "+l" (blocks)
+			:
+			: "r3", "r4", "r5", "r6", "cc", "memory");
+	}
+	while (dest < end) {
+		*dest++ = 0;
+	}
+}
+
 void __attribute__ ((weak)) reset_handler(void)
 {
-	volatile unsigned *src, *dest;
+	/* For linker scripts without the tables */
+	static const struct vector_copy_entry data_copy = {
+		&_data_loadaddr, &_data, &_edata
+	};
+	static const struct vector_zero_entry bss_zero = { &_edata, &_ebss };
+	const struct vector_copy_entry *copy, *copy_end;
+	const struct vector_zero_entry *zero, *zero_end;
 	funcp_t *fp;
 
-	for (src = &_data_loadaddr, dest = &_data;
-		dest < &_edata;
-		src++, dest++) {
-		*dest = *src;
+	/* Clocks up, before the bulk of the work */
+	reset_pre_init();
+
+	if (__copy_table_start) {
+		copy = __copy_table_start;
+		copy_end = __copy_table_end;
+		zero = __zero_table_start;
+		zero_end = __zero_table_end;
+	} else {
+		copy = &data_copy;
+		copy_end = copy + 1;
+		zero = &bss_zero;
+		zero_end = zero + 1;
 	}
 
-	while (dest < &_ebss) {
-		*dest++ = 0;
+	/* Sections the DMA takes are cleared while the CPU copies */
+	for (; zero < zero_end; zero++) {
+		if (!reset_dma_clear(zero->dest, zero->end)) {
+			reset_clear(zero->dest, zero->end);
+		}
 	}
+	for (; copy < copy_end; copy++) {
+		reset_copy(copy->src, copy->dest, copy->end);
+	}
+	reset_dma_wait();
 
 	/* Ensure 8-byte alignment of stack pointer on interrupts */
 	/* Enabled by default on most Cortex-M parts, but not M3 r1 */
@@ -109,6 +187,15 @@ void null_handler(void)
 	/* Do nothing. */
 }
 
+bool __attribute__ ((weak)) reset_dma_clear(unsigned *dest, unsigned *end)
+{
+	(void)dest;
+	(void)end;
+	return false;
+}
+
+#pragma weak reset_pre_init = null_handler
+#pragma weak reset_dma_wait = null_handler
 #pragma weak nmi_handler = null_handler
 #pragma weak hard_fault_handler = blocking_handler
 #pragma weak sv_call_handler = null_handler
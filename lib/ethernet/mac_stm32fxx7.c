@@ -36,12 +36,27 @@
 #include <libopencm3/ethernet/phy.h>
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/cm3/nvic.h>
+#include <libopencm3/cm3/cortex.h>
 
 /**@{*/
 
 uint32_t TxBD;
 uint32_t RxBD;
 
+/* Zero-copy mode: oldest TX descriptor not yet reclaimed, and the RX
+ * descriptor from which to look for an empty slot to give a buffer to. */
+static uint32_t TxReclaimBD;
+static uint32_t RxGiveBD;
+/* Size of the zero-copy transmit ring. */
+static uint32_t TxCount;
+/* Descriptors queued and not yet reclaimed, reclaiming may be done from the
+ * interrupt. */
+static volatile uint32_t TxQueued;
+
+static eth_rx_callback eth_rx_cb;
+static eth_tx_done_callback eth_tx_cb;
+static struct eth_stats eth_stats;
+
 /*---------------------------------------------------------------------------*/
 /** @brief Set MAC to the PHY
  *
@@ -114,6 +129,9 @@ void eth_desc_init(uint8_t *buf, uint32_t nTx, uint32_t nRx, uint32_t cTx,
 
 	ETH_DMARDLAR = (uint32_t) RxBD;
 	ETH_DMATDLAR = (uint32_t) TxBD;
+
+	TxReclaimBD = TxBD;
+	RxGiveBD = RxBD;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -185,6 +203,293 @@ bool eth_rx(uint8_t *ppkt, uint32_t *len, uint32_t maxlen)
 	return fs && ls && !overrun;
 }
 
+/*---------------------------------------------------------------------------*/
+/** @brief Initialize descriptors for zero-copy operation
+ *
+ * Only the descriptor chains are set up, the data buffers stay owned by the
+ * application: transmit buffers are handed over per frame with
+ * @ref eth_tx_frags and returned by @ref eth_tx_reclaim, receive buffers are
+ * handed over with @ref eth_rx_give and returned by @ref eth_rx_claim.
+ * Buffers must be word aligned and stay valid while the DMA owns them.
+ *
+ * The copying @ref eth_tx and @ref eth_rx must not be used in this mode.
+ *
+ * @param[in] desc uint8_t* Memory area for nTx + nRx descriptors
+ * @param[in] nTx uint32_t Count of transmit descriptors (one per buffer)
+ * @param[in] nRx uint32_t Count of receive descriptors (one per buffer)
+ * @param[in] isext bool true if extended descriptors should be used
+ */
+void eth_desc_init_zerocopy(uint8_t *desc, uint32_t nTx, uint32_t nRx,
+			    bool isext)
+{
+	uint32_t bd = (uint32_t)desc;
+	uint32_t sz = isext ? ETH_DES_EXT_SIZE : ETH_DES_STD_SIZE;
+
+	memset(desc, 0, (nTx + nRx) * sz);
+	TxCount = nTx;
+
+	/* enable / disable extended frames */
+	if (isext) {
+		ETH_DMABMR |= ETH_DMABMR_EDFE;
+	} else {
+		ETH_DMABMR &= ~ETH_DMABMR_EDFE;
+	}
+
+	/* A descriptor without buffer (DES2 == 0) is free. */
+	TxBD = bd;
+	while (--nTx > 0) {
+		ETH_DES0(bd) = ETH_TDES0_TCH;
+		ETH_DES3(bd) = bd + sz;
+		bd = ETH_DES3(bd);
+	}
+
+	ETH_DES0(bd) = ETH_TDES0_TCH;
+	ETH_DES3(bd) = TxBD;
+	bd += sz;
+
+	RxBD = bd;
+	while (--nRx > 0) {
+		ETH_DES1(bd) = ETH_RDES1_RCH;
+		ETH_DES3(bd) = bd + sz;
+		bd = ETH_DES3(bd);
+	}
+
+	ETH_DES1(bd) = ETH_RDES1_RCH;
+	ETH_DES3(bd) = RxBD;
+
+	ETH_DMARDLAR = (uint32_t) RxBD;
+	ETH_DMATDLAR = (uint32_t) TxBD;
+
+	TxReclaimBD = TxBD;
+	RxGiveBD = RxBD;
+	TxQueued = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Transmit a frame gathered from several buffers without copying
+ *
+ * Each buffer occupies one descriptor until it is returned by
+ * @ref eth_tx_reclaim. The frame is queued as a whole or not at all, nothing
+ * is written to the ring unless there are n free descriptors.
+ *
+ * @param[in] frags const struct eth_frag* Buffers of the frame, in order
+ * @param[in] n uint32_t Count of buffers, at most the size of the ring
+ * @returns bool true, if the frame was queued
+ */
+bool eth_tx_frags(const struct eth_frag *frags, uint32_t n)
+{
+	uint32_t bd = TxBD;
+	uint32_t i;
+
+	if ((n == 0) || (n > TxCount - TxQueued)) {
+		return false;
+	}
+
+	for (i = 0; i < n; i++) {
+		if ((ETH_DES0(bd) & ETH_TDES0_OWN) || ETH_DES2(bd)) {
+			return false;
+		}
+		bd = ETH_DES3(bd);
+	}
+
+	/* Fill all descriptors, the first one is given to the DMA last so
+	 * it never sees a partial frame. */
+	bd = TxBD;
+	for (i = 0; i < n; i++) {
+		ETH_DES2(bd) = (uint32_t)frags[i].buf;
+		ETH_DES1(bd) = frags[i].len & ETH_TDES1_TBS1;
+		ETH_DES0(bd) = (ETH_DES0(bd) & ETH_TDES0_CIC) | ETH_TDES0_TCH |
+			       ((i == 0) ? ETH_TDES0_FS : ETH_TDES0_OWN) |
+			       ((i == n - 1) ? ETH_TDES0_LS : 0);
+		bd = ETH_DES3(bd);
+	}
+
+	/* Counted before the DMA has the frame, so reclaiming it from the
+	 * interrupt cannot take the count below zero. */
+	CM_ATOMIC_BLOCK() {
+		TxQueued += n;
+		if (TxQueued > eth_stats.tx_hwm) {
+			eth_stats.tx_hwm = TxQueued;
+		}
+	}
+
+	ETH_DES0(TxBD) |= ETH_TDES0_OWN;
+	TxBD = bd;
+
+	if (ETH_DMASR & ETH_DMASR_TBUS) {
+		ETH_DMASR = ETH_DMASR_TBUS;
+		ETH_DMATPDR = 0;
+	}
+
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Take back the oldest transmitted buffer
+ *
+ * @param[out] status uint32_t* TDES0 of the descriptor
+ * @returns void* The buffer, NULL if none has been transmitted yet
+ */
+static void *eth_tx_reclaim_one(uint32_t *status)
+{
+	void *buf = (void *)ETH_DES2(TxReclaimBD);
+
+	if (!buf || (ETH_DES0(TxReclaimBD) & ETH_TDES0_OWN)) {
+		return NULL;
+	}
+
+	*status = ETH_DES0(TxReclaimBD);
+	if (*status & ETH_TDES0_LS) {
+		eth_stats.tx_frames++;
+		if (*status & ETH_TDES0_ES) {
+			eth_stats.tx_errors++;
+		}
+	}
+
+	ETH_DES2(TxReclaimBD) = 0;
+	TxReclaimBD = ETH_DES3(TxReclaimBD);
+	CM_ATOMIC_BLOCK() {
+		TxQueued--;
+	}
+
+	return buf;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Return the buffers of transmitted frames to the application
+ *
+ * @param[out] bufs void** Array receiving the buffers, oldest first
+ * @param[in] max uint32_t Size of the bufs array
+ * @returns uint32_t Count of buffers returned
+ */
+uint32_t eth_tx_reclaim(void **bufs, uint32_t max)
+{
+	uint32_t n = 0;
+	uint32_t status;
+
+	while (n < max) {
+		bufs[n] = eth_tx_reclaim_one(&status);
+		if (!bufs[n]) {
+			break;
+		}
+		n++;
+	}
+
+	return n;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Resume the receive DMA if it ran out of descriptors
+ *
+ * The poll demand is ignored while the DMA is running, it is issued
+ * unconditionally as the interrupt handler may have acknowledged RBUS.
+ */
+static void eth_rx_resume(void)
+{
+	ETH_DMASR = ETH_DMASR_RBUS;
+	ETH_DMARPDR = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Give a receive buffer to the DMA
+ *
+ * @param[in] buf void* Word aligned receive buffer
+ * @param[in] size uint32_t Bytes in the buffer, must be a multiple of 4
+ * @returns bool true, if a free descriptor took the buffer
+ */
+bool eth_rx_give(void *buf, uint32_t size)
+{
+	uint32_t bd = RxGiveBD;
+
+	do {
+		if (!(ETH_DES0(bd) & ETH_RDES0_OWN) && !ETH_DES2(bd)) {
+			ETH_DES2(bd) = (uint32_t)buf;
+			ETH_DES1(bd) = ETH_RDES1_RCH | (size & ETH_RDES1_RBS1);
+			ETH_DES0(bd) = ETH_RDES0_OWN;
+			RxGiveBD = ETH_DES3(bd);
+			eth_rx_resume();
+			return true;
+		}
+		bd = ETH_DES3(bd);
+	} while (bd != RxGiveBD);
+
+	return false;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Take the buffers of the next received frame without copying
+ *
+ * Frames with errors, and frames spanning more than max buffers, are
+ * dropped and their buffers are given back to the DMA in place. The
+ * returned buffers leave their descriptors empty until they (or others) are
+ * given back with @ref eth_rx_give.
+ *
+ * @param[out] frags struct eth_frag* Array receiving the buffers of the frame
+ * @param[in] max uint32_t Size of the frags array
+ * @returns uint32_t Count of buffers of the frame, 0 if none is complete
+ */
+uint32_t eth_rx_claim(struct eth_frag *frags, uint32_t max)
+{
+	uint32_t bd, last, n, i, l;
+
+	for (;;) {
+		/* Look for the last descriptor of the frame */
+		bd = RxBD;
+		n = 0;
+		for (;;) {
+			if ((ETH_DES0(bd) & ETH_RDES0_OWN) || !ETH_DES2(bd)) {
+				return 0;
+			}
+			n++;
+			if (ETH_DES0(bd) & ETH_RDES0_LS) {
+				break;
+			}
+			bd = ETH_DES3(bd);
+			if (bd == RxBD) {
+				return 0;
+			}
+		}
+		last = bd;
+
+		if ((ETH_DES0(RxBD) & ETH_RDES0_FS) &&
+		    !(ETH_DES0(last) & ETH_RDES0_ES) && (n <= max)) {
+			break;
+		}
+
+		/* Drop the frame */
+		eth_stats.rx_dropped++;
+		if (ETH_DES0(last) & ETH_RDES0_CE) {
+			eth_stats.rx_crc_errors++;
+		}
+		if (ETH_DES0(last) & ETH_RDES0_OE) {
+			eth_stats.rx_overruns++;
+		}
+		for (i = 0; i < n; i++) {
+			ETH_DES0(RxBD) = ETH_RDES0_OWN;
+			RxBD = ETH_DES3(RxBD);
+		}
+		eth_rx_resume();
+	}
+
+	l = (ETH_DES0(last) & ETH_RDES0_FL) >> ETH_RDES0_FL_SHIFT;
+	for (i = 0; i < n; i++) {
+		frags[i].buf = (void *)ETH_DES2(RxBD);
+		if (i < n - 1) {
+			frags[i].len = ETH_DES1(RxBD) & ETH_RDES1_RBS1;
+			l -= frags[i].len;
+		} else {
+			frags[i].len = l;
+		}
+
+		ETH_DES2(RxBD) = 0;
+		ETH_DES0(RxBD) = 0;
+		RxBD = ETH_DES3(RxBD);
+	}
+	eth_stats.rx_frames++;
+
+	return n;
+}
+
 /*---------------------------------------------------------------------------*/
 /** @brief Start the Ethernet DMA processing
  */
@@ -269,6 +574,117 @@ bool eth_irq_ack_pending(uint32_t reason)
 	return reason != 0;
 }
 
+/*---------------------------------------------------------------------------*/
+/** @brief Set up interrupt driven operation of the zero-copy rings
+ *
+ * Registers the callbacks and enables the DMA interrupts handled by
+ * @ref eth_irq_handler, which has to be called from eth_isr(). The ETH
+ * interrupt still has to be enabled in the NVIC.
+ *
+ * @param[in] rx_cb eth_rx_callback Called for every received frame
+ * @param[in] tx_cb eth_tx_done_callback Called for every transmitted
+ *                  buffer, may be NULL
+ */
+void eth_irq_setup(eth_rx_callback rx_cb, eth_tx_done_callback tx_cb)
+{
+	eth_rx_cb = rx_cb;
+	eth_tx_cb = tx_cb;
+
+	eth_irq_enable(ETH_DMAIER_NISE | ETH_DMAIER_RIE | ETH_DMAIER_TIE |
+		       ETH_DMAIER_AISE | ETH_DMAIER_RBUIE | ETH_DMAIER_ROIE |
+		       ETH_DMAIER_TUIE | ETH_DMAIER_FBEIE);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Process the Ethernet DMA interrupt
+ *
+ * Delivers received frames and transmitted buffers to the callbacks set by
+ * @ref eth_irq_setup, resumes suspended DMA and updates the counters.
+ */
+void eth_irq_handler(void)
+{
+	struct eth_frag frags[ETH_RX_FRAGS_MAX];
+	uint32_t sr = ETH_DMASR;
+	uint32_t mfbocr, backlog, status, n;
+	void *buf;
+
+	/* TBUS is left to eth_tx_frags(), which resumes on it */
+	ETH_DMASR = sr & (ETH_DMASR_TS | ETH_DMASR_ROS |
+			  ETH_DMASR_TUS | ETH_DMASR_RS | ETH_DMASR_RBUS |
+			  ETH_DMASR_FBES | ETH_DMASR_AIS | ETH_DMASR_NIS);
+
+	if (sr & ETH_DMASR_FBES) {
+		eth_stats.bus_errors++;
+	}
+
+	if (sr & ETH_DMASR_ROS) {
+		eth_stats.rx_overruns++;
+	}
+
+	if (sr & (ETH_DMASR_ROS | ETH_DMASR_RBUS)) {
+		/* Counter is cleared on read */
+		mfbocr = ETH_DMAMFBOCR;
+		eth_stats.rx_missed += mfbocr & ETH_DMAMFBOCR_MFC;
+	}
+
+	if (sr & ETH_DMASR_TUS) {
+		eth_stats.tx_underflows++;
+	}
+
+	if (sr & (ETH_DMASR_TS | ETH_DMASR_TUS)) {
+		while ((buf = eth_tx_reclaim_one(&status)) != NULL) {
+			if (eth_tx_cb) {
+				eth_tx_cb(buf, status);
+			}
+		}
+	}
+
+	if (sr & (ETH_DMASR_RS | ETH_DMASR_RBUS | ETH_DMASR_ROS)) {
+		backlog = 0;
+		while ((n = eth_rx_claim(frags, ETH_RX_FRAGS_MAX)) != 0) {
+			backlog += n;
+			if (eth_rx_cb) {
+				eth_rx_cb(frags, n);
+			}
+		}
+		if (backlog > eth_stats.rx_hwm) {
+			eth_stats.rx_hwm = backlog;
+		}
+	}
+
+	/* Recover from suspended DMA */
+	/* Only resume once the callbacks gave buffers back, otherwise the DMA
+	 * would suspend again right away. eth_rx_give() resumes later. */
+	if (sr & ETH_DMASR_RBUS) {
+		eth_stats.rx_buf_unavail++;
+		if (ETH_DES0(ETH_DMACHRDR) & ETH_RDES0_OWN) {
+			ETH_DMARPDR = 0;
+		}
+	}
+
+	if ((sr & ETH_DMASR_TUS) && TxQueued) {
+		ETH_DMATPDR = 0;
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Get the driver counters
+ *
+ * @returns const struct eth_stats* Counters since the last clear
+ */
+const struct eth_stats *eth_get_stats(void)
+{
+	return &eth_stats;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Clear the driver counters
+ */
+void eth_clear_stats(void)
+{
+	memset(&eth_stats, 0, sizeof(eth_stats));
+}
+
 /*---------------------------------------------------------------------------*/
 /** @brief Enable checksum offload feature
  *
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Register files of the host build. MMIO8() to MMIO64() look up every
+ * address here: the peripheral regions of the memory map are backed by
+ * plain memory, which a peripheral model of the program reads and writes
+ * to play the hardware, everything else is taken to be memory of the
+ * program itself. A model that has to see every access to a register, a
+ * counter or a FIFO, overrides host_mmio_model().
+ */
+
+#include <stddef.h>
+#include <libopencm3/cm3/common.h>
+#include <libopencm3/stm32/tools.h>
+
+struct host_mmio_region {
+	uint32_t base;
+	uint32_t size;
+	uint8_t *mem;
+};
+
+/* APB1, APB2 and AHB1 */
+static uint8_t host_periph[0x80000] __attribute__((aligned(8)));
+/* AHB2, the USB OTG FS core */
+static uint8_t host_ahb2[0x70000] __attribute__((aligned(8)));
+/* Private peripheral bus: ITM, DWT, SCS */
+static uint8_t host_ppb[0x100000] __attribute__((aligned(8)));
+
+static const struct host_mmio_region host_regions[] = {
+	{ 0x40000000, sizeof(host_periph), host_periph },
+	{ 0x50000000, sizeof(host_ahb2), host_ahb2 },
+	{ 0xE0000000, sizeof(host_ppb), host_ppb },
+};
+
+uint32_t host_primask;
+uint32_t host_faultmask;
+
+/* No register of its own, unless the program brings a model */
+__attribute__((weak))
+volatile void *host_mmio_model(uint32_t addr, unsigned size)
+{
+	(void)addr;
+	(void)size;
+	return NULL;
+}
+
+volatile void *host_mmio(uint32_t addr, unsigned size)
+{
+	const struct host_mmio_region *r;
+	volatile void *model = host_mmio_model(addr, size);
+	unsigned i;
+
+	if (model) {
+		return model;
+	}
+	for (i = 0; i < sizeof(host_regions) / sizeof(host_regions[0]); i++) {
+		r = &host_regions[i];
+		if (addr - r->base < r->size) {
+			return r->mem + (addr - r->base);
+		}
+	}
+	return (volatile void *)(uintptr_t)addr;
+}
+
+/* Plain store, a model of a peripheral with toggle or write 0 to clear
+ * bits brings its own. */
+__attribute__((weak))
+void host_set_reg(volatile uint32_t *reg, uint16_t val)
+{
+	*reg = val;
+}
@@ -0,0 +1,411 @@
+/** @addtogroup can_file
+ *
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+#include <libopencm3/stm32/can.h>
+
+#define CAN_FILTER_STD_WIDTH	0x7FF
+#define CAN_FILTER_EXT_WIDTH	0x1FFFFFFF
+
+/* 16 bit filter: STID[10:0] RTR IDE EXID[17:15] */
+#define CAN_FILTER_16_SHIFT	5
+#define CAN_FILTER_16_RTR_IDE	(0x3 << 3)
+/* 32 bit filter: STID[10:0] EXID[17:0] IDE RTR 0 */
+#define CAN_FILTER_32_SHIFT	3
+#define CAN_FILTER_32_IDE	(1 << 2)
+#define CAN_FILTER_32_RTR	(1 << 1)
+
+/* A block of IDs, those equal to id in the bits set in mask. The group is
+ * the FIFO times two, plus one for extended IDs. */
+struct can_filter_entry {
+	uint32_t id;
+	uint32_t mask;
+	uint8_t group;
+};
+
+static struct {
+	struct can_filter_entry entry[CAN_FILTER_MAX_ENTRIES];
+	uint32_t count;
+	/* Entries of each group, singles and blocks */
+	uint32_t kind[4][2];
+	bool exact;
+} can_filter;
+
+static uint32_t can_filter_width(uint8_t group)
+{
+	return (group & 1) ? CAN_FILTER_EXT_WIDTH : CAN_FILTER_STD_WIDTH;
+}
+
+static bool can_filter_is_block(const struct can_filter_entry *e)
+{
+	return e->mask != can_filter_width(e->group);
+}
+
+static uint32_t can_filter_size(const struct can_filter_entry *e)
+{
+	return 1 << __builtin_popcount(~e->mask & can_filter_width(e->group));
+}
+
+static bool can_filter_contains(const struct can_filter_entry *a,
+				const struct can_filter_entry *b)
+{
+	return (b->mask & a->mask) == a->mask &&
+		(b->id & a->mask) == a->id;
+}
+
+/* Banks needed: 16 bit masks two to a bank, with a single standard ID in
+ * the odd slot, standard IDs four to a list bank, 32 bit masks one to a
+ * bank and extended IDs two to a list bank. */
+static uint32_t can_filter_banks(uint32_t kind[4][2])
+{
+	uint32_t banks = 0;
+	uint32_t singles;
+	int fifo;
+
+	for (fifo = 0; fifo < 2; fifo++) {
+		singles = kind[fifo * 2][0];
+		if ((kind[fifo * 2][1] & 1) && singles) {
+			singles--;
+		}
+		banks += (kind[fifo * 2][1] + 1) / 2 + (singles + 3) / 4;
+		banks += kind[fifo * 2 + 1][1] + (kind[fifo * 2 + 1][0] + 1) / 2;
+	}
+	return banks;
+}
+
+static void can_filter_count(void)
+{
+	const struct can_filter_entry *e;
+	uint32_t i;
+
+	for (i = 0; i < 4; i++) {
+		can_filter.kind[i][0] = 0;
+		can_filter.kind[i][1] = 0;
+	}
+	for (i = 0; i < can_filter.count; i++) {
+		e = &can_filter.entry[i];
+		can_filter.kind[e->group][can_filter_is_block(e)]++;
+	}
+}
+
+static void can_filter_remove(uint32_t i)
+{
+	can_filter.entry[i] = can_filter.entry[--can_filter.count];
+}
+
+/* Merges the two entries of a group that save the most banks, and of those
+ * the two that let the fewest extra IDs through. Returns false if there are
+ * no two entries of a group left. */
+static bool can_filter_merge(void)
+{
+	struct can_filter_entry *a, *b;
+	struct can_filter_entry m, best_m = { 0, 0, 0 };
+	uint32_t kind[4][2];
+	uint32_t banks, best_banks = 0xFFFFFFFF;
+	int64_t cost, best_cost = 0;
+	uint32_t i, j, k, best_i = 0, best_j = 0;
+
+	for (i = 0; i < can_filter.count; i++) {
+		for (j = i + 1; j < can_filter.count; j++) {
+			a = &can_filter.entry[i];
+			b = &can_filter.entry[j];
+			if (a->group != b->group) {
+				continue;
+			}
+
+			if (can_filter_contains(a, b)) {
+				m = *a;
+				cost = -1;
+			} else if (can_filter_contains(b, a)) {
+				m = *b;
+				cost = -1;
+			} else {
+				m.group = a->group;
+				m.mask = ~(a->id ^ b->id) & a->mask & b->mask;
+				m.id = a->id & m.mask;
+				cost = (int64_t)can_filter_size(&m)
+					- can_filter_size(a)
+					- can_filter_size(b);
+			}
+
+			for (k = 0; k < 4; k++) {
+				kind[k][0] = can_filter.kind[k][0];
+				kind[k][1] = can_filter.kind[k][1];
+			}
+			kind[a->group][can_filter_is_block(a)]--;
+			kind[b->group][can_filter_is_block(b)]--;
+			kind[m.group][can_filter_is_block(&m)]++;
+			banks = can_filter_banks(kind);
+
+			if (banks < best_banks ||
+			    (banks == best_banks && cost < best_cost)) {
+				best_banks = banks;
+				best_cost = cost;
+				best_m = m;
+				best_i = i;
+				best_j = j;
+			}
+		}
+	}
+
+	if (best_banks == 0xFFFFFFFF) {
+		return false;
+	}
+
+	if (best_cost > 0) {
+		can_filter.exact = false;
+	}
+	can_filter.entry[best_i] = best_m;
+	can_filter_remove(best_j);
+
+	/* Drop what the merged block now covers */
+	i = 0;
+	while (i < can_filter.count) {
+		if (i != best_i &&
+		    can_filter.entry[i].group == best_m.group &&
+		    can_filter_contains(&best_m, &can_filter.entry[i])) {
+			can_filter_remove(i);
+			if (best_i == can_filter.count) {
+				best_i = i;
+			}
+			continue;
+		}
+		i++;
+	}
+	can_filter_count();
+	return true;
+}
+
+static void can_filter_add(uint32_t id, uint32_t mask, uint8_t group)
+{
+	struct can_filter_entry e = { id, mask, group };
+	uint32_t i;
+
+	for (i = 0; i < can_filter.count; i++) {
+		if (can_filter.entry[i].group == group &&
+		    can_filter_contains(&can_filter.entry[i], &e)) {
+			return;
+		}
+	}
+
+	if (can_filter.count == CAN_FILTER_MAX_ENTRIES) {
+		can_filter_merge();
+	}
+	can_filter.entry[can_filter.count++] = e;
+	can_filter.kind[group][can_filter_is_block(&e)]++;
+}
+
+/* Splits a range into aligned power of two blocks */
+static void can_filter_add_range(uint32_t first, uint32_t last, uint8_t group)
+{
+	uint32_t width = can_filter_width(group);
+	uint32_t size;
+
+	for (;;) {
+		size = first ? (first & -first) : width + 1;
+		while (size > last - first + 1) {
+			size >>= 1;
+		}
+		can_filter_add(first, width & ~(size - 1), group);
+		if (size == last - first + 1) {
+			break;
+		}
+		first += size;
+	}
+}
+
+static uint16_t can_filter_16(const struct can_filter_entry *e)
+{
+	return e->id << CAN_FILTER_16_SHIFT;
+}
+
+static uint16_t can_filter_16_mask(const struct can_filter_entry *e)
+{
+	return (e->mask << CAN_FILTER_16_SHIFT) | CAN_FILTER_16_RTR_IDE;
+}
+
+static uint32_t can_filter_32(const struct can_filter_entry *e)
+{
+	return (e->id << CAN_FILTER_32_SHIFT) | CAN_FILTER_32_IDE;
+}
+
+static uint32_t can_filter_32_mask(const struct can_filter_entry *e)
+{
+	return (e->mask << CAN_FILTER_32_SHIFT) | CAN_FILTER_32_IDE
+		| CAN_FILTER_32_RTR;
+}
+
+/* Programs the banks of a FIFO, returns the next free bank */
+static uint32_t can_filter_program(uint32_t nr, uint8_t fifo)
+{
+	const struct can_filter_entry *e, *slot[4];
+	uint32_t i, n;
+	int spare = -1;
+
+	/* Standard ID blocks, a single ID fills an odd slot */
+	n = 0;
+	for (i = 0; i < can_filter.count; i++) {
+		e = &can_filter.entry[i];
+		if (e->group != fifo * 2 || !can_filter_is_block(e)) {
+			continue;
+		}
+		slot[n++] = e;
+		if (n == 2) {
+			can_filter_id_mask_16bit_init(nr++,
+				can_filter_16(slot[0]),
+				can_filter_16_mask(slot[0]),
+				can_filter_16(slot[1]),
+				can_filter_16_mask(slot[1]), fifo, true);
+			n = 0;
+		}
+	}
+	if (n) {
+		slot[1] = slot[0];
+		for (i = 0; i < can_filter.count; i++) {
+			e = &can_filter.entry[i];
+			if (e->group == fifo * 2 && !can_filter_is_block(e)) {
+				slot[1] = e;
+				spare = i;
+				break;
+			}
+		}
+		can_filter_id_mask_16bit_init(nr++,
+			can_filter_16(slot[0]), can_filter_16_mask(slot[0]),
+			can_filter_16(slot[1]), can_filter_16_mask(slot[1]),
+			fifo, true);
+	}
+
+	/* Single standard IDs, padded with the first of the bank */
+	n = 0;
+	for (i = 0; i < can_filter.count; i++) {
+		e = &can_filter.entry[i];
+		if (e->group != fifo * 2 || can_filter_is_block(e) ||
+		    (int)i == spare) {
+			continue;
+		}
+		slot[n++] = e;
+		if (n == 4) {
+			can_filter_id_list_16bit_init(nr++,
+				can_filter_16(slot[0]), can_filter_16(slot[1]),
+				can_filter_16(slot[2]), can_filter_16(slot[3]),
+				fifo, true);
+			n = 0;
+		}
+	}
+	if (n) {
+		while (n < 4) {
+			slot[n++] = slot[0];
+		}
+		can_filter_id_list_16bit_init(nr++,
+			can_filter_16(slot[0]), can_filter_16(slot[1]),
+			can_filter_16(slot[2]), can_filter_16(slot[3]),
+			fifo, true);
+	}
+
+	/* Extended ID blocks, then single extended IDs */
+	n = 0;
+	for (i = 0; i < can_filter.count; i++) {
+		e = &can_filter.entry[i];
+		if (e->group != fifo * 2 + 1) {
+			continue;
+		}
+		if (can_filter_is_block(e)) {
+			can_filter_id_mask_32bit_init(nr++, can_filter_32(e),
+				can_filter_32_mask(e), fifo, true);
+			continue;
+		}
+		slot[n++] = e;
+		if (n == 2) {
+			can_filter_id_list_32bit_init(nr++,
+				can_filter_32(slot[0]), can_filter_32(slot[1]),
+				fifo, true);
+			n = 0;
+		}
+	}
+	if (n) {
+		can_filter_id_list_32bit_init(nr++, can_filter_32(slot[0]),
+			can_filter_32(slot[0]), fifo, true);
+	}
+
+	return nr;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief CAN Compile Filters from ID Ranges
+
+Packs the ranges into the banks first_bank to first_bank + banks - 1, and
+deactivates the banks of those it does not need. Nothing is programmed if the
+ranges do not fit even merged into a bank per FIFO and ID type.
+
+@param[in] ranges IDs to accept.
+@param[in] count Number of ranges.
+@param[in] first_bank Unsigned int32. First filter bank to use.
+@param[in] banks Unsigned int32. Number of filter banks to use.
+@param[out] exact Set to false if more than the ranges is accepted, may be
+			NULL.
+@returns int Number of banks used, or -1 if a range is invalid or the ranges
+do not fit.
+ */
+int can_filter_compile(const struct can_filter_range *ranges, uint32_t count,
+		       uint32_t first_bank, uint32_t banks, bool *exact)
+{
+	const struct can_filter_range *r;
+	uint32_t nr, i;
+	uint8_t group;
+
+	can_filter.count = 0;
+	can_filter.exact = true;
+	can_filter_count();
+
+	for (i = 0; i < count; i++) {
+		r = &ranges[i];
+		group = r->fifo * 2 + ((r->flags & CAN_MSG_EXT) ? 1 : 0);
+		if (r->fifo > 1 || r->first > r->last ||
+		    r->last > can_filter_width(group)) {
+			return -1;
+		}
+		can_filter_add_range(r->first, r->last, group);
+	}
+
+	while (can_filter_banks(can_filter.kind) > banks) {
+		if (!can_filter_merge()) {
+			return -1;
+		}
+	}
+
+	nr = can_filter_program(first_bank, 0);
+	nr = can_filter_program(nr, 1);
+
+	/* Deactivate the banks left over */
+	CAN_FMR(CAN1) |= CAN_FMR_FINIT;
+	for (i = nr; i < first_bank + banks; i++) {
+		CAN_FA1R(CAN1) &= ~(1 << i);
+	}
+	CAN_FMR(CAN1) &= ~CAN_FMR_FINIT;
+
+	if (exact) {
+		*exact = can_filter.exact;
+	}
+	return nr - first_bank;
+}
+
+/**@}*/
@@ -0,0 +1,422 @@
+/** @addtogroup can_file
+ *
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+#include <stddef.h>
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/can.h>
+
+#define CAN_QUEUE_IRQS	(CAN_IER_TMEIE | \
+			 CAN_IER_FMPIE0 | CAN_IER_FOVIE0 | \
+			 CAN_IER_FMPIE1 | CAN_IER_FOVIE1 | \
+			 CAN_IER_ERRIE | CAN_IER_BOFIE | \
+			 CAN_IER_EPVIE | CAN_IER_EWGIE)
+
+#define CAN_QUEUE_ESR_FLAGS	(CAN_ESR_BOFF | CAN_ESR_EPVF | CAN_ESR_EWGF)
+
+/* Mailbox and FIFO registers are laid out alike for each one */
+#define CAN_QUEUE_MBOX(i)		(CAN_MBOX0 + 0x10 * (i))
+#define CAN_QUEUE_RFR(canport, fifo)	MMIO32((canport) + 0x00C + 4 * (fifo))
+#define CAN_QUEUE_TSR(bit, i)		((bit) << (8 * (i)))
+
+/* Arbitration order, lower wins: base ID, then RTR of a standard frame or
+ * SRR of an extended one, then IDE, extended ID and RTR */
+static uint32_t can_queue_priority(const struct can_tx_msg *msg)
+{
+	uint32_t rtr = (msg->flags & CAN_MSG_RTR) ? 1 : 0;
+
+	if (msg->flags & CAN_MSG_EXT) {
+		return (((msg->id >> 18) & 0x7FF) << 21) | (1 << 20)
+			| (1 << 19) | ((msg->id & 0x3FFFF) << 1) | rtr;
+	}
+	return ((msg->id & 0x7FF) << 21) | (rtr << 20);
+}
+
+/* Links frame into the queue, behind frames of the same priority, or ahead
+ * of them if it is one that was aborted */
+static void can_queue_insert(struct can_queue *queue, struct can_tx_msg *msg,
+			     bool ahead)
+{
+	struct can_tx_msg **link = &queue->head;
+	uint32_t priority = can_queue_priority(msg);
+
+	while (*link && (can_queue_priority(*link) < priority ||
+			 (!ahead && can_queue_priority(*link) == priority))) {
+		link = &(*link)->next;
+	}
+	msg->next = *link;
+	*link = msg;
+}
+
+static void can_queue_load(uint32_t canport, uint32_t mbox,
+			   const struct can_tx_msg *msg)
+{
+	const uint8_t *d = msg->data;
+	uint32_t tir;
+
+	if (msg->flags & CAN_MSG_EXT) {
+		tir = ((msg->id & 0x1FFFFFFF) << CAN_TIxR_EXID_SHIFT)
+			| CAN_TIxR_IDE;
+	} else {
+		tir = (msg->id & 0x7FF) << CAN_TIxR_STID_SHIFT;
+	}
+	if (msg->flags & CAN_MSG_RTR) {
+		tir |= CAN_TIxR_RTR;
+	}
+
+	CAN_TDTxR(canport, mbox) = msg->length & CAN_TDTxR_DLC_MASK;
+	CAN_TDLxR(canport, mbox) = d[0] | (d[1] << 8) | (d[2] << 16)
+		| ((uint32_t)d[3] << 24);
+	CAN_TDHxR(canport, mbox) = d[4] | (d[5] << 8) | (d[6] << 16)
+		| ((uint32_t)d[7] << 24);
+	CAN_TIxR(canport, mbox) = tir | CAN_TIxR_TXRQ;
+}
+
+/* Moves queued frames into empty mailboxes, and aborts the frame of lowest
+ * priority if the first queued one would have to wait behind it */
+static void can_queue_feed(struct can_queue *queue)
+{
+	uint32_t canport = queue->canport;
+	uint32_t lowest = 0;
+	uint32_t priority;
+	int victim = -1;
+	int i;
+
+	for (i = 0; i < CAN_QUEUE_MAILBOXES && queue->head; i++) {
+		if (queue->mailbox[i] ||
+		    !(CAN_TSR(canport) & (CAN_TSR_TME0 << i))) {
+			continue;
+		}
+		queue->mailbox[i] = queue->head;
+		queue->head = queue->head->next;
+		can_queue_load(canport, CAN_QUEUE_MBOX(i), queue->mailbox[i]);
+	}
+
+	if (!queue->head || queue->aborting) {
+		return;
+	}
+	for (i = 0; i < CAN_QUEUE_MAILBOXES; i++) {
+		if (!queue->mailbox[i]) {
+			continue;
+		}
+		priority = can_queue_priority(queue->mailbox[i]);
+		if (victim < 0 || priority > lowest) {
+			lowest = priority;
+			victim = i;
+		}
+	}
+	if (victim >= 0 && lowest > can_queue_priority(queue->head)) {
+		queue->aborting = 1 << victim;
+		CAN_TSR(canport) = CAN_QUEUE_TSR(CAN_TSR_ABRQ0, victim);
+	}
+}
+
+/* Ends the frames of mailboxes that completed */
+static void can_queue_tx_done(struct can_queue *queue)
+{
+	struct can_tx_msg *msg;
+	uint32_t canport = queue->canport;
+	uint32_t tsr = CAN_TSR(canport);
+	bool ok;
+	int i;
+
+	for (i = 0; i < CAN_QUEUE_MAILBOXES; i++) {
+		if (!(tsr & CAN_QUEUE_TSR(CAN_TSR_RQCP0, i))) {
+			continue;
+		}
+		CAN_TSR(canport) = CAN_QUEUE_TSR(CAN_TSR_RQCP0, i);
+
+		msg = queue->mailbox[i];
+		queue->mailbox[i] = NULL;
+		if (!msg) {
+			continue;
+		}
+
+		ok = (tsr & CAN_QUEUE_TSR(CAN_TSR_TXOK0, i)) != 0;
+		if (!ok && (queue->aborting & (1 << i))) {
+			/* Preempted, it goes again ahead of its peers */
+			queue->aborting &= ~(1 << i);
+			queue->stats.tx_preempted++;
+			can_queue_insert(queue, msg, true);
+			continue;
+		}
+		queue->aborting &= ~(1 << i);
+
+		if (ok) {
+			queue->stats.tx_frames++;
+		} else {
+			queue->stats.tx_failed++;
+		}
+		if (msg->callback) {
+			msg->callback(msg, ok);
+		}
+	}
+}
+
+/* Copies the frames of a receive FIFO into the rings */
+static void can_queue_rx(struct can_queue *queue, uint8_t fifo)
+{
+	struct can_rx_msg msg;
+	struct ringbuf *ring;
+	uint32_t canport = queue->canport;
+	uint32_t mbox = fifo ? CAN_FIFO1 : CAN_FIFO0;
+	uint32_t rir, rdtr, rdlr, rdhr;
+
+	while (CAN_QUEUE_RFR(canport, fifo) & CAN_RF0R_FMP0_MASK) {
+		rir = CAN_RIxR(canport, mbox);
+		rdtr = CAN_RDTxR(canport, mbox);
+		rdlr = CAN_RDLxR(canport, mbox);
+		rdhr = CAN_RDHxR(canport, mbox);
+
+		/* Release, and wait for the next frame to be in the output
+		 * mailbox before looking at the frame count again */
+		CAN_QUEUE_RFR(canport, fifo) = CAN_RF0R_RFOM0;
+		while (CAN_QUEUE_RFR(canport, fifo) & CAN_RF0R_RFOM0);
+
+		if (rir & CAN_RIxR_IDE) {
+			msg.id = (rir >> CAN_RIxR_EXID_SHIFT) &
+				CAN_RIxR_EXID_MASK;
+			msg.flags = CAN_MSG_EXT;
+		} else {
+			msg.id = (rir >> CAN_RIxR_STID_SHIFT) &
+				CAN_RIxR_STID_MASK;
+			msg.flags = 0;
+		}
+		if (rir & CAN_RIxR_RTR) {
+			msg.flags |= CAN_MSG_RTR;
+		}
+		msg.length = rdtr & CAN_RDTxR_DLC_MASK;
+		if (msg.length > 8) {
+			msg.length = 8;
+		}
+		msg.fifo = fifo;
+		msg.fmi = (rdtr & CAN_RDTxR_FMI_MASK) >> CAN_RDTxR_FMI_SHIFT;
+		msg.data[0] = rdlr;
+		msg.data[1] = rdlr >> 8;
+		msg.data[2] = rdlr >> 16;
+		msg.data[3] = rdlr >> 24;
+		msg.data[4] = rdhr;
+		msg.data[5] = rdhr >> 8;
+		msg.data[6] = rdhr >> 16;
+		msg.data[7] = rdhr >> 24;
+
+		ring = NULL;
+		if (msg.fmi < CAN_QUEUE_RX_RINGS) {
+			ring = queue->rx_ring[fifo][msg.fmi];
+		}
+		if (!ring) {
+			ring = queue->default_ring;
+		}
+
+		queue->stats.rx_frames++;
+		if (ring && ringbuf_free(ring) >= sizeof(msg)) {
+			ringbuf_write(ring, &msg, sizeof(msg));
+		} else {
+			queue->stats.rx_dropped++;
+		}
+	}
+}
+
+/* Counts the error states the CAN went into. Leaving them raises no
+ * interrupt, so the flags are looked at on every interrupt. */
+static void can_queue_status(struct can_queue *queue)
+{
+	uint32_t canport = queue->canport;
+	uint8_t esr = CAN_ESR(canport) & CAN_QUEUE_ESR_FLAGS;
+	uint8_t entered = esr & ~queue->esr;
+
+	if (CAN_MSR(canport) & CAN_MSR_ERRI) {
+		CAN_MSR(canport) = CAN_MSR_ERRI;
+	}
+	queue->esr = esr;
+
+	if (entered & CAN_ESR_EWGF) {
+		queue->stats.error_warning++;
+	}
+	if (entered & CAN_ESR_EPVF) {
+		queue->stats.error_passive++;
+	}
+	if (entered & CAN_ESR_BOFF) {
+		queue->stats.bus_off++;
+	}
+}
+
+/** Set up interrupt driven queues of a CAN.
+ *
+ * Enables the interrupts the queues need. The transmit mailboxes must not be
+ * used with can_transmit() as well, nor the receive FIFOs with can_receive().
+ *
+ * @param [in] queue Queue state.
+ * @param [in] canport CAN block register base @ref can_reg_base.
+ */
+void can_queue_init(struct can_queue *queue, uint32_t canport)
+{
+	uint32_t i;
+
+	queue->canport = canport;
+	queue->head = NULL;
+	for (i = 0; i < CAN_QUEUE_MAILBOXES; i++) {
+		queue->mailbox[i] = NULL;
+	}
+	queue->aborting = 0;
+	queue->esr = 0;
+	for (i = 0; i < CAN_QUEUE_RX_RINGS; i++) {
+		queue->rx_ring[0][i] = NULL;
+		queue->rx_ring[1][i] = NULL;
+	}
+	queue->default_ring = NULL;
+	queue->stats.tx_frames = 0;
+	queue->stats.tx_failed = 0;
+	queue->stats.tx_preempted = 0;
+	queue->stats.rx_frames = 0;
+	queue->stats.rx_dropped = 0;
+	queue->stats.rx_lost = 0;
+	queue->stats.error_warning = 0;
+	queue->stats.error_passive = 0;
+	queue->stats.bus_off = 0;
+
+	can_enable_irq(canport, CAN_QUEUE_IRQS);
+}
+
+/** Register ring for frames accepted by a filter.
+ *
+ * The ring gets whole struct can_rx_msg records, so its size should be a
+ * multiple of that.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] fifo Receive FIFO the filter is assigned to, 0 or 1.
+ * @param [in] fmi Filter match index of the filter within the FIFO.
+ * @param [in] ring Ring, NULL to use the default ring.
+ */
+void can_queue_set_rx_ring(struct can_queue *queue, uint8_t fifo,
+			   uint8_t fmi, struct ringbuf *ring)
+{
+	if (fifo < 2 && fmi < CAN_QUEUE_RX_RINGS) {
+		queue->rx_ring[fifo][fmi] = ring;
+	}
+}
+
+/** Register ring for frames without a filter ring.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] ring Ring, or NULL to drop these frames.
+ */
+void can_queue_set_default_ring(struct can_queue *queue, struct ringbuf *ring)
+{
+	queue->default_ring = ring;
+}
+
+/** Queue frame for transmission.
+ *
+ * Frame is queued behind frames of the same or higher priority and put into
+ * a mailbox once one becomes free, or one with a frame of lower priority is
+ * aborted. Frame must not be changed until its callback has been called.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] msg Frame to be sent.
+ * @returns 0, or -1 if the length is more than 8.
+ */
+int can_queue_submit(struct can_queue *queue, struct can_tx_msg *msg)
+{
+	if (msg->length > 8) {
+		return -1;
+	}
+
+	CM_ATOMIC_BLOCK() {
+		can_queue_insert(queue, msg, false);
+		can_queue_feed(queue);
+	}
+
+	return 0;
+}
+
+/** Tell if frames are waiting to be sent.
+ *
+ * @param [in] queue Queue state.
+ * @returns true if any queued frame has not been sent yet.
+ */
+bool can_queue_busy(struct can_queue *queue)
+{
+	return queue->head || queue->mailbox[0] || queue->mailbox[1] ||
+		queue->mailbox[2];
+}
+
+/** Take the oldest frame from a ring.
+ *
+ * @param [in] ring Ring registered with the queue.
+ * @param [out] msg The frame.
+ * @returns true if there was a frame.
+ */
+bool can_queue_read(struct ringbuf *ring, struct can_rx_msg *msg)
+{
+	if (ringbuf_used(ring) < sizeof(*msg)) {
+		return false;
+	}
+	ringbuf_read(ring, msg, sizeof(*msg));
+	return true;
+}
+
+/** Read the error counters of the CAN.
+ *
+ * @param [in] queue Queue state.
+ * @param [out] tec Transmit error counter, low byte.
+ * @param [out] rec Receive error counter.
+ */
+void can_queue_error_counters(struct can_queue *queue, uint8_t *tec,
+			      uint8_t *rec)
+{
+	uint32_t esr = CAN_ESR(queue->canport);
+
+	*tec = (esr & CAN_ESR_TEC_MASK) >> CAN_ESR_TEC_SHIFT;
+	*rec = (esr & CAN_ESR_REC_MASK) >> CAN_ESR_REC_SHIFT;
+}
+
+/** CAN queue interrupt handler.
+ *
+ * Has to be called from the transmit, both receive and the status change
+ * interrupts of the CAN.
+ *
+ * @param [in] queue Queue state.
+ */
+void can_queue_irq_handler(struct can_queue *queue)
+{
+	uint32_t canport = queue->canport;
+	uint8_t fifo;
+
+	if (CAN_TSR(canport) & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 |
+				CAN_TSR_RQCP2)) {
+		can_queue_tx_done(queue);
+		can_queue_feed(queue);
+	}
+
+	for (fifo = 0; fifo < 2; fifo++) {
+		if (CAN_QUEUE_RFR(canport, fifo) & CAN_RF0R_FOVR0) {
+			CAN_QUEUE_RFR(canport, fifo) = CAN_RF0R_FOVR0;
+			queue->stats.rx_lost++;
+		}
+		can_queue_rx(queue, fifo);
+	}
+
+	can_queue_status(queue);
+}
+
+/**@}*/
@@ -0,0 +1,349 @@
+/** @addtogroup adc_file ADC peripheral API
+ * @ingroup peripheral_apis
+ *
+ * This part captures an ADC continuously through the DMA, see
+ * @ref adc_api_capture.
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <libopencm3/stm32/adc.h>
+#include <libopencm3/stm32/dma.h>
+
+/**@{*/
+
+#if defined(DMA_SxCR_EN)
+#define ADC_CAPTURE_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_DMEIF | \
+				 DMA_FEIF)
+#else
+#define ADC_CAPTURE_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_GIF)
+#endif
+
+/* (Re)start the DMA at the first block. */
+static void adc_capture_dma_start(struct adc_capture *capture)
+{
+	uint32_t dma = capture->dma;
+	uint8_t channel = capture->channel;
+
+#if defined(DMA_SxCR_EN)
+	dma_disable_stream(dma, channel);
+	while (DMA_SCR(dma, channel) & DMA_SxCR_EN);
+	dma_clear_interrupt_flags(dma, channel, ADC_CAPTURE_DMA_FLAGS);
+	/* The stream starts on M0 again */
+	DMA_SCR(dma, channel) &= ~DMA_SxCR_CT;
+	dma_set_memory_address(dma, channel, (uint32_t)capture->buf);
+	dma_set_memory_address_1(dma, channel,
+				 (uint32_t)(capture->buf + capture->block_len));
+	/* ADC pairs come as one word through the common data register */
+	dma_set_number_of_data(dma, channel, capture->multi ?
+					     capture->block_len / 2 :
+					     capture->block_len);
+	dma_enable_stream(dma, channel);
+#else
+	dma_disable_channel(dma, channel);
+	dma_clear_interrupt_flags(dma, channel, ADC_CAPTURE_DMA_FLAGS);
+	dma_set_memory_address(dma, channel, (uint32_t)capture->buf);
+	dma_set_number_of_data(dma, channel, 2 * capture->block_len);
+	dma_enable_channel(dma, channel);
+#endif
+	capture->next = 0;
+}
+
+static void adc_capture_dma_setup(struct adc_capture *capture,
+				  volatile uint32_t *reg)
+{
+	uint32_t dma = capture->dma;
+	uint8_t channel = capture->channel;
+
+#if defined(DMA_SxCR_EN)
+	uint32_t chsel = DMA_SCR(dma, channel) & DMA_SxCR_CHSEL_MASK;
+
+	dma_stream_reset(dma, channel);
+	dma_channel_select(dma, channel, chsel);
+	dma_set_transfer_mode(dma, channel, DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+	if (capture->multi) {
+		dma_set_peripheral_size(dma, channel, DMA_SxCR_PSIZE_32BIT);
+		dma_set_memory_size(dma, channel, DMA_SxCR_MSIZE_32BIT);
+	} else {
+		dma_set_peripheral_size(dma, channel, DMA_SxCR_PSIZE_16BIT);
+		dma_set_memory_size(dma, channel, DMA_SxCR_MSIZE_16BIT);
+	}
+	dma_set_priority(dma, channel, DMA_SxCR_PL_VERY_HIGH);
+	dma_enable_double_buffer_mode(dma, channel);
+#else
+	dma_channel_reset(dma, channel);
+	dma_set_read_from_peripheral(dma, channel);
+	dma_set_peripheral_size(dma, channel, DMA_CCR_PSIZE_16BIT);
+	dma_set_memory_size(dma, channel, DMA_CCR_MSIZE_16BIT);
+	dma_set_priority(dma, channel, DMA_CCR_PL_VERY_HIGH);
+	dma_enable_circular_mode(dma, channel);
+	dma_enable_half_transfer_interrupt(dma, channel);
+#endif
+	dma_set_peripheral_address(dma, channel, (uint32_t)reg);
+	dma_enable_memory_increment_mode(dma, channel);
+	dma_enable_transfer_complete_interrupt(dma, channel);
+}
+
+/* Continuous DMA requests from the ADC, and conversions armed or started
+ * where the ADC does not run on its trigger alone. */
+static void adc_capture_adc_start(struct adc_capture *capture)
+{
+	uint32_t adc = capture->adc;
+
+#if defined(DMA_SxCR_EN)
+	if (capture->multi) {
+		ADC_CCR &= ~ADC_CCR_DMA_MASK;
+		ADC_CCR |= ADC_CCR_DMA_MODE_2 | ADC_CCR_DDS;
+		return;
+	}
+#endif
+#if defined(ADC_CR2_DDS)
+	/* F4, F7 and L1: without DDS the ADC stops requesting after
+	 * the first run of the DMA. */
+	adc_set_dma_continue(adc);
+	adc_disable_dma(adc);
+	adc_enable_dma(adc);
+	if (!(ADC_CR2(adc) & ADC_CR2_EXTEN_MASK)) {
+		adc_start_conversion_regular(adc);
+	}
+#elif defined(ADC_CFGR1_DMACFG)
+	adc_enable_dma_circular_mode(adc);
+	adc_enable_dma(adc);
+	adc_start_conversion_regular(adc);
+#else
+	/* F1 requests on every conversion while DMA is set. */
+	adc_enable_dma(adc);
+#endif
+}
+
+static void adc_capture_adc_stop(struct adc_capture *capture)
+{
+	uint32_t adc = capture->adc;
+
+#if defined(DMA_SxCR_EN)
+	if (capture->multi) {
+		ADC_CCR &= ~(ADC_CCR_DMA_MASK | ADC_CCR_DDS);
+		return;
+	}
+#endif
+#if defined(ADC_CR_ADSTP)
+	if (ADC_CR(adc) & ADC_CR_ADSTART) {
+		ADC_CR(adc) |= ADC_CR_ADSTP;
+		while (ADC_CR(adc) & ADC_CR_ADSTP);
+	}
+#endif
+	adc_disable_dma(adc);
+#if defined(ADC_CR2_DDS)
+	adc_set_dma_terminate(adc);
+#endif
+}
+
+/* Tell whether the ADC dropped samples, and clear that. */
+static bool adc_capture_adc_overrun(struct adc_capture *capture)
+{
+#if defined(DMA_SxCR_EN)
+	if (capture->multi) {
+		bool ovr = ADC_CSR & (ADC_CSR_OVR1 | ADC_CSR_OVR2 |
+				      ADC_CSR_OVR3);
+
+		if (ovr) {
+			ADC_SR(ADC1) &= ~ADC_SR_OVR;
+			ADC_SR(ADC2) &= ~ADC_SR_OVR;
+			ADC_SR(ADC3) &= ~ADC_SR_OVR;
+		}
+		return ovr;
+	}
+#endif
+#if defined(ADC_SR_OVR) || defined(ADC_ISR_OVR)
+	if (adc_get_overrun_flag(capture->adc)) {
+		adc_clear_overrun_flag(capture->adc);
+		return true;
+	}
+#else
+	(void)capture;
+#endif
+	return false;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief ADC Capture Initialise.
+
+@param[in] capture Capture state
+@param[in] adc Unsigned int32. ADC base address (@ref adc_reg_base)
+@param[in] dma Unsigned int32. DMA controller base address
+@param[in] channel Unsigned int8. DMA channel or stream serving the ADC
+*/
+
+void adc_capture_init(struct adc_capture *capture, uint32_t adc,
+		      uint32_t dma, uint8_t channel)
+{
+	capture->blocks = 0;
+	capture->overruns = 0;
+	capture->adc = adc;
+	capture->dma = dma;
+	capture->channel = channel;
+	capture->multi = false;
+	capture->next = 0;
+	capture->buf = NULL;
+	capture->block_len = 0;
+	capture->callback = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief ADC Capture Start.
+
+@param[in] capture Capture state
+@param[in] buf Storage for two blocks, 2 * @a block_len samples
+@param[in] block_len Unsigned int32. Samples per block, up to 65535 with DMA
+streams, 32767 with channels
+@param[in] callback Called with each block filled, or NULL
+*/
+
+void adc_capture_start(struct adc_capture *capture, uint16_t *buf,
+		       uint32_t block_len, adc_capture_callback callback)
+{
+	capture->multi = false;
+	capture->buf = buf;
+	capture->block_len = block_len;
+	capture->callback = callback;
+
+	adc_capture_dma_setup(capture, &ADC_DR(capture->adc));
+	adc_capture_dma_start(capture);
+#if defined(ADC_SR_OVR) || defined(ADC_ISR_OVR)
+	adc_capture_adc_overrun(capture);
+	adc_enable_overrun_interrupt(capture->adc);
+#endif
+	adc_capture_adc_start(capture);
+}
+
+#if defined(DMA_SxCR_EN)
+/*---------------------------------------------------------------------------*/
+/** @brief ADC Capture Start in Multi ADC Mode.
+
+ADC1 is the one given to adc_capture_init(). Its partners are set up by the
+caller like ADC1, apart from the trigger, which only ADC1 takes. Samples are
+stored in the order they were converted: alternating ADC1 and ADC2 in dual
+modes, ADC1, ADC2, ADC3 in triple interleaved mode.
+
+@param[in] capture Capture state
+@param[in] mode Unsigned int32. Interleaved or dual regular simultaneous
+multi mode, @ref adc_multi_mode
+@param[in] buf Storage for two blocks, 2 * @a block_len samples
+@param[in] block_len Unsigned int32. Samples per block, even, up to 131070
+@param[in] callback Called with each block filled, or NULL
+*/
+
+void adc_capture_start_multi(struct adc_capture *capture, uint32_t mode,
+			     uint16_t *buf, uint32_t block_len,
+			     adc_capture_callback callback)
+{
+	capture->multi = true;
+	capture->buf = buf;
+	capture->block_len = block_len;
+	capture->callback = callback;
+
+	ADC_CCR = (ADC_CCR & ~ADC_CCR_MULTI_MASK) | mode;
+	adc_capture_dma_setup(capture, &ADC_CDR);
+	adc_capture_dma_start(capture);
+	adc_capture_adc_overrun(capture);
+	adc_enable_overrun_interrupt(ADC1);
+	adc_capture_adc_start(capture);
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+/** @brief ADC Capture Stop.
+
+The ADC stays configured and powered, only its DMA requests end.
+
+@param[in] capture Capture state
+*/
+
+void adc_capture_stop(struct adc_capture *capture)
+{
+	adc_capture_adc_stop(capture);
+#if defined(DMA_SxCR_EN)
+	dma_disable_stream(capture->dma, capture->channel);
+	while (DMA_SCR(capture->dma, capture->channel) & DMA_SxCR_EN);
+#else
+	dma_disable_channel(capture->dma, capture->channel);
+#endif
+#if defined(ADC_SR_OVR) || defined(ADC_ISR_OVR)
+	adc_disable_overrun_interrupt(capture->adc);
+#endif
+	capture->buf = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief ADC Capture Interrupt Handler.
+
+Call from the DMA channel interrupt and the ADC interrupt. Hands each block
+the DMA finished to the callback and restarts the capture after an ADC
+overrun.
+
+@param[in] capture Capture state
+*/
+
+void adc_capture_irq_handler(struct adc_capture *capture)
+{
+	uint8_t block;
+
+	if (!capture->buf) {
+		return;
+	}
+
+	if (adc_capture_adc_overrun(capture)) {
+		/* The DMA requests stopped, start over in step with the
+		 * sequence. */
+		capture->overruns++;
+		adc_capture_adc_stop(capture);
+		adc_capture_dma_start(capture);
+		adc_capture_adc_start(capture);
+		return;
+	}
+
+	if (!dma_get_interrupt_flag(capture->dma, capture->channel,
+				    DMA_HTIF | DMA_TCIF)) {
+		return;
+	}
+	dma_clear_interrupt_flags(capture->dma, capture->channel,
+				  DMA_HTIF | DMA_TCIF);
+
+	/* The finished block is the one the DMA is not writing now. */
+#if defined(DMA_SxCR_EN)
+	block = dma_get_target(capture->dma, capture->channel) ? 0 : 1;
+#else
+	block = dma_get_number_of_data(capture->dma, capture->channel) >
+		capture->block_len ? 1 : 0;
+#endif
+	if (block != capture->next) {
+		/* The interrupt came a whole block late. */
+		capture->overruns++;
+	}
+	capture->next = block ^ 1;
+	capture->blocks++;
+
+	if (capture->callback) {
+		capture->callback(capture, capture->buf +
+					   block * capture->block_len,
+				  capture->block_len);
+	}
+}
+
+/**@}*/
@@ -24,7 +24,11 @@
  * along with this library.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include <libopencm3/stm32/crc.h>
+#ifdef CRC_POL
+#include <libopencm3/stm32/dma.h>
+#endif
 
 /**@{*/
 
@@ -50,5 +54,406 @@ uint32_t crc_calculate_block(uint32_t *datap, int size)
 
 	return CRC_DR;
 }
+
+const struct crc_params crc_params_crc32 = {
+	.width = 32, .refin = true, .refout = true,
+	.poly = 0x04C11DB7, .init = 0xFFFFFFFF, .xorout = 0xFFFFFFFF,
+};
+
+const struct crc_params crc_params_crc32_mpeg2 = {
+	.width = 32, .refin = false, .refout = false,
+	.poly = 0x04C11DB7, .init = 0xFFFFFFFF, .xorout = 0,
+};
+
+const struct crc_params crc_params_crc16_ccitt = {
+	.width = 16, .refin = false, .refout = false,
+	.poly = 0x1021, .init = 0xFFFF, .xorout = 0,
+};
+
+const struct crc_params crc_params_crc16_kermit = {
+	.width = 16, .refin = true, .refout = true,
+	.poly = 0x1021, .init = 0, .xorout = 0,
+};
+
+const struct crc_params crc_params_crc16_modbus = {
+	.width = 16, .refin = true, .refout = true,
+	.poly = 0x8005, .init = 0xFFFF, .xorout = 0,
+};
+
+const struct crc_params crc_params_crc8 = {
+	.width = 8, .refin = false, .refout = false,
+	.poly = 0x07, .init = 0, .xorout = 0,
+};
+
+const struct crc_params crc_params_crc7_mmc = {
+	.width = 7, .refin = false, .refout = false,
+	.poly = 0x09, .init = 0, .xorout = 0,
+};
+
+/* Context whose register currently lives in the CRC unit */
+static struct crc_context *crc_owner;
+
+#ifdef CRC_POL
+static uint32_t crc_dma;
+static uint8_t crc_dma_channel;
+/* Bytes handed to the DMA controller and not yet retired */
+static uint32_t crc_dma_count;
+#endif
+
+static uint32_t crc_mask(uint8_t width)
+{
+	return width >= 32 ? 0xFFFFFFFF : (1UL << width) - 1;
+}
+
+static uint32_t crc_reflect(uint32_t value, uint8_t bits)
+{
+	uint32_t ret = 0;
+
+	while (bits--) {
+		ret = (ret << 1) | (value & 1);
+		value >>= 1;
+	}
+	return ret;
+}
+
+/* Table driven software CRC, a nibble at a time. The register is kept
+ * left aligned so the same loop serves every width. */
+static void crc_sw_update(struct crc_context *ctx, const uint8_t *data,
+			  uint32_t len)
+{
+	const struct crc_params *p = ctx->params;
+	uint8_t shift = 32 - p->width;
+	uint32_t reg = ctx->reg << shift;
+	uint8_t b;
+
+	while (len--) {
+		b = *data++;
+		if (p->refin) {
+			b = crc_reflect(b, 8);
+		}
+		reg ^= (uint32_t)b << 24;
+		reg = (reg << 4) ^ ctx->table[reg >> 28];
+		reg = (reg << 4) ^ ctx->table[reg >> 28];
+	}
+	ctx->reg = reg >> shift;
+}
+
+#ifdef CRC_POL
+
+static bool crc_hw_capable(const struct crc_params *p)
+{
+	/* The unit only does odd polynomials of the four sizes it knows */
+	return (p->poly & 1) && (p->width == 7 || p->width == 8 ||
+				 p->width == 16 || p->width == 32);
+}
+
+static void crc_hw_load(struct crc_context *ctx)
+{
+	const struct crc_params *p = ctx->params;
+	uint32_t cr;
+
+	switch (p->width) {
+	case 7:
+		cr = CRC_CR_POLYSIZE_7;
+		break;
+	case 8:
+		cr = CRC_CR_POLYSIZE_8;
+		break;
+	case 16:
+		cr = CRC_CR_POLYSIZE_16;
+		break;
+	default:
+		cr = CRC_CR_POLYSIZE_32;
+		break;
+	}
+	/* Words are written byte swapped so per byte reflection is enough,
+	 * the output is reflected in software as the unit only knows about
+	 * full words there. */
+	if (p->refin) {
+		cr |= CRC_CR_REV_IN_BYTE;
+	}
+	CRC_CR = cr;
+	CRC_POL = p->poly;
+	CRC_INIT = ctx->reg;
+	CRC_CR |= CRC_CR_RESET;
+}
+
+static void crc_hw_word(struct crc_context *ctx, uint32_t word)
+{
+	(void)ctx;
+	CRC_DR = __builtin_bswap32(word);
+}
+
+#else
+
+static bool crc_hw_capable(const struct crc_params *p)
+{
+	return p->width == 32 && p->poly == 0x04C11DB7;
+}
+
+static void crc_hw_load(struct crc_context *ctx)
+{
+	(void)ctx;
+	crc_reset();
+}
+
+static uint32_t crc_reflect32(uint32_t value)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+	__asm__("rbit %0, %1" : "=r" (value) : "r" (value));
+	return value;
+#else
+	return crc_reflect(value, 32);
+#endif
+}
+
+static void crc_hw_word(struct crc_context *ctx, uint32_t word)
+{
+	/* The unit eats whole words MSB first */
+	if (ctx->params->refin) {
+		CRC_DR = crc_reflect32(word);
+	} else {
+		CRC_DR = __builtin_bswap32(word);
+	}
+}
+
+#endif
+
+static void crc_hw_update(struct crc_context *ctx, const uint8_t *data,
+			  uint32_t len)
+{
+	uint32_t word;
+
+	while (ctx->carry_len != 0 && len) {
+		ctx->carry[ctx->carry_len++] = *data++;
+		len--;
+		if (ctx->carry_len == 4) {
+			memcpy(&word, ctx->carry, 4);
+			crc_hw_word(ctx, word);
+			ctx->carry_len = 0;
+		}
+	}
+	while (len >= 4) {
+		memcpy(&word, data, 4);
+		crc_hw_word(ctx, word);
+		data += 4;
+		len -= 4;
+	}
+#ifdef CRC_POL
+	while (len--) {
+		CRC_DR8 = *data++;
+	}
+#else
+	/* The plain unit cannot take single bytes, hold them back */
+	while (len--) {
+		ctx->carry[ctx->carry_len++] = *data++;
+	}
+#endif
+}
+
+#ifdef CRC_POL
+
+static void crc_dma_start(const uint8_t *data, uint32_t len)
+{
+#if defined(DMA_SxCR_EN)
+	/* Memory-to-memory always reads through the peripheral port */
+	dma_stream_reset(crc_dma, crc_dma_channel);
+	dma_set_transfer_mode(crc_dma, crc_dma_channel,
+			      DMA_SxCR_DIR_MEM_TO_MEM);
+	dma_set_peripheral_address(crc_dma, crc_dma_channel, (uint32_t)data);
+	dma_enable_peripheral_increment_mode(crc_dma, crc_dma_channel);
+	dma_set_peripheral_size(crc_dma, crc_dma_channel,
+				DMA_SxCR_PSIZE_8BIT);
+	dma_set_memory_address(crc_dma, crc_dma_channel,
+			       (uint32_t)&CRC_DR8);
+	dma_set_memory_size(crc_dma, crc_dma_channel, DMA_SxCR_MSIZE_8BIT);
+	dma_enable_fifo_mode(crc_dma, crc_dma_channel);
+	dma_set_number_of_data(crc_dma, crc_dma_channel, len);
+	dma_enable_stream(crc_dma, crc_dma_channel);
+#else
+	dma_channel_reset(crc_dma, crc_dma_channel);
+	dma_enable_mem2mem_mode(crc_dma, crc_dma_channel);
+	dma_set_read_from_memory(crc_dma, crc_dma_channel);
+	dma_set_peripheral_address(crc_dma, crc_dma_channel,
+				   (uint32_t)&CRC_DR8);
+	dma_set_peripheral_size(crc_dma, crc_dma_channel, DMA_CCR_PSIZE_8BIT);
+	dma_set_memory_address(crc_dma, crc_dma_channel, (uint32_t)data);
+	dma_enable_memory_increment_mode(crc_dma, crc_dma_channel);
+	dma_set_memory_size(crc_dma, crc_dma_channel, DMA_CCR_MSIZE_8BIT);
+	dma_set_number_of_data(crc_dma, crc_dma_channel, len);
+	dma_enable_channel(crc_dma, crc_dma_channel);
+#endif
+	crc_dma_count = len;
+}
+
+static bool crc_dma_done(void)
+{
+	return dma_get_interrupt_flag(crc_dma, crc_dma_channel,
+				      DMA_TCIF | DMA_TEIF);
+}
+
+/* Wait for the DMA transfer of the owner and account for what it fed.
+ * After a transfer error the remainder is left to the CPU. */
+static void crc_dma_retire(void)
+{
+	uint32_t done;
+
+	if (crc_dma_count == 0) {
+		return;
+	}
+	while (!crc_dma_done());
+#if defined(DMA_SxCR_EN)
+	dma_disable_stream(crc_dma, crc_dma_channel);
+#else
+	dma_disable_channel(crc_dma, crc_dma_channel);
+#endif
+	done = crc_dma_count -
+	       dma_get_number_of_data(crc_dma, crc_dma_channel);
+	dma_clear_interrupt_flags(crc_dma, crc_dma_channel,
+				  DMA_TCIF | DMA_TEIF);
+	crc_owner->pending += done;
+	crc_owner->pending_len -= done;
+	crc_dma_count = 0;
+}
+
+void crc_dma_setup(uint32_t dma, uint8_t channel)
+{
+	if (crc_owner) {
+		crc_dma_retire();
+	}
+	crc_dma = dma;
+	crc_dma_channel = channel;
+}
+
+#endif
+
+/* Save the register of the owning context and give up the unit */
+static void crc_release(void)
+{
+	if (!crc_owner) {
+		return;
+	}
+#ifdef CRC_POL
+	crc_dma_retire();
+#endif
+	crc_owner->reg = CRC_DR & crc_mask(crc_owner->params->width);
+	crc_owner = NULL;
+}
+
+static bool crc_acquire(struct crc_context *ctx)
+{
+	if (crc_owner == ctx) {
+		return true;
+	}
+	if (!crc_hw_capable(ctx->params)) {
+		return false;
+	}
+#ifndef CRC_POL
+	/* Without an init register only a fresh register can be loaded */
+	if (ctx->reg != 0xFFFFFFFF) {
+		return false;
+	}
+#endif
+	crc_release();
+	crc_hw_load(ctx);
+	crc_owner = ctx;
+	return true;
+}
+
+/* Feed pending input to wherever the register lives. Returns true while
+ * a DMA transfer is still running. */
+static bool crc_pump(struct crc_context *ctx)
+{
+#ifdef CRC_POL
+	if (crc_owner == ctx && crc_dma_count) {
+		if (!crc_dma_done()) {
+			return true;
+		}
+		crc_dma_retire();
+	}
+#endif
+	if (ctx->pending_len == 0) {
+		return false;
+	}
+	if (!crc_acquire(ctx)) {
+		crc_sw_update(ctx, ctx->carry, ctx->carry_len);
+		ctx->carry_len = 0;
+		crc_sw_update(ctx, ctx->pending, ctx->pending_len);
+		ctx->pending_len = 0;
+		return false;
+	}
+#ifdef CRC_POL
+	if (crc_dma && ctx->pending_len >= CRC_DMA_THRESHOLD) {
+		crc_dma_start(ctx->pending, ctx->pending_len > 0xFFFF ?
+			      0xFFFF : ctx->pending_len);
+		return true;
+	}
+#endif
+	crc_hw_update(ctx, ctx->pending, ctx->pending_len);
+	ctx->pending_len = 0;
+	return false;
+}
+
+void crc_context_init(struct crc_context *ctx, const struct crc_params *params)
+{
+	uint32_t poly = params->poly << (32 - params->width);
+	uint32_t t;
+	int i, j;
+
+	ctx->params = params;
+	ctx->reg = params->init & crc_mask(params->width);
+	ctx->pending_len = 0;
+	ctx->carry_len = 0;
+	for (i = 0; i < 16; i++) {
+		t = (uint32_t)i << 28;
+		for (j = 0; j < 4; j++) {
+			t = (t & 0x80000000) ? (t << 1) ^ poly : t << 1;
+		}
+		ctx->table[i] = t;
+	}
+}
+
+void crc_context_update(struct crc_context *ctx, const void *data,
+			uint32_t len)
+{
+	while (crc_pump(ctx));
+	ctx->pending = data;
+	ctx->pending_len = len;
+	crc_pump(ctx);
+}
+
+bool crc_context_busy(struct crc_context *ctx)
+{
+	return crc_pump(ctx);
+}
+
+uint32_t crc_context_final(struct crc_context *ctx)
+{
+	const struct crc_params *p = ctx->params;
+	uint32_t reg;
+
+	while (crc_pump(ctx));
+	if (crc_owner == ctx) {
+		crc_release();
+	}
+	crc_sw_update(ctx, ctx->carry, ctx->carry_len);
+	ctx->carry_len = 0;
+
+	reg = ctx->reg;
+	if (p->refout) {
+		reg = crc_reflect(reg, p->width);
+	}
+	return (reg ^ p->xorout) & crc_mask(p->width);
+}
+
+uint32_t crc_compute(const struct crc_params *params, const void *data,
+		     uint32_t len)
+{
+	struct crc_context ctx;
+
+	crc_context_init(&ctx, params);
+	crc_context_update(&ctx, data, len);
+	return crc_context_final(&ctx);
+}
 /**@}*/
 
@@ -32,10 +32,22 @@
 
 /**@{*/
 
+#include <stddef.h>
 #include <libopencm3/stm32/crypto.h>
+#include <libopencm3/stm32/dma.h>
 
 #define CRYP_CR_ALGOMODE_MASK	((1 << 19) | CRYP_CR_ALGOMODE)
 
+/* Largest DMA transfer that is a whole number of 128 bit blocks */
+#define CRYPTO_DMA_MAX_WORDS	0xFFFC
+
+static const struct crypto_dma_chunk *crypto_dma_chunks;
+static uint32_t crypto_dma_count;
+static uint32_t crypto_dma_offset;
+static uint32_t crypto_dma_length;
+static crypto_dma_callback crypto_dma_cb;
+static volatile bool crypto_dma_running;
+
 /**
  * @brief Wait, if the Controller is busy
  */
@@ -172,4 +184,179 @@ uint32_t crypto_process_block(uint32_t *inp, uint32_t *outp, uint32_t length)
 	return wr;
 }
 
+static void crypto_dma_setup_stream(uint8_t stream, uint32_t direction,
+				    uint32_t periph, uint32_t mem,
+				    uint16_t length)
+{
+	dma_stream_reset(CRYPTO_DMA, stream);
+	dma_channel_select(CRYPTO_DMA, stream, CRYPTO_DMA_CHANNEL);
+	dma_set_transfer_mode(CRYPTO_DMA, stream, direction);
+	dma_set_priority(CRYPTO_DMA, stream, DMA_SxCR_PL_HIGH);
+	dma_set_peripheral_size(CRYPTO_DMA, stream, DMA_SxCR_PSIZE_32BIT);
+	dma_set_memory_size(CRYPTO_DMA, stream, DMA_SxCR_MSIZE_32BIT);
+	dma_enable_memory_increment_mode(CRYPTO_DMA, stream);
+	dma_set_peripheral_address(CRYPTO_DMA, stream, periph);
+	dma_set_memory_address(CRYPTO_DMA, stream, mem);
+	dma_set_number_of_data(CRYPTO_DMA, stream, length);
+	dma_enable_transfer_error_interrupt(CRYPTO_DMA, stream);
+}
+
+/* Start the next piece of the current chunk, pieces fit in one transfer. */
+static void crypto_dma_next(void)
+{
+	const struct crypto_dma_chunk *chunk = crypto_dma_chunks;
+
+	crypto_dma_length = chunk->length - crypto_dma_offset;
+	if (crypto_dma_length > CRYPTO_DMA_MAX_WORDS) {
+		crypto_dma_length = CRYPTO_DMA_MAX_WORDS;
+	}
+
+	/* The output stream is armed first so no result is ever missed. */
+	crypto_dma_setup_stream(CRYPTO_DMA_OUT_STREAM,
+				DMA_SxCR_DIR_PERIPHERAL_TO_MEM,
+				(uint32_t)&CRYP_DOUT,
+				(uint32_t)(chunk->outp + crypto_dma_offset),
+				crypto_dma_length);
+	dma_enable_transfer_complete_interrupt(CRYPTO_DMA,
+					       CRYPTO_DMA_OUT_STREAM);
+	dma_enable_stream(CRYPTO_DMA, CRYPTO_DMA_OUT_STREAM);
+
+	crypto_dma_setup_stream(CRYPTO_DMA_IN_STREAM,
+				DMA_SxCR_DIR_MEM_TO_PERIPHERAL,
+				(uint32_t)&CRYP_DIN,
+				(uint32_t)(chunk->inp + crypto_dma_offset),
+				crypto_dma_length);
+	dma_enable_stream(CRYPTO_DMA, CRYPTO_DMA_IN_STREAM);
+}
+
+static void crypto_dma_finish(bool success)
+{
+	CRYP_DMACR = 0;
+	dma_disable_stream(CRYPTO_DMA, CRYPTO_DMA_IN_STREAM);
+	dma_disable_stream(CRYPTO_DMA, CRYPTO_DMA_OUT_STREAM);
+	crypto_dma_running = false;
+
+	if (crypto_dma_cb) {
+		crypto_dma_cb(success);
+	}
+}
+
+/**
+ * @brief Start of encryption or decryption of a chunked message by DMA
+ *
+ * This non-blocking method streams every chunk through the cryptographic
+ * coprocessor with DMA2, one after the other, so the chaining state (IV,
+ * counter) carries over from chunk to chunk as for a single buffer. The
+ * controller has to be set up and started as for
+ * @ref crypto_process_block. Chunk list and buffers must stay valid until
+ * completion. Chunks longer than one DMA transfer are split automatically.
+ *
+ * @param[in] chunks const struct crypto_dma_chunk* List of chunks.
+ * @param[in] count uint32_t Number of chunks.
+ * @param[in] callback crypto_dma_callback Completion callback, may be NULL.
+ *
+ * @returns bool false if a DMA operation is still running
+ */
+bool crypto_dma_start(const struct crypto_dma_chunk *chunks, uint32_t count,
+		      crypto_dma_callback callback)
+{
+	if (crypto_dma_running) {
+		return false;
+	}
+
+	/* Skip empty chunks */
+	while (count && (chunks->length == 0)) {
+		chunks++;
+		count--;
+	}
+
+	crypto_dma_cb = callback;
+	if (count == 0) {
+		if (callback) {
+			callback(true);
+		}
+		return true;
+	}
+
+	crypto_dma_chunks = chunks;
+	crypto_dma_count = count;
+	crypto_dma_offset = 0;
+	crypto_dma_running = true;
+
+	crypto_dma_next();
+	CRYP_DMACR = CRYP_DMACR_DIEN | CRYP_DMACR_DOEN;
+
+	return true;
+}
+
+/**
+ * @brief Check if a DMA operation is still running
+ *
+ * @returns bool true until the last chunk has been written out
+ */
+bool crypto_dma_busy(void)
+{
+	return crypto_dma_running;
+}
+
+/**
+ * @brief Abort a running DMA operation
+ *
+ * The completion callback is not called. The controller FIFOs have to be
+ * flushed by @ref crypto_set_algorithm before the next operation.
+ */
+void crypto_dma_abort(void)
+{
+	crypto_dma_cb = NULL;
+	crypto_dma_finish(false);
+}
+
+/**
+ * @brief Process the DMA stream interrupts
+ *
+ * To be called from both dma2_stream5_isr() and dma2_stream6_isr(), or
+ * polled. Both streams interrupt on a transfer error, the output stream
+ * also on completion. Starts the next piece or chunk of the message, and
+ * reports completion or errors.
+ */
+void crypto_dma_irq_handler(void)
+{
+	if (dma_get_interrupt_flag(CRYPTO_DMA, CRYPTO_DMA_IN_STREAM,
+				   DMA_TEIF) ||
+	    dma_get_interrupt_flag(CRYPTO_DMA, CRYPTO_DMA_OUT_STREAM,
+				   DMA_TEIF)) {
+		dma_clear_interrupt_flags(CRYPTO_DMA, CRYPTO_DMA_IN_STREAM,
+					  DMA_TEIF);
+		dma_clear_interrupt_flags(CRYPTO_DMA, CRYPTO_DMA_OUT_STREAM,
+					  DMA_TEIF);
+		crypto_dma_finish(false);
+		return;
+	}
+
+	if (!dma_get_interrupt_flag(CRYPTO_DMA, CRYPTO_DMA_OUT_STREAM,
+				    DMA_TCIF)) {
+		return;
+	}
+	dma_clear_interrupt_flags(CRYPTO_DMA, CRYPTO_DMA_OUT_STREAM, DMA_TCIF);
+
+	if (!crypto_dma_running) {
+		return;
+	}
+
+	crypto_dma_offset += crypto_dma_length;
+	if (crypto_dma_offset == crypto_dma_chunks->length) {
+		crypto_dma_offset = 0;
+		do {
+			crypto_dma_chunks++;
+			crypto_dma_count--;
+		} while (crypto_dma_count && (crypto_dma_chunks->length == 0));
+	}
+
+	if (crypto_dma_count) {
+		crypto_dma_next();
+	} else {
+		crypto_dma_finish(true);
+	}
+}
+
 /**@}*/
@@ -26,8 +26,294 @@
  * along with this library.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <libopencm3/stm32/common/dma2d_common_f47.h>
+#include <stddef.h>
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/dma2d.h>
 
 /**@{*/
 
+#define DMA2D_CR_IRQS		(DMA2D_CR_CEIE | DMA2D_CR_CTCIE | \
+				 DMA2D_CR_CAEIE | DMA2D_CR_TCIE | DMA2D_CR_TEIE)
+#define DMA2D_ISR_ERRORS	(DMA2D_ISR_CEIF | DMA2D_ISR_CAEIF | \
+				 DMA2D_ISR_TEIF)
+
+/* Bits per pixel, by DMA2D_xPFCCR_CM_* */
+static const uint8_t dma2d_bpp[] = {
+	32, 24, 16, 16, 16, 8, 8, 16, 4, 8, 4,
+};
+
+static struct dma2d_op *dma2d_head;
+static struct dma2d_op *dma2d_tail;
+
+/* What the running operation does next: load the foreground CLUT, the
+ * background CLUT, then transfer. */
+enum dma2d_stage {
+	DMA2D_STAGE_FG_CLUT,
+	DMA2D_STAGE_BG_CLUT,
+	DMA2D_STAGE_TRANSFER,
+};
+static enum dma2d_stage dma2d_stage;
+
+static uint32_t dma2d_address(const struct dma2d_surface *s,
+			      uint16_t x, uint16_t y)
+{
+	uint32_t pixel = (uint32_t)y * s->width + x;
+
+	return (uint32_t)s->pixels + pixel * dma2d_bpp[s->format] / 8;
+}
+
+/* Input side of a layer, the PFCCR gets its alpha settings from the
+ * caller. */
+static void dma2d_input(const struct dma2d_surface *s, uint16_t x,
+			uint16_t y, uint16_t w, uint32_t *mar, uint32_t *off,
+			uint32_t *pfccr, uint32_t *colr, uint32_t *cmar)
+{
+	*mar = dma2d_address(s, x, y);
+	*off = s->width - w;
+	*pfccr = s->format << DMA2D_xPFCCR_CM_SHIFT;
+	*colr = s->color;
+	*cmar = 0;
+	if (s->format == DMA2D_xPFCCR_CM_L8 ||
+	    s->format == DMA2D_xPFCCR_CM_L4) {
+		*pfccr |= DMA2D_xPFCCR_CCM_ARGB8888 |
+			  ((s->clut_len - 1) << DMA2D_xPFCCR_CS_SHIFT);
+		*cmar = (uint32_t)s->clut;
+	}
+}
+
+static void dma2d_output(struct dma2d_op *op, uint32_t mode,
+			 const struct dma2d_surface *dst, uint16_t x,
+			 uint16_t y, uint16_t w, uint16_t h)
+{
+	op->cr = (mode << DMA2D_CR_MODE_SHIFT) | DMA2D_CR_IRQS;
+	op->opfccr = dst->format << DMA2D_OPFCCR_CM_SHIFT;
+	op->omar = dma2d_address(dst, x, y);
+	op->oor = dst->width - w;
+	op->nlr = ((uint32_t)w << DMA2D_NLR_PL_SHIFT) |
+		  (h << DMA2D_NLR_NL_SHIFT);
+}
+
+/* Kick off the next stage of the running operation. The CLUT loads end with
+ * CTCIF, the transfer with TCIF. */
+static void dma2d_step(struct dma2d_op *op)
+{
+	if (dma2d_stage == DMA2D_STAGE_FG_CLUT) {
+		dma2d_stage = DMA2D_STAGE_BG_CLUT;
+		if (op->fgcmar) {
+			DMA2D_FGPFCCR |= DMA2D_xPFCCR_START;
+			return;
+		}
+	}
+	if (dma2d_stage == DMA2D_STAGE_BG_CLUT) {
+		dma2d_stage = DMA2D_STAGE_TRANSFER;
+		if (op->bgcmar) {
+			DMA2D_BGPFCCR |= DMA2D_xPFCCR_START;
+			return;
+		}
+	}
+	DMA2D_CR |= DMA2D_CR_START;
+}
+
+static void dma2d_start(struct dma2d_op *op)
+{
+	DMA2D_CR = op->cr;
+	DMA2D_FGMAR = op->fgmar;
+	DMA2D_FGOR = op->fgor;
+	DMA2D_FGPFCCR = op->fgpfccr;
+	DMA2D_FGCOLR = op->fgcolr;
+	DMA2D_FGCMAR = op->fgcmar;
+	DMA2D_BGMAR = op->bgmar;
+	DMA2D_BGOR = op->bgor;
+	DMA2D_BGPFCCR = op->bgpfccr;
+	DMA2D_BGCOLR = op->bgcolr;
+	DMA2D_BGCMAR = op->bgcmar;
+	DMA2D_OPFCCR = op->opfccr;
+	DMA2D_OCOLR = op->ocolr;
+	DMA2D_OMAR = op->omar;
+	DMA2D_OOR = op->oor;
+	DMA2D_NLR = op->nlr;
+
+	dma2d_stage = DMA2D_STAGE_FG_CLUT;
+	dma2d_step(op);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DMA2D Prepare a Fill.
+
+Fills a rectangle with one colour.
+
+@param[out] op Operation to prepare, the callback is kept
+@param[in] dst Surface to draw on
+@param[in] x Left edge
+@param[in] y Top edge
+@param[in] w Width in pixels
+@param[in] h Height in lines
+@param[in] color Colour in the format of @a dst
+*/
+
+void dma2d_op_fill(struct dma2d_op *op, const struct dma2d_surface *dst,
+		   uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+		   uint32_t color)
+{
+	dma2d_output(op, DMA2D_CR_MODE_R2M, dst, x, y, w, h);
+	op->ocolr = color;
+	op->fgmar = op->fgor = op->fgpfccr = op->fgcolr = op->fgcmar = 0;
+	op->bgmar = op->bgor = op->bgpfccr = op->bgcolr = op->bgcmar = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DMA2D Prepare a Copy.
+
+Copies a rectangle, converting the pixels if the surfaces differ in format.
+
+@param[out] op Operation to prepare, the callback is kept
+@param[in] dst Surface to draw on
+@param[in] x Left edge on @a dst
+@param[in] y Top edge on @a dst
+@param[in] src Surface to copy from
+@param[in] sx Left edge on @a src
+@param[in] sy Top edge on @a src
+@param[in] w Width in pixels
+@param[in] h Height in lines
+*/
+
+void dma2d_op_copy(struct dma2d_op *op,
+		   const struct dma2d_surface *dst, uint16_t x, uint16_t y,
+		   const struct dma2d_surface *src, uint16_t sx, uint16_t sy,
+		   uint16_t w, uint16_t h)
+{
+	dma2d_output(op, src->format == dst->format ? DMA2D_CR_MODE_M2M :
+						      DMA2D_CR_MODE_M2MWPFC,
+		     dst, x, y, w, h);
+	op->ocolr = 0;
+	dma2d_input(src, sx, sy, w, &op->fgmar, &op->fgor, &op->fgpfccr,
+		    &op->fgcolr, &op->fgcmar);
+	op->bgmar = op->bgor = op->bgpfccr = op->bgcolr = op->bgcmar = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DMA2D Prepare a Blend.
+
+Draws a foreground rectangle over a background one by the foreground alpha,
+scaled by @a alpha, into the destination. The background may be the
+destination itself.
+
+@param[out] op Operation to prepare, the callback is kept
+@param[in] dst Surface to draw on
+@param[in] x Left edge on @a dst
+@param[in] y Top edge on @a dst
+@param[in] fg Foreground surface
+@param[in] fx Left edge on @a fg
+@param[in] fy Top edge on @a fg
+@param[in] alpha Foreground opacity, 255 for the pixel alpha as it is
+@param[in] bg Background surface
+@param[in] bx Left edge on @a bg
+@param[in] by Top edge on @a bg
+@param[in] w Width in pixels
+@param[in] h Height in lines
+*/
+
+void dma2d_op_blend(struct dma2d_op *op,
+		    const struct dma2d_surface *dst, uint16_t x, uint16_t y,
+		    const struct dma2d_surface *fg, uint16_t fx, uint16_t fy,
+		    uint8_t alpha,
+		    const struct dma2d_surface *bg, uint16_t bx, uint16_t by,
+		    uint16_t w, uint16_t h)
+{
+	dma2d_output(op, DMA2D_CR_MODE_M2MWB, dst, x, y, w, h);
+	op->ocolr = 0;
+	dma2d_input(fg, fx, fy, w, &op->fgmar, &op->fgor, &op->fgpfccr,
+		    &op->fgcolr, &op->fgcmar);
+	if (alpha != 0xff) {
+		op->fgpfccr |= (DMA2D_xPFCCR_AM_PRODUCT <<
+				DMA2D_xPFCCR_AM_SHIFT) |
+			       ((uint32_t)alpha << DMA2D_xPFCCR_ALPHA_SHIFT);
+	}
+	dma2d_input(bg, bx, by, w, &op->bgmar, &op->bgor, &op->bgpfccr,
+		    &op->bgcolr, &op->bgcmar);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DMA2D Submit an Operation.
+
+The operation starts at once if the DMA2D is idle, otherwise when the ones
+before it are done. It and the CLUTs it uses must not be changed until its
+callback.
+
+@param[in] op Prepared operation
+*/
+
+void dma2d_submit(struct dma2d_op *op)
+{
+	bool idle;
+
+	op->next = NULL;
+	CM_ATOMIC_BLOCK() {
+		idle = dma2d_head == NULL;
+		if (idle) {
+			dma2d_head = op;
+		} else {
+			dma2d_tail->next = op;
+		}
+		dma2d_tail = op;
+	}
+
+	if (idle) {
+		dma2d_start(op);
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DMA2D Busy.
+
+@returns true while operations are queued or running
+*/
+
+bool dma2d_busy(void)
+{
+	return dma2d_head != NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief DMA2D Interrupt Handler.
+
+Call from dma2d_isr(). Moves the running operation on, and when it is over
+starts the next one and then calls the completion callback.
+*/
+
+void dma2d_irq_handler(void)
+{
+	struct dma2d_op *op = dma2d_head;
+	uint32_t isr = DMA2D_ISR;
+
+	DMA2D_IFCR = isr;
+	if (!op) {
+		return;
+	}
+
+	if (!(isr & DMA2D_ISR_ERRORS)) {
+		if (isr & DMA2D_ISR_CTCIF) {
+			dma2d_step(op);
+			return;
+		}
+		if (!(isr & DMA2D_ISR_TCIF)) {
+			return;
+		}
+	}
+
+	CM_ATOMIC_BLOCK() {
+		dma2d_head = op->next;
+		if (!dma2d_head) {
+			dma2d_tail = NULL;
+		}
+	}
+	if (dma2d_head) {
+		dma2d_start(dma2d_head);
+	}
+
+	if (op->callback) {
+		op->callback(op, !(isr & DMA2D_ISR_ERRORS));
+	}
+}
+
 /**@}*/
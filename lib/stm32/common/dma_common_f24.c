@@ -806,5 +806,44 @@ void dma_set_number_of_data(uint32_t dma, uint8_t stream, uint16_t number)
 {
 	DMA_SNDTR(dma, stream) = number;
 }
-/**@}*/
+/*---------------------------------------------------------------------------*/
+/** @brief DMA Stream Start Clearing Memory
+
+Starts a memory to memory transfer that clears a block of words. The first word
+is cleared by the CPU and is the source of the transfer for the others, so the
+function uses no static data and can run before it is set up, as in
+reset_dma_clear(). The stream is busy until it is disabled again by the
+hardware, with the transfer complete flag set.
+
+@note Only DMA2 can do memory to memory transfers.
+
+@param[in] dma unsigned int32. DMA controller base address: DMA2
+@param[in] stream unsigned int8. Stream number: @ref dma_st_number
+@param[in] dest Word aligned start of the block
+@param[in] words unsigned int32. Number of words to clear (65536 maximum).
+*/
 
+void dma_start_mem_clear(uint32_t dma, uint8_t stream, uint32_t *dest,
+			 uint32_t words)
+{
+	DMA_SCR(dma, stream) = 0;
+	while (DMA_SCR(dma, stream) & DMA_SxCR_EN);
+	dma_clear_interrupt_flags(dma, stream, DMA_TCIF | DMA_HTIF | DMA_TEIF |
+				  DMA_DMEIF | DMA_FEIF);
+	if (!words) {
+		return;
+	}
+	*dest = 0;
+	if (words == 1) {
+		return;
+	}
+	DMA_SPAR(dma, stream) = dest;
+	DMA_SM0AR(dma, stream) = dest + 1;
+	DMA_SNDTR(dma, stream) = words - 1;
+	/* No direct mode from memory to memory */
+	DMA_SFCR(dma, stream) = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH_4_4_FULL;
+	DMA_SCR(dma, stream) = DMA_SxCR_DIR_MEM_TO_MEM | DMA_SxCR_MINC |
+			       DMA_SxCR_PSIZE_32BIT | DMA_SxCR_MSIZE_32BIT |
+			       DMA_SxCR_EN;
+}
+/**@}*/
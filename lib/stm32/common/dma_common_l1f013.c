@@ -447,5 +447,39 @@ void dma_set_number_of_data(uint32_t dma, uint8_t channel, uint16_t number)
 {
 	DMA_CNDTR(dma, channel) = number;
 }
-/**@}*/
+/*---------------------------------------------------------------------------*/
+/** @brief DMA Channel Start Clearing Memory
+
+Starts a memory to memory transfer that clears a block of words. The first word
+is cleared by the CPU and is the source of the transfer for the others, so the
+function uses no static data and can run before it is set up, as in
+reset_dma_clear(). The channel is busy until it is disabled again by the
+hardware, with the transfer complete flag set.
+
+@param[in] dma unsigned int32. DMA controller base address: DMA1 or DMA2
+@param[in] channel unsigned int8. Channel number: 1-7 for DMA1 or 1-5 for DMA2
+@param[in] dest Word aligned start of the block
+@param[in] words unsigned int32. Number of words to clear (65536 maximum).
+*/
 
+void dma_start_mem_clear(uint32_t dma, uint8_t channel, uint32_t *dest,
+			 uint32_t words)
+{
+	DMA_CCR(dma, channel) = 0;
+	dma_clear_interrupt_flags(dma, channel, DMA_TCIF | DMA_HTIF | DMA_TEIF |
+				  DMA_GIF);
+	if (!words) {
+		return;
+	}
+	MMIO32(dest) = 0;
+	if (words == 1) {
+		return;
+	}
+	DMA_CPAR(dma, channel) = (uint32_t)dest;
+	DMA_CMAR(dma, channel) = (uint32_t)(dest + 1);
+	DMA_CNDTR(dma, channel) = words - 1;
+	DMA_CCR(dma, channel) = DMA_CCR_MEM2MEM | DMA_CCR_MINC |
+				DMA_CCR_PSIZE_32BIT | DMA_CCR_MSIZE_32BIT |
+				DMA_CCR_EN;
+}
+/**@}*/
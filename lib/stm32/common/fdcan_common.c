@@ -629,17 +629,72 @@ void fdcan_release_fifo(uint32_t canport, uint8_t fifo_id)
 {
 	unsigned pending_frames, get_index;
 
-	get_index = (FDCAN_RXFIS(canport, fifo_id) >> FDCAN_RXFIFO_GI_SHIFT)
-		& FDCAN_RXFIFO_GI_SHIFT;
-
-	pending_frames = (FDCAN_RXFIS(canport, fifo_id) >> FDCAN_RXFIFO_FL_SHIFT)
-		& FDCAN_RXFIFO_FL_SHIFT;
+	fdcan_get_fill_rxfifo(canport, fifo_id, &get_index, &pending_frames);
 
 	if (pending_frames) {
-		FDCAN_RXFIA(canport, fifo_id) |= get_index << FDCAN_RXFIFO_AI_SHIFT;
+		FDCAN_RXFIA(canport, fifo_id) = get_index << FDCAN_RXFIFO_AI_SHIFT;
 	}
 }
 
+/** Return oldest frame of receive FIFO in message RAM.
+ *
+ * Gives access to the oldest frame of receive FIFO without copying it out of
+ * message RAM. Frame stays in FIFO and pointer stays valid until it is
+ * released using @ref fdcan_release_fifo. Message RAM should be read in
+ * 32 bit words.
+ *
+ * @param [in] canport FDCAN block base address. See @ref fdcan_block.
+ * @param [in] fifo_id ID of FIFO (0 or 1)
+ * @returns Pointer to FIFO element, NULL if FIFO is empty.
+ */
+const struct fdcan_rx_fifo_element *fdcan_rx_peek(uint32_t canport,
+		uint8_t fifo_id)
+{
+	unsigned pending_frames, get_index;
+
+	fdcan_get_fill_rxfifo(canport, fifo_id, &get_index, &pending_frames);
+
+	if (pending_frames == 0) {
+		return NULL;
+	}
+
+	return fdcan_get_rxfifo_addr(canport, fifo_id, get_index);
+}
+
+/** Return ID of received frame.
+ *
+ * @param [in] element FIFO element, see @ref fdcan_rx_peek.
+ * @param [out] ext Set to true if ID is extended. Optional.
+ * @returns Standard or extended frame ID.
+ */
+uint32_t fdcan_rx_element_id(const struct fdcan_rx_fifo_element *element,
+		bool *ext)
+{
+	bool xtd = (element->identifier_flags & FDCAN_FIFO_XTD) == FDCAN_FIFO_XTD;
+
+	if (ext) {
+		*ext = xtd;
+	}
+
+	if (xtd) {
+		return (element->identifier_flags >> FDCAN_FIFO_EID_SHIFT)
+			& FDCAN_FIFO_EID_MASK;
+	}
+	return (element->identifier_flags >> FDCAN_FIFO_SID_SHIFT)
+		& FDCAN_FIFO_SID_MASK;
+}
+
+/** Return payload length of received frame.
+ *
+ * @param [in] element FIFO element, see @ref fdcan_rx_peek.
+ * @returns Frame payload length in bytes.
+ */
+uint8_t fdcan_rx_element_length(const struct fdcan_rx_fifo_element *element)
+{
+	return fdcan_dlc_to_length((element->filt_fmt_dlc_ts >> FDCAN_FIFO_DLC_SHIFT)
+			& FDCAN_FIFO_DLC_MASK);
+}
+
 /** Enable IRQ from FDCAN block.
  *
  * This routine configures FDCAN to enable certain IRQ.
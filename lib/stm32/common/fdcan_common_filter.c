@@ -0,0 +1,343 @@
+/** @addtogroup fdcan_file
+ *
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+#include <stddef.h>
+#include <libopencm3/stm32/fdcan.h>
+
+/* A range of IDs. The group is the FIFO times two, plus one for extended
+ * IDs. A merged range holds IDs that were not asked for. */
+struct fdcan_filter_entry {
+	uint32_t first;
+	uint32_t last;
+	uint8_t group;
+	bool merged;
+};
+
+static struct {
+	struct fdcan_filter_entry entry[FDCAN_FILTER_MAX_ENTRIES];
+	uint32_t count;
+	/* Entries of each group, single IDs and ranges */
+	uint32_t kind[4][2];
+	bool exact;
+} fdcan_filter;
+
+static bool fdcan_filter_is_range(const struct fdcan_filter_entry *e)
+{
+	return e->first != e->last;
+}
+
+/* Elements needed for standard (ext = 0) or extended (ext = 1) IDs: a range
+ * element for each range, a dual ID element for each two single IDs */
+static uint32_t fdcan_filter_elements(uint32_t kind[4][2], uint8_t ext)
+{
+	return kind[ext][1] + (kind[ext][0] + 1) / 2
+		+ kind[2 + ext][1] + (kind[2 + ext][0] + 1) / 2;
+}
+
+static uint32_t fdcan_filter_overflow(uint32_t kind[4][2], uint8_t ext)
+{
+	uint32_t elements = fdcan_filter_elements(kind, ext);
+	uint32_t max = ext ? FDCAN_FILTER_EXT_ELEMENTS
+		: FDCAN_FILTER_STD_ELEMENTS;
+
+	return elements > max ? elements - max : 0;
+}
+
+static void fdcan_filter_count(void)
+{
+	const struct fdcan_filter_entry *e;
+	uint32_t i;
+
+	for (i = 0; i < 4; i++) {
+		fdcan_filter.kind[i][0] = 0;
+		fdcan_filter.kind[i][1] = 0;
+	}
+	for (i = 0; i < fdcan_filter.count; i++) {
+		e = &fdcan_filter.entry[i];
+		fdcan_filter.kind[e->group][fdcan_filter_is_range(e)]++;
+	}
+}
+
+static void fdcan_filter_remove(uint32_t i)
+{
+	fdcan_filter.entry[i] = fdcan_filter.entry[--fdcan_filter.count];
+}
+
+/* Joins the entries of a group that overlap or touch the given one into it */
+static void fdcan_filter_join(uint32_t at)
+{
+	struct fdcan_filter_entry *e = &fdcan_filter.entry[at];
+	struct fdcan_filter_entry *o;
+	uint32_t i = 0;
+
+	while (i < fdcan_filter.count) {
+		o = &fdcan_filter.entry[i];
+		if (i == at || o->group != e->group ||
+		    o->first > e->last + 1 || e->first > o->last + 1) {
+			i++;
+			continue;
+		}
+		if (o->first < e->first) {
+			e->first = o->first;
+		}
+		if (o->last > e->last) {
+			e->last = o->last;
+		}
+		e->merged |= o->merged;
+		fdcan_filter_remove(i);
+		if (at == fdcan_filter.count) {
+			at = i;
+			e = &fdcan_filter.entry[at];
+		}
+		/* It grew, entries passed may touch it now */
+		i = 0;
+	}
+}
+
+/* Merges the two entries of a group, of standard or extended IDs, or of any
+ * if ext is negative, that save the most elements, and of those the two
+ * with the smallest gap in between. Returns false if there are no two
+ * entries of a group left. */
+static bool fdcan_filter_merge(int ext)
+{
+	struct fdcan_filter_entry *a, *b;
+	struct fdcan_filter_entry m, best_m = { 0, 0, 0, false };
+	uint32_t kind[4][2];
+	uint32_t elements = 0, best_elements = 0xFFFFFFFF;
+	int64_t cost, best_cost = 0;
+	uint32_t i, j, k, best_i = 0, best_j = 0;
+
+	for (i = 0; i < fdcan_filter.count; i++) {
+		for (j = i + 1; j < fdcan_filter.count; j++) {
+			a = &fdcan_filter.entry[i];
+			b = &fdcan_filter.entry[j];
+			if (a->group != b->group ||
+			    (ext >= 0 && (a->group & 1) != ext)) {
+				continue;
+			}
+
+			m.group = a->group;
+			m.first = a->first < b->first ? a->first : b->first;
+			m.last = a->last > b->last ? a->last : b->last;
+			cost = (int64_t)(m.last - m.first)
+				- (a->last - a->first) - (b->last - b->first) - 1;
+			m.merged = cost > 0 || a->merged || b->merged;
+
+			if (ext >= 0) {
+				for (k = 0; k < 4; k++) {
+					kind[k][0] = fdcan_filter.kind[k][0];
+					kind[k][1] = fdcan_filter.kind[k][1];
+				}
+				kind[a->group][fdcan_filter_is_range(a)]--;
+				kind[b->group][fdcan_filter_is_range(b)]--;
+				kind[m.group][1]++;
+				elements = fdcan_filter_elements(kind, ext);
+			}
+
+			if (elements < best_elements ||
+			    (elements == best_elements && cost < best_cost)) {
+				best_elements = elements;
+				best_cost = cost;
+				best_m = m;
+				best_i = i;
+				best_j = j;
+			}
+		}
+	}
+
+	if (best_elements == 0xFFFFFFFF) {
+		return false;
+	}
+
+	if (best_cost > 0) {
+		fdcan_filter.exact = false;
+	}
+	fdcan_filter.entry[best_i] = best_m;
+	fdcan_filter_remove(best_j);
+	fdcan_filter_join(best_i);
+	fdcan_filter_count();
+	return true;
+}
+
+static void fdcan_filter_add(uint32_t first, uint32_t last, uint8_t group)
+{
+	struct fdcan_filter_entry *e;
+
+	if (fdcan_filter.count == FDCAN_FILTER_MAX_ENTRIES) {
+		fdcan_filter_merge(-1);
+	}
+	e = &fdcan_filter.entry[fdcan_filter.count++];
+	e->first = first;
+	e->last = last;
+	e->group = group;
+	e->merged = false;
+	fdcan_filter_join(fdcan_filter.count - 1);
+	fdcan_filter_count();
+}
+
+static bool fdcan_filter_after(const struct fdcan_filter_entry *a,
+			       const struct fdcan_filter_entry *b)
+{
+	if (a->merged != b->merged) {
+		return a->merged;
+	}
+	return a->last - a->first > b->last - b->first;
+}
+
+static void fdcan_filter_set(uint32_t canport, uint8_t ext, uint32_t nr,
+			     uint8_t type, uint32_t id1, uint32_t id2,
+			     uint8_t fifo)
+{
+	if (ext) {
+		fdcan_set_ext_filter(canport, nr,
+			type == FDCAN_SFT_RANGE ? FDCAN_EFT_RANGE_NOXIDAM
+						: FDCAN_EFT_DUAL,
+			id1, id2, fifo ? FDCAN_EFEC_FIFO1 : FDCAN_EFEC_FIFO0);
+	} else {
+		fdcan_set_std_filter(canport, nr, type, id1, id2,
+			fifo ? FDCAN_SFEC_FIFO1 : FDCAN_SFEC_FIFO0);
+	}
+}
+
+/* Programs the elements of standard or extended IDs in the order of the
+ * entries, single IDs paired up ahead of the ranges */
+static void fdcan_filter_program(uint32_t canport, uint8_t ext)
+{
+	const struct fdcan_filter_entry *e;
+	const struct fdcan_filter_entry *pending[2] = { NULL, NULL };
+	uint32_t nr = 0;
+	uint32_t i;
+	uint8_t fifo;
+
+	for (i = 0; i < fdcan_filter.count; i++) {
+		e = &fdcan_filter.entry[i];
+		if ((e->group & 1) != ext) {
+			continue;
+		}
+		fifo = e->group >> 1;
+
+		if (!fdcan_filter_is_range(e)) {
+			if (pending[fifo]) {
+				fdcan_filter_set(canport, ext, nr++,
+						 FDCAN_SFT_DUAL,
+						 pending[fifo]->first,
+						 e->first, fifo);
+				pending[fifo] = NULL;
+			} else {
+				pending[fifo] = e;
+			}
+			continue;
+		}
+
+		for (fifo = 0; fifo < 2; fifo++) {
+			if (pending[fifo]) {
+				fdcan_filter_set(canport, ext, nr++,
+						 FDCAN_SFT_DUAL,
+						 pending[fifo]->first,
+						 pending[fifo]->first, fifo);
+				pending[fifo] = NULL;
+			}
+		}
+		fdcan_filter_set(canport, ext, nr++, FDCAN_SFT_RANGE,
+				 e->first, e->last, e->group >> 1);
+	}
+
+	for (fifo = 0; fifo < 2; fifo++) {
+		if (pending[fifo]) {
+			fdcan_filter_set(canport, ext, nr++, FDCAN_SFT_DUAL,
+					 pending[fifo]->first,
+					 pending[fifo]->first, fifo);
+		}
+	}
+}
+
+/** Set up filters accepting ranges of IDs.
+ *
+ * Replaces all filter rules of the FDCAN block, and sets it to reject frames
+ * which match none of them, as well as all remote frames. Has to be called
+ * while the FDCAN block is in INIT mode, see @ref fdcan_init.
+ *
+ * @param [in] canport FDCAN block base address. See @ref fdcan_block.
+ * @param [in] ranges IDs to accept.
+ * @param [in] count Number of ranges.
+ * @param [out] exact Set to false if more than the ranges is accepted, may
+ *		be NULL.
+ * @returns FDCAN_E_OK, FDCAN_E_INVALID if a range is invalid, or
+ * FDCAN_E_OUTOFRANGE if the ranges do not fit. See @ref fdcan_error.
+ */
+int fdcan_filter_compile(uint32_t canport,
+			 const struct fdcan_filter_range *ranges,
+			 uint32_t count, bool *exact)
+{
+	const struct fdcan_filter_range *r;
+	struct fdcan_filter_entry e;
+	uint32_t width, i, j;
+	uint8_t ext;
+
+	fdcan_filter.count = 0;
+	fdcan_filter.exact = true;
+	fdcan_filter_count();
+
+	for (i = 0; i < count; i++) {
+		r = &ranges[i];
+		ext = (r->flags & FDCAN_MSG_EXT) ? 1 : 0;
+		width = ext ? FDCAN_FIFO_EID_MASK : FDCAN_FIFO_SID_MASK;
+		if (r->fifo > 1 || r->first > r->last || r->last > width) {
+			return FDCAN_E_INVALID;
+		}
+		fdcan_filter_add(r->first, r->last, r->fifo * 2 + ext);
+	}
+
+	for (ext = 0; ext < 2; ext++) {
+		while (fdcan_filter_overflow(fdcan_filter.kind, ext)) {
+			if (!fdcan_filter_merge(ext)) {
+				return FDCAN_E_OUTOFRANGE;
+			}
+		}
+	}
+
+	/* Ranges as asked for ahead of merged ones, shortest first */
+	for (i = 1; i < fdcan_filter.count; i++) {
+		e = fdcan_filter.entry[i];
+		for (j = i; j > 0 && fdcan_filter_after(&fdcan_filter.entry[j - 1],
+							&e); j--) {
+			fdcan_filter.entry[j] = fdcan_filter.entry[j - 1];
+		}
+		fdcan_filter.entry[j] = e;
+	}
+
+	fdcan_init_filter(canport,
+			  fdcan_filter_elements(fdcan_filter.kind, 0),
+			  fdcan_filter_elements(fdcan_filter.kind, 1));
+	fdcan_filter_program(canport, 0);
+	fdcan_filter_program(canport, 1);
+	fdcan_set_global_filter(canport, FDCAN_ANF_REJECT, FDCAN_ANF_REJECT,
+				true, true);
+
+	if (exact) {
+		*exact = fdcan_filter.exact;
+	}
+	return FDCAN_E_OK;
+}
+
+/**@}*/
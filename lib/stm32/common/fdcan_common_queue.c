@@ -0,0 +1,355 @@
+/** @addtogroup fdcan_file
+ *
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+#include <stddef.h>
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/fdcan.h>
+
+#define FDCAN_QUEUE_IRQS	(FDCAN_IE_RF0NE | FDCAN_IE_RF0LE | \
+				 FDCAN_IE_RF1NE | FDCAN_IE_RF1LE | \
+				 FDCAN_IE_TCE | FDCAN_IE_TCFE | \
+				 FDCAN_IE_TEFNE)
+
+/* The message marker of a frame is its buffer index in the low bits, and a
+ * count of the frames sent from that buffer in the bits above, so the event
+ * of a frame is not taken for one sent later from the same buffer */
+#define FDCAN_QUEUE_MM_INDEX	(FDCAN_QUEUE_TX_BUFFERS - 1)
+#define FDCAN_QUEUE_MM_COUNT	(FDCAN_QUEUE_MM_INDEX + 1)
+
+static uint16_t fdcan_queue_now(struct fdcan_queue *queue)
+{
+	return (FDCAN_TSCV(queue->canport) >> FDCAN_TSCV_TSC_SHIFT)
+		& FDCAN_TSCV_TSC_MASK;
+}
+
+/* Arbitration order, a standard ID wins over an extended one with the same
+ * base ID */
+static uint32_t fdcan_queue_priority(const struct fdcan_tx_msg *msg)
+{
+	if (msg->flags & FDCAN_MSG_EXT) {
+		return ((msg->id & FDCAN_FIFO_EID_MASK) << 1) | 1;
+	}
+	return (msg->id & FDCAN_FIFO_SID_MASK) << 19;
+}
+
+/* Moves queued frames into free transmit buffers */
+static void fdcan_queue_feed(struct fdcan_queue *queue)
+{
+	struct fdcan_tx_buffer_element *buffer;
+	struct fdcan_tx_msg *msg;
+	uint32_t canport = queue->canport;
+	uint32_t index;
+	uint32_t q;
+
+	while (queue->head &&
+	       !(FDCAN_TXFQS(canport) & FDCAN_TXFQS_TFQF)) {
+		msg = queue->head;
+		index = (FDCAN_TXFQS(canport) >> FDCAN_TXFQS_TFQPI_SHIFT)
+			& FDCAN_TXFQS_TFQPI_MASK;
+		buffer = fdcan_get_txbuf_addr(canport, index);
+
+		if (msg->flags & FDCAN_MSG_EXT) {
+			buffer->identifier_flags = FDCAN_FIFO_XTD
+				| ((msg->id & FDCAN_FIFO_EID_MASK)
+				   << FDCAN_FIFO_EID_SHIFT);
+		} else {
+			buffer->identifier_flags =
+				(msg->id & FDCAN_FIFO_SID_MASK)
+				<< FDCAN_FIFO_SID_SHIFT;
+		}
+		if (msg->flags & FDCAN_MSG_RTR) {
+			buffer->identifier_flags |= FDCAN_FIFO_RTR;
+		}
+
+		queue->marker[index] = (queue->marker[index]
+					+ FDCAN_QUEUE_MM_COUNT)
+				       & FDCAN_FIFO_MM_MASK;
+		buffer->evt_fmt_dlc_res = (queue->marker[index]
+					   << FDCAN_FIFO_MM_SHIFT)
+			| FDCAN_FIFO_EFC
+			| (fdcan_length_to_dlc(msg->length)
+			   << FDCAN_FIFO_DLC_SHIFT)
+			| ((msg->flags & FDCAN_MSG_FDF) ? FDCAN_FIFO_FDF : 0)
+			| ((msg->flags & FDCAN_MSG_BRS) ? FDCAN_FIFO_BRS : 0);
+
+		for (q = 0; q < msg->length; q += 4) {
+			buffer->data[q / 4] = *(const uint32_t *)&msg->data[q];
+		}
+
+		queue->head = msg->next;
+		queue->sending[index] = msg;
+		queue->pending |= 1 << index;
+		FDCAN_TXBAR(canport) = 1 << index;
+	}
+}
+
+/* Takes the timestamps of sent frames from the transmit event FIFO */
+static void fdcan_queue_tx_events(struct fdcan_queue *queue)
+{
+	const struct fdcan_tx_event_element *event;
+	struct fdcan_tx_msg *msg;
+	uint32_t canport = queue->canport;
+	uint32_t index;
+	uint8_t marker;
+
+	while ((FDCAN_TXEFS(canport) >> FDCAN_TXEFS_EFFL_SHIFT)
+	       & FDCAN_TXEFS_EFFL_MASK) {
+		index = (FDCAN_TXEFS(canport) >> FDCAN_TXEFS_EFGI_SHIFT)
+			& FDCAN_TXEFS_EFGI_MASK;
+		event = fdcan_get_txevt_addr(canport) + index;
+
+		/* Late events of frames already done with are dropped */
+		marker = (event->evt_fmt_dlc_ts >> FDCAN_FIFO_MM_SHIFT)
+			 & FDCAN_FIFO_MM_MASK;
+		msg = queue->sending[marker & FDCAN_QUEUE_MM_INDEX];
+		if (msg && marker ==
+		    queue->marker[marker & FDCAN_QUEUE_MM_INDEX]) {
+			msg->sent_at = (event->evt_fmt_dlc_ts
+					>> FDCAN_FIFO_RXTS_SHIFT)
+				& FDCAN_FIFO_RXTS_MASK;
+			msg->stamped = true;
+		}
+		FDCAN_TXEFA(canport) = index << FDCAN_TXEFA_EFAI_SHIFT;
+	}
+}
+
+/* Ends the frames whose buffers were sent or cancelled */
+static void fdcan_queue_tx_done(struct fdcan_queue *queue)
+{
+	struct fdcan_tx_msg *msg;
+	uint32_t canport = queue->canport;
+	uint32_t sent = FDCAN_TXBTO(canport) & queue->pending;
+	uint32_t failed = FDCAN_TXBCF(canport) & queue->pending & ~sent;
+	uint32_t index;
+
+	for (index = 0; index < FDCAN_QUEUE_TX_BUFFERS; index++) {
+		if (!((sent | failed) & (1 << index))) {
+			continue;
+		}
+		msg = queue->sending[index];
+		queue->sending[index] = NULL;
+		queue->pending &= ~(1 << index);
+
+		if (!msg->stamped) {
+			msg->sent_at = fdcan_queue_now(queue);
+		}
+		if (sent & (1 << index)) {
+			queue->stats.tx_frames++;
+		} else {
+			queue->stats.tx_failed++;
+		}
+		if (msg->callback) {
+			msg->callback(msg, (sent & (1 << index)) != 0);
+		}
+	}
+}
+
+/* Hands the frames of a receive FIFO to their handlers */
+static void fdcan_queue_rx(struct fdcan_queue *queue, uint8_t fifo)
+{
+	const struct fdcan_rx_fifo_element *element;
+	fdcan_rx_handler handler;
+	uint32_t canport = queue->canport;
+	uint32_t filter;
+	bool ext;
+
+	while ((element = fdcan_rx_peek(canport, fifo))) {
+		filter = (element->filt_fmt_dlc_ts >> FDCAN_FIFO_FIDX_SHIFT)
+			& FDCAN_FIFO_FIDX_MASK;
+		ext = (element->identifier_flags & FDCAN_FIFO_XTD) != 0;
+
+		handler = NULL;
+		if (element->filt_fmt_dlc_ts & FDCAN_FIFO_ANMF) {
+			/* Accepted as non-matching frame */
+		} else if (ext && filter < FDCAN_QUEUE_EXT_HANDLERS) {
+			handler = queue->ext_handler[filter];
+		} else if (!ext && filter < FDCAN_QUEUE_STD_HANDLERS) {
+			handler = queue->std_handler[filter];
+		}
+		if (!handler) {
+			handler = queue->default_handler;
+		}
+
+		queue->stats.rx_frames++;
+		if (handler) {
+			handler(queue, fifo, element);
+		}
+		fdcan_release_fifo(canport, fifo);
+	}
+}
+
+/** Set up interrupt driven queues of an FDCAN.
+ *
+ * Enables the timestamp counter, counting bit times, and the interrupts the
+ * queues need on interrupt line 0. Has to be called while the FDCAN block is
+ * in INIT mode, see @ref fdcan_init.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] canport FDCAN block base address. See @ref fdcan_block.
+ */
+void fdcan_queue_init(struct fdcan_queue *queue, uint32_t canport)
+{
+	uint32_t i;
+
+	queue->canport = canport;
+	queue->head = NULL;
+	queue->pending = 0;
+	for (i = 0; i < FDCAN_QUEUE_TX_BUFFERS; i++) {
+		queue->sending[i] = NULL;
+		queue->marker[i] = i;
+	}
+	for (i = 0; i < FDCAN_QUEUE_STD_HANDLERS; i++) {
+		queue->std_handler[i] = NULL;
+	}
+	for (i = 0; i < FDCAN_QUEUE_EXT_HANDLERS; i++) {
+		queue->ext_handler[i] = NULL;
+	}
+	queue->default_handler = NULL;
+	queue->stats.tx_frames = 0;
+	queue->stats.tx_failed = 0;
+	queue->stats.rx_frames = 0;
+	queue->stats.rx_lost = 0;
+
+	/* TSS = 1, internal counter */
+	FDCAN_TSCC(canport) = 1 << FDCAN_TSCC_TSS_SHIFT;
+
+	FDCAN_TXBTIE(canport) = 0xffffffff;
+	FDCAN_TXBCIE(canport) = 0xffffffff;
+	FDCAN_ILS(canport) = 0;
+	FDCAN_IR(canport) = FDCAN_QUEUE_IRQS;
+	FDCAN_IE(canport) |= FDCAN_QUEUE_IRQS;
+	fdcan_enable_irq(canport, FDCAN_ILE_INT0);
+}
+
+/** Register handler for frames accepted by a filter.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] ext true for an extended ID filter, false for a standard one.
+ * @param [in] filter Number of the filter, as passed to
+ *		@ref fdcan_set_std_filter or @ref fdcan_set_ext_filter.
+ * @param [in] handler Frame handler, NULL to use the default handler.
+ */
+void fdcan_queue_set_rx_handler(struct fdcan_queue *queue, bool ext,
+				uint8_t filter, fdcan_rx_handler handler)
+{
+	if (ext && filter < FDCAN_QUEUE_EXT_HANDLERS) {
+		queue->ext_handler[filter] = handler;
+	} else if (!ext && filter < FDCAN_QUEUE_STD_HANDLERS) {
+		queue->std_handler[filter] = handler;
+	}
+}
+
+/** Register handler for frames without a filter handler.
+ *
+ * Gets frames accepted as non-matching and frames of filters, which have no
+ * handler registered. Frames are dropped, if there is no default handler.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] handler Frame handler, or NULL.
+ */
+void fdcan_queue_set_default_handler(struct fdcan_queue *queue,
+				     fdcan_rx_handler handler)
+{
+	queue->default_handler = handler;
+}
+
+/** Queue frame for transmission.
+ *
+ * Frame is queued behind frames of the same or higher priority and sent
+ * once transmit buffer becomes free. Frame must not be changed until its
+ * callback has been called.
+ *
+ * @param [in] queue Queue state.
+ * @param [in] msg Frame to be sent.
+ * @returns FDCAN_E_OK, or FDCAN_E_INVALID if length is not a valid frame
+ * length. See @ref fdcan_error.
+ */
+int fdcan_queue_submit(struct fdcan_queue *queue, struct fdcan_tx_msg *msg)
+{
+	struct fdcan_tx_msg **link;
+	uint32_t priority = fdcan_queue_priority(msg);
+
+	if (fdcan_length_to_dlc(msg->length) == 0xFF) {
+		return FDCAN_E_INVALID;
+	}
+
+	msg->stamped = false;
+	msg->queued_at = fdcan_queue_now(queue);
+
+	CM_ATOMIC_BLOCK() {
+		link = &queue->head;
+		while (*link && fdcan_queue_priority(*link) <= priority) {
+			link = &(*link)->next;
+		}
+		msg->next = *link;
+		*link = msg;
+		fdcan_queue_feed(queue);
+	}
+
+	return FDCAN_E_OK;
+}
+
+/** Tell if frames are waiting to be sent.
+ *
+ * @param [in] queue Queue state.
+ * @returns true if any queued frame has not been sent yet.
+ */
+bool fdcan_queue_busy(struct fdcan_queue *queue)
+{
+	return queue->head || queue->pending;
+}
+
+/** FDCAN queue interrupt handler.
+ *
+ * Has to be called from the interrupt line 0 of the FDCAN block.
+ *
+ * @param [in] queue Queue state.
+ */
+void fdcan_queue_irq_handler(struct fdcan_queue *queue)
+{
+	uint32_t canport = queue->canport;
+	uint32_t ir = FDCAN_IR(canport) & FDCAN_QUEUE_IRQS;
+
+	FDCAN_IR(canport) = ir;
+
+	if (ir & FDCAN_IR_RF0L) {
+		queue->stats.rx_lost++;
+	}
+	if (ir & FDCAN_IR_RF1L) {
+		queue->stats.rx_lost++;
+	}
+	if (ir & (FDCAN_IR_RF0N | FDCAN_IR_RF0L)) {
+		fdcan_queue_rx(queue, FDCAN_FIFO0);
+	}
+	if (ir & (FDCAN_IR_RF1N | FDCAN_IR_RF1L)) {
+		fdcan_queue_rx(queue, FDCAN_FIFO1);
+	}
+
+	if (ir & (FDCAN_IR_TC | FDCAN_IR_TCF | FDCAN_IR_TEFN)) {
+		fdcan_queue_tx_events(queue);
+		fdcan_queue_tx_done(queue);
+		fdcan_queue_feed(queue);
+	}
+}
+
+/**@}*/
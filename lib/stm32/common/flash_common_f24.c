@@ -24,8 +24,26 @@
 
 /**@{*/
 
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/cm3/vector.h>
 #include <libopencm3/stm32/flash.h>
 
+/* Errors of a program or erase, PGSERR is ERSERR on the F7 */
+#define FLASH_SR_ERRORS		(FLASH_SR_PGPERR | FLASH_SR_PGAERR | \
+				 FLASH_SR_WRPERR | FLASH_SR_OPERR | (1 << 7))
+
+/* Widest program size flash_program() may use */
+static uint32_t flash_program_limit = FLASH_CR_PROGRAM_X32;
+
+/* The operation of flash_program_async() or flash_erase_sector_async() */
+static struct {
+	uint32_t address;
+	const uint8_t *data;
+	uint32_t len;
+	void (*callback)(bool ok);
+	volatile bool busy;
+} flash_async;
+
 /*---------------------------------------------------------------------------*/
 /** @brief Set the Program Parallelism Size
 
@@ -190,10 +208,104 @@ void flash_program_byte(uint32_t address, uint8_t data)
 	FLASH_CR &= ~FLASH_CR_PG;		/* Disable the PG bit. */
 }
 
+/*---------------------------------------------------------------------------*/
+/** @brief Set the Widest Program Size
+
+flash_program(), flash_program_async() and flash_erase_sector_async() use the
+widest program size up to this one that the address and length allow. It
+defaults to @ref FLASH_CR_PROGRAM_X32, which needs a supply of 2.7 V to 3.6 V.
+@ref FLASH_CR_PROGRAM_X64 needs the external VPP supply, lower voltages need
+@ref FLASH_CR_PROGRAM_X16 or @ref FLASH_CR_PROGRAM_X8. See the programming
+manual for the voltage ranges.
+
+@param[in] psize The widest programming word width one of:
+@ref flash_cr_program_width
+*/
+
+void flash_set_program_size_limit(uint32_t psize)
+{
+	flash_program_limit = psize & FLASH_CR_PROGRAM_MASK;
+}
+
+/* Little endian word at an address of any alignment, the data need not be
+ * aligned like the flash address. */
+static inline __attribute__((always_inline))
+uint32_t flash_data_word(const uint8_t *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) |
+	       ((uint32_t)data[3] << 24);
+}
+
+/* Start programming the widest unit up to limit that address is aligned to
+ * and len fills, returns its size in bytes. Inlined into the RAM loop, so
+ * it must not call anything in flash. */
+static inline __attribute__((always_inline))
+uint32_t flash_program_unit(uint32_t address, const uint8_t *data,
+			    uint32_t len, uint32_t limit)
+{
+	uint32_t psize = limit;
+	uint32_t cr;
+
+	while (psize > FLASH_CR_PROGRAM_X8 &&
+	       ((address & ((1 << psize) - 1)) || len < (1u << psize))) {
+		psize--;
+	}
+
+	cr = FLASH_CR & ~(FLASH_CR_PROGRAM_MASK << FLASH_CR_PROGRAM_SHIFT);
+	FLASH_CR = cr | (psize << FLASH_CR_PROGRAM_SHIFT) | FLASH_CR_PG;
+
+	switch (psize) {
+	case FLASH_CR_PROGRAM_X64:
+		MMIO32(address) = flash_data_word(data);
+		MMIO32(address + 4) = flash_data_word(data + 4);
+		break;
+	case FLASH_CR_PROGRAM_X32:
+		MMIO32(address) = flash_data_word(data);
+		break;
+	case FLASH_CR_PROGRAM_X16:
+		MMIO16(address) = data[0] | (data[1] << 8);
+		break;
+	default:
+		MMIO8(address) = data[0];
+		break;
+	}
+	/* The write has to reach the flash interface before BSY is polled */
+	__asm__ volatile("dsb":::"memory");
+
+	return 1 << psize;
+}
+
+/* The programming loop runs from RAM, so the core is not stalled fetching
+ * from the flash bank that is being programmed. */
+RAMFUNC static uint32_t flash_program_ram(uint32_t address,
+					  const uint8_t *data, uint32_t len,
+					  uint32_t limit)
+{
+	uint32_t errors = 0;
+	uint32_t n;
+
+	/* Errors left over would stop the loop at the first unit */
+	FLASH_SR = FLASH_SR_ERRORS;
+
+	while (len && !errors) {
+		n = flash_program_unit(address, data, len, limit);
+		while (FLASH_SR & FLASH_SR_BSY);
+		errors = FLASH_SR & FLASH_SR_ERRORS;
+		address += n;
+		data += n;
+		len -= n;
+	}
+	FLASH_CR &= ~FLASH_CR_PG;
+
+	return errors;
+}
+
 /*---------------------------------------------------------------------------*/
 /** @brief Program a Data Block to FLASH
 
-This programs an arbitrary length data block to FLASH memory.
+This programs an arbitrary length data block to FLASH memory, in the widest
+units the alignment allows up to the size set with
+flash_set_program_size_limit(). Programming stops at the first error.
 The program error flag should be checked separately for the event that memory
 was not properly erased.
 
@@ -204,13 +316,36 @@ was not properly erased.
 
 void flash_program(uint32_t address, const uint8_t *data, uint32_t len)
 {
-	/* TODO: Use dword and word size program operations where possible for
-	 * turbo speed.
-	 */
-	uint32_t i;
-	for (i = 0; i < len; i++) {
-		flash_program_byte(address+i, data[i]);
+	flash_wait_for_last_operation();
+	flash_program_ram(address, data, len, flash_program_limit);
+}
+
+/* End the background operation and tell its caller */
+static void flash_async_done(bool ok)
+{
+	FLASH_CR &= ~(FLASH_CR_EOPIE | FLASH_CR_ERRIE | FLASH_CR_PG |
+		      FLASH_CR_SER |
+		      (FLASH_CR_SNB_MASK << FLASH_CR_SNB_SHIFT));
+	flash_async.busy = false;
+	if (flash_async.callback) {
+		flash_async.callback(ok);
+	}
+}
+
+/* Start the erase of a sector, with the busy flag clear */
+static void flash_start_sector_erase(uint8_t sector, uint32_t program_size)
+{
+	flash_set_program_size(program_size);
+
+	/* Sector numbering is not contiguous internally! */
+	if (sector >= 12) {
+		sector += 4;
 	}
+
+	FLASH_CR &= ~(FLASH_CR_SNB_MASK << FLASH_CR_SNB_SHIFT);
+	FLASH_CR |= (sector & FLASH_CR_SNB_MASK) << FLASH_CR_SNB_SHIFT;
+	FLASH_CR |= FLASH_CR_SER;
+	FLASH_CR |= FLASH_CR_STRT;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -229,17 +364,7 @@ See the reference manual or the FLASH programming manual for details.
 void flash_erase_sector(uint8_t sector, uint32_t program_size)
 {
 	flash_wait_for_last_operation();
-	flash_set_program_size(program_size);
-
-	/* Sector numbering is not contiguous internally! */
-	if (sector >= 12) {
-		sector += 4;
-	}
-
-	FLASH_CR &= ~(FLASH_CR_SNB_MASK << FLASH_CR_SNB_SHIFT);
-	FLASH_CR |= (sector & FLASH_CR_SNB_MASK) << FLASH_CR_SNB_SHIFT;
-	FLASH_CR |= FLASH_CR_SER;
-	FLASH_CR |= FLASH_CR_STRT;
+	flash_start_sector_erase(sector, program_size);
 
 	flash_wait_for_last_operation();
 	FLASH_CR &= ~FLASH_CR_SER;
@@ -267,6 +392,141 @@ void flash_erase_all_sectors(uint32_t program_size)
 	FLASH_CR &= ~FLASH_CR_MER;		/* Disable mass erase. */
 }
 
+/*---------------------------------------------------------------------------*/
+/** @brief Program a Data Block to FLASH in the Background
+
+Like flash_program(), but each unit is started from flash_irq_handler() when
+the one before has ended, and the core goes on meanwhile. The callback is
+called from flash_irq_handler() when the block is programmed or an error
+stopped it. The data must stay valid until then.
+
+flash_irq_handler() has to be called from flash_isr(), and the flash
+interrupt enabled in the NVIC.
+
+@param[in] address Starting address in Flash.
+@param[in] data Pointer to start of data block.
+@param[in] len Length of data block.
+@param[in] callback Called with whether the block was programmed, may be NULL.
+@returns false if another operation is still running.
+*/
+
+bool flash_program_async(uint32_t address, const uint8_t *data, uint32_t len,
+			 void (*callback)(bool ok))
+{
+	uint32_t n;
+
+	if (flash_async.busy || (FLASH_SR & FLASH_SR_BSY)) {
+		return false;
+	}
+
+	FLASH_SR = FLASH_SR_EOP | FLASH_SR_ERRORS;
+	flash_async.callback = callback;
+	flash_async.busy = true;
+	if (!len) {
+		flash_async_done(true);
+		return true;
+	}
+
+	FLASH_CR |= FLASH_CR_EOPIE | FLASH_CR_ERRIE;
+	CM_ATOMIC_BLOCK() {
+		n = flash_program_unit(address, data, len,
+				       flash_program_limit);
+		flash_async.address = address + n;
+		flash_async.data = data + n;
+		flash_async.len = len - n;
+	}
+	/* Alignment and protection errors are flagged on the write and do not
+	 * end in an interrupt */
+	if (FLASH_SR & FLASH_SR_ERRORS) {
+		flash_async_done(false);
+	}
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Erase a Sector of FLASH in the Background
+
+Starts the erase of a sector and returns, the callback is called from
+flash_irq_handler() when it has ended. The erase takes up to seconds.
+
+The core is only stalled when it fetches from the flash bank being erased.
+On the dual bank parts, the STM32F42x/F43x with DB1M set and the
+STM32F76x/F77x in dual bank mode, code and data in the other bank can be used
+meanwhile, so a bank can be erased for an update while running from the
+other one. On single bank parts the code running meanwhile has to be in RAM.
+
+@param[in] sector (0 - 11 for some parts, 0-23 on others)
+@param[in] callback Called with whether the sector was erased, may be NULL.
+@returns false if another operation is still running.
+*/
+
+bool flash_erase_sector_async(uint8_t sector, void (*callback)(bool ok))
+{
+	if (flash_async.busy || (FLASH_SR & FLASH_SR_BSY)) {
+		return false;
+	}
+
+	FLASH_SR = FLASH_SR_EOP | FLASH_SR_ERRORS;
+	flash_async.callback = callback;
+	flash_async.len = 0;
+	flash_async.busy = true;
+
+	FLASH_CR |= FLASH_CR_EOPIE | FLASH_CR_ERRIE;
+	flash_start_sector_erase(sector, flash_program_limit);
+	if (FLASH_SR & FLASH_SR_ERRORS) {
+		flash_async_done(false);
+	}
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Check for a Background FLASH Operation
+
+@returns true while an operation of flash_program_async() or
+flash_erase_sector_async() has not ended.
+*/
+
+bool flash_busy(void)
+{
+	return flash_async.busy;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief FLASH Interrupt Handler
+
+Goes on with the operation of flash_program_async() or
+flash_erase_sector_async(). Has to be called from flash_isr().
+*/
+
+void flash_irq_handler(void)
+{
+	uint32_t sr = FLASH_SR & (FLASH_SR_EOP | FLASH_SR_ERRORS);
+	uint32_t n;
+
+	if (!sr || !flash_async.busy) {
+		return;
+	}
+	FLASH_SR = sr;
+
+	if (sr & FLASH_SR_ERRORS) {
+		flash_async_done(false);
+		return;
+	}
+	if (!flash_async.len) {
+		flash_async_done(true);
+		return;
+	}
+
+	n = flash_program_unit(flash_async.address, flash_async.data,
+			       flash_async.len, flash_program_limit);
+	flash_async.address += n;
+	flash_async.data += n;
+	flash_async.len -= n;
+	if (FLASH_SR & FLASH_SR_ERRORS) {
+		flash_async_done(false);
+	}
+}
+
 /*---------------------------------------------------------------------------*/
 /** @brief Program the Option Bytes
 
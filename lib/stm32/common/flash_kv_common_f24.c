@@ -0,0 +1,515 @@
+/** @addtogroup flash_file
+ *
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+#include <stddef.h>
+#include <string.h>
+#include <libopencm3/cm3/scb.h>
+#include <libopencm3/stm32/flash.h>
+
+/*
+ * A sector starts with a header, its generation and then the magic, which
+ * is programmed last. Each record is
+ *
+ *	key (16 bits), length and flags (16 bits), check (32 bits)
+ *	value, padded to 8 bytes
+ *	commit word, programmed last, and 4 bytes left erased
+ *
+ * all 8 byte aligned, so x64 programming can be used.
+ */
+#define FLASH_KV_MAGIC		0x314b5653
+#define FLASH_KV_COMMIT		0x4b56c0de
+#define FLASH_KV_HEADER		8
+#define FLASH_KV_RECORD		16
+#define FLASH_KV_DELETED	0x8000
+#define FLASH_KV_NO_KEY		0xffff
+
+#define FLASH_KV_SR_ERRORS	(FLASH_SR_PGPERR | FLASH_SR_PGAERR | \
+				 FLASH_SR_WRPERR | FLASH_SR_OPERR | (1 << 7))
+
+/* The store whose spare sector is being erased in the background */
+static struct flash_kv *flash_kv_erasing;
+
+static uint32_t flash_kv_record_size(uint16_t len)
+{
+	return FLASH_KV_RECORD + ((len + 7) & ~7);
+}
+
+static uint32_t flash_kv_check(uint16_t key, uint16_t len,
+			       const uint8_t *value)
+{
+	/* FNV-1a */
+	uint32_t hash = 0x811c9dc5;
+	uint32_t i;
+
+	hash = (hash ^ (key & 0xff)) * 0x01000193;
+	hash = (hash ^ (key >> 8)) * 0x01000193;
+	hash = (hash ^ (len & 0xff)) * 0x01000193;
+	hash = (hash ^ (len >> 8)) * 0x01000193;
+	len &= ~FLASH_KV_DELETED;
+	for (i = 0; i < len; i++) {
+		hash = (hash ^ value[i]) * 0x01000193;
+	}
+	return hash;
+}
+
+static const struct flash_kv_sector *flash_kv_sector(struct flash_kv *kv,
+						     uint8_t n)
+{
+	return &kv->sectors[n % kv->count];
+}
+
+/* Drops what the data cache holds of a range from before a program or
+ * erase: the flash data cache on the F2/F4, on the F7 the lines of the
+ * Cortex-M7 cache, which reads the flash over AXI. */
+static void flash_kv_flush(uint32_t address, uint32_t len)
+{
+#if defined(STM32F7)
+	uint32_t line;
+
+	__asm__ volatile("dsb":::"memory");
+	for (line = address & ~31; line < address + len; line += 32) {
+		SCB_DCIMVAC = line;
+	}
+	__asm__ volatile("dsb":::"memory");
+	__asm__ volatile("isb":::"memory");
+#else
+	(void)address;
+	(void)len;
+	if (FLASH_ACR & FLASH_ACR_DCEN) {
+		FLASH_ACR &= ~FLASH_ACR_DCEN;
+		FLASH_ACR |= FLASH_ACR_DCRST;
+		FLASH_ACR &= ~FLASH_ACR_DCRST;
+		FLASH_ACR |= FLASH_ACR_DCEN;
+	}
+#endif
+}
+
+static bool flash_kv_program(uint32_t address, const void *data,
+			     uint32_t len)
+{
+	flash_program(address, data, len);
+	flash_kv_flush(address, len);
+	return !(FLASH_SR & FLASH_KV_SR_ERRORS);
+}
+
+/* The index entry of a key, added if add is set, NULL if there is none */
+static struct flash_kv_entry *flash_kv_entry(struct flash_kv *kv,
+					     uint16_t key, bool add)
+{
+	struct flash_kv_entry *entry;
+	uint32_t i = ((key * 0x9e3779b1) >> 16) & (FLASH_KV_MAX_KEYS - 1);
+	uint32_t n;
+
+	for (n = 0; n < FLASH_KV_MAX_KEYS; n++) {
+		entry = &kv->index[i];
+		if (entry->key == key) {
+			return entry;
+		}
+		if (entry->key == FLASH_KV_NO_KEY) {
+			if (!add) {
+				return NULL;
+			}
+			entry->key = key;
+			entry->len = 0;
+			entry->offset = 0;
+			kv->keys++;
+			return entry;
+		}
+		i = (i + 1) & (FLASH_KV_MAX_KEYS - 1);
+	}
+	return NULL;
+}
+
+/* Builds the index from the records of the active sector. A record that is
+ * not intact, left by a power failure, ends the scan, and the sector is
+ * taken as full so the next write compacts it. */
+static void flash_kv_scan(struct flash_kv *kv)
+{
+	const struct flash_kv_sector *s = flash_kv_sector(kv, kv->active);
+	const uint8_t *record;
+	struct flash_kv_entry *entry;
+	uint16_t key, flags, len;
+	uint32_t size;
+	uint32_t i;
+
+	for (i = 0; i < FLASH_KV_MAX_KEYS; i++) {
+		kv->index[i].key = FLASH_KV_NO_KEY;
+	}
+	kv->keys = 0;
+
+	kv->end = FLASH_KV_HEADER;
+	while (kv->end + FLASH_KV_RECORD <= s->size) {
+		record = (const uint8_t *)(s->address + kv->end);
+		key = *(const uint16_t *)record;
+		flags = *(const uint16_t *)(record + 2);
+		if (key == FLASH_KV_NO_KEY && flags == 0xffff) {
+			return;
+		}
+
+		len = flags & ~FLASH_KV_DELETED;
+		size = flash_kv_record_size(len);
+		if (key == FLASH_KV_NO_KEY || len > FLASH_KV_MAX_VALUE ||
+		    kv->end + size > s->size ||
+		    *(const uint32_t *)(record + 4) !=
+		    flash_kv_check(key, flags, record + 8) ||
+		    *(const uint32_t *)(record + size - 8) !=
+		    FLASH_KV_COMMIT) {
+			kv->end = s->size;
+			return;
+		}
+
+		entry = flash_kv_entry(kv, key, true);
+		if (entry) {
+			entry->len = len;
+			entry->offset = (flags & FLASH_KV_DELETED) ? 0 : kv->end;
+		}
+		kv->end += size;
+	}
+}
+
+static void flash_kv_erased(bool ok)
+{
+	if (flash_kv_erasing) {
+		flash_kv_erasing->spare_erased = ok;
+		flash_kv_erasing = NULL;
+	}
+}
+
+/* Starts erasing the sector after the active one */
+static void flash_kv_erase_spare(struct flash_kv *kv)
+{
+	const struct flash_kv_sector *s = flash_kv_sector(kv, kv->active + 1);
+
+	kv->spare_erased = false;
+	if (flash_kv_erasing) {
+		return;
+	}
+	flash_kv_erasing = kv;
+	if (!flash_erase_sector_async(s->sector, flash_kv_erased)) {
+		flash_kv_erasing = NULL;
+	}
+}
+
+static bool flash_kv_is_erased(const struct flash_kv_sector *s)
+{
+	const uint32_t *word = (const uint32_t *)s->address;
+	uint32_t i;
+
+	for (i = 0; i < s->size / 4; i++) {
+		if (word[i] != 0xffffffff) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Programs the generation and then the magic of a sector header */
+static bool flash_kv_program_header(const struct flash_kv_sector *s,
+				    uint32_t generation)
+{
+	uint32_t magic = FLASH_KV_MAGIC;
+
+	return flash_kv_program(s->address + 4, &generation, 4) &&
+	       flash_kv_program(s->address, &magic, 4);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Set up a Key Value Store
+
+Finds the newest sector of the store and indexes its records. When no sector
+has been used yet, the first one is erased and started, and the erase of the
+next one is started in the background.
+
+@param[in] kv The store.
+@param[in] sectors The sectors of the store, they have to stay valid.
+@param[in] count Number of sectors, 2 to @ref FLASH_KV_MAX_SECTORS.
+@returns false if the count is wrong or the first sector can not be started.
+*/
+
+bool flash_kv_init(struct flash_kv *kv, const struct flash_kv_sector *sectors,
+		   uint8_t count)
+{
+	const struct flash_kv_sector *s;
+	bool found = false;
+	uint8_t i;
+
+	if (count < 2 || count > FLASH_KV_MAX_SECTORS) {
+		return false;
+	}
+	kv->sectors = sectors;
+	kv->count = count;
+	kv->active = 0;
+	kv->generation = 0;
+
+	for (i = 0; i < count; i++) {
+		s = &sectors[i];
+		if (MMIO32(s->address) != FLASH_KV_MAGIC) {
+			continue;
+		}
+		if (!found || MMIO32(s->address + 4) > kv->generation) {
+			kv->active = i;
+			kv->generation = MMIO32(s->address + 4);
+			found = true;
+		}
+	}
+
+	if (!found) {
+		s = &sectors[0];
+		flash_clear_status_flags();
+		flash_erase_sector(s->sector, FLASH_CR_PROGRAM_X32);
+		flash_kv_flush(s->address, s->size);
+		kv->generation = 1;
+		if (!flash_kv_program_header(s, kv->generation)) {
+			return false;
+		}
+	}
+
+	flash_kv_scan(kv);
+	kv->spare_erased = flash_kv_is_erased(flash_kv_sector(kv,
+							      kv->active + 1));
+	if (!kv->spare_erased) {
+		flash_kv_erase_spare(kv);
+	}
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Find a Value in a Key Value Store
+
+@param[in] kv The store.
+@param[in] key The key.
+@param[out] len Set to the length of the value, may be NULL.
+@returns the value in flash, NULL if the key is not set. It stays valid
+until the store is compacted.
+*/
+
+const void *flash_kv_find(struct flash_kv *kv, uint16_t key, uint16_t *len)
+{
+	struct flash_kv_entry *entry = flash_kv_entry(kv, key, false);
+
+	if (!entry || !entry->offset) {
+		return NULL;
+	}
+	if (len) {
+		*len = entry->len;
+	}
+	return (const void *)(flash_kv_sector(kv, kv->active)->address +
+			      entry->offset + 8);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Read a Value from a Key Value Store
+
+@param[in] kv The store.
+@param[in] key The key.
+@param[out] value Filled with the value, up to size bytes.
+@param[in] size Size of the value buffer.
+@returns the length of the value, which may be more than size, or -1 if the
+key is not set.
+*/
+
+int flash_kv_get(struct flash_kv *kv, uint16_t key, void *value,
+		 uint16_t size)
+{
+	const void *data;
+	uint16_t len;
+
+	data = flash_kv_find(kv, key, &len);
+	if (!data) {
+		return -1;
+	}
+	memcpy(value, data, len < size ? len : size);
+	return len;
+}
+
+/* Appends a record to the active sector, compacting it first if full */
+static bool flash_kv_append(struct flash_kv *kv, uint16_t key,
+			    uint16_t flags, const void *value)
+{
+	const struct flash_kv_sector *s;
+	struct flash_kv_entry *entry;
+	uint16_t len = flags & ~FLASH_KV_DELETED;
+	uint32_t size = flash_kv_record_size(len);
+	uint32_t header[2];
+	uint32_t commit = FLASH_KV_COMMIT;
+	uint32_t address;
+	bool ok;
+
+	if (kv->end + size > flash_kv_sector(kv, kv->active)->size &&
+	    !flash_kv_compact(kv)) {
+		return false;
+	}
+	s = flash_kv_sector(kv, kv->active);
+	if (kv->end + size > s->size) {
+		return false;
+	}
+
+	entry = flash_kv_entry(kv, key, true);
+	if (!entry) {
+		return false;
+	}
+
+	/* A spare sector erase in the background holds the flash */
+	while (flash_busy());
+	flash_clear_status_flags();
+
+	header[0] = key | (flags << 16);
+	header[1] = flash_kv_check(key, flags, value);
+	address = s->address + kv->end;
+	ok = flash_kv_program(address, header, sizeof(header)) &&
+	     flash_kv_program(address + 8, value, len) &&
+	     flash_kv_program(address + size - 8, &commit, 4);
+	kv->end += size;
+	if (!ok) {
+		return false;
+	}
+
+	entry->len = len;
+	entry->offset = (flags & FLASH_KV_DELETED) ? 0 : address - s->address;
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Set a Value in a Key Value Store
+
+Appends the value, unless it is set to the same already. This takes the time
+to program it, unless the erase of the spare sector is still running, or the
+sector is full: the live records are then copied to the spare sector before
+this returns, see flash_kv_compact().
+
+@param[in] kv The store.
+@param[in] key The key, 0 to 0xfffe.
+@param[in] value The value.
+@param[in] len Length of the value, up to @ref FLASH_KV_MAX_VALUE.
+@returns false if the value could not be stored, the store keeps the value
+from before.
+*/
+
+bool flash_kv_set(struct flash_kv *kv, uint16_t key, const void *value,
+		  uint16_t len)
+{
+	const void *old;
+	uint16_t old_len;
+
+	if (key == FLASH_KV_NO_KEY || len > FLASH_KV_MAX_VALUE) {
+		return false;
+	}
+
+	old = flash_kv_find(kv, key, &old_len);
+	if (old && old_len == len && !memcmp(old, value, len)) {
+		return true;
+	}
+	return flash_kv_append(kv, key, len, value);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Delete a Value from a Key Value Store
+
+@param[in] kv The store.
+@param[in] key The key.
+@returns false if the deletion could not be stored.
+*/
+
+bool flash_kv_delete(struct flash_kv *kv, uint16_t key)
+{
+	if (!flash_kv_find(kv, key, NULL)) {
+		return true;
+	}
+	return flash_kv_append(kv, key, FLASH_KV_DELETED, NULL);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Compact a Key Value Store
+
+Copies the newest record of each key to the spare sector, which becomes the
+active one, and starts erasing the sector after it in the background. This is
+done by flash_kv_set() when the active sector is full, but can be done at a
+better time. Waits for the spare sector to be erased first, and returns once
+all records are programmed, which takes the time to program up to a sector.
+
+@param[in] kv The store.
+@returns false if the values could not be copied, the store stays in the
+sector it was in.
+*/
+
+bool flash_kv_compact(struct flash_kv *kv)
+{
+	const struct flash_kv_sector *from = flash_kv_sector(kv, kv->active);
+	const struct flash_kv_sector *to = flash_kv_sector(kv, kv->active + 1);
+	const struct flash_kv_entry *entry;
+	uint32_t end = FLASH_KV_HEADER;
+	uint32_t size;
+	uint32_t i;
+
+	while (flash_busy());
+	flash_clear_status_flags();
+	if (!kv->spare_erased) {
+		flash_erase_sector(to->sector, FLASH_CR_PROGRAM_X32);
+		if (FLASH_SR & FLASH_KV_SR_ERRORS) {
+			return false;
+		}
+	}
+	/* Also after an erase in the background */
+	flash_kv_flush(to->address, to->size);
+	kv->spare_erased = false;
+
+	for (i = 0; i < FLASH_KV_MAX_KEYS; i++) {
+		entry = &kv->index[i];
+		if (entry->key == FLASH_KV_NO_KEY || !entry->offset) {
+			continue;
+		}
+		size = flash_kv_record_size(entry->len);
+		if (end + size > to->size ||
+		    !flash_kv_program(to->address + end,
+				      (const void *)(from->address +
+						     entry->offset), size)) {
+			return false;
+		}
+		end += size;
+	}
+
+	/* The header makes the copy the newest sector */
+	if (!flash_kv_program_header(to, kv->generation + 1)) {
+		return false;
+	}
+	kv->generation++;
+	kv->active = (kv->active + 1) % kv->count;
+	flash_kv_scan(kv);
+	flash_kv_erase_spare(kv);
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief Free Space of a Key Value Store
+
+@param[in] kv The store.
+@returns bytes left in the active sector, a record takes 16 bytes and its
+value padded to 8 bytes.
+*/
+
+uint32_t flash_kv_free(struct flash_kv *kv)
+{
+	return flash_kv_sector(kv, kv->active)->size - kv->end;
+}
+
+/**@}*/
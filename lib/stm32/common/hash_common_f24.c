@@ -32,7 +32,10 @@
 
 /**@{*/
 
+#include <string.h>
+#include <libopencm3/stm32/dbgmcu.h>
 #include <libopencm3/stm32/hash.h>
+#include <libopencm3/stm32/dma.h>
 
 /*---------------------------------------------------------------------------*/
 /** @brief HASH Set Mode
@@ -160,5 +163,316 @@ void hash_get_result(uint32_t *data)
 		data[4] = HASH_HR[4];
 	}
 }
+
+/*---------------------------------------------------------------------------*/
+/* Streaming contexts */
+
+static struct hash_context *hash_owner;
+static bool hash_dma_active;
+
+/* Wait until all data handed to the processor has been consumed. */
+static void hash_wait_idle(void)
+{
+	if (hash_dma_active) {
+		while (DMA_SCR(HASH_DMA, HASH_DMA_STREAM) & DMA_SxCR_EN);
+		HASH_CR &= ~HASH_CR_DMAE;
+		hash_dma_active = false;
+	}
+
+	while (HASH_SR & (HASH_SR_DMAS | HASH_SR_BUSY));
+}
+
+static void hash_feed_words(const uint8_t *data, uint32_t words)
+{
+	uint32_t word;
+
+	while (words--) {
+		memcpy(&word, data, 4);
+		HASH_DIN = word;
+		data += 4;
+	}
+}
+
+/* Feed a complete byte string and start its digest phase. */
+static void hash_feed_message(const uint8_t *data, uint32_t len)
+{
+	uint32_t word = 0;
+
+	hash_feed_words(data, len / 4);
+	if (len % 4) {
+		memcpy(&word, data + (len & ~3), len % 4);
+		HASH_DIN = word;
+	}
+
+	hash_set_last_word_valid_bits(8 * (len % 4));
+	hash_digest();
+}
+
+static void hash_feed_dma(const uint8_t *data, uint32_t words)
+{
+	uint16_t n;
+
+	while (words) {
+		n = (words > 0xFFFF) ? 0xFFFF : words;
+
+		hash_wait_idle();
+		dma_stream_reset(HASH_DMA, HASH_DMA_STREAM);
+		dma_channel_select(HASH_DMA, HASH_DMA_STREAM, HASH_DMA_CHANNEL);
+		dma_set_transfer_mode(HASH_DMA, HASH_DMA_STREAM,
+				      DMA_SxCR_DIR_MEM_TO_PERIPHERAL);
+		dma_set_priority(HASH_DMA, HASH_DMA_STREAM, DMA_SxCR_PL_MEDIUM);
+		dma_set_peripheral_size(HASH_DMA, HASH_DMA_STREAM,
+					DMA_SxCR_PSIZE_32BIT);
+		dma_set_memory_size(HASH_DMA, HASH_DMA_STREAM,
+				    DMA_SxCR_MSIZE_32BIT);
+		dma_enable_memory_increment_mode(HASH_DMA, HASH_DMA_STREAM);
+		dma_set_peripheral_address(HASH_DMA, HASH_DMA_STREAM,
+					   (uint32_t)&HASH_DIN);
+		dma_set_memory_address(HASH_DMA, HASH_DMA_STREAM,
+				       (uint32_t)data);
+		dma_set_number_of_data(HASH_DMA, HASH_DMA_STREAM, n);
+
+		HASH_CR |= HASH_CR_DMAE;
+		dma_enable_stream(HASH_DMA, HASH_DMA_STREAM);
+		hash_dma_active = true;
+
+		data += 4 * n;
+		words -= n;
+	}
+}
+
+/* Context swap registers of the part: 51 on the F2 and the F405/407/415/417,
+ * 54 on those with SHA-2 and HMAC SHA-2. */
+static int hash_csr_count(void)
+{
+#if defined(STM32F2)
+	return 51;
+#else
+	if ((DBGMCU_IDCODE & DBGMCU_IDCODE_DEV_ID_MASK) == 0x413) {
+		return 51;
+	}
+	return HASH_CSR_COUNT;
+#endif
+}
+
+/* Swap the processor state over to ctx. */
+static void hash_context_activate(struct hash_context *ctx)
+{
+	int csr_count = hash_csr_count();
+	int i;
+
+	if (hash_owner == ctx) {
+		return;
+	}
+
+	hash_wait_idle();
+
+	if (hash_owner) {
+		hash_owner->imr = HASH_IMR;
+		hash_owner->str = HASH_STR;
+		hash_owner->saved_cr = HASH_CR;
+		for (i = 0; i < csr_count; i++) {
+			hash_owner->csr[i] = HASH_CSR[i];
+		}
+	}
+
+	hash_owner = ctx;
+
+	if (ctx->started) {
+		HASH_IMR = ctx->imr;
+		HASH_STR = ctx->str;
+		HASH_CR = ctx->saved_cr;
+		HASH_CR = ctx->saved_cr | HASH_CR_INIT;
+		for (i = 0; i < csr_count; i++) {
+			HASH_CSR[i] = ctx->csr[i];
+		}
+		return;
+	}
+
+	HASH_CR = ctx->cr | HASH_CR_INIT;
+	ctx->started = true;
+
+	/* HMAC inner key phase */
+	if (ctx->cr & HASH_MODE_HMAC) {
+		hash_feed_message(ctx->key, ctx->keylen);
+		hash_wait_idle();
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief HASH Context Init
+
+Prepares a message digest context. The processor is only claimed on the first
+update, so any number of contexts can be in progress; the processor state is
+saved to and restored from the contexts (HASH_IMR, HASH_STR, HASH_CR and
+HASH_CSR) whenever another context is used.
+
+Input is taken as a byte stream. OR-ing @ref HASH_CR_MDMAT into the algorithm
+feeds large updates by DMA2 stream 7; this needs a processor supporting
+multiple DMA transfers per digest (STM32F437/F439). The STM32F415/F417 lack
+the bit and end the message with the first DMA transfer, so do not set it
+there: all updates are then fed by the CPU, a single DMA transfer of a whole
+message is not supported.
+
+@param[out] ctx Context to initialize.
+@param[in] algorithm unsigned int32. Hash algorithm: @ref hash_algorithm,
+optionally with @ref HASH_CR_MDMAT.
+@param[in] key Pointer to the HMAC key, or NULL for a plain digest. The key
+must stay valid until @ref hash_context_finish.
+@param[in] keylen unsigned int32. Length of the key in bytes.
+*/
+
+void hash_context_init(struct hash_context *ctx, uint32_t algorithm,
+		       const uint8_t *key, uint32_t keylen)
+{
+	ctx->cr = algorithm | HASH_DATA_8BIT;
+	if (key) {
+		ctx->cr |= HASH_MODE_HMAC;
+		if (keylen > 64) {
+			ctx->cr |= HASH_KEY_LONG;
+		}
+	}
+
+	ctx->key = key;
+	ctx->keylen = keylen;
+	ctx->tail_len = 0;
+	ctx->started = false;
+
+	if (hash_owner == ctx) {
+		hash_wait_idle();
+		hash_owner = NULL;
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief HASH Context Update
+
+Adds a buffer of arbitrary length and alignment to the message. Bytes that do
+not fill a whole word are kept in the context until the next update or the
+end of the message.
+
+With @ref HASH_CR_MDMAT, word aligned updates of at least
+HASH_DMA_THRESHOLD words are fed by DMA. This function then returns before
+the data was consumed, the buffer must stay valid until
+@ref hash_context_busy returns false.
+
+@param[in] ctx Context to update.
+@param[in] data Pointer to the data.
+@param[in] len unsigned int32. Length of the data in bytes.
+*/
+
+void hash_context_update(struct hash_context *ctx, const void *data,
+			 uint32_t len)
+{
+	const uint8_t *p = data;
+	uint32_t words, n;
+
+	hash_context_activate(ctx);
+	hash_wait_idle();
+
+	/* Complete the word started by the previous update */
+	if (ctx->tail_len) {
+		n = 4 - ctx->tail_len;
+		if (n > len) {
+			n = len;
+		}
+		memcpy(&ctx->tail[ctx->tail_len], p, n);
+		ctx->tail_len += n;
+		p += n;
+		len -= n;
+
+		if (ctx->tail_len < 4) {
+			return;
+		}
+		hash_feed_words(ctx->tail, 1);
+		ctx->tail_len = 0;
+	}
+
+	words = len / 4;
+	if ((ctx->cr & HASH_CR_MDMAT) && (words >= HASH_DMA_THRESHOLD) &&
+	    (((uint32_t)p & 3) == 0)) {
+		hash_feed_dma(p, words);
+	} else {
+		hash_feed_words(p, words);
+	}
+	p += 4 * words;
+
+	ctx->tail_len = len % 4;
+	memcpy(ctx->tail, p, ctx->tail_len);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief HASH Context Busy
+
+@returns true while a DMA update is still feeding the processor.
+*/
+
+bool hash_context_busy(void)
+{
+	return hash_dma_active &&
+	       (DMA_SCR(HASH_DMA, HASH_DMA_STREAM) & DMA_SxCR_EN);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief HASH Context Finish
+
+Feeds the remaining bytes with the matching number of valid bits in the last
+word, runs the final (and for HMAC the outer key) digest phase and reads the
+result. The context may be initialized again afterwards.
+
+@param[in] ctx Context to finish.
+@param[out] digest unsigned int32. Result, 4 (MD5), 5 (SHA-1), 7 (SHA-224) or
+8 (SHA-256) words long.
+@returns Number of digest words.
+*/
+
+uint8_t hash_context_finish(struct hash_context *ctx, uint32_t *digest)
+{
+	uint32_t word = 0;
+	uint8_t i, n;
+
+	hash_context_activate(ctx);
+	hash_wait_idle();
+
+	if (ctx->tail_len) {
+		memcpy(&word, ctx->tail, ctx->tail_len);
+		HASH_DIN = word;
+	}
+	hash_set_last_word_valid_bits(8 * ctx->tail_len);
+	hash_digest();
+
+	/* HMAC outer key phase */
+	if (ctx->cr & HASH_MODE_HMAC) {
+		hash_wait_idle();
+		hash_feed_message(ctx->key, ctx->keylen);
+	}
+
+	while (!(HASH_SR & HASH_SR_DCIS));
+
+	switch (ctx->cr & (HASH_CR_ALGO1 | HASH_CR_ALGO)) {
+	case HASH_ALGO_MD5:
+		n = 4;
+		break;
+	case HASH_ALGO_SHA224:
+		n = 7;
+		break;
+	case HASH_ALGO_SHA256:
+		n = 8;
+		break;
+	default:
+		n = 5;
+		break;
+	}
+
+	for (i = 0; i < n; i++) {
+		digest[i] = (ctx->cr & HASH_CR_ALGO1) ? HASH_HRX[i] : HASH_HR[i];
+	}
+
+	ctx->tail_len = 0;
+	ctx->started = false;
+	hash_owner = NULL;
+
+	return n;
+}
 /**@}*/
 
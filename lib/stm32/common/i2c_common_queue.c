@@ -0,0 +1,428 @@
+/** @addtogroup i2c_file I2C peripheral API
+ * @ingroup peripheral_apis
+ *
+ * This part runs queued I2C master transactions from the interrupts, see
+ * @ref i2c_api_queue.
+ */
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/i2c.h>
+
+/**@{*/
+
+#if defined(I2C_ISR)
+
+#define I2C_QUEUE_IRQS		(I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_NACKIE | \
+				 I2C_CR1_STOPIE | I2C_CR1_TCIE | I2C_CR1_ERRIE)
+
+/* Software reset, the configuration registers are kept. */
+static void i2c_queue_reset(uint32_t i2c)
+{
+	I2C_CR1(i2c) &= ~I2C_CR1_PE;
+	while (I2C_CR1(i2c) & I2C_CR1_PE);
+	I2C_CR1(i2c) |= I2C_CR1_PE;
+}
+
+/* Address one phase of the transaction. The read after a write is started
+ * from TC, with AUTOEND set only after START for a proper repeated start. */
+static void i2c_queue_send_start(uint32_t i2c, struct i2c_transaction *t,
+				 bool reading)
+{
+	uint32_t cr2 = I2C_CR2(i2c);
+
+	cr2 &= ~(I2C_CR2_SADD_10BIT_MASK | I2C_CR2_ADD10 | I2C_CR2_RD_WRN |
+		 I2C_CR2_NBYTES_MASK | I2C_CR2_RELOAD | I2C_CR2_AUTOEND);
+	cr2 |= t->addr << I2C_CR2_SADD_7BIT_SHIFT;
+	if (reading) {
+		cr2 |= I2C_CR2_RD_WRN | (t->rn << I2C_CR2_NBYTES_SHIFT);
+	} else {
+		cr2 |= t->wn << I2C_CR2_NBYTES_SHIFT;
+	}
+	I2C_CR2(i2c) = cr2 | I2C_CR2_START;
+	if (reading || t->rn == 0) {
+		I2C_CR2(i2c) |= I2C_CR2_AUTOEND;
+	}
+}
+
+#else
+
+#define I2C_QUEUE_SR1_ERRORS	(I2C_SR1_AF | I2C_SR1_ARLO | I2C_SR1_BERR)
+
+/* SWRST clears every register, so the configuration is put back. */
+static void i2c_queue_reset(uint32_t i2c)
+{
+	uint32_t cr1 = I2C_CR1(i2c) & ~(I2C_CR1_START | I2C_CR1_STOP |
+					I2C_CR1_ACK | I2C_CR1_POS);
+	uint32_t cr2 = I2C_CR2(i2c);
+	uint32_t ccr = I2C_CCR(i2c);
+	uint32_t trise = I2C_TRISE(i2c);
+	uint32_t oar1 = I2C_OAR1(i2c);
+	uint32_t oar2 = I2C_OAR2(i2c);
+#if defined(I2C_FLTR)
+	uint32_t fltr = I2C_FLTR(i2c);
+#endif
+
+	I2C_CR1(i2c) = I2C_CR1_SWRST;
+	I2C_CR1(i2c) = 0;
+	I2C_CR2(i2c) = cr2;
+	I2C_CCR(i2c) = ccr;
+	I2C_TRISE(i2c) = trise;
+	I2C_OAR1(i2c) = oar1;
+	I2C_OAR2(i2c) = oar2;
+#if defined(I2C_FLTR)
+	I2C_FLTR(i2c) = fltr;
+#endif
+	I2C_CR1(i2c) = cr1;
+}
+
+#endif
+
+static void i2c_queue_start(struct i2c_queue *queue)
+{
+	struct i2c_transaction *t = queue->head;
+
+	queue->pos = 0;
+	queue->reading = t->wn == 0 && t->rn != 0;
+	queue->status = I2C_TRANSACTION_OK;
+	queue->ticks = t->timeout;
+
+#if defined(I2C_ISR)
+	i2c_queue_send_start(queue->i2c, t, queue->reading);
+#else
+	/* Buffer interrupts for writing, reading decides on them after ADDR */
+	I2C_CR2(queue->i2c) |= I2C_CR2_ITBUFEN;
+	/* The STOP of the previous transaction is still going out. */
+	while (I2C_CR1(queue->i2c) & I2C_CR1_STOP);
+	I2C_CR1(queue->i2c) |= I2C_CR1_START;
+#endif
+}
+
+/* Take the running transaction off the queue, start the next one and then
+ * report. */
+static void i2c_queue_done(struct i2c_queue *queue,
+			   enum i2c_transaction_status status)
+{
+	struct i2c_transaction *t = queue->head;
+
+#if !defined(I2C_ISR)
+	I2C_CR1(queue->i2c) &= ~I2C_CR1_POS;
+#endif
+	CM_ATOMIC_BLOCK() {
+		queue->head = t->next;
+		if (!queue->head) {
+			queue->tail = NULL;
+		}
+	}
+	if (queue->head) {
+		i2c_queue_start(queue);
+	}
+
+	if (t->callback) {
+		t->callback(t, status);
+	}
+}
+
+#if defined(I2C_ISR)
+
+static void i2c_queue_irq(struct i2c_queue *queue)
+{
+	struct i2c_transaction *t = queue->head;
+	uint32_t i2c = queue->i2c;
+	uint32_t isr = I2C_ISR(i2c);
+
+	if (isr & (I2C_ISR_BERR | I2C_ISR_ARLO)) {
+		/* No STOP is coming, the bus is not ours. */
+		i2c_queue_reset(i2c);
+		i2c_queue_done(queue, (isr & I2C_ISR_BERR) ?
+				      I2C_TRANSACTION_BUS_ERROR :
+				      I2C_TRANSACTION_ARB_LOST);
+		return;
+	}
+
+	if (isr & I2C_ISR_NACKF) {
+		/* Reported once the automatic STOP is out */
+		I2C_ICR(i2c) = I2C_ICR_NACKCF;
+		queue->status = I2C_TRANSACTION_NACK;
+	}
+
+	if ((isr & I2C_ISR_TXIS) && queue->pos < t->wn) {
+		I2C_TXDR(i2c) = t->w[queue->pos++];
+	}
+	if ((isr & I2C_ISR_RXNE) && queue->pos < t->rn) {
+		t->r[queue->pos++] = I2C_RXDR(i2c);
+	}
+
+	if (isr & I2C_ISR_TC) {
+		queue->pos = 0;
+		queue->reading = true;
+		i2c_queue_send_start(i2c, t, true);
+	}
+
+	if (isr & I2C_ISR_STOPF) {
+		I2C_ICR(i2c) = I2C_ICR_STOPCF;
+		/* Drop a byte left behind by a NACK */
+		I2C_ISR(i2c) = I2C_ISR_TXE;
+		i2c_queue_done(queue, queue->status);
+	}
+}
+
+#else
+
+/* Writing: the last byte is followed by BTF, with the buffer interrupts
+ * off, and from there the read starts with a repeated START or the STOP
+ * goes out. */
+static void i2c_queue_write(struct i2c_queue *queue, uint32_t sr1)
+{
+	struct i2c_transaction *t = queue->head;
+	uint32_t i2c = queue->i2c;
+
+	if (sr1 & I2C_SR1_ADDR) {
+		(void)I2C_SR2(i2c);
+		if (t->wn == 0) {
+			/* Address only, the slave answered */
+			I2C_CR1(i2c) |= I2C_CR1_STOP;
+			i2c_queue_done(queue, I2C_TRANSACTION_OK);
+		}
+	} else if ((sr1 & I2C_SR1_TxE) && queue->pos < t->wn) {
+		I2C_DR(i2c) = t->w[queue->pos++];
+		if (queue->pos == t->wn) {
+			I2C_CR2(i2c) &= ~I2C_CR2_ITBUFEN;
+		}
+	} else if (sr1 & I2C_SR1_BTF) {
+		if (t->rn) {
+			queue->pos = 0;
+			queue->reading = true;
+			I2C_CR1(i2c) |= I2C_CR1_START;
+		} else {
+			I2C_CR1(i2c) |= I2C_CR1_STOP;
+			i2c_queue_done(queue, I2C_TRANSACTION_OK);
+		}
+	}
+}
+
+/* Reading: the NACK of the last byte and the STOP have to be set up while
+ * the bytes before it are still held back, as in the reference manual. A
+ * single byte is taken on RxNE, two with POS on BTF, and of more the last
+ * three on BTF. */
+static void i2c_queue_read(struct i2c_queue *queue, uint32_t sr1)
+{
+	struct i2c_transaction *t = queue->head;
+	uint32_t i2c = queue->i2c;
+	size_t left = t->rn - queue->pos;
+
+	if (sr1 & I2C_SR1_ADDR) {
+		if (t->rn == 1) {
+			I2C_CR1(i2c) &= ~I2C_CR1_ACK;
+			CM_ATOMIC_BLOCK() {
+				(void)I2C_SR2(i2c);
+				I2C_CR1(i2c) |= I2C_CR1_STOP;
+			}
+			I2C_CR2(i2c) |= I2C_CR2_ITBUFEN;
+		} else if (t->rn == 2) {
+			I2C_CR1(i2c) = (I2C_CR1(i2c) & ~I2C_CR1_ACK) | I2C_CR1_POS;
+			(void)I2C_SR2(i2c);
+			I2C_CR2(i2c) &= ~I2C_CR2_ITBUFEN;
+		} else {
+			I2C_CR1(i2c) |= I2C_CR1_ACK;
+			(void)I2C_SR2(i2c);
+			if (t->rn == 3) {
+				I2C_CR2(i2c) &= ~I2C_CR2_ITBUFEN;
+			} else {
+				I2C_CR2(i2c) |= I2C_CR2_ITBUFEN;
+			}
+		}
+	} else if (sr1 & I2C_SR1_BTF) {
+		if (left == 2) {
+			CM_ATOMIC_BLOCK() {
+				I2C_CR1(i2c) |= I2C_CR1_STOP;
+				t->r[queue->pos++] = I2C_DR(i2c);
+			}
+			t->r[queue->pos++] = I2C_DR(i2c);
+			i2c_queue_done(queue, I2C_TRANSACTION_OK);
+			return;
+		}
+		if (left == 3) {
+			I2C_CR1(i2c) &= ~I2C_CR1_ACK;
+		}
+		I2C_CR2(i2c) &= ~I2C_CR2_ITBUFEN;
+		t->r[queue->pos++] = I2C_DR(i2c);
+	} else if ((sr1 & I2C_SR1_RxNE) &&
+		   (I2C_CR2(i2c) & I2C_CR2_ITBUFEN)) {
+		t->r[queue->pos++] = I2C_DR(i2c);
+		if (left == 1) {
+			i2c_queue_done(queue, I2C_TRANSACTION_OK);
+		} else if (left == 4) {
+			I2C_CR2(i2c) &= ~I2C_CR2_ITBUFEN;
+		}
+	}
+}
+
+static void i2c_queue_irq(struct i2c_queue *queue)
+{
+	struct i2c_transaction *t = queue->head;
+	uint32_t i2c = queue->i2c;
+	uint32_t sr1 = I2C_SR1(i2c);
+
+	if (sr1 & I2C_QUEUE_SR1_ERRORS) {
+		/* The flags clear on writing zero, others ignore it. */
+		I2C_SR1(i2c) &= ~I2C_QUEUE_SR1_ERRORS;
+		I2C_CR2(i2c) &= ~I2C_CR2_ITBUFEN;
+		if (sr1 & I2C_SR1_BERR) {
+			i2c_queue_reset(i2c);
+			i2c_queue_done(queue, I2C_TRANSACTION_BUS_ERROR);
+		} else if (sr1 & I2C_SR1_ARLO) {
+			i2c_queue_done(queue, I2C_TRANSACTION_ARB_LOST);
+		} else {
+			I2C_CR1(i2c) |= I2C_CR1_STOP;
+			i2c_queue_done(queue, I2C_TRANSACTION_NACK);
+		}
+		return;
+	}
+
+	if (sr1 & I2C_SR1_SB) {
+		I2C_DR(i2c) = (t->addr << 1) | (queue->reading ? 1 : 0);
+	} else if (queue->reading) {
+		i2c_queue_read(queue, sr1);
+	} else {
+		i2c_queue_write(queue, sr1);
+	}
+}
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/** @brief I2C Queue Initialise.
+
+Enables the interrupts the queue runs on. The I2C must be configured and
+enabled beforehand.
+
+@param[in] queue Queue state
+@param[in] i2c Unsigned int32. I2C register base address @ref i2c_reg_base.
+*/
+
+void i2c_queue_init(struct i2c_queue *queue, uint32_t i2c)
+{
+	queue->i2c = i2c;
+	queue->head = NULL;
+	queue->tail = NULL;
+	queue->ticks = 0;
+
+#if defined(I2C_ISR)
+	I2C_CR1(i2c) |= I2C_QUEUE_IRQS;
+#else
+	I2C_CR2(i2c) |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief I2C Queue Submit a Transaction.
+
+The transaction starts at once if the queue is idle, otherwise when the ones
+before it are done. It must not be changed until its callback.
+
+@param[in] queue Queue state
+@param[in] transaction Transaction to append
+@returns false, and the transaction is not queued, if it writes or reads
+more than 255 bytes
+*/
+
+bool i2c_queue_submit(struct i2c_queue *queue,
+		      struct i2c_transaction *transaction)
+{
+	bool idle;
+
+	/* The byte count of the v2 peripheral is 8 bits, the limit for all */
+	if (transaction->wn > 255 || transaction->rn > 255) {
+		return false;
+	}
+
+	transaction->next = NULL;
+	CM_ATOMIC_BLOCK() {
+		idle = queue->head == NULL;
+		if (idle) {
+			queue->head = transaction;
+		} else {
+			queue->tail->next = transaction;
+		}
+		queue->tail = transaction;
+	}
+
+	if (idle) {
+		i2c_queue_start(queue);
+	}
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief I2C Queue Busy.
+
+@param[in] queue Queue state
+@returns true while transactions are queued or running
+*/
+
+bool i2c_queue_busy(struct i2c_queue *queue)
+{
+	return queue->head != NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief I2C Queue Interrupt Handler.
+
+Call from the event and error interrupts of the I2C. Moves the running
+transaction on, and when it is over starts the next one and then calls the
+completion callback.
+
+@param[in] queue Queue state
+*/
+
+void i2c_queue_irq_handler(struct i2c_queue *queue)
+{
+	if (queue->head) {
+		i2c_queue_irq(queue);
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief I2C Queue Timeout Tick.
+
+Counts down the timeout of the running transaction. When it runs out, the
+I2C is reset, which lets go of the lines if it was holding them, and the
+transaction ends with @ref I2C_TRANSACTION_TIMEOUT.
+
+@param[in] queue Queue state
+*/
+
+void i2c_queue_tick(struct i2c_queue *queue)
+{
+	bool expired = false;
+
+	CM_ATOMIC_BLOCK() {
+		if (queue->head && queue->ticks && --queue->ticks == 0) {
+			i2c_queue_reset(queue->i2c);
+			expired = true;
+		}
+	}
+
+	if (expired) {
+		i2c_queue_done(queue, I2C_TRANSACTION_TIMEOUT);
+	}
+}
+
+/**@}*/
@@ -348,6 +348,17 @@ void i2c_disable_txdma(uint32_t i2c)
 	I2C_CR1(i2c) &= ~I2C_CR1_TXDMAEN;
 }
 
+/* A NACK from the slave ends the transfer, the STOP goes out by itself. */
+static bool i2c_nack_abort(uint32_t i2c)
+{
+	if (!i2c_nack(i2c)) {
+		return false;
+	}
+	while (!(I2C_ISR(i2c) & I2C_ISR_STOPF));
+	I2C_ICR(i2c) = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+	return true;
+}
+
 /**
  * Run a write/read transaction to a given 7bit i2c address
  * If both write & read are provided, the read will use repeated start.
@@ -358,6 +369,9 @@ void i2c_disable_txdma(uint32_t i2c)
  * @param wn length of w
  * @param r destination buffer to read into
  * @param rn number of bytes to read (r should be at least this long)
+ *
+ * A slave that does not acknowledge ends the transaction early, the remaining
+ * data is not sent and @a r is left as it is.
  */
 void i2c_transfer7(uint32_t i2c, uint8_t addr, const uint8_t *w, size_t wn, uint8_t *r, size_t rn)
 {
@@ -374,12 +388,10 @@ void i2c_transfer7(uint32_t i2c, uint8_t addr, const uint8_t *w, size_t wn, uint
 		i2c_send_start(i2c);
 
 		while (wn--) {
-			bool wait = true;
-			while (wait) {
-				if (i2c_transmit_int_status(i2c)) {
-					wait = false;
+			while (!i2c_transmit_int_status(i2c)) {
+				if (i2c_nack_abort(i2c)) {
+					return;
 				}
-				while (i2c_nack(i2c)); /* FIXME Some error */
 			}
 			i2c_send_data(i2c, *w++);
 		}
@@ -387,7 +399,11 @@ void i2c_transfer7(uint32_t i2c, uint8_t addr, const uint8_t *w, size_t wn, uint
 		 * RM implies it will stall until it can write out the later bits
 		 */
 		if (rn) {
-			while (!i2c_transfer_complete(i2c));
+			while (!i2c_transfer_complete(i2c)) {
+				if (i2c_nack_abort(i2c)) {
+					return;
+				}
+			}
 		}
 	}
 
@@ -402,7 +418,11 @@ void i2c_transfer7(uint32_t i2c, uint8_t addr, const uint8_t *w, size_t wn, uint
 		i2c_enable_autoend(i2c);
 
 		for (size_t i = 0; i < rn; i++) {
-			while (i2c_received_data(i2c) == 0);
+			while (i2c_received_data(i2c) == 0) {
+				if (i2c_nack_abort(i2c)) {
+					return;
+				}
+			}
 			r[i] = i2c_get_data(i2c);
 		}
 	}
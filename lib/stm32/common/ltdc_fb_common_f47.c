@@ -0,0 +1,423 @@
+/** @addtogroup ltdc_file
+ *
+ * LGPL License Terms @ref lgpl_license
+ */
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/ltdc.h>
+
+/**@{*/
+
+/* Bytes per pixel, by LTDC_LxPFCR_* */
+static const uint8_t ltdc_fb_bytes[] = {
+	4, 3, 2, 2, 2, 1, 1, 2,
+};
+
+/* Buffers start on a 1K boundary, so they do not share SDRAM rows */
+#define LTDC_FB_ALIGN		1024
+
+static void ltdc_fb_copied(struct dma2d_op *op, bool ok)
+{
+	struct ltdc_fb *fb = ((struct ltdc_fb_copy *)op)->fb;
+
+	(void)ok;
+	fb->copies--;
+}
+
+static void ltdc_fb_surface(const struct ltdc_fb *fb, int8_t buffer,
+			    struct dma2d_surface *surface)
+{
+	surface->pixels = fb->buffer[buffer];
+	surface->width = fb->width;
+	surface->format = fb->format;
+	surface->clut = NULL;
+	surface->clut_len = 0;
+	surface->color = 0;
+}
+
+/* Queues the oldest waiting buffer for the next vertical blanking */
+static void ltdc_fb_load(struct ltdc_fb *fb)
+{
+	fb->loading = fb->pending;
+	fb->pending = -1;
+	ltdc_set_fbuffer_address(fb->layer,
+				 (uint32_t)fb->buffer[fb->loading]);
+	ltdc_reload(LTDC_SRCR_VBR);
+}
+
+/* Picks the buffer with the newest frame of those not on or bound for the
+ * screen, -1 if there is none */
+static int8_t ltdc_fb_free(const struct ltdc_fb *fb)
+{
+	int8_t i, best = -1;
+
+	for (i = 0; i < fb->count; i++) {
+		if ((i == fb->front) || (i == fb->loading) ||
+		    (i == fb->pending)) {
+			continue;
+		}
+		if ((best < 0) || (fb->content[i] > fb->content[best])) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+/* Copies what changed since its frame from the newest frame into a buffer */
+static void ltdc_fb_repair(struct ltdc_fb *fb, int8_t buffer)
+{
+	struct dma2d_surface src, dst;
+	const struct ltdc_fb_rect *r;
+	uint32_t frame, from = fb->content[buffer];
+	uint8_t i, slot, n = 0;
+
+	if (from == fb->seq) {
+		return;
+	}
+
+	ltdc_fb_surface(fb, fb->latest, &src);
+	ltdc_fb_surface(fb, buffer, &dst);
+	if (fb->seq - from >= LTDC_FB_HISTORY) {
+		dma2d_op_copy(&fb->copy[n++].op, &dst, 0, 0, &src, 0, 0,
+			      fb->width, fb->height);
+	} else {
+		for (frame = from + 1; frame <= fb->seq; frame++) {
+			slot = frame % LTDC_FB_HISTORY;
+			for (i = 0; i < fb->damage_count[slot]; i++) {
+				r = &fb->damage[slot][i];
+				dma2d_op_copy(&fb->copy[n++].op, &dst, r->x,
+					      r->y, &src, r->x, r->y, r->w,
+					      r->h);
+			}
+		}
+	}
+
+	fb->copies = n;
+	for (i = 0; i < n; i++) {
+		fb->copy[i].fb = fb;
+		fb->copy[i].op.callback = ltdc_fb_copied;
+		dma2d_submit(&fb->copy[i].op);
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Initialise
+
+Lays out the buffers one after the other in an SDRAM bank and shows the
+first one on the layer. The bank is brought back to normal mode if it was
+left in self refresh or power down. The layer window, timings and the LTDC
+itself are set up as before, ltdc_fb_irq_handler() is to be called from
+lcd_tft_isr(), with the LCD_TFT interrupt enabled in the NVIC.
+
+The line interrupt is set to the first line after the active area, to
+count the refreshes. Only one layer of the LTDC can be managed this way.
+
+@param[out] fb Framebuffers to set up
+@param[in] layer @ref ltdc_layer_num
+@param[in] format LTDC_LxPFCR_*, one the DMA2D can write: ARGB8888,
+RGB888, RGB565, ARGB1555 or ARGB4444
+@param[in] width Pixels per line
+@param[in] height Lines
+@param[in] count Number of buffers, 2 or 3
+@param[in] bank SDRAM_BANK1 or SDRAM_BANK2
+@param[in] offset Bytes from the start of the bank to the first buffer
+@returns false if the arguments are not supported
+*/
+bool ltdc_fb_init(struct ltdc_fb *fb, uint32_t layer, uint8_t format,
+		  uint16_t width, uint16_t height, uint8_t count,
+		  enum fmc_sdram_bank bank, uint32_t offset)
+{
+	uint32_t base, line, size, shift;
+	uint8_t i;
+
+	if ((count < 2) || (count > LTDC_FB_MAX_BUFFERS) ||
+	    (format > LTDC_LxPFCR_ARGB4444)) {
+		return false;
+	}
+
+	switch (bank) {
+	case SDRAM_BANK1:
+		base = FMC_BANK7_BASE;
+		shift = FMC_SDSR_MODE1_SHIFT;
+		break;
+	case SDRAM_BANK2:
+		base = FMC_BANK8_BASE;
+		shift = FMC_SDSR_MODE2_SHIFT;
+		break;
+	default:
+		return false;
+	}
+	if (((FMC_SDSR >> shift) & 3) != FMC_SDSR_MODE_NORMAL) {
+		sdram_command(bank, SDRAM_NORMAL, 0, 0);
+	}
+
+	line = (uint32_t)width * ltdc_fb_bytes[format];
+	size = (line * height + LTDC_FB_ALIGN - 1) & ~(LTDC_FB_ALIGN - 1);
+
+	fb->layer = layer;
+	fb->width = width;
+	fb->height = height;
+	fb->format = format;
+	fb->count = count;
+	for (i = 0; i < count; i++) {
+		fb->buffer[i] = (uint8_t *)(base + offset + i * size);
+		fb->content[i] = 0;
+	}
+	for (i = 0; i < LTDC_FB_HISTORY; i++) {
+		fb->damage_count[i] = 0;
+	}
+	fb->seq = 0;
+	fb->latest = 0;
+	fb->front = 0;
+	fb->loading = -1;
+	fb->pending = -1;
+	fb->back = -1;
+	fb->copies = 0;
+	ltdc_fb_reset_stats(fb);
+
+	ltdc_set_pixel_format(layer, format);
+	ltdc_set_fb_line_length(layer, line + 3, line);
+	ltdc_set_fb_line_count(layer, height);
+	ltdc_set_fbuffer_address(layer, (uint32_t)fb->buffer[0]);
+	ltdc_reload(LTDC_SRCR_IMR);
+
+	LTDC_LIPCR = ((LTDC_AWCR >> LTDC_AWCR_AAH_SHIFT) &
+		      LTDC_AWCR_AAH_MASK) + 1;
+	LTDC_ICR = LTDC_ICR_CLIF | LTDC_ICR_CRRIF;
+	LTDC_IER |= LTDC_IER_LIE | LTDC_IER_RRIE;
+
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Acquire the Buffer to Draw
+
+Gives the buffer for the next frame. The first call after a swap takes a
+free buffer, when there is one, and queues the DMA2D copies that bring it
+up to the newest frame. DMA2D operations submitted afterwards run after
+them, before drawing with the CPU wait for ltdc_fb_ready().
+
+@param[in] fb Framebuffers
+@param[out] surface The buffer, to draw on
+@returns false if no buffer is free yet, try again after the next refresh
+*/
+bool ltdc_fb_acquire(struct ltdc_fb *fb, struct dma2d_surface *surface)
+{
+	int8_t buffer = fb->back;
+
+	if (buffer < 0) {
+		CM_ATOMIC_BLOCK() {
+			buffer = ltdc_fb_free(fb);
+		}
+		if (buffer < 0) {
+			return false;
+		}
+		ltdc_fb_repair(fb, buffer);
+		fb->damage_count[(fb->seq + 1) % LTDC_FB_HISTORY] = 0;
+		fb->back = buffer;
+	}
+
+	ltdc_fb_surface(fb, buffer, surface);
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Ready for the CPU
+
+@param[in] fb Framebuffers
+@returns true once the acquired buffer holds the newest frame
+*/
+bool ltdc_fb_ready(const struct ltdc_fb *fb)
+{
+	return fb->copies == 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Mark a Region as Drawn
+
+Records a region drawn in the acquired buffer, so the other buffers get it
+copied. A frame swapped without any region is taken as drawn all over.
+
+@param[in] fb Framebuffers
+@param[in] x Left edge
+@param[in] y Top edge
+@param[in] w Width in pixels
+@param[in] h Height in lines
+*/
+void ltdc_fb_damage(struct ltdc_fb *fb, uint16_t x, uint16_t y,
+		    uint16_t w, uint16_t h)
+{
+	uint8_t slot = (fb->seq + 1) % LTDC_FB_HISTORY;
+	struct ltdc_fb_rect *r;
+	uint16_t x2, y2;
+
+	if ((x >= fb->width) || (y >= fb->height)) {
+		return;
+	}
+	if (w > fb->width - x) {
+		w = fb->width - x;
+	}
+	if (h > fb->height - y) {
+		h = fb->height - y;
+	}
+	if (!w || !h) {
+		return;
+	}
+
+	if (fb->damage_count[slot] < LTDC_FB_MAX_DAMAGE) {
+		r = &fb->damage[slot][fb->damage_count[slot]++];
+		r->x = x;
+		r->y = y;
+		r->w = w;
+		r->h = h;
+		return;
+	}
+
+	/* Out of regions, grow the last one over this one */
+	r = &fb->damage[slot][LTDC_FB_MAX_DAMAGE - 1];
+	x2 = r->x + r->w > x + w ? r->x + r->w : x + w;
+	y2 = r->y + r->h > y + h ? r->y + r->h : y + h;
+	r->x = r->x < x ? r->x : x;
+	r->y = r->y < y ? r->y : y;
+	r->w = x2 - r->x;
+	r->h = y2 - r->y;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Swap
+
+Queues the acquired buffer for the screen. It is shown from the next
+vertical blanking on, or after the frame already queued. A queued frame
+that has not reached the screen yet is dropped for this one. The drawing
+must be complete, call this from the callback of the last DMA2D operation
+of the frame when drawing with the DMA2D.
+
+@param[in] fb Framebuffers
+*/
+void ltdc_fb_swap(struct ltdc_fb *fb)
+{
+	uint8_t slot = (fb->seq + 1) % LTDC_FB_HISTORY;
+	int8_t buffer = fb->back;
+
+	if (buffer < 0) {
+		return;
+	}
+	if (!fb->damage_count[slot]) {
+		ltdc_fb_damage(fb, 0, 0, fb->width, fb->height);
+	}
+
+	fb->seq++;
+	fb->content[buffer] = fb->seq;
+	fb->latest = buffer;
+	fb->back = -1;
+
+	CM_ATOMIC_BLOCK() {
+		if (fb->pending >= 0) {
+			fb->stats.dropped++;
+		}
+		fb->pending = buffer;
+		if (fb->loading < 0) {
+			ltdc_fb_load(fb);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Get the Statistics
+
+@param[in] fb Framebuffers
+@param[out] stats Frame times since the last reset
+*/
+void ltdc_fb_get_stats(struct ltdc_fb *fb, struct ltdc_fb_stats *stats)
+{
+	CM_ATOMIC_BLOCK() {
+		*stats = fb->stats;
+	}
+	if (!stats->frames) {
+		stats->min_refreshes = 0;
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Reset the Statistics
+
+@param[in] fb Framebuffers
+*/
+void ltdc_fb_reset_stats(struct ltdc_fb *fb)
+{
+	CM_ATOMIC_BLOCK() {
+		fb->stats.refreshes = 0;
+		fb->stats.frames = 0;
+		fb->stats.dropped = 0;
+		fb->stats.min_refreshes = UINT32_MAX;
+		fb->stats.max_refreshes = 0;
+		fb->stats.repeats = 0;
+		fb->shown_at = 0;
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief LTDC Framebuffers Interrupt Handler
+
+Counts the refreshes and, once a queued buffer is on screen, frees the one
+it replaced and queues the next. To be called from lcd_tft_isr().
+
+@param[in] fb Framebuffers
+*/
+void ltdc_fb_irq_handler(struct ltdc_fb *fb)
+{
+	uint32_t isr = LTDC_ISR;
+	uint32_t shown;
+
+	if (isr & LTDC_ISR_LIF) {
+		LTDC_ICR = LTDC_ICR_CLIF;
+		fb->stats.refreshes++;
+	}
+
+	if (!(isr & LTDC_ISR_RRIF)) {
+		return;
+	}
+	LTDC_ICR = LTDC_ICR_CRRIF;
+	if (fb->loading < 0) {
+		return;
+	}
+
+	/* How long the frame it replaces was on screen */
+	shown = fb->stats.refreshes - fb->shown_at;
+	fb->shown_at = fb->stats.refreshes;
+	fb->stats.frames++;
+	if (shown < fb->stats.min_refreshes) {
+		fb->stats.min_refreshes = shown;
+	}
+	if (shown > fb->stats.max_refreshes) {
+		fb->stats.max_refreshes = shown;
+	}
+	if (shown > 1) {
+		fb->stats.repeats += shown - 1;
+	}
+
+	fb->front = fb->loading;
+	fb->loading = -1;
+	if (fb->pending >= 0) {
+		ltdc_fb_load(fb);
+	}
+}
+
+/**@}*/
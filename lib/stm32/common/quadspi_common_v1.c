@@ -1,5 +1,20 @@
-
 #include <libopencm3/stm32/quadspi.h>
+#if defined(QUADSPI_CR_DMAEN)
+#include <libopencm3/stm32/dma.h>
+#endif
+
+#define QUADSPI_FCR_ALL		(QUADSPI_FCR_CTOF | QUADSPI_FCR_CSMF | \
+				 QUADSPI_FCR_CTCF | QUADSPI_FCR_CTEF)
+
+/* Quad output fast read, 8 dummy cycles on every vendor's parts */
+static const struct quadspi_command quadspi_nor_read_cmd = {
+	.instruction = QUADSPI_NOR_QUAD_OUTPUT_READ,
+	.instruction_mode = QUADSPI_CCR_MODE_1LINE,
+	.address_mode = QUADSPI_CCR_MODE_1LINE,
+	.address_size = 3,
+	.dummy_cycles = 8,
+	.data_mode = QUADSPI_CCR_MODE_4LINE,
+};
 
 void quadspi_enable(void)
 {
@@ -9,4 +24,330 @@ void quadspi_enable(void)
 void quadspi_disable(void)
 {
 	QUADSPI_CR &= ~QUADSPI_CR_EN;
-}
\ No newline at end of file
+}
+
+void quadspi_set_prescaler(uint8_t prescaler)
+{
+	QUADSPI_CR = (QUADSPI_CR & ~(QUADSPI_CR_PRESCALE_MASK <<
+				     QUADSPI_CR_PRESCALE_SHIFT)) |
+		     (prescaler << QUADSPI_CR_PRESCALE_SHIFT);
+}
+
+void quadspi_set_flash_size(uint8_t size_log2)
+{
+	QUADSPI_DCR = (QUADSPI_DCR & ~(QUADSPI_DCR_FSIZE_MASK <<
+				       QUADSPI_DCR_FSIZE_SHIFT)) |
+		      ((size_log2 - 1) << QUADSPI_DCR_FSIZE_SHIFT);
+}
+
+void quadspi_set_cs_high_time(uint8_t cycles)
+{
+	QUADSPI_DCR = (QUADSPI_DCR & ~(QUADSPI_DCR_CSHT_MASK <<
+				       QUADSPI_DCR_CSHT_SHIFT)) |
+		      ((cycles - 1) << QUADSPI_DCR_CSHT_SHIFT);
+}
+
+void quadspi_enable_sample_shift(void)
+{
+	QUADSPI_CR |= QUADSPI_CR_SSHIFT;
+}
+
+void quadspi_disable_sample_shift(void)
+{
+	QUADSPI_CR &= ~QUADSPI_CR_SSHIFT;
+}
+
+void quadspi_abort(void)
+{
+	QUADSPI_CR |= QUADSPI_CR_ABORT;
+	while (QUADSPI_CR & QUADSPI_CR_ABORT);
+}
+
+bool quadspi_is_busy(void)
+{
+	return QUADSPI_SR & QUADSPI_SR_BUSY;
+}
+
+static uint32_t quadspi_ccr(const struct quadspi_command *cmd, uint32_t fmode)
+{
+	uint32_t ccr;
+
+	ccr = (fmode << QUADSPI_CCR_FMODE_SHIFT) |
+	      (cmd->data_mode << QUADSPI_CCR_DMODE_SHIFT) |
+	      (cmd->dummy_cycles << QUADSPI_CCR_DCYC_SHIFT) |
+	      (cmd->alternate_mode << QUADSPI_CCR_ABMODE_SHIFT) |
+	      (cmd->address_mode << QUADSPI_CCR_ADMODE_SHIFT) |
+	      (cmd->instruction_mode << QUADSPI_CCR_IMODE_SHIFT) |
+	      (cmd->instruction << QUADSPI_CCR_INST_SHIFT);
+	if (cmd->address_mode != QUADSPI_CCR_MODE_NONE) {
+		ccr |= (cmd->address_size - 1) << QUADSPI_CCR_ADSIZE_SHIFT;
+	}
+	if (cmd->alternate_mode != QUADSPI_CCR_MODE_NONE) {
+		ccr |= (cmd->alternate_size - 1) << QUADSPI_CCR_ABSIZE_SHIFT;
+	}
+	if (cmd->ddr) {
+		ccr |= QUADSPI_CCR_DDRM;
+	}
+	return ccr;
+}
+
+/* Load a command into the peripheral. It goes out on the CCR write, or on
+ * the AR write if it has an address. */
+static void quadspi_start(const struct quadspi_command *cmd, uint32_t fmode,
+			  uint32_t address, uint32_t len)
+{
+	while (QUADSPI_SR & QUADSPI_SR_BUSY);
+	QUADSPI_FCR = QUADSPI_FCR_ALL;
+	if (len) {
+		QUADSPI_DLR = len - 1;
+	}
+	if (cmd->alternate_mode != QUADSPI_CCR_MODE_NONE) {
+		QUADSPI_ABR = cmd->alternate;
+	}
+	QUADSPI_CCR = quadspi_ccr(cmd, fmode);
+	if (cmd->address_mode != QUADSPI_CCR_MODE_NONE) {
+		QUADSPI_AR = address;
+	}
+}
+
+/* Wait for the end of an indirect command. */
+static void quadspi_wait(void)
+{
+	while (!(QUADSPI_SR & QUADSPI_SR_TCF));
+	QUADSPI_FCR = QUADSPI_FCR_CTCF;
+}
+
+/* FIFO threshold, in bytes, for the FTF flag and the DMA requests */
+static void quadspi_set_fifo_threshold(uint32_t bytes)
+{
+	QUADSPI_CR = (QUADSPI_CR & ~(QUADSPI_CR_FTHRES_MASK <<
+				     QUADSPI_CR_FTHRES_SHIFT)) |
+		     ((bytes - 1) << QUADSPI_CR_FTHRES_SHIFT);
+}
+
+void quadspi_command(const struct quadspi_command *cmd, uint32_t address)
+{
+	quadspi_start(cmd, QUADSPI_CCR_FMODE_IWRITE, address, 0);
+	quadspi_wait();
+}
+
+void quadspi_read(const struct quadspi_command *cmd, uint32_t address,
+		  void *data, uint32_t len)
+{
+	uint8_t *p = data;
+
+#if defined(QUADSPI_CR_DMAEN)
+	QUADSPI_CR &= ~QUADSPI_CR_DMAEN;
+#endif
+	quadspi_set_fifo_threshold(1);
+	quadspi_start(cmd, QUADSPI_CCR_FMODE_IREAD, address, len);
+	while (len--) {
+		while (!(QUADSPI_SR & (QUADSPI_SR_FTF | QUADSPI_SR_TCF)));
+		*p++ = QUADSPI_BYTE_DR;
+	}
+	quadspi_wait();
+}
+
+void quadspi_write(const struct quadspi_command *cmd, uint32_t address,
+		   const void *data, uint32_t len)
+{
+	const uint8_t *p = data;
+
+#if defined(QUADSPI_CR_DMAEN)
+	QUADSPI_CR &= ~QUADSPI_CR_DMAEN;
+#endif
+	quadspi_set_fifo_threshold(1);
+	quadspi_start(cmd, QUADSPI_CCR_FMODE_IWRITE, address, len);
+	while (len--) {
+		while (!(QUADSPI_SR & QUADSPI_SR_FTF));
+		QUADSPI_BYTE_DR = *p++;
+	}
+	quadspi_wait();
+}
+
+#if defined(QUADSPI_CR_DMAEN)
+
+#if defined(DMA_SxCR_EN)
+#define QUADSPI_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_DMEIF | \
+				 DMA_FEIF)
+#else
+#define QUADSPI_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_GIF)
+#endif
+
+/* One shot transfer between the data register and memory, the request
+ * selection of the channel is left as the caller set it up. */
+static void quadspi_dma_start(uint32_t dma, uint8_t channel, bool to_quadspi,
+			      const void *data, uint32_t len)
+{
+	bool words = !(((uint32_t)data | len) & 3);
+
+#if defined(DMA_SxCR_EN)
+	uint32_t chsel = DMA_SCR(dma, channel) & DMA_SxCR_CHSEL_MASK;
+
+	dma_stream_reset(dma, channel);
+	dma_channel_select(dma, channel, chsel);
+	dma_set_transfer_mode(dma, channel,
+			      to_quadspi ? DMA_SxCR_DIR_MEM_TO_PERIPHERAL :
+					   DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+	dma_set_peripheral_size(dma, channel, words ? DMA_SxCR_PSIZE_32BIT :
+						      DMA_SxCR_PSIZE_8BIT);
+	dma_set_memory_size(dma, channel, words ? DMA_SxCR_MSIZE_32BIT :
+						  DMA_SxCR_MSIZE_8BIT);
+#else
+	dma_channel_reset(dma, channel);
+	if (to_quadspi) {
+		dma_set_read_from_memory(dma, channel);
+	} else {
+		dma_set_read_from_peripheral(dma, channel);
+	}
+	dma_set_peripheral_size(dma, channel, words ? DMA_CCR_PSIZE_32BIT :
+						      DMA_CCR_PSIZE_8BIT);
+	dma_set_memory_size(dma, channel, words ? DMA_CCR_MSIZE_32BIT :
+						  DMA_CCR_MSIZE_8BIT);
+#endif
+	dma_clear_interrupt_flags(dma, channel, QUADSPI_DMA_FLAGS);
+	dma_set_peripheral_address(dma, channel, (uint32_t)&QUADSPI_DR);
+	dma_enable_memory_increment_mode(dma, channel);
+	dma_set_memory_address(dma, channel, (uint32_t)data);
+	dma_set_number_of_data(dma, channel, words ? len / 4 : len);
+#if defined(DMA_SxCR_EN)
+	dma_enable_stream(dma, channel);
+#else
+	dma_enable_channel(dma, channel);
+#endif
+
+	quadspi_set_fifo_threshold(words ? 4 : 1);
+	QUADSPI_CR |= QUADSPI_CR_DMAEN;
+}
+
+void quadspi_read_dma(const struct quadspi_command *cmd, uint32_t address,
+		      uint32_t dma, uint8_t channel, void *data, uint32_t len)
+{
+	while (QUADSPI_SR & QUADSPI_SR_BUSY);
+	quadspi_dma_start(dma, channel, false, data, len);
+	quadspi_start(cmd, QUADSPI_CCR_FMODE_IREAD, address, len);
+}
+
+void quadspi_write_dma(const struct quadspi_command *cmd, uint32_t address,
+		       uint32_t dma, uint8_t channel, const void *data,
+		       uint32_t len)
+{
+	while (QUADSPI_SR & QUADSPI_SR_BUSY);
+	quadspi_dma_start(dma, channel, true, data, len);
+	quadspi_start(cmd, QUADSPI_CCR_FMODE_IWRITE, address, len);
+}
+
+#endif
+
+void quadspi_start_polling(const struct quadspi_command *cmd, uint8_t len,
+			   uint32_t mask, uint32_t match, uint16_t interval)
+{
+	while (QUADSPI_SR & QUADSPI_SR_BUSY);
+	QUADSPI_PSMKR = mask;
+	QUADSPI_PSMAR = match;
+	QUADSPI_PIR = interval;
+	/* Stop on the match, AND of the masked bits */
+	QUADSPI_CR = (QUADSPI_CR | QUADSPI_CR_APMS) & ~QUADSPI_CR_PMM;
+	quadspi_start(cmd, QUADSPI_CCR_FMODE_APOLL, 0, len);
+}
+
+bool quadspi_poll_matched(void)
+{
+	if (!(QUADSPI_SR & QUADSPI_SR_SMF)) {
+		return false;
+	}
+	QUADSPI_FCR = QUADSPI_FCR_CSMF;
+	return true;
+}
+
+void quadspi_memory_map(const struct quadspi_command *cmd)
+{
+	while (QUADSPI_SR & QUADSPI_SR_BUSY);
+	QUADSPI_FCR = QUADSPI_FCR_ALL;
+	if (cmd->alternate_mode != QUADSPI_CCR_MODE_NONE) {
+		QUADSPI_ABR = cmd->alternate;
+	}
+	QUADSPI_CCR = quadspi_ccr(cmd, QUADSPI_CCR_FMODE_MEMMAP);
+}
+
+static void quadspi_nor_simple(uint8_t instruction, uint32_t address,
+			       bool has_address)
+{
+	struct quadspi_command cmd = {
+		.instruction = instruction,
+		.instruction_mode = QUADSPI_CCR_MODE_1LINE,
+		.address_mode = has_address ? QUADSPI_CCR_MODE_1LINE :
+					      QUADSPI_CCR_MODE_NONE,
+		.address_size = 3,
+	};
+
+	quadspi_command(&cmd, address);
+}
+
+void quadspi_nor_read_id(uint8_t id[3])
+{
+	static const struct quadspi_command cmd = {
+		.instruction = QUADSPI_NOR_READ_ID,
+		.instruction_mode = QUADSPI_CCR_MODE_1LINE,
+		.data_mode = QUADSPI_CCR_MODE_1LINE,
+	};
+
+	quadspi_read(&cmd, 0, id, 3);
+}
+
+void quadspi_nor_wait_ready(void)
+{
+	static const struct quadspi_command cmd = {
+		.instruction = QUADSPI_NOR_READ_STATUS,
+		.instruction_mode = QUADSPI_CCR_MODE_1LINE,
+		.data_mode = QUADSPI_CCR_MODE_1LINE,
+	};
+
+	quadspi_start_polling(&cmd, 1, QUADSPI_NOR_SR_WIP, 0, 16);
+	while (!quadspi_poll_matched());
+}
+
+void quadspi_nor_erase_sector(uint32_t address)
+{
+	quadspi_nor_simple(QUADSPI_NOR_WRITE_ENABLE, 0, false);
+	quadspi_nor_simple(QUADSPI_NOR_SECTOR_ERASE, address, true);
+	quadspi_nor_wait_ready();
+}
+
+void quadspi_nor_program(uint32_t address, const void *data, uint32_t len)
+{
+	static const struct quadspi_command cmd = {
+		.instruction = QUADSPI_NOR_PAGE_PROGRAM,
+		.instruction_mode = QUADSPI_CCR_MODE_1LINE,
+		.address_mode = QUADSPI_CCR_MODE_1LINE,
+		.address_size = 3,
+		.data_mode = QUADSPI_CCR_MODE_1LINE,
+	};
+	const uint8_t *p = data;
+	uint32_t chunk;
+
+	while (len) {
+		/* A page program wraps around within the page */
+		chunk = QUADSPI_NOR_PAGE_SIZE -
+			(address & (QUADSPI_NOR_PAGE_SIZE - 1));
+		if (chunk > len) {
+			chunk = len;
+		}
+		quadspi_nor_simple(QUADSPI_NOR_WRITE_ENABLE, 0, false);
+		quadspi_write(&cmd, address, p, chunk);
+		quadspi_nor_wait_ready();
+		address += chunk;
+		p += chunk;
+		len -= chunk;
+	}
+}
+
+void quadspi_nor_read(uint32_t address, void *data, uint32_t len)
+{
+	quadspi_read(&quadspi_nor_read_cmd, address, data, len);
+}
+
+void quadspi_nor_memory_map(void)
+{
+	quadspi_memory_map(&quadspi_nor_read_cmd);
+}
@@ -0,0 +1,241 @@
+/** @addtogroup spi_file SPI peripheral API
+ * @ingroup peripheral_apis
+
+This part runs queued SPI master transactions on DMA, see @ref spi_api_queue.
+
+*/
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/spi.h>
+#include <libopencm3/stm32/dma.h>
+#include <libopencm3/stm32/gpio.h>
+
+/**@{*/
+
+#if defined(DMA_SxCR_EN)
+#define SPI_QUEUE_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_DMEIF | \
+				 DMA_FEIF)
+#else
+#define SPI_QUEUE_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_GIF)
+#endif
+
+/* Sent for transactions without transmit data, and where received frames
+ * without a buffer go. */
+static const uint16_t spi_queue_fill = 0xffff;
+static uint16_t spi_queue_sink;
+
+/* Frames between the data register and memory, the request selection of the
+ * channel is left as the caller set it up. */
+static void spi_queue_dma_setup(uint32_t dma, uint8_t channel, uint32_t spi,
+				bool to_spi, bool wide)
+{
+#if defined(DMA_SxCR_EN)
+	uint32_t chsel = DMA_SCR(dma, channel) & DMA_SxCR_CHSEL_MASK;
+
+	dma_stream_reset(dma, channel);
+	dma_channel_select(dma, channel, chsel);
+	dma_set_transfer_mode(dma, channel,
+			      to_spi ? DMA_SxCR_DIR_MEM_TO_PERIPHERAL :
+				       DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+	dma_set_peripheral_size(dma, channel, wide ? DMA_SxCR_PSIZE_16BIT :
+						     DMA_SxCR_PSIZE_8BIT);
+	dma_set_memory_size(dma, channel, wide ? DMA_SxCR_MSIZE_16BIT :
+						 DMA_SxCR_MSIZE_8BIT);
+#else
+	dma_channel_reset(dma, channel);
+	if (to_spi) {
+		dma_set_read_from_memory(dma, channel);
+	} else {
+		dma_set_read_from_peripheral(dma, channel);
+	}
+	dma_set_peripheral_size(dma, channel, wide ? DMA_CCR_PSIZE_16BIT :
+						     DMA_CCR_PSIZE_8BIT);
+	dma_set_memory_size(dma, channel, wide ? DMA_CCR_MSIZE_16BIT :
+						 DMA_CCR_MSIZE_8BIT);
+#endif
+	dma_set_peripheral_address(dma, channel, (uint32_t)&SPI_DR(spi));
+}
+
+static void spi_queue_dma_arm(uint32_t dma, uint8_t channel,
+			      const void *mem, uint16_t len)
+{
+#if defined(DMA_SxCR_EN)
+	dma_disable_stream(dma, channel);
+	while (DMA_SCR(dma, channel) & DMA_SxCR_EN);
+#else
+	dma_disable_channel(dma, channel);
+#endif
+	dma_clear_interrupt_flags(dma, channel, SPI_QUEUE_DMA_FLAGS);
+	if (mem == &spi_queue_fill || mem == &spi_queue_sink) {
+		dma_disable_memory_increment_mode(dma, channel);
+	} else {
+		dma_enable_memory_increment_mode(dma, channel);
+	}
+	dma_set_memory_address(dma, channel, (uint32_t)mem);
+	dma_set_number_of_data(dma, channel, len);
+#if defined(DMA_SxCR_EN)
+	dma_enable_stream(dma, channel);
+#else
+	dma_enable_channel(dma, channel);
+#endif
+}
+
+/* Assert the chip select and hand both buffers to the DMA. Receive is armed
+ * first, so that no frame clocked in is missed. */
+static void spi_queue_start(struct spi_queue *queue)
+{
+	struct spi_transaction *t = queue->head;
+
+	if (t->cs_port) {
+		gpio_clear(t->cs_port, t->cs_pins);
+	}
+	spi_queue_dma_arm(queue->dma, queue->rx_channel,
+			  t->rx_buf ? t->rx_buf : &spi_queue_sink, t->len);
+	spi_queue_dma_arm(queue->dma, queue->tx_channel,
+			  t->tx_buf ? t->tx_buf : &spi_queue_fill, t->len);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief SPI Queue Initialise.
+
+Sets up both DMA channels for the frame size the SPI is configured for, and
+enables its DMA requests. The SPI must be configured as master beforehand.
+
+@param[in] queue Queue state
+@param[in] spi Unsigned int32. SPI peripheral identifier @ref spi_reg_base.
+@param[in] dma Unsigned int32. DMA controller base address
+@param[in] rx_channel Unsigned int8. DMA channel or stream for reception
+@param[in] tx_channel Unsigned int8. DMA channel or stream for transmission
+*/
+
+void spi_queue_init(struct spi_queue *queue, uint32_t spi, uint32_t dma,
+		    uint8_t rx_channel, uint8_t tx_channel)
+{
+	bool wide;
+
+#if defined(SPI_CR2_DS_MASK)
+	wide = (SPI_CR2(spi) & SPI_CR2_DS_MASK) > SPI_CR2_DS_8BIT;
+	if (!wide) {
+		/* RXNE, and so the DMA request, for every byte */
+		SPI_CR2(spi) |= SPI_CR2_FRXTH;
+	}
+#else
+	wide = SPI_CR1(spi) & SPI_CR1_DFF;
+#endif
+
+	queue->spi = spi;
+	queue->dma = dma;
+	queue->rx_channel = rx_channel;
+	queue->tx_channel = tx_channel;
+	queue->head = NULL;
+	queue->tail = NULL;
+
+	spi_queue_dma_setup(dma, rx_channel, spi, false, wide);
+	dma_enable_transfer_complete_interrupt(dma, rx_channel);
+	spi_queue_dma_setup(dma, tx_channel, spi, true, wide);
+
+	spi_enable_rx_dma(spi);
+	spi_enable_tx_dma(spi);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief SPI Queue Submit a Transaction.
+
+The transaction starts at once if the queue is idle, otherwise when the ones
+before it are done. It must not be changed until its callback.
+
+@param[in] queue Queue state
+@param[in] transaction Transaction to append
+*/
+
+void spi_queue_submit(struct spi_queue *queue,
+		      struct spi_transaction *transaction)
+{
+	bool idle;
+
+	transaction->next = NULL;
+	CM_ATOMIC_BLOCK() {
+		idle = queue->head == NULL;
+		if (idle) {
+			queue->head = transaction;
+		} else {
+			queue->tail->next = transaction;
+		}
+		queue->tail = transaction;
+	}
+
+	if (idle) {
+		spi_queue_start(queue);
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief SPI Queue Busy.
+
+@param[in] queue Queue state
+@returns true while transactions are queued or running
+*/
+
+bool spi_queue_busy(struct spi_queue *queue)
+{
+	return queue->head != NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief SPI Queue Interrupt Handler.
+
+Call from the interrupt of the receive DMA channel. Finishes the running
+transaction, starts the next one and then calls the completion callback.
+
+@param[in] queue Queue state
+*/
+
+void spi_queue_irq_handler(struct spi_queue *queue)
+{
+	struct spi_transaction *t = queue->head;
+
+	if (!t || !dma_get_interrupt_flag(queue->dma, queue->rx_channel,
+					  DMA_TCIF)) {
+		return;
+	}
+	dma_clear_interrupt_flags(queue->dma, queue->rx_channel, DMA_TCIF);
+
+	/* The last frame is in, so the bus is quiet. */
+	if (t->cs_port && !(t->flags & SPI_TRANSACTION_CS_HOLD)) {
+		gpio_set(t->cs_port, t->cs_pins);
+	}
+
+	CM_ATOMIC_BLOCK() {
+		queue->head = t->next;
+		if (!queue->head) {
+			queue->tail = NULL;
+		}
+	}
+	if (queue->head) {
+		spi_queue_start(queue);
+	}
+
+	if (t->callback) {
+		t->callback(t);
+	}
+}
+
+/**@}*/
@@ -30,6 +30,10 @@
 uint8_t st_usbfs_force_nak[8];
 struct _usbd_device st_usbfs_dev;
 
+/* Double buffered IN endpoints with a packet waiting behind the one in
+ * flight, one bit per endpoint. */
+static uint8_t st_usbfs_dbl_queued;
+
 void st_usbfs_set_address(usbd_device *dev, uint8_t addr)
 {
 	(void)dev;
@@ -37,20 +41,13 @@ void st_usbfs_set_address(usbd_device *dev, uint8_t addr)
 	SET_REG(USB_DADDR_REG, (addr & USB_DADDR_ADDR) | USB_DADDR_EF);
 }
 
-/**
- * Set the receive buffer size for a given USB endpoint.
- *
- * @param dev the usb device handle returned from @ref usbd_init
- * @param ep Index of endpoint to configure.
- * @param size Size in bytes of the RX buffer. Legal sizes : {2,4,6...62}; {64,96,128...992}.
- * @returns (uint16) Actual size set
- */
-uint16_t st_usbfs_set_ep_rx_bufsize(usbd_device *dev, uint8_t ep, uint32_t size)
+/* Encode an RX buffer size for a COUNT_RX field, returning the real size */
+static uint16_t st_usbfs_rx_count(uint32_t size, uint16_t *count)
 {
 	uint16_t realsize;
-	(void)dev;
+
 	/*
-	 * Writes USB_COUNTn_RX reg fields : bits <14:10> are NUM_BLOCK; bit 15 is BL_SIZE
+	 * Encodes USB_COUNTn_RX reg fields : bits <14:10> are NUM_BLOCK; bit 15 is BL_SIZE
 	 * - When (size <= 62), BL_SIZE is set to 0 and NUM_BLOCK set to (size / 2).
 	 * - When (size > 62), BL_SIZE is set to 1 and NUM_BLOCK=((size / 32) - 1).
 	 *
@@ -72,11 +69,82 @@ uint16_t st_usbfs_set_ep_rx_bufsize(usbd_device *dev, uint8_t ep, uint32_t size)
 		size = (size + 1) >> 1;
 		realsize = size << 1;
 	}
+	*count = size << 10;
+	return realsize;
+}
+
+/**
+ * Set the receive buffer size for a given USB endpoint.
+ *
+ * @param dev the usb device handle returned from @ref usbd_init
+ * @param ep Index of endpoint to configure.
+ * @param size Size in bytes of the RX buffer. Legal sizes : {2,4,6...62}; {64,96,128...992}.
+ * @returns (uint16) Actual size set
+ */
+uint16_t st_usbfs_set_ep_rx_bufsize(usbd_device *dev, uint8_t ep, uint32_t size)
+{
+	uint16_t realsize, count;
+	(void)dev;
+
+	realsize = st_usbfs_rx_count(size, &count);
 	/* write to the BL_SIZE and NUM_BLOCK fields */
-	USB_SET_EP_RX_COUNT(ep, size << 10);
+	USB_SET_EP_RX_COUNT(ep, count);
 	return realsize;
 }
 
+static bool st_usbfs_ep_is_dbl(uint8_t ep)
+{
+	return (*USB_EP_REG(ep) & (USB_EP_TYPE | USB_EP_KIND)) ==
+	       (USB_EP_TYPE_BULK | USB_EP_KIND);
+}
+
+static bool st_usbfs_ep_is_iso(uint8_t ep)
+{
+	return (*USB_EP_REG(ep) & USB_EP_TYPE) == USB_EP_TYPE_ISO;
+}
+
+/*
+ * Put the buffer flags of a double buffered endpoint in their idle state.
+ * IN endpoints start with SW_BUF == DTOG_TX, so the peripheral NAKs until
+ * the first packet is released to it. OUT endpoints start with the two
+ * different, so the peripheral may fill buffer 0 straight away.
+ */
+static void st_usbfs_dbl_reset(uint8_t ep, bool in)
+{
+	USB_CLR_EP_TX_DTOG(ep);
+	USB_CLR_EP_RX_DTOG(ep);
+	if (in) {
+		st_usbfs_dbl_queued &= ~(1 << ep);
+	} else {
+		USB_TOG_EP_RX_SW_BUF(ep);
+	}
+}
+
+/*
+ * Double buffered and isochronous endpoints take buffer 0 from the TX and
+ * buffer 1 from the RX half of the buffer descriptor.
+ */
+static void st_usbfs_dbl_setup(usbd_device *dev, uint8_t ep, bool in,
+			       uint16_t max_size)
+{
+	uint16_t realsize, count;
+
+	if (in) {
+		USB_SET_EP_TX_ADDR(ep, dev->pm_top);
+		USB_SET_EP_RX_ADDR(ep, dev->pm_top + max_size);
+		USB_SET_EP_TX_COUNT(ep, 0);
+		USB_SET_EP_RX_COUNT(ep, 0);
+		dev->pm_top += 2 * max_size;
+	} else {
+		realsize = st_usbfs_rx_count(max_size, &count);
+		USB_SET_EP_TX_ADDR(ep, dev->pm_top);
+		USB_SET_EP_RX_ADDR(ep, dev->pm_top + realsize);
+		USB_SET_EP_TX_COUNT(ep, count);
+		USB_SET_EP_RX_COUNT(ep, count);
+		dev->pm_top += 2 * realsize;
+	}
+}
+
 void st_usbfs_ep_setup(usbd_device *dev, uint8_t addr, uint8_t type,
 		uint16_t max_size,
 		void (*callback) (usbd_device *usbd_dev,
@@ -90,12 +158,41 @@ void st_usbfs_ep_setup(usbd_device *dev, uint8_t addr, uint8_t type,
 		[USB_ENDPOINT_ATTR_INTERRUPT] = USB_EP_TYPE_INTERRUPT,
 	};
 	uint8_t dir = addr & 0x80;
+	bool dbl = type & USBD_EP_DOUBLE_BUFFER;
 	addr &= 0x7f;
+	type &= ~USBD_EP_DOUBLE_BUFFER;
 
 	/* Assign address. */
 	USB_SET_EP_ADDR(addr, addr);
 	USB_SET_EP_TYPE(addr, typelookup[type]);
 
+	if (type == USB_ENDPOINT_ATTR_ISOCHRONOUS ||
+	    (dbl && type == USB_ENDPOINT_ATTR_BULK)) {
+		/* Isochronous endpoints are always double buffered. */
+		if (type == USB_ENDPOINT_ATTR_BULK) {
+			USB_SET_EP_KIND(addr);
+		} else {
+			USB_CLR_EP_KIND(addr);
+		}
+		st_usbfs_dbl_setup(dev, addr, dir, max_size);
+		st_usbfs_dbl_reset(addr, dir);
+		if (callback) {
+			dev->user_callback_ctr[addr][dir ? USB_TRANSACTION_IN :
+						     USB_TRANSACTION_OUT] =
+			    (void *)callback;
+		}
+		/* Flow control is done with SW_BUF, not with STAT. */
+		if (dir) {
+			USB_SET_EP_RX_STAT(addr, USB_EP_RX_STAT_DISABLED);
+			USB_SET_EP_TX_STAT(addr, USB_EP_TX_STAT_VALID);
+		} else {
+			USB_SET_EP_TX_STAT(addr, USB_EP_TX_STAT_DISABLED);
+			USB_SET_EP_RX_STAT(addr, USB_EP_RX_STAT_VALID);
+		}
+		return;
+	}
+	USB_CLR_EP_KIND(addr);
+
 	if (dir || (addr == 0)) {
 		USB_SET_EP_TX_ADDR(addr, dev->pm_top);
 		if (callback) {
@@ -130,6 +227,7 @@ void st_usbfs_endpoints_reset(usbd_device *dev)
 		USB_SET_EP_TX_STAT(i, USB_EP_TX_STAT_DISABLED);
 		USB_SET_EP_RX_STAT(i, USB_EP_RX_STAT_DISABLED);
 	}
+	st_usbfs_dbl_queued = 0;
 	dev->pm_top = USBD_PM_TOP + (2 * dev->desc->bMaxPacketSize0);
 }
 
@@ -145,6 +243,16 @@ void st_usbfs_ep_stall_set(usbd_device *dev, uint8_t addr,
 	if (addr & 0x80) {
 		addr &= 0x7F;
 
+		if (st_usbfs_ep_is_dbl(addr)) {
+			/* Reset to DATA0, dropping any queued packets */
+			if (!stall) {
+				st_usbfs_dbl_reset(addr, true);
+			}
+			USB_SET_EP_TX_STAT(addr, stall ? USB_EP_TX_STAT_STALL :
+					   USB_EP_TX_STAT_VALID);
+			return;
+		}
+
 		USB_SET_EP_TX_STAT(addr, stall ? USB_EP_TX_STAT_STALL :
 				   USB_EP_TX_STAT_NAK);
 
@@ -155,7 +263,11 @@ void st_usbfs_ep_stall_set(usbd_device *dev, uint8_t addr,
 	} else {
 		/* Reset to DATA0 if clearing stall condition. */
 		if (!stall) {
-			USB_CLR_EP_RX_DTOG(addr);
+			if (st_usbfs_ep_is_dbl(addr)) {
+				st_usbfs_dbl_reset(addr, false);
+			} else {
+				USB_CLR_EP_RX_DTOG(addr);
+			}
 		}
 
 		USB_SET_EP_RX_STAT(addr, stall ? USB_EP_RX_STAT_STALL :
@@ -197,12 +309,60 @@ void st_usbfs_ep_nak_set(usbd_device *dev, uint8_t addr, uint8_t nak)
 	}
 }
 
+/*
+ * Copy into the buffer owned by the application. If the peripheral is idle
+ * the buffer is released to it at once, otherwise it is queued and released
+ * from st_usbfs_poll() when the packet in flight has gone.
+ */
+static uint16_t st_usbfs_dbl_write_packet(uint8_t addr, const void *buf,
+					  uint16_t len)
+{
+	uint16_t epr = *USB_EP_REG(addr);
+	bool idle = !(epr & USB_EP_TX_DTOG) == !(epr & USB_EP_TX_SW_BUF);
+
+	if (!idle && (st_usbfs_dbl_queued & (1 << addr))) {
+		return 0;
+	}
+
+	if (epr & USB_EP_TX_SW_BUF) {
+		st_usbfs_copy_to_pm(USB_GET_EP_RX_BUFF(addr), buf, len);
+		USB_SET_EP_RX_COUNT(addr, len);
+	} else {
+		st_usbfs_copy_to_pm(USB_GET_EP_TX_BUFF(addr), buf, len);
+		USB_SET_EP_TX_COUNT(addr, len);
+	}
+
+	if (idle) {
+		USB_TOG_EP_TX_SW_BUF(addr);
+	} else {
+		st_usbfs_dbl_queued |= 1 << addr;
+	}
+
+	return len;
+}
+
 uint16_t st_usbfs_ep_write_packet(usbd_device *dev, uint8_t addr,
 				     const void *buf, uint16_t len)
 {
 	(void)dev;
 	addr &= 0x7F;
 
+	if (st_usbfs_ep_is_dbl(addr)) {
+		return st_usbfs_dbl_write_packet(addr, buf, len);
+	}
+
+	if (st_usbfs_ep_is_iso(addr)) {
+		/* No flow control, fill whichever buffer is not next on air */
+		if (*USB_EP_REG(addr) & USB_EP_TX_DTOG) {
+			st_usbfs_copy_to_pm(USB_GET_EP_TX_BUFF(addr), buf, len);
+			USB_SET_EP_TX_COUNT(addr, len);
+		} else {
+			st_usbfs_copy_to_pm(USB_GET_EP_RX_BUFF(addr), buf, len);
+			USB_SET_EP_RX_COUNT(addr, len);
+		}
+		return len;
+	}
+
 	if ((*USB_EP_REG(addr) & USB_EP_TX_STAT) == USB_EP_TX_STAT_VALID) {
 		return 0;
 	}
@@ -214,10 +374,57 @@ uint16_t st_usbfs_ep_write_packet(usbd_device *dev, uint8_t addr,
 	return len;
 }
 
+/* Read the buffer the peripheral filled last, the other one being buffer 1
+ * when DTOG_RX is set. The register is sampled by the caller before it hands
+ * the other buffer over, after which DTOG_RX may move on under us. */
+static uint16_t st_usbfs_read_last_buffer(uint8_t addr, uint16_t epr,
+					  void *buf, uint16_t len)
+{
+	if (epr & USB_EP_RX_DTOG) {
+		len = MIN(USB_GET_EP_TX_COUNT(addr) & 0x3ff, len);
+		st_usbfs_copy_from_pm(buf, USB_GET_EP_TX_BUFF(addr), len);
+	} else {
+		len = MIN(USB_GET_EP_RX_COUNT(addr) & 0x3ff, len);
+		st_usbfs_copy_from_pm(buf, USB_GET_EP_RX_BUFF(addr), len);
+	}
+	return len;
+}
+
+/*
+ * A packet is waiting while the peripheral is held off by SW_BUF. The other
+ * buffer is released to it before copying, so the host can send the next
+ * packet meanwhile.
+ */
+static uint16_t st_usbfs_dbl_read_packet(uint8_t addr, void *buf,
+					 uint16_t len)
+{
+	uint16_t epr = *USB_EP_REG(addr);
+
+	if (!(epr & USB_EP_RX_DTOG) != !(epr & USB_EP_RX_SW_BUF)) {
+		return 0;
+	}
+
+	USB_CLR_EP_RX_CTR(addr);
+	USB_TOG_EP_RX_SW_BUF(addr);
+
+	return st_usbfs_read_last_buffer(addr, epr, buf, len);
+}
+
 uint16_t st_usbfs_ep_read_packet(usbd_device *dev, uint8_t addr,
 					 void *buf, uint16_t len)
 {
 	(void)dev;
+	if (st_usbfs_ep_is_dbl(addr)) {
+		return st_usbfs_dbl_read_packet(addr, buf, len);
+	}
+
+	if (st_usbfs_ep_is_iso(addr)) {
+		uint16_t epr = *USB_EP_REG(addr);
+
+		USB_CLR_EP_RX_CTR(addr);
+		return st_usbfs_read_last_buffer(addr, epr, buf, len);
+	}
+
 	if ((*USB_EP_REG(addr) & USB_EP_RX_STAT) == USB_EP_RX_STAT_VALID) {
 		return 0;
 	}
@@ -233,6 +440,22 @@ uint16_t st_usbfs_ep_read_packet(usbd_device *dev, uint8_t addr,
 	return len;
 }
 
+/* Hand a queued packet of a double buffered IN endpoint to the peripheral
+ * once it has finished with the other buffer. */
+static void st_usbfs_dbl_release(uint8_t ep)
+{
+	uint16_t epr;
+
+	if (!(st_usbfs_dbl_queued & (1 << ep))) {
+		return;
+	}
+	epr = *USB_EP_REG(ep);
+	if (!(epr & USB_EP_TX_DTOG) == !(epr & USB_EP_TX_SW_BUF)) {
+		USB_TOG_EP_TX_SW_BUF(ep);
+		st_usbfs_dbl_queued &= ~(1 << ep);
+	}
+}
+
 void st_usbfs_poll(usbd_device *dev)
 {
 	uint16_t istr = *USB_ISTR_REG;
@@ -259,6 +482,7 @@ void st_usbfs_poll(usbd_device *dev)
 		} else {
 			type = USB_TRANSACTION_IN;
 			USB_CLR_EP_TX_CTR(ep);
+			st_usbfs_dbl_release(ep);
 		}
 
 		if (dev->user_callback_ctr[ep][type]) {
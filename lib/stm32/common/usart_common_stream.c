@@ -0,0 +1,431 @@
+/** @addtogroup usart_file USART peripheral API
+@ingroup peripheral_apis
+
+This part runs a USART as a DMA driven byte stream, see @ref usart_api_stream.
+
+*/
+
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**@{*/
+
+#include <stddef.h>
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/stm32/usart.h>
+#include <libopencm3/stm32/dma.h>
+
+#if defined(USART_RDR)
+#define USART_STREAM_RDR(usart)		(&USART_RDR(usart))
+#define USART_STREAM_TDR(usart)		(&USART_TDR(usart))
+#else
+#define USART_STREAM_RDR(usart)		(&USART_DR(usart))
+#define USART_STREAM_TDR(usart)		(&USART_DR(usart))
+#endif
+
+#if defined(DMA_SxCR_EN)
+#define USART_STREAM_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_DMEIF | \
+				 DMA_FEIF)
+#else
+#define USART_STREAM_DMA_FLAGS	(DMA_TCIF | DMA_HTIF | DMA_TEIF | DMA_GIF)
+#endif
+
+/* Byte wide transfers between a data register and incrementing memory, the
+ * request selection of the channel is left as the caller set it up. */
+static void usart_stream_dma_setup(uint32_t dma, uint8_t channel,
+				   volatile uint32_t *reg, bool to_usart)
+{
+#if defined(DMA_SxCR_EN)
+	uint32_t chsel = DMA_SCR(dma, channel) & DMA_SxCR_CHSEL_MASK;
+
+	dma_stream_reset(dma, channel);
+	dma_channel_select(dma, channel, chsel);
+	dma_set_transfer_mode(dma, channel,
+			      to_usart ? DMA_SxCR_DIR_MEM_TO_PERIPHERAL :
+					 DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+	dma_set_peripheral_size(dma, channel, DMA_SxCR_PSIZE_8BIT);
+	dma_set_memory_size(dma, channel, DMA_SxCR_MSIZE_8BIT);
+#else
+	dma_channel_reset(dma, channel);
+	if (to_usart) {
+		dma_set_read_from_memory(dma, channel);
+	} else {
+		dma_set_read_from_peripheral(dma, channel);
+	}
+	dma_set_peripheral_size(dma, channel, DMA_CCR_PSIZE_8BIT);
+	dma_set_memory_size(dma, channel, DMA_CCR_MSIZE_8BIT);
+#endif
+	dma_set_peripheral_address(dma, channel, (uint32_t)reg);
+	dma_enable_memory_increment_mode(dma, channel);
+}
+
+static void usart_stream_dma_enable(uint32_t dma, uint8_t channel)
+{
+#if defined(DMA_SxCR_EN)
+	dma_enable_stream(dma, channel);
+#else
+	dma_enable_channel(dma, channel);
+#endif
+}
+
+static void usart_stream_dma_disable(uint32_t dma, uint8_t channel)
+{
+#if defined(DMA_SxCR_EN)
+	dma_disable_stream(dma, channel);
+	/* A stream only stops at the end of the current single transfer */
+	while (DMA_SCR(dma, channel) & DMA_SxCR_EN);
+#else
+	dma_disable_channel(dma, channel);
+#endif
+}
+
+/* Send the next contiguous piece of the transmit ring, if any. */
+static void usart_stream_tx_next(struct usart_stream *stream)
+{
+	uint8_t *data;
+	uint32_t len = ringbuf_read_span(&stream->tx, &data);
+
+	if (len > 0xffff) {
+		len = 0xffff;
+	}
+	stream->tx_len = len;
+	if (len == 0) {
+		return;
+	}
+
+	usart_stream_dma_disable(stream->dma, stream->tx_channel);
+	dma_clear_interrupt_flags(stream->dma, stream->tx_channel,
+				  USART_STREAM_DMA_FLAGS);
+	dma_set_memory_address(stream->dma, stream->tx_channel,
+			       (uint32_t)data);
+	dma_set_number_of_data(stream->dma, stream->tx_channel, len);
+	usart_stream_dma_enable(stream->dma, stream->tx_channel);
+}
+
+/* The half and the full point of the receive ring, as flags */
+#define USART_STREAM_RX_HALF	(1 << 0)
+#define USART_STREAM_RX_FULL	(1 << 1)
+
+/* Points of the receive ring the DMA passes going from index from to index
+ * to, those it stores the bytes before of included. */
+static uint32_t usart_stream_rx_passed(struct usart_stream *stream,
+				       uint32_t from, uint32_t to)
+{
+	uint32_t mask = stream->rx.mask;
+	uint32_t len = (to - from) & mask;
+	uint32_t passed = 0;
+
+	if ((((mask + 1) / 2 - from - 1) & mask) < len) {
+		passed |= USART_STREAM_RX_HALF;
+	}
+	if (((0 - from - 1) & mask) < len) {
+		passed |= USART_STREAM_RX_FULL;
+	}
+	return passed;
+}
+
+/* Index of the receive DMA in the ring, taking and clearing the half and
+ * full transfer flags. A point passed while the flags are read sets them
+ * again afterwards, it is remembered so the next call does not count it
+ * twice. */
+static uint32_t usart_stream_rx_position(struct usart_stream *stream,
+					 uint32_t *passed)
+{
+	uint32_t size = stream->rx.mask + 1;
+	uint32_t before, pos;
+
+	before = size - dma_get_number_of_data(stream->dma,
+					       stream->rx_channel);
+	*passed = 0;
+	if (dma_get_interrupt_flag(stream->dma, stream->rx_channel,
+				   DMA_HTIF)) {
+		*passed |= USART_STREAM_RX_HALF;
+	}
+	if (dma_get_interrupt_flag(stream->dma, stream->rx_channel,
+				   DMA_TCIF)) {
+		*passed |= USART_STREAM_RX_FULL;
+	}
+	dma_clear_interrupt_flags(stream->dma, stream->rx_channel,
+				  DMA_HTIF | DMA_TCIF);
+	pos = size - dma_get_number_of_data(stream->dma, stream->rx_channel);
+
+	stream->rx_passed = usart_stream_rx_passed(stream, before, pos);
+	return pos & stream->rx.mask;
+}
+
+/* Publish what the receive DMA stored since the last call. The DMA overran
+ * the reader when it stored more than the ring has room for, or passed a
+ * point of the ring the distance from the last position does not account
+ * for, as it does when going a full round further. Reception is then held
+ * until usart_stream_read() resyncs. */
+static uint32_t usart_stream_rx_update(struct usart_stream *stream)
+{
+	uint32_t head = stream->rx.head;
+	uint32_t expected = stream->rx_passed;
+	uint32_t passed;
+	uint32_t pos = usart_stream_rx_position(stream, &passed);
+	uint32_t len = (pos - head) & stream->rx.mask;
+
+	if (stream->rx_hold) {
+		return 0;
+	}
+	expected |= usart_stream_rx_passed(stream, head, pos);
+	if ((passed & ~expected) || len > ringbuf_free(&stream->rx)) {
+		stream->rx_overruns++;
+		stream->rx_hold = true;
+		return 0;
+	}
+
+	ringbuf_commit(&stream->rx, len);
+	return len;
+}
+
+/* Drop the unread data after an overrun and carry on at the DMA position. */
+static void usart_stream_rx_resync(struct usart_stream *stream)
+{
+	uint32_t passed;
+	uint32_t pos;
+
+	CM_ATOMIC_BLOCK() {
+		pos = usart_stream_rx_position(stream, &passed);
+		stream->rx.head += (pos - stream->rx.head) & stream->rx.mask;
+		stream->rx.tail = stream->rx.head;
+		stream->rx_hold = false;
+	}
+}
+
+/* Clear a pending IDLE line flag, and tell whether there was one. */
+static bool usart_stream_idle(uint32_t usart)
+{
+	if (!(USART_CR1(usart) & USART_CR1_IDLEIE) ||
+	    !usart_get_flag(usart, USART_FLAG_IDLE)) {
+		return false;
+	}
+#if defined(USART_ICR_IDLECF)
+	USART_ICR(usart) = USART_ICR_IDLECF;
+#else
+	/* Status read done above, the data register read clears it. */
+	(void)USART_DR(usart);
+#endif
+	return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Initialise.
+
+Binds the stream state to a USART and the DMA controller serving it. The
+USART is configured (baud rate, format) and enabled by the caller as usual.
+
+@param[in] stream Stream state, stays in use until usart_stream_stop()
+@param[in] usart unsigned 32 bit. USART block register address base @ref
+usart_reg_base
+@param[in] dma unsigned 32 bit. DMA controller base address
+*/
+
+void usart_stream_init(struct usart_stream *stream, uint32_t usart,
+		       uint32_t dma)
+{
+	ringbuf_init(&stream->rx, NULL, 0);
+	ringbuf_init(&stream->tx, NULL, 0);
+	stream->usart = usart;
+	stream->dma = dma;
+	stream->rx_channel = 0;
+	stream->tx_channel = 0;
+	stream->tx_len = 0;
+	stream->rx_callback = NULL;
+	stream->rx_overruns = 0;
+	stream->rx_passed = 0;
+	stream->rx_hold = false;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Start Reception.
+
+The DMA runs in circular mode over @a buf for as long as the stream is
+active. @a callback is called from usart_stream_irq_handler() at the half
+and full points of @a buf and whenever the line goes idle after a frame.
+
+@param[in] stream Stream state
+@param[in] channel unsigned 8 bit. DMA channel or stream number
+@param[in] buf Receive ring storage
+@param[in] size Size of @a buf, a power of two up to 32768
+@param[in] callback Called when data arrived, or NULL to only poll
+*/
+
+void usart_stream_rx_start(struct usart_stream *stream, uint8_t channel,
+			   uint8_t *buf, uint32_t size,
+			   usart_stream_rx_callback callback)
+{
+	ringbuf_init(&stream->rx, buf, size);
+	stream->rx_channel = channel;
+	stream->rx_callback = callback;
+	stream->rx_passed = 0;
+	stream->rx_hold = false;
+
+	usart_stream_dma_setup(stream->dma, channel,
+			       USART_STREAM_RDR(stream->usart), false);
+	dma_set_memory_address(stream->dma, channel, (uint32_t)buf);
+	dma_set_number_of_data(stream->dma, channel, size);
+	dma_enable_circular_mode(stream->dma, channel);
+	dma_enable_half_transfer_interrupt(stream->dma, channel);
+	dma_enable_transfer_complete_interrupt(stream->dma, channel);
+	usart_stream_dma_enable(stream->dma, channel);
+
+	/* Drop an IDLE left over from before the start. */
+	usart_enable_idle_interrupt(stream->usart);
+	usart_stream_idle(stream->usart);
+	usart_enable_rx_dma(stream->usart);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Start Transmission.
+
+@param[in] stream Stream state
+@param[in] channel unsigned 8 bit. DMA channel or stream number
+@param[in] buf Transmit ring storage
+@param[in] size Size of @a buf, a power of two
+*/
+
+void usart_stream_tx_start(struct usart_stream *stream, uint8_t channel,
+			   uint8_t *buf, uint32_t size)
+{
+	ringbuf_init(&stream->tx, buf, size);
+	stream->tx_channel = channel;
+	stream->tx_len = 0;
+
+	usart_stream_dma_setup(stream->dma, channel,
+			       USART_STREAM_TDR(stream->usart), true);
+	dma_enable_transfer_complete_interrupt(stream->dma, channel);
+	usart_enable_tx_dma(stream->usart);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Stop.
+
+Stops both directions. Data not yet sent or read is dropped.
+
+@param[in] stream Stream state
+*/
+
+void usart_stream_stop(struct usart_stream *stream)
+{
+	usart_disable_idle_interrupt(stream->usart);
+	if (stream->rx.buf) {
+		usart_disable_rx_dma(stream->usart);
+		usart_stream_dma_disable(stream->dma, stream->rx_channel);
+	}
+	if (stream->tx.buf) {
+		usart_disable_tx_dma(stream->usart);
+		usart_stream_dma_disable(stream->dma, stream->tx_channel);
+	}
+	usart_stream_init(stream, stream->usart, stream->dma);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Read.
+
+Takes received data out of the ring. Use from one context only, be it the
+main loop or the reception callback.
+
+After an overrun, the data not read yet is dropped here and reception
+carries on with what the DMA stores next. A reader taking the data from the
+ring in place calls this with @a len 0 when @ref usart_stream::rx_overruns
+went up.
+
+@param[in] stream Stream state
+@param[out] data Destination
+@param[in] len Maximum number of bytes
+@returns Number of bytes read
+*/
+
+uint32_t usart_stream_read(struct usart_stream *stream, void *data,
+			   uint32_t len)
+{
+	if (stream->rx_hold) {
+		usart_stream_rx_resync(stream);
+	}
+	return ringbuf_read(&stream->rx, data, len);
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Write.
+
+Queues data for transmission and starts the DMA if it is idle. Use from one
+context only, which must not preempt usart_stream_irq_handler().
+
+@param[in] stream Stream state
+@param[in] data Data to send
+@param[in] len Number of bytes
+@returns Number of bytes queued, less than @a len if the ring is full
+*/
+
+uint32_t usart_stream_write(struct usart_stream *stream, const void *data,
+			    uint32_t len)
+{
+	len = ringbuf_write(&stream->tx, data, len);
+	/* The DMA interrupt carries on by itself while a transfer runs. */
+	if (stream->tx_len == 0) {
+		usart_stream_tx_next(stream);
+	}
+	return len;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Transmission Pending.
+
+@param[in] stream Stream state
+@returns true while queued data has not all been handed to the USART
+*/
+
+bool usart_stream_tx_busy(struct usart_stream *stream)
+{
+	return ringbuf_used(&stream->tx) != 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/** @brief USART Stream Interrupt Handler.
+
+Call from the USART interrupt and from the interrupts of the DMA channels of
+the stream.
+
+@param[in] stream Stream state
+*/
+
+void usart_stream_irq_handler(struct usart_stream *stream)
+{
+	bool idle;
+	uint32_t len;
+
+	if (stream->rx.buf) {
+		idle = usart_stream_idle(stream->usart);
+		len = usart_stream_rx_update(stream);
+		if ((len || idle) && stream->rx_callback) {
+			stream->rx_callback(stream, len, idle);
+		}
+	}
+
+	if (stream->tx_len &&
+	    dma_get_interrupt_flag(stream->dma, stream->tx_channel,
+				   DMA_TCIF)) {
+		dma_clear_interrupt_flags(stream->dma, stream->tx_channel,
+					  DMA_TCIF);
+		ringbuf_consume(&stream->tx, stream->tx_len);
+		usart_stream_tx_next(stream);
+	}
+}
+
+/**@}*/
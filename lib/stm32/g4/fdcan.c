@@ -135,6 +135,39 @@ void fdcan_init_filter(uint32_t canport, uint8_t std_filt, uint8_t ext_filt)
 	}
 }
 
+/** Configure handling of frames no filter rule matches.
+ *
+ * This function can be only called after @ref fdcan_init has already been
+ * called and @ref fdcan_start has not been called yet, as the global filter
+ * configuration is write-protected unless FDCAN block is in INIT mode.
+ *
+ * @param [in] canport FDCAN block base address. See @ref fdcan_block.
+ * @param [in] std_nonmatching Action for standard ID frames no filter matched.
+ *				See @ref fdcan_anf.
+ * @param [in] ext_nonmatching Action for extended ID frames no filter matched.
+ *				See @ref fdcan_anf.
+ * @param [in] reject_std_remote Reject all remote frames with standard ID.
+ * @param [in] reject_ext_remote Reject all remote frames with extended ID.
+ */
+void fdcan_set_global_filter(uint32_t canport, uint8_t std_nonmatching,
+		uint8_t ext_nonmatching, bool reject_std_remote, bool reject_ext_remote)
+{
+	uint32_t gfc = FDCAN_RXGFC(canport);
+
+	gfc &= ~((FDCAN_RXGFC_ANFS_MASK << FDCAN_RXGFC_ANFS_SHIFT)
+		| (FDCAN_RXGFC_ANFE_MASK << FDCAN_RXGFC_ANFE_SHIFT)
+		| FDCAN_RXGFC_RRFS | FDCAN_RXGFC_RRFE);
+	gfc |= ((std_nonmatching & FDCAN_RXGFC_ANFS_MASK) << FDCAN_RXGFC_ANFS_SHIFT)
+		| ((ext_nonmatching & FDCAN_RXGFC_ANFE_MASK) << FDCAN_RXGFC_ANFE_SHIFT);
+	if (reject_std_remote) {
+		gfc |= FDCAN_RXGFC_RRFS;
+	}
+	if (reject_ext_remote) {
+		gfc |= FDCAN_RXGFC_RRFE;
+	}
+	FDCAN_RXGFC(canport) = gfc;
+}
+
 /** Enable FDCAN operation after FDCAN block has been set up.
  *
  * This function will disable FDCAN configuration effectively
@@ -0,0 +1,323 @@
+/* This file is part of the libopencm3 project.
+ *
+ * It was generated by the irq2nvic_h script.
+ *
+ * This part needs to get included in the compilation unit where
+ * blocking_handler gets defined due to the way #pragma works.
+ */
+
+
+/** @defgroup CM3_nvic_isrdecls_STM32H7 User interrupt service routines (ISR) defaults for STM32 H7 series
+    @ingroup CM3_nvic_isrdecls
+
+    @{*/
+
+void wwdg_isr(void) __attribute__((weak, alias("blocking_handler")));
+void pvd_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tamp_stamp_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rtc_wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+void flash_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rcc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void adc1_2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fdcan1_it0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fdcan2_it0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fdcan1_it1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fdcan2_it1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti9_5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_brk_tim9_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_up_tim10_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_trg_com_tim11_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_cc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c1_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c1_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c2_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c2_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti15_10_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rtc_alarm_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_brk_tim12_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_up_tim13_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_trg_com_tim14_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_cc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_str7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fsmc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sdmmc1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void uart4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void uart5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim6_dac_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void eth_isr(void) __attribute__((weak, alias("blocking_handler")));
+void eth_wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fdcan_cal_isr(void) __attribute__((weak, alias("blocking_handler")));
+void cm7_sev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_str7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c3_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c3_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_hs_ep1_out_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_hs_ep1_in_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_hs_wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_hs_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dcmi_isr(void) __attribute__((weak, alias("blocking_handler")));
+void cryp_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hash_rng_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fpu_isr(void) __attribute__((weak, alias("blocking_handler")));
+void uart7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void uart8_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sai1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void ltdc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void ltdc_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2d_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sai2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void quadspi_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lp_tim1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void cec_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c4_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c4_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spdifrx_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_fs_ep1_out_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_fs_ep1_in_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_fs_wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_fs_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dmamux1_ov_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_mst_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_tima_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_timb_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_timc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_timd_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_time_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hrtim1_flt_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm1_it0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm1_it1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm1_it2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm1_it3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sai3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void swpmi1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim15_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim16_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim17_isr(void) __attribute__((weak, alias("blocking_handler")));
+void mdios_wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+void mdios_isr(void) __attribute__((weak, alias("blocking_handler")));
+void jpeg_isr(void) __attribute__((weak, alias("blocking_handler")));
+void mdma_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sdmmc2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hsem0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void adc3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dmamux2_ovr_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void bdma_ch7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void comp_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lptim2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lptim3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lptim4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lptim5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lpuart_isr(void) __attribute__((weak, alias("blocking_handler")));
+void wwdg1_rst_isr(void) __attribute__((weak, alias("blocking_handler")));
+void crs_isr(void) __attribute__((weak, alias("blocking_handler")));
+void ramecc1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sai4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void reserved8_isr(void) __attribute__((weak, alias("blocking_handler")));
+void wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+
+/**@}*/
+
+/* Initialization template for the interrupt vector table. This definition is
+ * used by the startup code generator (vector.c) to set the initial values for
+ * the interrupt handling routines to the chip family specific _isr weak
+ * symbols. */
+
+#define IRQ_HANDLERS \
+    [NVIC_WWDG_IRQ] = wwdg_isr, \
+    [NVIC_PVD_IRQ] = pvd_isr, \
+    [NVIC_TAMP_STAMP_IRQ] = tamp_stamp_isr, \
+    [NVIC_RTC_WKUP_IRQ] = rtc_wkup_isr, \
+    [NVIC_FLASH_IRQ] = flash_isr, \
+    [NVIC_RCC_IRQ] = rcc_isr, \
+    [NVIC_EXTI0_IRQ] = exti0_isr, \
+    [NVIC_EXTI1_IRQ] = exti1_isr, \
+    [NVIC_EXTI2_IRQ] = exti2_isr, \
+    [NVIC_EXTI3_IRQ] = exti3_isr, \
+    [NVIC_EXTI4_IRQ] = exti4_isr, \
+    [NVIC_DMA1_STR0_IRQ] = dma1_str0_isr, \
+    [NVIC_DMA1_STR1_IRQ] = dma1_str1_isr, \
+    [NVIC_DMA1_STR2_IRQ] = dma1_str2_isr, \
+    [NVIC_DMA1_STR3_IRQ] = dma1_str3_isr, \
+    [NVIC_DMA1_STR4_IRQ] = dma1_str4_isr, \
+    [NVIC_DMA1_STR5_IRQ] = dma1_str5_isr, \
+    [NVIC_DMA1_STR6_IRQ] = dma1_str6_isr, \
+    [NVIC_ADC1_2_IRQ] = adc1_2_isr, \
+    [NVIC_FDCAN1_IT0_IRQ] = fdcan1_it0_isr, \
+    [NVIC_FDCAN2_IT0_IRQ] = fdcan2_it0_isr, \
+    [NVIC_FDCAN1_IT1_IRQ] = fdcan1_it1_isr, \
+    [NVIC_FDCAN2_IT1_IRQ] = fdcan2_it1_isr, \
+    [NVIC_EXTI9_5_IRQ] = exti9_5_isr, \
+    [NVIC_TIM1_BRK_TIM9_IRQ] = tim1_brk_tim9_isr, \
+    [NVIC_TIM1_UP_TIM10_IRQ] = tim1_up_tim10_isr, \
+    [NVIC_TIM1_TRG_COM_TIM11_IRQ] = tim1_trg_com_tim11_isr, \
+    [NVIC_TIM1_CC_IRQ] = tim1_cc_isr, \
+    [NVIC_TIM2_IRQ] = tim2_isr, \
+    [NVIC_TIM3_IRQ] = tim3_isr, \
+    [NVIC_TIM4_IRQ] = tim4_isr, \
+    [NVIC_I2C1_EV_IRQ] = i2c1_ev_isr, \
+    [NVIC_I2C1_ER_IRQ] = i2c1_er_isr, \
+    [NVIC_I2C2_EV_IRQ] = i2c2_ev_isr, \
+    [NVIC_I2C2_ER_IRQ] = i2c2_er_isr, \
+    [NVIC_SPI1_IRQ] = spi1_isr, \
+    [NVIC_SPI2_IRQ] = spi2_isr, \
+    [NVIC_USART1_IRQ] = usart1_isr, \
+    [NVIC_USART2_IRQ] = usart2_isr, \
+    [NVIC_USART3_IRQ] = usart3_isr, \
+    [NVIC_EXTI15_10_IRQ] = exti15_10_isr, \
+    [NVIC_RTC_ALARM_IRQ] = rtc_alarm_isr, \
+    [NVIC_RESERVED1_IRQ] = reserved1_isr, \
+    [NVIC_TIM8_BRK_TIM12_IRQ] = tim8_brk_tim12_isr, \
+    [NVIC_TIM8_UP_TIM13_IRQ] = tim8_up_tim13_isr, \
+    [NVIC_TIM8_TRG_COM_TIM14_IRQ] = tim8_trg_com_tim14_isr, \
+    [NVIC_TIM8_CC_IRQ] = tim8_cc_isr, \
+    [NVIC_DMA1_STR7_IRQ] = dma1_str7_isr, \
+    [NVIC_FSMC_IRQ] = fsmc_isr, \
+    [NVIC_SDMMC1_IRQ] = sdmmc1_isr, \
+    [NVIC_TIM5_IRQ] = tim5_isr, \
+    [NVIC_SPI3_IRQ] = spi3_isr, \
+    [NVIC_UART4_IRQ] = uart4_isr, \
+    [NVIC_UART5_IRQ] = uart5_isr, \
+    [NVIC_TIM6_DAC_IRQ] = tim6_dac_isr, \
+    [NVIC_TIM7_IRQ] = tim7_isr, \
+    [NVIC_DMA2_STR0_IRQ] = dma2_str0_isr, \
+    [NVIC_DMA2_STR1_IRQ] = dma2_str1_isr, \
+    [NVIC_DMA2_STR2_IRQ] = dma2_str2_isr, \
+    [NVIC_DMA2_STR3_IRQ] = dma2_str3_isr, \
+    [NVIC_DMA2_STR4_IRQ] = dma2_str4_isr, \
+    [NVIC_ETH_IRQ] = eth_isr, \
+    [NVIC_ETH_WKUP_IRQ] = eth_wkup_isr, \
+    [NVIC_FDCAN_CAL_IRQ] = fdcan_cal_isr, \
+    [NVIC_CM7_SEV_IRQ] = cm7_sev_isr, \
+    [NVIC_RESERVED2_IRQ] = reserved2_isr, \
+    [NVIC_RESERVED3_IRQ] = reserved3_isr, \
+    [NVIC_RESERVED4_IRQ] = reserved4_isr, \
+    [NVIC_DMA2_STR5_IRQ] = dma2_str5_isr, \
+    [NVIC_DMA2_STR6_IRQ] = dma2_str6_isr, \
+    [NVIC_DMA2_STR7_IRQ] = dma2_str7_isr, \
+    [NVIC_USART6_IRQ] = usart6_isr, \
+    [NVIC_I2C3_EV_IRQ] = i2c3_ev_isr, \
+    [NVIC_I2C3_ER_IRQ] = i2c3_er_isr, \
+    [NVIC_OTG_HS_EP1_OUT_IRQ] = otg_hs_ep1_out_isr, \
+    [NVIC_OTG_HS_EP1_IN_IRQ] = otg_hs_ep1_in_isr, \
+    [NVIC_OTG_HS_WKUP_IRQ] = otg_hs_wkup_isr, \
+    [NVIC_OTG_HS_IRQ] = otg_hs_isr, \
+    [NVIC_DCMI_IRQ] = dcmi_isr, \
+    [NVIC_CRYP_IRQ] = cryp_isr, \
+    [NVIC_HASH_RNG_IRQ] = hash_rng_isr, \
+    [NVIC_FPU_IRQ] = fpu_isr, \
+    [NVIC_UART7_IRQ] = uart7_isr, \
+    [NVIC_UART8_IRQ] = uart8_isr, \
+    [NVIC_SPI4_IRQ] = spi4_isr, \
+    [NVIC_SPI5_IRQ] = spi5_isr, \
+    [NVIC_SPI6_IRQ] = spi6_isr, \
+    [NVIC_SAI1_IRQ] = sai1_isr, \
+    [NVIC_LTDC_IRQ] = ltdc_isr, \
+    [NVIC_LTDC_ER_IRQ] = ltdc_er_isr, \
+    [NVIC_DMA2D_IRQ] = dma2d_isr, \
+    [NVIC_SAI2_IRQ] = sai2_isr, \
+    [NVIC_QUADSPI_IRQ] = quadspi_isr, \
+    [NVIC_LP_TIM1_IRQ] = lp_tim1_isr, \
+    [NVIC_CEC_IRQ] = cec_isr, \
+    [NVIC_I2C4_EV_IRQ] = i2c4_ev_isr, \
+    [NVIC_I2C4_ER_IRQ] = i2c4_er_isr, \
+    [NVIC_SPDIFRX_IRQ] = spdifrx_isr, \
+    [NVIC_OTG_FS_EP1_OUT_IRQ] = otg_fs_ep1_out_isr, \
+    [NVIC_OTG_FS_EP1_IN_IRQ] = otg_fs_ep1_in_isr, \
+    [NVIC_OTG_FS_WKUP_IRQ] = otg_fs_wkup_isr, \
+    [NVIC_OTG_FS_IRQ] = otg_fs_isr, \
+    [NVIC_DMAMUX1_OV_IRQ] = dmamux1_ov_isr, \
+    [NVIC_HRTIM1_MST_IRQ] = hrtim1_mst_isr, \
+    [NVIC_HRTIM1_TIMA_IRQ] = hrtim1_tima_isr, \
+    [NVIC_HRTIM1_TIMB_IRQ] = hrtim1_timb_isr, \
+    [NVIC_HRTIM1_TIMC_IRQ] = hrtim1_timc_isr, \
+    [NVIC_HRTIM1_TIMD_IRQ] = hrtim1_timd_isr, \
+    [NVIC_HRTIM1_TIME_IRQ] = hrtim1_time_isr, \
+    [NVIC_HRTIM1_FLT_IRQ] = hrtim1_flt_isr, \
+    [NVIC_DFSDM1_IT0_IRQ] = dfsdm1_it0_isr, \
+    [NVIC_DFSDM1_IT1_IRQ] = dfsdm1_it1_isr, \
+    [NVIC_DFSDM1_IT2_IRQ] = dfsdm1_it2_isr, \
+    [NVIC_DFSDM1_IT3_IRQ] = dfsdm1_it3_isr, \
+    [NVIC_SAI3_IRQ] = sai3_isr, \
+    [NVIC_SWPMI1_IRQ] = swpmi1_isr, \
+    [NVIC_TIM15_IRQ] = tim15_isr, \
+    [NVIC_TIM16_IRQ] = tim16_isr, \
+    [NVIC_TIM17_IRQ] = tim17_isr, \
+    [NVIC_MDIOS_WKUP_IRQ] = mdios_wkup_isr, \
+    [NVIC_MDIOS_IRQ] = mdios_isr, \
+    [NVIC_JPEG_IRQ] = jpeg_isr, \
+    [NVIC_MDMA_IRQ] = mdma_isr, \
+    [NVIC_RESERVED5_IRQ] = reserved5_isr, \
+    [NVIC_SDMMC2_IRQ] = sdmmc2_isr, \
+    [NVIC_HSEM0_IRQ] = hsem0_isr, \
+    [NVIC_RESERVED6_IRQ] = reserved6_isr, \
+    [NVIC_ADC3_IRQ] = adc3_isr, \
+    [NVIC_DMAMUX2_OVR_IRQ] = dmamux2_ovr_isr, \
+    [NVIC_BDMA_CH0_IRQ] = bdma_ch0_isr, \
+    [NVIC_BDMA_CH1_IRQ] = bdma_ch1_isr, \
+    [NVIC_BDMA_CH2_IRQ] = bdma_ch2_isr, \
+    [NVIC_BDMA_CH3_IRQ] = bdma_ch3_isr, \
+    [NVIC_BDMA_CH4_IRQ] = bdma_ch4_isr, \
+    [NVIC_BDMA_CH5_IRQ] = bdma_ch5_isr, \
+    [NVIC_BDMA_CH6_IRQ] = bdma_ch6_isr, \
+    [NVIC_BDMA_CH7_IRQ] = bdma_ch7_isr, \
+    [NVIC_COMP_IRQ] = comp_isr, \
+    [NVIC_LPTIM2_IRQ] = lptim2_isr, \
+    [NVIC_LPTIM3_IRQ] = lptim3_isr, \
+    [NVIC_LPTIM4_IRQ] = lptim4_isr, \
+    [NVIC_LPTIM5_IRQ] = lptim5_isr, \
+    [NVIC_LPUART_IRQ] = lpuart_isr, \
+    [NVIC_WWDG1_RST_IRQ] = wwdg1_rst_isr, \
+    [NVIC_CRS_IRQ] = crs_isr, \
+    [NVIC_RAMECC1_IRQ] = ramecc1_isr, \
+    [NVIC_SAI4_IRQ] = sai4_isr, \
+    [NVIC_RESERVED7_IRQ] = reserved7_isr, \
+    [NVIC_RESERVED8_IRQ] = reserved8_isr, \
+    [NVIC_WKUP_IRQ] = wkup_isr
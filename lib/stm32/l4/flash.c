@@ -40,8 +40,18 @@
 
 /**@{*/
 
+#include <libopencm3/cm3/cortex.h>
+#include <libopencm3/cm3/vector.h>
 #include <libopencm3/stm32/flash.h>
 
+/* Errors that stop a programming */
+#define FLASH_SR_ERRORS		(FLASH_SR_PGSERR | FLASH_SR_SIZERR | \
+				 FLASH_SR_PGAERR | FLASH_SR_WRPERR | \
+				 FLASH_SR_PROGERR)
+/* Errors that stop a fast programming */
+#define FLASH_SR_FAST_ERRORS	(FLASH_SR_ERRORS | FLASH_SR_MISERR | \
+				 FLASH_SR_FASTERR)
+
 /** @brief Wait until Last Operation has Ended
  * This loops indefinitely until an operation (write or erase) has completed
  * by testing the busy flag.
@@ -136,19 +146,91 @@ void flash_program_double_word(uint32_t address, uint64_t data)
 	FLASH_CR &= ~FLASH_CR_PG;
 }
 
+/* Little endian word at an address of any alignment */
+static inline __attribute__((always_inline))
+uint32_t flash_data_word(const uint8_t *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) |
+	       ((uint32_t)data[3] << 24);
+}
+
+/* The programming loops run from RAM, so the core is not stalled fetching
+ * from the flash bank that is being programmed. */
+RAMFUNC static void flash_program_ram(uint32_t address, const uint8_t *data,
+				      uint32_t len)
+{
+	uint32_t i;
+
+	/* Errors left over would stop the loop at the first word */
+	FLASH_SR = FLASH_SR_ERRORS;
+
+	FLASH_CR |= FLASH_CR_PG;
+	for (i = 0; i < len; i += 8) {
+		MMIO32(address + i) = flash_data_word(data + i);
+		MMIO32(address + i + 4) = flash_data_word(data + i + 4);
+		while (FLASH_SR & FLASH_SR_BSY);
+		if (FLASH_SR & FLASH_SR_ERRORS) {
+			break;
+		}
+	}
+	FLASH_CR &= ~FLASH_CR_PG;
+}
+
+RAMFUNC static uint32_t flash_program_row_ram(uint32_t address,
+					      const uint32_t *data)
+{
+	uint32_t primask;
+	uint32_t i;
+
+	/* Errors left over would fail the sequence */
+	FLASH_SR = FLASH_SR_FAST_ERRORS;
+
+	/* Nothing may read the flash until the last word is written */
+	primask = cm_mask_interrupts(1);
+	FLASH_CR |= FLASH_CR_FSTPG;
+	for (i = 0; i < FLASH_ROW_SIZE / 4; i++) {
+		MMIO32(address + i * 4) = data[i];
+		if (FLASH_SR & FLASH_SR_FAST_ERRORS) {
+			break;
+		}
+	}
+	while (FLASH_SR & FLASH_SR_BSY);
+	FLASH_CR &= ~FLASH_CR_FSTPG;
+	cm_mask_interrupts(primask);
+
+	return FLASH_SR & FLASH_SR_FAST_ERRORS;
+}
+
 /** @brief Program a Data Block to FLASH
- * This programs an arbitrary length data block to FLASH memory.
+ * This programs an arbitrary length data block to FLASH memory, a double
+ * word at a time. Programming stops at the first error.
  * The program error flag should be checked separately for the event that
  * memory was not properly erased.
- * @param[in] address Starting address in Flash.
- * @param[in] data Pointer to start of data block.
+ * @param[in] address Starting address in Flash, double word aligned.
+ * @param[in] data Pointer to start of data block, of any alignment.
  * @param[in] len Length of data block in bytes (multiple of 8).
  */
-void flash_program(uint32_t address, uint8_t *data, uint32_t len)
+void flash_program(uint32_t address, const uint8_t *data, uint32_t len)
 {
-	for (uint32_t i = 0; i < len; i += 8) {
-		flash_program_double_word(address+i, *(uint64_t*)(data + i));
-	}
+	flash_wait_for_last_operation();
+	flash_program_ram(address, data, len);
+}
+
+/** @brief Program a Row of FLASH
+ * This programs @ref FLASH_ROW_SIZE bytes with fast programming, which
+ * takes less time than programming them a double word at a time. The bank holding the row
+ * has to be mass erased with flash_erase_all_pages() before, a page erase
+ * is not enough and the programming then fails with FLASH_SR_PGSERR. The
+ * data has to be in RAM, and interrupts are masked while the row is
+ * programmed. Programming stops at the first error.
+ * @param[in] address Starting address in Flash, aligned to the row size.
+ * @param[in] data The words of the row.
+ * @returns The FLASH_SR error flags, 0 if the row was programmed.
+ */
+uint32_t flash_program_row(uint32_t address, const uint32_t *data)
+{
+	flash_wait_for_last_operation();
+	return flash_program_row_ram(address, data);
 }
 
 /** @brief Erase a page of FLASH
@@ -0,0 +1,205 @@
+/* This file is part of the libopencm3 project.
+ *
+ * It was generated by the irq2nvic_h script.
+ *
+ * This part needs to get included in the compilation unit where
+ * blocking_handler gets defined due to the way #pragma works.
+ */
+
+
+/** @defgroup CM3_nvic_isrdecls_STM32L4 User interrupt service routines (ISR) defaults for STM32 L4 series
+    @ingroup CM3_nvic_isrdecls
+
+    @{*/
+
+void wwdg_isr(void) __attribute__((weak, alias("blocking_handler")));
+void pvd_pvm_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tamp_stamp_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rtc_wkup_isr(void) __attribute__((weak, alias("blocking_handler")));
+void flash_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rcc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma1_channel7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void adc1_2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can1_tx_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can1_rx0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can1_rx1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can1_sce_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti9_5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_brk_tim15_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_up_tim16_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_trg_com_tim17_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim1_cc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c1_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c1_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c2_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c2_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void usart3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void exti15_10_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rtc_alarm_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_brk_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_up_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_trg_com_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim8_cc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void adc3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fmc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sdmmc1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void spi3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void uart4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void uart5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim6_dacunder_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tim7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel3_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel4_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel5_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dfsdm2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void comp_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lptim1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lptim2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void otg_fs_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel6_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2_channel7_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lpuart1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void quadspi_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c3_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c3_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sai1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void sai2_isr(void) __attribute__((weak, alias("blocking_handler")));
+void swpmi1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void tsc_isr(void) __attribute__((weak, alias("blocking_handler")));
+void lcd_isr(void) __attribute__((weak, alias("blocking_handler")));
+void aes_isr(void) __attribute__((weak, alias("blocking_handler")));
+void rng_isr(void) __attribute__((weak, alias("blocking_handler")));
+void fpu_isr(void) __attribute__((weak, alias("blocking_handler")));
+void hash_crs_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c4_ev_isr(void) __attribute__((weak, alias("blocking_handler")));
+void i2c4_er_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dcmi_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can2_tx_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can2_rx0_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can2_rx1_isr(void) __attribute__((weak, alias("blocking_handler")));
+void can2_sce_isr(void) __attribute__((weak, alias("blocking_handler")));
+void dma2d_isr(void) __attribute__((weak, alias("blocking_handler")));
+
+/**@}*/
+
+/* Initialization template for the interrupt vector table. This definition is
+ * used by the startup code generator (vector.c) to set the initial values for
+ * the interrupt handling routines to the chip family specific _isr weak
+ * symbols. */
+
+#define IRQ_HANDLERS \
+    [NVIC_WWDG_IRQ] = wwdg_isr, \
+    [NVIC_PVD_PVM_IRQ] = pvd_pvm_isr, \
+    [NVIC_TAMP_STAMP_IRQ] = tamp_stamp_isr, \
+    [NVIC_RTC_WKUP_IRQ] = rtc_wkup_isr, \
+    [NVIC_FLASH_IRQ] = flash_isr, \
+    [NVIC_RCC_IRQ] = rcc_isr, \
+    [NVIC_EXTI0_IRQ] = exti0_isr, \
+    [NVIC_EXTI1_IRQ] = exti1_isr, \
+    [NVIC_EXTI2_IRQ] = exti2_isr, \
+    [NVIC_EXTI3_IRQ] = exti3_isr, \
+    [NVIC_EXTI4_IRQ] = exti4_isr, \
+    [NVIC_DMA1_CHANNEL1_IRQ] = dma1_channel1_isr, \
+    [NVIC_DMA1_CHANNEL2_IRQ] = dma1_channel2_isr, \
+    [NVIC_DMA1_CHANNEL3_IRQ] = dma1_channel3_isr, \
+    [NVIC_DMA1_CHANNEL4_IRQ] = dma1_channel4_isr, \
+    [NVIC_DMA1_CHANNEL5_IRQ] = dma1_channel5_isr, \
+    [NVIC_DMA1_CHANNEL6_IRQ] = dma1_channel6_isr, \
+    [NVIC_DMA1_CHANNEL7_IRQ] = dma1_channel7_isr, \
+    [NVIC_ADC1_2_IRQ] = adc1_2_isr, \
+    [NVIC_CAN1_TX_IRQ] = can1_tx_isr, \
+    [NVIC_CAN1_RX0_IRQ] = can1_rx0_isr, \
+    [NVIC_CAN1_RX1_IRQ] = can1_rx1_isr, \
+    [NVIC_CAN1_SCE_IRQ] = can1_sce_isr, \
+    [NVIC_EXTI9_5_IRQ] = exti9_5_isr, \
+    [NVIC_TIM1_BRK_TIM15_IRQ] = tim1_brk_tim15_isr, \
+    [NVIC_TIM1_UP_TIM16_IRQ] = tim1_up_tim16_isr, \
+    [NVIC_TIM1_TRG_COM_TIM17_IRQ] = tim1_trg_com_tim17_isr, \
+    [NVIC_TIM1_CC_IRQ] = tim1_cc_isr, \
+    [NVIC_TIM2_IRQ] = tim2_isr, \
+    [NVIC_TIM3_IRQ] = tim3_isr, \
+    [NVIC_TIM4_IRQ] = tim4_isr, \
+    [NVIC_I2C1_EV_IRQ] = i2c1_ev_isr, \
+    [NVIC_I2C1_ER_IRQ] = i2c1_er_isr, \
+    [NVIC_I2C2_EV_IRQ] = i2c2_ev_isr, \
+    [NVIC_I2C2_ER_IRQ] = i2c2_er_isr, \
+    [NVIC_SPI1_IRQ] = spi1_isr, \
+    [NVIC_SPI2_IRQ] = spi2_isr, \
+    [NVIC_USART1_IRQ] = usart1_isr, \
+    [NVIC_USART2_IRQ] = usart2_isr, \
+    [NVIC_USART3_IRQ] = usart3_isr, \
+    [NVIC_EXTI15_10_IRQ] = exti15_10_isr, \
+    [NVIC_RTC_ALARM_IRQ] = rtc_alarm_isr, \
+    [NVIC_DFSDM3_IRQ] = dfsdm3_isr, \
+    [NVIC_TIM8_BRK_IRQ] = tim8_brk_isr, \
+    [NVIC_TIM8_UP_IRQ] = tim8_up_isr, \
+    [NVIC_TIM8_TRG_COM_IRQ] = tim8_trg_com_isr, \
+    [NVIC_TIM8_CC_IRQ] = tim8_cc_isr, \
+    [NVIC_ADC3_IRQ] = adc3_isr, \
+    [NVIC_FMC_IRQ] = fmc_isr, \
+    [NVIC_SDMMC1_IRQ] = sdmmc1_isr, \
+    [NVIC_TIM5_IRQ] = tim5_isr, \
+    [NVIC_SPI3_IRQ] = spi3_isr, \
+    [NVIC_UART4_IRQ] = uart4_isr, \
+    [NVIC_UART5_IRQ] = uart5_isr, \
+    [NVIC_TIM6_DACUNDER_IRQ] = tim6_dacunder_isr, \
+    [NVIC_TIM7_IRQ] = tim7_isr, \
+    [NVIC_DMA2_CHANNEL1_IRQ] = dma2_channel1_isr, \
+    [NVIC_DMA2_CHANNEL2_IRQ] = dma2_channel2_isr, \
+    [NVIC_DMA2_CHANNEL3_IRQ] = dma2_channel3_isr, \
+    [NVIC_DMA2_CHANNEL4_IRQ] = dma2_channel4_isr, \
+    [NVIC_DMA2_CHANNEL5_IRQ] = dma2_channel5_isr, \
+    [NVIC_DFSDM0_IRQ] = dfsdm0_isr, \
+    [NVIC_DFSDM1_IRQ] = dfsdm1_isr, \
+    [NVIC_DFSDM2_IRQ] = dfsdm2_isr, \
+    [NVIC_COMP_IRQ] = comp_isr, \
+    [NVIC_LPTIM1_IRQ] = lptim1_isr, \
+    [NVIC_LPTIM2_IRQ] = lptim2_isr, \
+    [NVIC_OTG_FS_IRQ] = otg_fs_isr, \
+    [NVIC_DMA2_CHANNEL6_IRQ] = dma2_channel6_isr, \
+    [NVIC_DMA2_CHANNEL7_IRQ] = dma2_channel7_isr, \
+    [NVIC_LPUART1_IRQ] = lpuart1_isr, \
+    [NVIC_QUADSPI_IRQ] = quadspi_isr, \
+    [NVIC_I2C3_EV_IRQ] = i2c3_ev_isr, \
+    [NVIC_I2C3_ER_IRQ] = i2c3_er_isr, \
+    [NVIC_SAI1_IRQ] = sai1_isr, \
+    [NVIC_SAI2_IRQ] = sai2_isr, \
+    [NVIC_SWPMI1_IRQ] = swpmi1_isr, \
+    [NVIC_TSC_IRQ] = tsc_isr, \
+    [NVIC_LCD_IRQ] = lcd_isr, \
+    [NVIC_AES_IRQ] = aes_isr, \
+    [NVIC_RNG_IRQ] = rng_isr, \
+    [NVIC_FPU_IRQ] = fpu_isr, \
+    [NVIC_HASH_CRS_IRQ] = hash_crs_isr, \
+    [NVIC_I2C4_EV_IRQ] = i2c4_ev_isr, \
+    [NVIC_I2C4_ER_IRQ] = i2c4_er_isr, \
+    [NVIC_DCMI_IRQ] = dcmi_isr, \
+    [NVIC_CAN2_TX_IRQ] = can2_tx_isr, \
+    [NVIC_CAN2_RX0_IRQ] = can2_rx0_isr, \
+    [NVIC_CAN2_RX1_IRQ] = can2_rx1_isr, \
+    [NVIC_CAN2_SCE_IRQ] = can2_sce_isr, \
+    [NVIC_DMA2D_IRQ] = dma2d_isr
@@ -114,6 +114,7 @@ void _usbd_reset(usbd_device *usbd_dev)
 {
 	usbd_dev->current_address = 0;
 	usbd_dev->current_config = 0;
+	_usbd_transfer_reset(usbd_dev);
 	usbd_ep_setup(usbd_dev, 0, USB_ENDPOINT_ATTR_CONTROL, usbd_dev->desc->bMaxPacketSize0, NULL);
 	usbd_dev->driver->set_address(usbd_dev, 0);
 
@@ -122,6 +123,27 @@ void _usbd_reset(usbd_device *usbd_dev)
 	}
 }
 
+/* Forget a queued transfer, giving the endpoint callback back */
+static void usbd_transfer_drop(usbd_device *usbd_dev, uint8_t ep, uint8_t dir)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][dir];
+
+	if (xfer && !usbd_dev->driver->ep_transfer) {
+		usbd_dev->user_callback_ctr[ep][dir] = xfer->saved;
+	}
+	usbd_dev->transfer[ep][dir] = NULL;
+}
+
+void _usbd_transfer_reset(usbd_device *usbd_dev)
+{
+	int i;
+
+	for (i = 1; i < 8; i++) {
+		usbd_transfer_drop(usbd_dev, i, USB_TRANSACTION_IN);
+		usbd_transfer_drop(usbd_dev, i, USB_TRANSACTION_OUT);
+	}
+}
+
 /* Functions to wrap the low-level driver */
 void usbd_poll(usbd_device *usbd_dev)
 {
@@ -140,6 +162,14 @@ __attribute__((weak)) void usbd_disconnect(usbd_device *usbd_dev,
 void usbd_ep_setup(usbd_device *usbd_dev, uint8_t addr, uint8_t type,
 		   uint16_t max_size, usbd_endpoint_callback callback)
 {
+	uint8_t ep = addr & 0x7f;
+	uint8_t dir = (addr & 0x80) ? USB_TRANSACTION_IN : USB_TRANSACTION_OUT;
+
+	if (!usbd_dev->driver->double_buffer) {
+		type &= ~USBD_EP_DOUBLE_BUFFER;
+	}
+	usbd_transfer_drop(usbd_dev, ep, dir);
+	usbd_dev->ep_max_size[ep][dir] = max_size;
 	usbd_dev->driver->ep_setup(usbd_dev, addr, type, max_size, callback);
 }
 
@@ -170,5 +200,131 @@ void usbd_ep_nak_set(usbd_device *usbd_dev, uint8_t addr, uint8_t nak)
 	usbd_dev->driver->ep_nak_set(usbd_dev, addr, nak);
 }
 
+/*
+ * Transfers on drivers without hardware support are run from the endpoint
+ * callbacks, which are borrowed from the user for the duration.
+ */
+static void usbd_transfer_in_fill(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_IN];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_IN];
+	uint16_t len;
+
+	/* Keep going while the driver takes packets, for double buffering */
+	while (xfer->queued < xfer->len) {
+		len = MIN(max_size, xfer->len - xfer->queued);
+		if (usbd_ep_write_packet(usbd_dev, ep, xfer->buf + xfer->queued,
+					 len) != len) {
+			return;
+		}
+		xfer->queued += len;
+	}
+
+	/* The zero length packet goes once everything else is through, as
+	 * its write can't report a busy endpoint. */
+	if (xfer->zlp && xfer->done == xfer->len) {
+		usbd_ep_write_packet(usbd_dev, ep, xfer->buf, 0);
+	}
+}
+
+static void usbd_transfer_in(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_IN];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_IN];
+
+	if (xfer->queued > xfer->done) {
+		xfer->done += MIN(max_size, xfer->queued - xfer->done);
+	} else {
+		xfer->zlp = false;
+	}
+
+	if (xfer->done == xfer->len && !xfer->zlp) {
+		_usbd_transfer_complete(usbd_dev, ep | 0x80);
+	} else {
+		usbd_transfer_in_fill(usbd_dev, ep);
+	}
+}
+
+static void usbd_transfer_out(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_OUT];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_OUT];
+	uint16_t len;
+
+	/* NAK first, so nothing slips in after the last packet */
+	usbd_ep_nak_set(usbd_dev, ep, 1);
+	len = usbd_ep_read_packet(usbd_dev, ep, xfer->buf + xfer->done,
+				  MIN(max_size, xfer->len - xfer->done));
+	xfer->done += len;
+
+	/* Done, the endpoint stays enabled and NAKing */
+	if (len < max_size || xfer->done == xfer->len) {
+		_usbd_transfer_complete(usbd_dev, ep);
+	} else {
+		usbd_ep_nak_set(usbd_dev, ep, 0);
+	}
+}
+
+int usbd_ep_transfer(usbd_device *usbd_dev, struct usbd_transfer *xfer,
+		     uint8_t addr, void *buf, uint32_t len, uint8_t flags,
+		     usbd_transfer_callback callback)
+{
+	uint8_t ep = addr & 0x7f;
+	uint8_t dir = (addr & 0x80) ? USB_TRANSACTION_IN : USB_TRANSACTION_OUT;
+	uint16_t max_size;
+
+	if (ep == 0 || ep >= 8 || usbd_dev->transfer[ep][dir]) {
+		return -1;
+	}
+	max_size = usbd_dev->ep_max_size[ep][dir];
+	if (max_size == 0) {
+		return -1;
+	}
+	/* The core's DMA moves whole words, and whole packets on OUT. */
+	if (usbd_dev->driver->dma &&
+	    (((uintptr_t)buf & 3) ||
+	     (dir == USB_TRANSACTION_OUT && (len == 0 || len % max_size)))) {
+		return -1;
+	}
+
+	xfer->buf = buf;
+	xfer->len = len;
+	xfer->done = 0;
+	xfer->queued = 0;
+	xfer->callback = callback;
+	xfer->zlp = (dir == USB_TRANSACTION_IN) &&
+		    (len == 0 ||
+		     (!(flags & USBD_TRANSFER_NO_ZLP) && len % max_size == 0));
+	xfer->last = false;
+	usbd_dev->transfer[ep][dir] = xfer;
+
+	if (usbd_dev->driver->ep_transfer) {
+		usbd_dev->driver->ep_transfer(usbd_dev, addr);
+		return 0;
+	}
+
+	xfer->saved = usbd_dev->user_callback_ctr[ep][dir];
+	if (dir == USB_TRANSACTION_IN) {
+		usbd_dev->user_callback_ctr[ep][dir] = usbd_transfer_in;
+		usbd_transfer_in_fill(usbd_dev, ep);
+	} else {
+		usbd_dev->user_callback_ctr[ep][dir] = usbd_transfer_out;
+		usbd_ep_nak_set(usbd_dev, ep, 0);
+	}
+	return 0;
+}
+
+void _usbd_transfer_complete(usbd_device *usbd_dev, uint8_t addr)
+{
+	uint8_t ep = addr & 0x7f;
+	uint8_t dir = (addr & 0x80) ? USB_TRANSACTION_IN : USB_TRANSACTION_OUT;
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][dir];
+
+	usbd_transfer_drop(usbd_dev, ep, dir);
+	if (xfer->callback) {
+		xfer->callback(usbd_dev, addr, xfer->done);
+	}
+}
+
 /**@}*/
 
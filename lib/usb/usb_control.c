@@ -177,6 +177,14 @@ static void usb_control_setup_read(usbd_device *usbd_dev,
 	usbd_dev->control_state.ctrl_len = req->wLength;
 
 	if (usb_control_request_dispatch(usbd_dev, req)) {
+		/* Requests that leave the length alone must not send more
+		 * than the control buffer holds. */
+		if ((usbd_dev->control_state.ctrl_buf == usbd_dev->ctrl_buf) &&
+		    (usbd_dev->control_state.ctrl_len >
+		     usbd_dev->ctrl_buf_len)) {
+			usbd_dev->control_state.ctrl_len =
+				usbd_dev->ctrl_buf_len;
+		}
 		if (req->wLength) {
 			usbd_dev->control_state.needs_zlp =
 				needs_zlp(usbd_dev->control_state.ctrl_len,
@@ -30,6 +30,20 @@
 #define dev_base_address (usbd_dev->driver->base_address)
 #define REBASE(x)        MMIO32((x) + (dev_base_address))
 
+/* Take a word aligned packet buffer for the core's DMA, NULL if the DMA
+ * memory is used up. */
+static uint32_t *dwc_dma_alloc(usbd_device *usbd_dev, uint16_t len)
+{
+	uint32_t *buf = usbd_dev->dma_mem + usbd_dev->dma_mem_top;
+	uint16_t words = (len + 3) / 4;
+
+	if (words > usbd_dev->dma_mem_size - usbd_dev->dma_mem_top) {
+		return NULL;
+	}
+	usbd_dev->dma_mem_top += words;
+	return buf;
+}
+
 void dwc_set_address(usbd_device *usbd_dev, uint8_t addr)
 {
 	REBASE(OTG_DCFG) = (REBASE(OTG_DCFG) & ~OTG_DCFG_DAD) | (addr << 4);
@@ -67,6 +81,20 @@ void dwc_ep_setup(usbd_device *usbd_dev, uint8_t addr, uint8_t type,
 		usbd_dev->doeptsiz[0] = OTG_DIEPSIZ0_STUPCNT_1 |
 			OTG_DIEPSIZ0_PKTCNT |
 			(max_size & OTG_DIEPSIZ0_XFRSIZ_MASK);
+		if (usbd_dev->driver->dma) {
+			/* The DMA stores back to back SETUPs one after the
+			 * other, so leave room for the three the core takes.
+			 */
+			usbd_dev->doeptsiz[0] |= OTG_DIEPSIZ0_STUPCNT_3;
+			usbd_dev->dma_buf[0][USB_TRANSACTION_IN] =
+				dwc_dma_alloc(usbd_dev, max_size);
+			usbd_dev->dma_buf[0][USB_TRANSACTION_OUT] =
+				dwc_dma_alloc(usbd_dev,
+					      max_size < 24 ? 24 : max_size);
+			usbd_dev->dma_mem_top_ep0 = usbd_dev->dma_mem_top;
+			REBASE(OTG_DOEPDMA(0)) =
+			    (uint32_t)usbd_dev->dma_buf[0][USB_TRANSACTION_OUT];
+		}
 		REBASE(OTG_DOEPTSIZ(0)) = usbd_dev->doeptsiz[0];
 		REBASE(OTG_DOEPCTL(0)) |=
 		    OTG_DOEPCTL0_EPENA | OTG_DIEPCTL0_SNAK;
@@ -80,6 +108,14 @@ void dwc_ep_setup(usbd_device *usbd_dev, uint8_t addr, uint8_t type,
 	}
 
 	if (dir) {
+		if (usbd_dev->driver->dma) {
+			usbd_dev->dma_buf[addr][USB_TRANSACTION_IN] =
+				dwc_dma_alloc(usbd_dev, max_size);
+			if (!usbd_dev->dma_buf[addr][USB_TRANSACTION_IN]) {
+				/* Left disabled, the host sees it time out */
+				return;
+			}
+		}
 		REBASE(OTG_DIEPTXF(addr)) = ((max_size / 4) << 16) |
 					     usbd_dev->fifo_mem_top;
 		usbd_dev->fifo_mem_top += max_size / 4;
@@ -100,6 +136,15 @@ void dwc_ep_setup(usbd_device *usbd_dev, uint8_t addr, uint8_t type,
 	if (!dir) {
 		usbd_dev->doeptsiz[addr] = OTG_DIEPSIZ0_PKTCNT |
 				 (max_size & OTG_DIEPSIZ0_XFRSIZ_MASK);
+		if (usbd_dev->driver->dma) {
+			usbd_dev->dma_buf[addr][USB_TRANSACTION_OUT] =
+				dwc_dma_alloc(usbd_dev, max_size);
+			if (!usbd_dev->dma_buf[addr][USB_TRANSACTION_OUT]) {
+				return;
+			}
+			REBASE(OTG_DOEPDMA(addr)) =
+			    (uint32_t)usbd_dev->dma_buf[addr][USB_TRANSACTION_OUT];
+		}
 		REBASE(OTG_DOEPTSIZ(addr)) = usbd_dev->doeptsiz[addr];
 		REBASE(OTG_DOEPCTL(addr)) |= OTG_DOEPCTL0_EPENA |
 		    OTG_DOEPCTL0_USBAEP | OTG_DIEPCTL0_CNAK |
@@ -117,6 +162,7 @@ void dwc_endpoints_reset(usbd_device *usbd_dev)
 	int i;
 	/* The core resets the endpoints automatically on reset. */
 	usbd_dev->fifo_mem_top = usbd_dev->fifo_mem_top_ep0;
+	usbd_dev->dma_mem_top = usbd_dev->dma_mem_top_ep0;
 
 	/* Disable any currently active endpoints */
 	for (i = 1; i < 4; i++) {
@@ -128,6 +174,8 @@ void dwc_endpoints_reset(usbd_device *usbd_dev)
 		}
 	}
 
+	REBASE(OTG_DIEPEMPMSK) = 0;
+
 	/* Flush all tx/rx fifos */
 	REBASE(OTG_GRSTCTL) = OTG_GRSTCTL_TXFFLSH | OTG_GRSTCTL_TXFNUM_ALL
 			      | OTG_GRSTCTL_RXFFLSH;
@@ -190,8 +238,8 @@ void dwc_ep_nak_set(usbd_device *usbd_dev, uint8_t addr, uint8_t nak)
 	}
 }
 
-uint16_t dwc_ep_write_packet(usbd_device *usbd_dev, uint8_t addr,
-			      const void *buf, uint16_t len)
+static void dwc_fifo_write(usbd_device *usbd_dev, uint8_t addr,
+			   const void *buf, uint16_t len)
 {
 	const uint32_t *buf32 = buf;
 #if defined(__ARM_ARCH_6M__)
@@ -200,18 +248,6 @@ uint16_t dwc_ep_write_packet(usbd_device *usbd_dev, uint8_t addr,
 #endif /* defined(__ARM_ARCH_6M__) */
 	int i;
 
-	addr &= 0x7F;
-
-	/* Return if endpoint is already enabled. */
-	if (REBASE(OTG_DIEPTSIZ(addr)) & OTG_DIEPSIZ0_PKTCNT) {
-		return 0;
-	}
-
-	/* Enable endpoint for transmission. */
-	REBASE(OTG_DIEPTSIZ(addr)) = OTG_DIEPSIZ0_PKTCNT | len;
-	REBASE(OTG_DIEPCTL(addr)) |= OTG_DIEPCTL0_EPENA |
-				     OTG_DIEPCTL0_CNAK;
-
 	/* Copy buffer to endpoint FIFO, note - memcpy does not work.
 	 * ARMv7M supports non-word-aligned accesses, ARMv6M does not. */
 #if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
@@ -234,6 +270,37 @@ uint16_t dwc_ep_write_packet(usbd_device *usbd_dev, uint8_t addr,
 		}
 	}
 #endif /* defined(__ARM_ARCH_6M__) */
+}
+
+uint16_t dwc_ep_write_packet(usbd_device *usbd_dev, uint8_t addr,
+			      const void *buf, uint16_t len)
+{
+	addr &= 0x7F;
+
+	/* Return if endpoint is already enabled. */
+	if (REBASE(OTG_DIEPTSIZ(addr)) & OTG_DIEPSIZ0_PKTCNT) {
+		return 0;
+	}
+
+	if (usbd_dev->driver->dma) {
+		/* Not set up, its buffer did not fit. */
+		if (!usbd_dev->dma_buf[addr][USB_TRANSACTION_IN]) {
+			return 0;
+		}
+		/* The core fetches the packet itself once enabled. */
+		memcpy(usbd_dev->dma_buf[addr][USB_TRANSACTION_IN], buf, len);
+		REBASE(OTG_DIEPDMA(addr)) =
+			(uint32_t)usbd_dev->dma_buf[addr][USB_TRANSACTION_IN];
+	}
+
+	/* Enable endpoint for transmission. */
+	REBASE(OTG_DIEPTSIZ(addr)) = OTG_DIEPSIZ0_PKTCNT | len;
+	REBASE(OTG_DIEPCTL(addr)) |= OTG_DIEPCTL0_EPENA |
+				     OTG_DIEPCTL0_CNAK;
+
+	if (!usbd_dev->driver->dma) {
+		dwc_fifo_write(usbd_dev, addr, buf, len);
+	}
 
 	return len;
 }
@@ -249,12 +316,19 @@ uint16_t dwc_ep_read_packet(usbd_device *usbd_dev, uint8_t addr,
 #endif /* defined(__ARM_ARCH_6M__) */
 	uint32_t extra;
 
-	/* We do not need to know the endpoint address since there is only one
-	 * receive FIFO for all endpoints.
-	 */
-	(void) addr;
 	len = MIN(len, usbd_dev->rxbcnt);
 
+	if (usbd_dev->driver->dma) {
+		/* The core has already stored the packet. */
+		memcpy(buf, usbd_dev->dma_buf[addr][USB_TRANSACTION_OUT], len);
+		usbd_dev->rxbcnt = 0;
+		return len;
+	}
+
+	/* Otherwise we do not need to know the endpoint address since there
+	 * is only one receive FIFO for all endpoints.
+	 */
+
 	/* ARMv7M supports non-word-aligned accesses, ARMv6M does not. */
 #if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
 	for (i = len; i >= 4; i -= 4) {
@@ -297,6 +371,176 @@ uint16_t dwc_ep_read_packet(usbd_device *usbd_dev, uint8_t addr,
 	return len;
 }
 
+/*
+ * Transfers are handed to the core in one go, up to the packet count limit,
+ * so there is a single transfer complete per transfer rather than one per
+ * packet. IN data is pushed into the TX FIFO as space frees up.
+ */
+#define DWC_PKTCNT_MAX	(OTG_DIEPSIZX_PKTCNT_MASK >> OTG_DIEPSIZX_PKTCNT_SHIFT)
+
+/* End of the part of an IN transfer currently programmed in the core */
+static uint32_t dwc_transfer_in_end(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_IN];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_IN];
+
+	return xfer->done + MIN(xfer->len - xfer->done,
+				(uint32_t)DWC_PKTCNT_MAX * max_size);
+}
+
+static void dwc_transfer_in_fill(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_IN];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_IN];
+	uint32_t end = dwc_transfer_in_end(usbd_dev, ep);
+	uint16_t len;
+
+	while (xfer->queued < end) {
+		len = MIN(max_size, end - xfer->queued);
+		if ((REBASE(OTG_DTXFSTS(ep)) & OTG_DTXFSTS_INEPTFSAV_MASK) <
+		    (len + 3) / 4u) {
+			/* Carry on from the TX FIFO empty interrupt. */
+			REBASE(OTG_DIEPEMPMSK) |= 1 << ep;
+			return;
+		}
+		dwc_fifo_write(usbd_dev, ep, xfer->buf + xfer->queued, len);
+		xfer->queued += len;
+	}
+	REBASE(OTG_DIEPEMPMSK) &= ~(1 << ep);
+}
+
+static void dwc_transfer_in_start(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_IN];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_IN];
+	uint32_t len = dwc_transfer_in_end(usbd_dev, ep) - xfer->done;
+	uint32_t pktcnt = len ? (len + max_size - 1) / max_size : 1;
+
+	REBASE(OTG_DIEPTSIZ(ep)) = (pktcnt << OTG_DIEPSIZX_PKTCNT_SHIFT) | len;
+	if (usbd_dev->driver->dma) {
+		REBASE(OTG_DIEPDMA(ep)) = (uint32_t)(xfer->buf + xfer->done);
+		xfer->queued = xfer->done + len;
+	}
+	REBASE(OTG_DIEPCTL(ep)) |= OTG_DIEPCTL0_EPENA | OTG_DIEPCTL0_CNAK;
+	if (!usbd_dev->driver->dma) {
+		dwc_transfer_in_fill(usbd_dev, ep);
+	}
+}
+
+static void dwc_transfer_in_done(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_IN];
+
+	xfer->done = xfer->queued;
+	if (xfer->done < xfer->len) {
+		dwc_transfer_in_start(usbd_dev, ep);
+	} else if (xfer->zlp) {
+		xfer->zlp = false;
+		dwc_transfer_in_start(usbd_dev, ep);
+	} else {
+		_usbd_transfer_complete(usbd_dev, ep | 0x80);
+	}
+}
+
+static void dwc_transfer_out_start(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_OUT];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_OUT];
+	uint32_t pktcnt = (xfer->len - xfer->done + max_size - 1) / max_size;
+
+	if (pktcnt == 0) {
+		pktcnt = 1;
+	} else if (pktcnt > DWC_PKTCNT_MAX) {
+		pktcnt = DWC_PKTCNT_MAX;
+	}
+	REBASE(OTG_DOEPTSIZ(ep)) = (pktcnt << OTG_DIEPSIZX_PKTCNT_SHIFT) |
+				   (pktcnt * max_size);
+	if (usbd_dev->driver->dma) {
+		/* Whole packets only, see usbd_ep_transfer(). */
+		REBASE(OTG_DOEPDMA(ep)) = (uint32_t)(xfer->buf + xfer->done);
+		xfer->queued = xfer->done + pktcnt * max_size;
+	}
+	REBASE(OTG_DOEPCTL(ep)) |= OTG_DOEPCTL0_EPENA | OTG_DOEPCTL0_CNAK;
+}
+
+static void dwc_transfer_out_data(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_OUT];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_OUT];
+
+	if (usbd_dev->rxbcnt < max_size) {
+		xfer->last = true;
+	}
+	xfer->done += dwc_ep_read_packet(usbd_dev, ep, xfer->buf + xfer->done,
+					 MIN(max_size, xfer->len - xfer->done));
+}
+
+/*
+ * The core disables the endpoint at the end of a transfer. Arm it again for
+ * a packet of its own, NAKing as st_usbfs does, so usbd_ep_nak_set() or the
+ * next transfer is all it takes to let the host in.
+ */
+static void dwc_transfer_out_park(usbd_device *usbd_dev, uint8_t ep)
+{
+	usbd_dev->force_nak[ep] = 1;
+	if (usbd_dev->driver->dma) {
+		REBASE(OTG_DOEPDMA(ep)) =
+			(uint32_t)usbd_dev->dma_buf[ep][USB_TRANSACTION_OUT];
+	}
+	REBASE(OTG_DOEPTSIZ(ep)) = usbd_dev->doeptsiz[ep];
+	REBASE(OTG_DOEPCTL(ep)) |= OTG_DOEPCTL0_EPENA | OTG_DOEPCTL0_SNAK;
+}
+
+static void dwc_transfer_out_done(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_OUT];
+
+	if (xfer->last || xfer->done == xfer->len) {
+		dwc_transfer_out_park(usbd_dev, ep);
+		_usbd_transfer_complete(usbd_dev, ep);
+	} else {
+		dwc_transfer_out_start(usbd_dev, ep);
+	}
+}
+
+/* OUT transfer complete with the DMA, on a short packet or a full buffer */
+static void dwc_dma_transfer_out_done(usbd_device *usbd_dev, uint8_t ep)
+{
+	struct usbd_transfer *xfer = usbd_dev->transfer[ep][USB_TRANSACTION_OUT];
+	uint16_t max_size = usbd_dev->ep_max_size[ep][USB_TRANSACTION_OUT];
+	uint32_t left = REBASE(OTG_DOEPTSIZ(ep)) & OTG_DIEPSIZX_XFRSIZ_MASK;
+
+	if (xfer->queued == xfer->done) {
+		/* Armed before the transfer was queued, so the packet went to
+		 * the endpoint's own buffer. */
+		usbd_dev->rxbcnt = max_size - left;
+		dwc_transfer_out_data(usbd_dev, ep);
+	} else {
+		xfer->last = left != 0;
+		xfer->done = xfer->queued - left;
+	}
+	dwc_transfer_out_done(usbd_dev, ep);
+}
+
+void dwc_ep_transfer(usbd_device *usbd_dev, uint8_t addr)
+{
+	uint8_t ep = addr & 0x7f;
+
+	if (addr & 0x80) {
+		/* An empty transfer is its own zero length packet. */
+		if (usbd_dev->transfer[ep][USB_TRANSACTION_IN]->len == 0) {
+			usbd_dev->transfer[ep][USB_TRANSACTION_IN]->zlp = false;
+		}
+		dwc_transfer_in_start(usbd_dev, ep);
+	} else if (REBASE(OTG_DOEPCTL(ep)) & OTG_DOEPCTL0_EPENA) {
+		/* The packet the endpoint is armed for lands in the transfer
+		 * and it is rearmed from there. */
+		dwc_ep_nak_set(usbd_dev, ep, 0);
+	} else {
+		dwc_transfer_out_start(usbd_dev, ep);
+	}
+}
+
 static void dwc_flush_txfifo(usbd_device *usbd_dev, int ep)
 {
 	uint32_t fifo;
@@ -321,6 +565,78 @@ static void dwc_flush_txfifo(usbd_device *usbd_dev, int ep)
 	}
 }
 
+static void dwc_dma_out_rearm(usbd_device *usbd_dev, uint8_t ep)
+{
+	REBASE(OTG_DOEPDMA(ep)) =
+		(uint32_t)usbd_dev->dma_buf[ep][USB_TRANSACTION_OUT];
+	REBASE(OTG_DOEPTSIZ(ep)) = usbd_dev->doeptsiz[ep];
+	REBASE(OTG_DOEPCTL(ep)) |= OTG_DOEPCTL0_EPENA |
+		(usbd_dev->force_nak[ep] ?
+		 OTG_DOEPCTL0_SNAK : OTG_DOEPCTL0_CNAK);
+}
+
+/*
+ * With the DMA the core empties the receive FIFO into memory by itself, and
+ * reports each finished SETUP or OUT transfer in OTG_DOEPINT(x).
+ */
+static void dwc_dma_poll_out(usbd_device *usbd_dev)
+{
+	uint32_t doepint;
+	uint32_t stupcnt;
+	uint8_t i;
+
+	for (i = 0; i < 4; i++) {
+		doepint = REBASE(OTG_DOEPINT(i));
+
+		if (doepint & OTG_DOEPINTX_STUP) {
+			REBASE(OTG_DOEPINT(i)) = OTG_DOEPINTX_STUP |
+						 OTG_DOEPINTX_XFRC;
+			/* The last of any back to back SETUPs is the one. */
+			stupcnt = (REBASE(OTG_DOEPTSIZ(i)) &
+				   OTG_DIEPSIZ0_STUPCNT_MASK) >>
+				  OTG_DIEPSIZ0_STUPCNT_SHIFT;
+			memcpy(&usbd_dev->control_state.req,
+			       usbd_dev->dma_buf[i][USB_TRANSACTION_OUT] +
+			       2 * (2 - stupcnt), 8);
+
+			if (REBASE(OTG_DIEPTSIZ(i)) & OTG_DIEPSIZ0_PKTCNT) {
+				/* Something is still stuck in the transmit
+				 * fifo.  Flush it.
+				 */
+				dwc_flush_txfifo(usbd_dev, i);
+			}
+
+			usbd_dev->user_callback_ctr[i][USB_TRANSACTION_SETUP] (usbd_dev, i);
+			dwc_dma_out_rearm(usbd_dev, i);
+			continue;
+		}
+
+		if (!(doepint & OTG_DOEPINTX_XFRC)) {
+			continue;
+		}
+		REBASE(OTG_DOEPINT(i)) = OTG_DOEPINTX_XFRC;
+
+		if (usbd_dev->transfer[i][USB_TRANSACTION_OUT]) {
+			dwc_dma_transfer_out_done(usbd_dev, i);
+			continue;
+		}
+
+		usbd_dev->rxbcnt = (usbd_dev->doeptsiz[i] -
+				    REBASE(OTG_DOEPTSIZ(i))) &
+				   OTG_DIEPSIZX_XFRSIZ_MASK;
+		if (usbd_dev->user_callback_ctr[i][USB_TRANSACTION_OUT]) {
+			usbd_dev->user_callback_ctr[i]
+				[USB_TRANSACTION_OUT](usbd_dev, i);
+		}
+		usbd_dev->rxbcnt = 0;
+
+		/* Unless the callback queued a transfer in its place. */
+		if (!usbd_dev->transfer[i][USB_TRANSACTION_OUT]) {
+			dwc_dma_out_rearm(usbd_dev, i);
+		}
+	}
+}
+
 void dwc_poll(usbd_device *usbd_dev)
 {
 	/* Read interrupt status register. */
@@ -331,6 +647,7 @@ void dwc_poll(usbd_device *usbd_dev)
 		/* Handle USB RESET condition. */
 		REBASE(OTG_GINTSTS) = OTG_GINTSTS_ENUMDNE;
 		usbd_dev->fifo_mem_top = usbd_dev->driver->rx_fifo_size;
+		usbd_dev->dma_mem_top = 0;
 		_usbd_reset(usbd_dev);
 		return;
 	}
@@ -340,6 +657,18 @@ void dwc_poll(usbd_device *usbd_dev)
 	 * The XFRC bit must be checked in each OTG_DIEPINT(x).
 	 */
 	for (i = 0; i < 4; i++) { /* Iterate over endpoints. */
+		if (usbd_dev->transfer[i][USB_TRANSACTION_IN]) {
+			if ((REBASE(OTG_DIEPEMPMSK) & (1 << i)) &&
+			    (REBASE(OTG_DIEPINT(i)) & OTG_DIEPINTX_TXFE)) {
+				dwc_transfer_in_fill(usbd_dev, i);
+			}
+			if (REBASE(OTG_DIEPINT(i)) & OTG_DIEPINTX_XFRC) {
+				REBASE(OTG_DIEPINT(i)) = OTG_DIEPINTX_XFRC;
+				dwc_transfer_in_done(usbd_dev, i);
+			}
+			continue;
+		}
+
 		if (REBASE(OTG_DIEPINT(i)) & OTG_DIEPINTX_XFRC) {
 			/* Transfer complete. */
 			if (usbd_dev->user_callback_ctr[i]
@@ -353,7 +682,9 @@ void dwc_poll(usbd_device *usbd_dev)
 	}
 
 	/* Note: RX and TX handled differently in this device. */
-	if (intsts & OTG_GINTSTS_RXFLVL) {
+	if (usbd_dev->driver->dma) {
+		dwc_dma_poll_out(usbd_dev);
+	} else if (intsts & OTG_GINTSTS_RXFLVL) {
 		/* Receive FIFO non-empty. */
 		uint32_t rxstsp = REBASE(OTG_GRXSTSP);
 		uint32_t pktsts = rxstsp & OTG_GRXSTSP_PKTSTS_MASK;
@@ -363,6 +694,12 @@ void dwc_poll(usbd_device *usbd_dev)
 			usbd_dev->user_callback_ctr[ep][USB_TRANSACTION_SETUP] (usbd_dev, ep);
 		}
 
+		if (pktsts == OTG_GRXSTSP_PKTSTS_OUT_COMP &&
+		    usbd_dev->transfer[ep][USB_TRANSACTION_OUT]) {
+			dwc_transfer_out_done(usbd_dev, ep);
+			return;
+		}
+
 		if (pktsts == OTG_GRXSTSP_PKTSTS_OUT_COMP
 			|| pktsts == OTG_GRXSTSP_PKTSTS_SETUP_COMP)  {
 			REBASE(OTG_DOEPTSIZ(ep)) = usbd_dev->doeptsiz[ep];
@@ -397,6 +734,8 @@ void dwc_poll(usbd_device *usbd_dev)
 
 		if (type == USB_TRANSACTION_SETUP) {
 			dwc_ep_read_packet(usbd_dev, ep, &usbd_dev->control_state.req, 8);
+		} else if (usbd_dev->transfer[ep][type]) {
+			dwc_transfer_out_data(usbd_dev, ep);
 		} else if (usbd_dev->user_callback_ctr[ep][type]) {
 			usbd_dev->user_callback_ctr[ep][type] (usbd_dev, ep);
 		}
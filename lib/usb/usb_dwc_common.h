@@ -32,6 +32,7 @@ uint16_t dwc_ep_write_packet(usbd_device *usbd_dev, uint8_t addr,
 				   const void *buf, uint16_t len);
 uint16_t dwc_ep_read_packet(usbd_device *usbd_dev, uint8_t addr,
 				  void *buf, uint16_t len);
+void dwc_ep_transfer(usbd_device *usbd_dev, uint8_t addr);
 void dwc_poll(usbd_device *usbd_dev);
 void dwc_disconnect(usbd_device *usbd_dev, bool disconnected);
 
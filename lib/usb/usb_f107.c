@@ -44,6 +44,7 @@ const struct _usbd_driver stm32f107_usb_driver = {
 	.ep_write_packet = dwc_ep_write_packet,
 	.ep_read_packet = dwc_ep_read_packet,
 	.poll = dwc_poll,
+	.ep_transfer = dwc_ep_transfer,
 	.disconnect = dwc_disconnect,
 	.base_address = USB_OTG_FS_BASE,
 	.set_address_before_status = 1,
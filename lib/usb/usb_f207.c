@@ -28,8 +28,13 @@
 
 /* Receive FIFO size in 32-bit words. */
 #define RX_FIFO_SIZE 512
+/* Packet buffer memory for the internal DMA in 32-bit words. Only packets for
+ * the endpoint callbacks pass through it, transfers move straight between the
+ * core and the caller's buffer. */
+#define DMA_MEM_SIZE 512
 
 static usbd_device *stm32f207_usbd_init(void);
+static usbd_device *stm32f207_usbd_dma_init(void);
 
 static struct _usbd_device usbd_dev;
 
@@ -44,14 +49,33 @@ const struct _usbd_driver stm32f207_usb_driver = {
 	.ep_write_packet = dwc_ep_write_packet,
 	.ep_read_packet = dwc_ep_read_packet,
 	.poll = dwc_poll,
+	.ep_transfer = dwc_ep_transfer,
 	.disconnect = dwc_disconnect,
 	.base_address = USB_OTG_HS_BASE,
 	.set_address_before_status = 1,
 	.rx_fifo_size = RX_FIFO_SIZE,
 };
 
-/** Initialize the USB device controller hardware of the STM32. */
-static usbd_device *stm32f207_usbd_init(void)
+const struct _usbd_driver stm32f207_usb_dma_driver = {
+	.init = stm32f207_usbd_dma_init,
+	.set_address = dwc_set_address,
+	.ep_setup = dwc_ep_setup,
+	.ep_reset = dwc_endpoints_reset,
+	.ep_stall_set = dwc_ep_stall_set,
+	.ep_stall_get = dwc_ep_stall_get,
+	.ep_nak_set = dwc_ep_nak_set,
+	.ep_write_packet = dwc_ep_write_packet,
+	.ep_read_packet = dwc_ep_read_packet,
+	.poll = dwc_poll,
+	.ep_transfer = dwc_ep_transfer,
+	.disconnect = dwc_disconnect,
+	.base_address = USB_OTG_HS_BASE,
+	.set_address_before_status = 1,
+	.rx_fifo_size = RX_FIFO_SIZE,
+	.dma = true,
+};
+
+static void stm32f207_core_init(void)
 {
 	rcc_periph_clock_enable(RCC_OTGHS);
 	OTG_HS_GINTSTS = OTG_GINTSTS_MMIS;
@@ -75,8 +99,14 @@ static usbd_device *stm32f207_usbd_init(void)
 	/* Restart the PHY clock. */
 	OTG_HS_PCGCCTL = 0;
 
-	OTG_HS_GRXFSIZ = stm32f207_usb_driver.rx_fifo_size;
-	usbd_dev.fifo_mem_top = stm32f207_usb_driver.rx_fifo_size;
+	OTG_HS_GRXFSIZ = RX_FIFO_SIZE;
+	usbd_dev.fifo_mem_top = RX_FIFO_SIZE;
+}
+
+/** Initialize the USB device controller hardware of the STM32. */
+static usbd_device *stm32f207_usbd_init(void)
+{
+	stm32f207_core_init();
 
 	/* Unmask interrupts for TX and RX. */
 	OTG_HS_GAHBCFG |= OTG_GAHBCFG_GINT;
@@ -90,3 +120,29 @@ static usbd_device *stm32f207_usbd_init(void)
 
 	return &usbd_dev;
 }
+
+/** Initialize the USB device controller hardware of the STM32, letting the
+ * core move packets to and from memory with its internal DMA. */
+static usbd_device *stm32f207_usbd_dma_init(void)
+{
+	static uint32_t dma_mem[DMA_MEM_SIZE];
+
+	stm32f207_core_init();
+	usbd_dev.dma_mem = dma_mem;
+	usbd_dev.dma_mem_size = DMA_MEM_SIZE;
+	usbd_dev.dma_mem_top = 0;
+
+	OTG_HS_GAHBCFG |= OTG_GAHBCFG_GINT | OTG_GAHBCFG_DMAEN |
+			  OTG_GAHBCFG_HBSTLEN_INCR4;
+	/* The core drains the receive FIFO, completion is per endpoint. */
+	OTG_HS_GINTMSK = OTG_GINTMSK_ENUMDNEM |
+			 OTG_GINTMSK_IEPINT |
+			 OTG_GINTMSK_OEPINT |
+			 OTG_GINTMSK_USBSUSPM |
+			 OTG_GINTMSK_WUIM;
+	OTG_HS_DAINTMSK = 0xF000F;
+	OTG_HS_DIEPMSK = OTG_DIEPMSK_XFRCM;
+	OTG_HS_DOEPMSK = OTG_DOEPMSK_XFRCM | OTG_DOEPMSK_STUPM;
+
+	return &usbd_dev;
+}
@@ -162,6 +162,25 @@ struct usb_msc_trans {
 
 	uint8_t msd_buf[512];
 
+	/* Asynchronous sector ring, see usb_msc_init_async(). */
+	uint32_t io_block;		/* Next block handed to the backend */
+	uint32_t io_count;		/* Blocks the backend is working on */
+	uint8_t io_slot;		/* Ring slot of io_block */
+	uint8_t usb_slot;		/* Ring slot currently on the wire */
+	uint8_t ready;			/* Full slots waiting for the other
+					   side (USB on reads, the backend
+					   on writes). */
+	bool usb_idle;			/* Endpoint waits for the backend */
+	uint16_t usb_parked;		/* Bytes of an OUT packet held in
+					   msd_buf while the ring is full */
+	uint8_t io_tag;			/* Tag of the request io_count is
+					   accounted to */
+	uint8_t io_issued;		/* Requests handed to the backend */
+	uint8_t io_completed;		/* Completions seen, in order */
+
+	bool locked;			/* lock() was called for this
+					   transaction */
+
 	bool csw_valid;
 	uint8_t csw_sent;		/* Write until 13 bytes */
 	union {
@@ -185,6 +204,14 @@ struct _usbd_mass_storage {
 	int (*read_block)(uint32_t lba, uint8_t *copy_to);
 	int (*write_block)(uint32_t lba, const uint8_t *copy_from);
 
+	int (*read_blocks)(uint32_t lba, uint32_t count, uint8_t *copy_to,
+			   usb_msc_io_done_callback done);
+	int (*write_blocks)(uint32_t lba, uint32_t count,
+			    const uint8_t *copy_from,
+			    usb_msc_io_done_callback done);
+	uint8_t *ring;
+	uint8_t ring_size;
+
 	void (*lock)(void);
 	void (*unlock)(void);
 
@@ -369,7 +396,10 @@ static void scsi_format_unit(usbd_mass_storage *ms,
 
 		memset(trans->msd_buf, 0, 512);
 
-		for (i = 0; i < ms->block_count; i++) {
+		/* The asynchronous backend has no synchronous write path,
+		 * the medium is left untouched in that case. */
+		for (i = 0; (NULL != ms->write_block) &&
+			    (i < ms->block_count); i++) {
 			(*ms->write_block)(i, trans->msd_buf);
 		}
 
@@ -538,6 +568,350 @@ static void scsi_command(usbd_mass_storage *ms,
 	}
 }
 
+/*-- Transaction State -------------------------------------------------------*/
+
+static void msc_lock(usbd_mass_storage *ms)
+{
+	if (!ms->trans.locked && (NULL != ms->lock)) {
+		(*ms->lock)();
+	}
+	ms->trans.locked = true;
+}
+
+static void msc_unlock(usbd_mass_storage *ms)
+{
+	if (ms->trans.locked && (NULL != ms->unlock)) {
+		(*ms->unlock)();
+	}
+	ms->trans.locked = false;
+}
+
+/** @brief Wait for the next CBW.
+ *
+ * A backend request that is still running is not credited when it
+ * completes, see msc_async_io_done().
+ */
+static void msc_end_transaction(struct usb_msc_trans *trans)
+{
+	trans->lba_start = 0xffffffff;
+	trans->block_count = 0;
+	trans->current_block = 0;
+	trans->cbw_cnt = 0;
+	trans->bytes_to_read = 0;
+	trans->bytes_to_write = 0;
+	trans->byte_count = 0;
+	trans->csw_sent = 0;
+	trans->csw_valid = false;
+	trans->io_count = 0;
+	trans->usb_idle = false;
+	trans->usb_parked = 0;
+}
+
+/** @brief Drop the transaction in progress, on a Bulk-Only Mass Storage
+ *	   Reset or a new configuration. */
+static void msc_reset(usbd_mass_storage *ms)
+{
+	msc_unlock(ms);
+	msc_end_transaction(&ms->trans);
+	/* The OUT endpoint may be NAKed while the ring was full. */
+	usbd_ep_nak_set(ms->usbd_dev, ms->ep_out, 0);
+}
+
+/*-- Asynchronous Sector Ring ------------------------------------------------*/
+
+static void msc_async_io_done(int status);
+
+static bool msc_async_active(usbd_mass_storage *ms,
+			     struct usb_msc_trans *trans)
+{
+	return (NULL != ms->ring) && (0 < trans->block_count);
+}
+
+static bool msc_async_is_read(struct usb_msc_trans *trans)
+{
+	return 0 < trans->bytes_to_write;
+}
+
+/** @brief Slots neither holding data nor handed to the backend.
+ *
+ * None while a request of a transaction that was reset is still running.
+ */
+static uint32_t msc_async_free(usbd_mass_storage *ms,
+			       struct usb_msc_trans *trans)
+{
+	if ((0 == trans->io_count) &&
+	    (trans->io_issued != trans->io_completed)) {
+		return 0;
+	}
+	return ms->ring_size - trans->ready - trans->io_count;
+}
+
+/** @brief Hand the next contiguous run of ring slots to the backend.
+ *
+ * Only one backend request is outstanding at a time, which includes one
+ * left over from a transaction that was reset, as the backend may still
+ * be using the ring.  On reads the run covers free slots, on writes the
+ * slots that USB has already filled.  Runs never wrap around the end of
+ * the ring.
+ */
+static void msc_async_kick(usbd_mass_storage *ms,
+			   struct usb_msc_trans *trans)
+{
+	uint32_t count;
+	uint32_t lba;
+	uint8_t *buf;
+	int ret;
+
+	if ((trans->io_issued != trans->io_completed) ||
+	    (trans->io_block >= trans->block_count)) {
+		return;
+	}
+
+	if (msc_async_is_read(trans)) {
+		count = ms->ring_size - trans->ready;
+	} else {
+		count = trans->ready;
+	}
+	count = MIN(count, (uint32_t)(ms->ring_size - trans->io_slot));
+	count = MIN(count, trans->block_count - trans->io_block);
+	if (0 == count) {
+		return;
+	}
+
+	if (!msc_async_is_read(trans)) {
+		trans->ready -= count;
+	}
+	trans->io_count = count;
+	trans->io_tag = trans->io_issued++;
+
+	lba = trans->lba_start + trans->io_block;
+	buf = &ms->ring[trans->io_slot << 9];
+	if (msc_async_is_read(trans)) {
+		ret = (*ms->read_blocks)(lba, count, buf, msc_async_io_done);
+	} else {
+		ret = (*ms->write_blocks)(lba, count, buf, msc_async_io_done);
+	}
+
+	if (0 != ret) {
+		/* Request was refused, complete it as failed. */
+		msc_async_io_done(ret);
+	}
+}
+
+/** @brief Send the CSW once every block of a write has been committed. */
+static void msc_async_write_finish(usbd_mass_storage *ms,
+				   struct usb_msc_trans *trans)
+{
+	if ((trans->byte_count < trans->bytes_to_read) ||
+	    (trans->io_block < trans->block_count) ||
+	    (0 != trans->io_count) || trans->csw_valid) {
+		return;
+	}
+
+	scsi_command(ms, trans, EVENT_NEED_STATUS);
+	trans->csw_valid = true;
+	trans->csw_sent += usbd_ep_write_packet(ms->usbd_dev, ms->ep_in,
+						&trans->csw.buf[0],
+						sizeof(struct usb_msc_csw));
+}
+
+/** @brief Send the next IN packet from the slot on the wire. */
+static void msc_async_in(usbd_mass_storage *ms, struct usb_msc_trans *trans)
+{
+	uint32_t offset;
+	uint16_t len;
+
+	if (0 == trans->ready) {
+		trans->usb_idle = true;
+		return;
+	}
+
+	offset = 0x1ff & trans->byte_count;
+	len = usbd_ep_write_packet(ms->usbd_dev, ms->ep_in,
+				   &ms->ring[(trans->usb_slot << 9) + offset],
+				   MIN(ms->ep_in_size, 512 - offset));
+	trans->byte_count += len;
+
+	if ((0 < len) && (0 == (0x1ff & trans->byte_count))) {
+		/* Sector is in the packet memory, recycle its slot. */
+		trans->usb_slot = (trans->usb_slot + 1) % ms->ring_size;
+		trans->ready--;
+		trans->current_block++;
+		msc_async_kick(ms, trans);
+	}
+}
+
+/** @brief Account for @a len bytes received into the slot on the wire. */
+static void msc_async_out_done(usbd_mass_storage *ms,
+			       struct usb_msc_trans *trans, uint16_t len)
+{
+	trans->byte_count += len;
+
+	if ((0 < len) && (0 == (0x1ff & trans->byte_count))) {
+		trans->usb_slot = (trans->usb_slot + 1) % ms->ring_size;
+		trans->ready++;
+		trans->current_block++;
+		msc_async_kick(ms, trans);
+	}
+}
+
+/** @brief Receive the next OUT packet into the slot on the wire.
+ *
+ * Reading a packet re-arms the endpoint, so the host is NAKed before the
+ * read that fills the last free slot, not after it.  A packet the endpoint
+ * had already taken by then is parked until the backend frees a slot.
+ */
+static void msc_async_out(usbd_mass_storage *ms, struct usb_msc_trans *trans,
+			  uint8_t ep)
+{
+	uint32_t offset;
+	uint16_t max_len;
+	uint16_t len;
+
+	offset = 0x1ff & trans->byte_count;
+	max_len = MIN(ms->ep_out_size, 512 - offset);
+
+	if (0 == msc_async_free(ms, trans)) {
+		trans->usb_idle = true;
+		usbd_ep_nak_set(ms->usbd_dev, ep, 1);
+		if (0 == trans->usb_parked) {
+			trans->usb_parked = usbd_ep_read_packet(ms->usbd_dev,
+						ep, &trans->msd_buf[offset],
+						max_len);
+		}
+		return;
+	}
+
+	if ((1 == msc_async_free(ms, trans)) && (512 == offset + max_len) &&
+	    (trans->byte_count + max_len < trans->bytes_to_read)) {
+		trans->usb_idle = true;
+		usbd_ep_nak_set(ms->usbd_dev, ep, 1);
+	}
+
+	len = usbd_ep_read_packet(ms->usbd_dev, ep,
+				  &ms->ring[(trans->usb_slot << 9) + offset],
+				  max_len);
+	msc_async_out_done(ms, trans, len);
+
+	if (trans->usb_idle && (0 < msc_async_free(ms, trans))) {
+		/* Short packet, the slot is still there. */
+		trans->usb_idle = false;
+		usbd_ep_nak_set(ms->usbd_dev, ep, 0);
+	}
+
+	msc_async_write_finish(ms, trans);
+}
+
+/** @brief Take the parked OUT packet and let the host go on, once the
+ *	   backend has given slots back. */
+static void msc_async_out_resume(usbd_mass_storage *ms,
+				 struct usb_msc_trans *trans)
+{
+	uint32_t offset;
+	uint16_t len;
+
+	if (0 == msc_async_free(ms, trans)) {
+		return;
+	}
+
+	if (0 != trans->usb_parked) {
+		offset = 0x1ff & trans->byte_count;
+		len = trans->usb_parked;
+		trans->usb_parked = 0;
+		memcpy(&ms->ring[(trans->usb_slot << 9) + offset],
+		       &trans->msd_buf[offset], len);
+		msc_async_out_done(ms, trans, len);
+	}
+
+	if (trans->usb_idle && (0 < msc_async_free(ms, trans))) {
+		trans->usb_idle = false;
+		usbd_ep_nak_set(ms->usbd_dev, ms->ep_out, 0);
+	}
+}
+
+/** @brief Move both sides on after the backend finished a request. */
+static void msc_async_continue(usbd_mass_storage *ms,
+			       struct usb_msc_trans *trans)
+{
+	if (msc_async_is_read(trans)) {
+		msc_async_kick(ms, trans);
+		if (trans->usb_idle) {
+			trans->usb_idle = false;
+			msc_async_in(ms, trans);
+		}
+	} else {
+		msc_async_kick(ms, trans);
+		msc_async_out_resume(ms, trans);
+		msc_async_write_finish(ms, trans);
+	}
+}
+
+static void msc_async_io_done(int status)
+{
+	usbd_mass_storage *ms;
+	struct usb_msc_trans *trans;
+	uint8_t tag;
+
+	ms = &_mass_storage;
+	trans = &ms->trans;
+
+	/* Completions come in the order of the requests. */
+	tag = trans->io_completed++;
+	if ((tag != trans->io_tag) || (0 == trans->io_count)) {
+		/* Transaction was reset underneath the backend, the slots
+		 * of this request are not credited.  The current one may
+		 * have been waiting for the ring though. */
+		if (msc_async_active(ms, trans)) {
+			msc_async_continue(ms, trans);
+		}
+		return;
+	}
+
+	if (0 != status) {
+		trans->csw.csw.bCSWStatus = CSW_STATUS_FAILED;
+		if (msc_async_is_read(trans)) {
+			set_sbc_status(ms, SBC_SENSE_KEY_MEDIUM_ERROR,
+				       SBC_ASC_UNRECOVERED_READ_ERROR,
+				       SBC_ASCQ_NA);
+		} else {
+			set_sbc_status(ms, SBC_SENSE_KEY_MEDIUM_ERROR,
+				       SBC_ASC_PERIPHERAL_DEVICE_WRITE_FAULT,
+				       SBC_ASCQ_NA);
+		}
+	}
+
+	trans->io_block += trans->io_count;
+	trans->io_slot = (trans->io_slot + trans->io_count) % ms->ring_size;
+	if (msc_async_is_read(trans)) {
+		trans->ready += trans->io_count;
+	}
+	trans->io_count = 0;
+
+	msc_async_continue(ms, trans);
+}
+
+/** @brief Set up the ring for a READ/WRITE command that was just parsed. */
+static void msc_async_start(usbd_mass_storage *ms,
+			    struct usb_msc_trans *trans)
+{
+	msc_lock(ms);
+
+	trans->current_block = 0;
+	trans->io_block = 0;
+	trans->io_count = 0;
+	trans->io_slot = 0;
+	trans->usb_slot = 0;
+	trans->ready = 0;
+	trans->usb_idle = false;
+	trans->usb_parked = 0;
+
+	if (msc_async_is_read(trans)) {
+		/* Start fetching, then send whatever is already there. */
+		msc_async_kick(ms, trans);
+		msc_async_in(ms, trans);
+	}
+}
+
 /*-- USB Mass Storage Layer --------------------------------------------------*/
 
 /** @brief Handle the USB 'OUT' requests. */
@@ -561,6 +935,10 @@ static void msc_data_rx_cb(usbd_device *usbd_dev, uint8_t ep)
 
 		if (sizeof(struct usb_msc_cbw) == trans->cbw_cnt) {
 			scsi_command(ms, trans, EVENT_CBW_VALID);
+			if (msc_async_active(ms, trans)) {
+				msc_async_start(ms, trans);
+				return;
+			}
 			if (trans->byte_count < trans->bytes_to_read) {
 				/* We must wait until there is something to
 				 * read again. */
@@ -569,10 +947,17 @@ static void msc_data_rx_cb(usbd_device *usbd_dev, uint8_t ep)
 		}
 	}
 
+	if (msc_async_active(ms, trans)) {
+		if (trans->byte_count < trans->bytes_to_read) {
+			msc_async_out(ms, trans, ep);
+		}
+		return;
+	}
+
 	if (trans->byte_count < trans->bytes_to_read) {
 		if (0 < trans->block_count) {
-			if ((0 == trans->byte_count) && (NULL != ms->lock)) {
-				(*ms->lock)();
+			if (0 == trans->byte_count) {
+				msc_lock(ms);
 			}
 		}
 
@@ -611,8 +996,8 @@ static void msc_data_rx_cb(usbd_device *usbd_dev, uint8_t ep)
 
 	} else if (trans->byte_count < trans->bytes_to_write) {
 		if (0 < trans->block_count) {
-			if ((0 == trans->byte_count) && (NULL != ms->lock)) {
-				(*ms->lock)();
+			if (0 == trans->byte_count) {
+				msc_lock(ms);
 			}
 
 			if (0 == (0x1ff & trans->byte_count)) {
@@ -644,9 +1029,7 @@ static void msc_data_rx_cb(usbd_device *usbd_dev, uint8_t ep)
 				}
 
 				trans->current_block = 0;
-				if (NULL != ms->unlock) {
-					(*ms->unlock)();
-				}
+				msc_unlock(ms);
 			}
 		}
 		if (false == trans->csw_valid) {
@@ -676,6 +1059,12 @@ static void msc_data_tx_cb(usbd_device *usbd_dev, uint8_t ep)
 	ms = &_mass_storage;
 	trans = &ms->trans;
 
+	if (msc_async_active(ms, trans) &&
+	    (trans->byte_count < trans->bytes_to_write)) {
+		msc_async_in(ms, trans);
+		return;
+	}
+
 	if (trans->byte_count < trans->bytes_to_write) {
 		if (0 < trans->block_count) {
 			if (0 == (0x1ff & trans->byte_count)) {
@@ -699,9 +1088,7 @@ static void msc_data_tx_cb(usbd_device *usbd_dev, uint8_t ep)
 		if (0 < trans->block_count) {
 			if (trans->current_block == trans->block_count) {
 				trans->current_block = 0;
-				if (NULL != ms->unlock) {
-					(*ms->unlock)();
-				}
+				msc_unlock(ms);
 			}
 		}
 		if (false == trans->csw_valid) {
@@ -717,15 +1104,7 @@ static void msc_data_tx_cb(usbd_device *usbd_dev, uint8_t ep)
 			trans->csw_sent += len;
 		} else if (sizeof(struct usb_msc_csw) == trans->csw_sent) {
 			/* End of transaction */
-			trans->lba_start = 0xffffffff;
-			trans->block_count = 0;
-			trans->current_block = 0;
-			trans->cbw_cnt = 0;
-			trans->bytes_to_read = 0;
-			trans->bytes_to_write = 0;
-			trans->byte_count = 0;
-			trans->csw_sent = 0;
-			trans->csw_valid = false;
+			msc_end_transaction(trans);
 		}
 	}
 }
@@ -743,7 +1122,7 @@ msc_control_request(usbd_device *usbd_dev,
 
 	switch (req->bRequest) {
 	case USB_MSC_REQ_BULK_ONLY_RESET:
-		/* Do any special reset code here. */
+		msc_reset(&_mass_storage);
 		return USBD_REQ_HANDLED;
 	case USB_MSC_REQ_GET_MAX_LUN:
 		/* Return the number of LUNs.  We use 0. */
@@ -762,6 +1141,8 @@ static void msc_set_config(usbd_device *usbd_dev, uint16_t wValue)
 
 	(void)wValue;
 
+	msc_reset(ms);
+
 	usbd_ep_setup(usbd_dev, ms->ep_in, USB_ENDPOINT_ATTR_BULK,
 		      ms->ep_in_size, msc_data_tx_cb);
 	usbd_ep_setup(usbd_dev, ms->ep_out, USB_ENDPOINT_ATTR_BULK,
@@ -821,18 +1202,17 @@ usbd_mass_storage *usb_msc_init(usbd_device *usbd_dev,
 	_mass_storage.block_count = block_count - 1;
 	_mass_storage.read_block = read_block;
 	_mass_storage.write_block = write_block;
+	_mass_storage.read_blocks = NULL;
+	_mass_storage.write_blocks = NULL;
+	_mass_storage.ring = NULL;
+	_mass_storage.ring_size = 0;
 	_mass_storage.lock = NULL;
 	_mass_storage.unlock = NULL;
 
-	_mass_storage.trans.lba_start = 0xffffffff;
-	_mass_storage.trans.block_count = 0;
-	_mass_storage.trans.current_block = 0;
-	_mass_storage.trans.cbw_cnt = 0;
-	_mass_storage.trans.bytes_to_read = 0;
-	_mass_storage.trans.bytes_to_write = 0;
-	_mass_storage.trans.byte_count = 0;
-	_mass_storage.trans.csw_valid = false;
-	_mass_storage.trans.csw_sent = 0;
+	msc_end_transaction(&_mass_storage.trans);
+	_mass_storage.trans.io_issued = 0;
+	_mass_storage.trans.io_completed = 0;
+	_mass_storage.trans.locked = false;
 
 	set_sbc_status_good(&_mass_storage);
 
@@ -841,4 +1221,76 @@ usbd_mass_storage *usb_msc_init(usbd_device *usbd_dev,
 	return &_mass_storage;
 }
 
+/** @brief Initializes the USB Mass Storage subsystem with an asynchronous,
+	   multi-block backend.
+
+READ and WRITE commands are pipelined through a ring of @a sector_count
+512-byte sector buffers: while one sector is on the wire the backend fills
+(or drains) the following ones, so the bus no longer idles during media
+I/O.  The backend is handed runs of consecutive blocks that never wrap
+around the end of the ring, one request at a time.  It must call @a done
+once the run has completed, either before returning or later from a
+context that does not preempt usbd_poll(), in the order the requests
+were made.  While the ring is full on a write, the OUT endpoint is NAKed.
+A request still running when the host starts over with a new command is
+waited for, and its completion is dropped.
+
+The CSW of a write is only sent after all blocks were committed, a
+failing run reports a MEDIUM ERROR.  FORMAT UNIT leaves the medium
+untouched in this mode.
+
+@param[in] usbd_dev The USB device to associate the Mass Storage with.
+@param[in] ep_in The USB 'IN' endpoint.
+@param[in] ep_in_size The maximum endpoint size.  Must divide 512.
+@param[in] ep_out The USB 'OUT' endpoint.
+@param[in] ep_out_size The maximum endpoint size.  Must divide 512.
+@param[in] vendor_id The SCSI vendor ID to return.  Maximum used length is 8.
+@param[in] product_id The SCSI product ID to return.  Maximum used length is 16.
+@param[in] product_revision_level The SCSI product revision level to return.
+		Maximum used length is 4.
+@param[in] block_count The number of 512-byte blocks available.
+@param[in] sector_buf Word aligned ring of @a sector_count * 512 bytes.
+@param[in] sector_count Number of sectors in the ring, at least 2 for
+		pipelining.
+@param[in] read_blocks Starts reading @a count blocks into @a copy_to.
+		Returns nonzero if the request could not be started.
+		Must _NOT_ be NULL.
+@param[in] write_blocks Starts writing @a count blocks from @a copy_from.
+		Returns nonzero if the request could not be started.
+		Must _NOT_ be NULL.
+
+@return Pointer to the usbd_mass_storage struct, NULL if @a sector_buf is
+NULL or @a sector_count is 0.
+*/
+usbd_mass_storage *usb_msc_init_async(usbd_device *usbd_dev,
+				 uint8_t ep_in, uint8_t ep_in_size,
+				 uint8_t ep_out, uint8_t ep_out_size,
+				 const char *vendor_id,
+				 const char *product_id,
+				 const char *product_revision_level,
+				 const uint32_t block_count,
+				 uint8_t *sector_buf, uint8_t sector_count,
+				 int (*read_blocks)(uint32_t lba, uint32_t count,
+						    uint8_t *copy_to,
+						    usb_msc_io_done_callback done),
+				 int (*write_blocks)(uint32_t lba, uint32_t count,
+						     const uint8_t *copy_from,
+						     usb_msc_io_done_callback done))
+{
+	if (!sector_buf || sector_count == 0) {
+		return NULL;
+	}
+
+	usb_msc_init(usbd_dev, ep_in, ep_in_size, ep_out, ep_out_size,
+		     vendor_id, product_id, product_revision_level,
+		     block_count, NULL, NULL);
+
+	_mass_storage.read_blocks = read_blocks;
+	_mass_storage.write_blocks = write_blocks;
+	_mass_storage.ring = sector_buf;
+	_mass_storage.ring_size = sector_count;
+
+	return &_mass_storage;
+}
+
 /** @} */
@@ -85,6 +85,10 @@ struct _usbd_device {
 
 	usbd_endpoint_callback user_callback_ctr[8][3];
 
+	/* Transfers queued by usbd_ep_transfer(), by [ep][IN/OUT] */
+	struct usbd_transfer *transfer[8][2];
+	uint16_t ep_max_size[8][2];
+
 	/* User callback function for some standard USB function hooks */
 	usbd_set_config_callback user_callback_set_config[MAX_USER_SET_CONFIG_CALLBACK];
 
@@ -112,6 +116,15 @@ struct _usbd_device {
 	 * for use in stm32f107_ep_read_packet().
 	 */
 	uint16_t rxbcnt;
+	/*
+	 * Word aligned packet buffers for cores moving data with their own
+	 * DMA, carved out of dma_mem like the FIFO memory above.
+	 */
+	uint32_t *dma_mem;
+	uint16_t dma_mem_size;
+	uint16_t dma_mem_top;
+	uint16_t dma_mem_top_ep0;
+	uint32_t *dma_buf[4][2];
 };
 
 enum _usbd_transaction {
@@ -123,6 +136,9 @@ enum _usbd_transaction {
 /* Do not appear to belong to the API, so are omitted from docs */
 /**@}*/
 
+void _usbd_transfer_complete(usbd_device *usbd_dev, uint8_t addr);
+void _usbd_transfer_reset(usbd_device *usbd_dev);
+
 void _usbd_control_in(usbd_device *usbd_dev, uint8_t ea);
 void _usbd_control_out(usbd_device *usbd_dev, uint8_t ea);
 void _usbd_control_setup(usbd_device *usbd_dev, uint8_t ea);
@@ -158,8 +174,13 @@ struct _usbd_driver {
 				   void *buf, uint16_t len);
 	void (*poll)(usbd_device *usbd_dev);
 	void (*disconnect)(usbd_device *usbd_dev, bool disconnected);
+	/* Optional, runs a whole transfer without the packet callbacks */
+	void (*ep_transfer)(usbd_device *usbd_dev, uint8_t addr);
 	uint32_t base_address;
 	bool set_address_before_status;
+	bool double_buffer;
+	/* Packets go through the core's DMA instead of the CPU */
+	bool dma;
 	uint16_t rx_fifo_size;
 };
 
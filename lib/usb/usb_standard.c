@@ -165,8 +165,12 @@ usb_standard_get_descriptor(usbd_device *usbd_dev,
 		*len = MIN(*len, usbd_dev->desc->bLength);
 		return USBD_REQ_HANDLED;
 	case USB_DT_CONFIGURATION:
+		if (descr_idx >= usbd_dev->desc->bNumConfigurations) {
+			return USBD_REQ_NOTSUPP;
+		}
 		*buf = usbd_dev->ctrl_buf;
-		*len = build_config_descriptor(usbd_dev, descr_idx, *buf, *len);
+		*len = build_config_descriptor(usbd_dev, descr_idx, *buf,
+					       MIN(*len, usbd_dev->ctrl_buf_len));
 		return USBD_REQ_HANDLED;
 	case USB_DT_STRING:
 		sd = (struct usb_string_descriptor *)usbd_dev->ctrl_buf;
@@ -301,8 +305,9 @@ usb_standard_set_configuration(usbd_device *usbd_dev,
 		}
 	}
 
-	/* Reset all endpoints. */
+	/* Reset all endpoints, dropping their transfers. */
 	usbd_dev->driver->ep_reset(usbd_dev);
+	_usbd_transfer_reset(usbd_dev);
 
 	if (usbd_dev->user_callback_set_config[0]) {
 		/*
@@ -350,12 +355,17 @@ usb_standard_set_interface(usbd_device *usbd_dev,
 			   struct usb_setup_data *req,
 			   uint8_t **buf, uint16_t *len)
 {
-	const struct usb_config_descriptor *cfx =
-		&usbd_dev->config[usbd_dev->current_config - 1];
+	const struct usb_config_descriptor *cfx;
 	const struct usb_interface *iface;
 
 	(void)buf;
 
+	/* Interfaces only exist in the configured state */
+	if (usbd_dev->current_config == 0) {
+		return USBD_REQ_NOTSUPP;
+	}
+	cfx = &usbd_dev->config[usbd_dev->current_config - 1];
+
 	if (req->wIndex >= cfx->bNumInterfaces) {
 		return USBD_REQ_NOTSUPP;
 	}
@@ -389,8 +399,12 @@ usb_standard_get_interface(usbd_device *usbd_dev,
 			   uint8_t **buf, uint16_t *len)
 {
 	uint8_t *cur_altsetting;
-	const struct usb_config_descriptor *cfx =
-		&usbd_dev->config[usbd_dev->current_config - 1];
+	const struct usb_config_descriptor *cfx;
+
+	if (usbd_dev->current_config == 0) {
+		return USBD_REQ_NOTSUPP;
+	}
+	cfx = &usbd_dev->config[usbd_dev->current_config - 1];
 
 	if (req->wIndex >= cfx->bNumInterfaces) {
 		return USBD_REQ_NOTSUPP;
@@ -582,6 +596,11 @@ _usbd_standard_request_endpoint(usbd_device *usbd_dev,
 		struct usb_setup_data *req,
 		uint8_t **buf, uint16_t *len) = NULL;
 
+	/* wIndex goes to the driver as is, only endpoints 0 to 7 exist */
+	if (req->wIndex & ~0x87) {
+		return USBD_REQ_NOTSUPP;
+	}
+
 	switch (req->bRequest) {
 	case USB_REQ_CLEAR_FEATURE:
 		if (req->wValue == USB_FEAT_ENDPOINT_HALT) {
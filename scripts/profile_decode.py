@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+# Decodes the packets of libopencm3/cm3/profile.h from an ITM/SWO capture.
+
+# This file is part of the libopencm3 project.
+#
+# This library is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+"""Decode profile_report() and profile_announce() packets.
+
+The input is the raw ITM byte stream as captured from SWO, for instance by
+openocd "tpiu config internal swo.bin uart off <cpu clock>" or orbuculum.
+Only 32 bit writes to the given stimulus port are looked at.
+
+usage: profile_decode.py [-p PORT] [-H] [capture]
+"""
+
+import argparse
+import struct
+import sys
+
+PACKET_STATS = 0x53
+PACKET_NAME = 0x4e
+STATS_WORDS = 10
+
+
+def itm_words(data, port):
+    """Yields the 32 bit software source payloads of a stimulus port."""
+    i = 0
+    n = len(data)
+    zeros = False
+    while i < n:
+        header = data[i]
+        i += 1
+        if header == 0x00 or (header == 0x80 and zeros) or header == 0x70:
+            # Synchronisation or overflow
+            zeros = header == 0x00
+            continue
+        zeros = False
+        if header & 0x03 == 0:
+            # Timestamp or extension, with continuation bytes
+            if header & 0x80:
+                while i < n and data[i] & 0x80:
+                    i += 1
+                i += 1
+            continue
+        size = {1: 1, 2: 2, 3: 4}[header & 0x03]
+        payload = data[i:i + size]
+        i += size
+        if header & 0x04 or header >> 3 != port or size != 4:
+            # Hardware source, other port or not a word
+            continue
+        if len(payload) == 4:
+            yield struct.unpack("<I", payload)[0]
+
+
+def packets(words):
+    """Yields the decoded profile packets of a word stream, up to the last
+    complete one."""
+    words = list(words)
+    i = 0
+    while i < len(words):
+        first = words[i]
+        kind = first >> 24
+        region = (first >> 16) & 0xff
+        if kind == PACKET_NAME:
+            length = first & 0xffff
+            end = i + 1 + (length + 3) // 4
+        elif kind == PACKET_STATS:
+            lo = (first >> 8) & 0xff
+            hi = first & 0xff
+            end = i + 1 + STATS_WORDS + max(hi + 1 - lo, 0)
+        else:
+            # Not a packet start, resynchronise on the next word
+            i += 1
+            continue
+        if end > len(words):
+            print("capture ends in a packet", file=sys.stderr)
+            return
+        body = words[i + 1:end]
+        i = end
+
+        if kind == PACKET_NAME:
+            raw = struct.pack("<%dI" % len(body), *body)
+            yield ("name", region, raw[:length].decode("ascii", "replace"))
+            continue
+        stats = {
+            "count": body[0],
+            "min": body[1],
+            "max": body[2],
+            "total": body[3] | (body[4] << 32),
+            "cpi": body[5],
+            "exc": body[6],
+            "sleep": body[7],
+            "lsu": body[8],
+            "fold": body[9],
+            "histogram": dict(zip(range(lo, hi + 1), body[STATS_WORDS:])),
+        }
+        yield ("stats", region, stats)
+
+
+def print_stats(name, stats, histogram):
+    count = stats["count"]
+    mean = stats["total"] // count if count else 0
+    print("%-20s n=%-8d min=%-8d mean=%-8d max=%-8d "
+          "cpi=%d exc=%d sleep=%d lsu=%d fold=%d" %
+          (name, count, stats["min"] if count else 0, mean, stats["max"],
+           stats["cpi"], stats["exc"], stats["sleep"], stats["lsu"],
+           stats["fold"]))
+    if not histogram or not stats["histogram"]:
+        return
+    top = max(stats["histogram"].values()) or 1
+    for bucket, runs in sorted(stats["histogram"].items()):
+        print("    %10d..%-10d %8d %s" %
+              (1 << bucket if bucket else 0, (2 << bucket) - 1, runs,
+               "#" * (runs * 40 // top)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?",
+                        help="ITM capture file, stdin if not given")
+    parser.add_argument("-p", "--port", type=int, default=1,
+                        help="stimulus port of the packets (default 1)")
+    parser.add_argument("-H", "--histogram", action="store_true",
+                        help="print the cycle histograms")
+    args = parser.parse_args()
+
+    if args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    names = {}
+    for kind, region, value in packets(itm_words(data, args.port)):
+        if kind == "name":
+            names[region] = value
+        else:
+            print_stats(names.get(region, "region %d" % region), value,
+                        args.histogram)
+
+
+if __name__ == "__main__":
+    main()
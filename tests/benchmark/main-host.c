@@ -0,0 +1,273 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The profiler of libopencm3/cm3/profile.h on the build machine, against
+ * a DWT and ITM played by host_mmio_model(): the cycle counter either
+ * steps by a fixed count on every read, or runs in nanoseconds of the
+ * monotonic clock, and every access to a stimulus port lands in a log
+ * word of its own, preset to FIFOREADY. The statistics and the packets are
+ * checked, the packets written out as an ITM capture for
+ * scripts/profile_decode.py, and the packet copies of the st_usbfs driver
+ * timed against memcpy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <libopencm3/cm3/profile.h>
+#include <libopencm3/cm3/dwt.h>
+#include <libopencm3/cm3/itm.h>
+#include <libopencm3/cm3/scs.h>
+#include "../../lib/stm32/common/st_usbfs_core.h"
+
+#define BENCH_PORT	1
+#define BENCH_RUNS	1000
+#define STIM_LOG	4096
+
+static enum { CYCCNT_STEP, CYCCNT_CLOCK } cyccnt_mode;
+static uint32_t cyccnt, cyccnt_step;
+static uint32_t stim_log[STIM_LOG];
+static unsigned stim_count;
+static int failures;
+
+#define CHECK(cond) do {						\
+	if (!(cond)) {							\
+		printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);	\
+		failures++;						\
+	}								\
+} while (0)
+
+volatile void *host_mmio_model(uint32_t addr, unsigned size)
+{
+	struct timespec ts;
+
+	(void)size;
+	if (addr == DWT_BASE + 0x04) {
+		if (cyccnt_mode == CYCCNT_CLOCK) {
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			cyccnt = ts.tv_sec * 1000000000ull + ts.tv_nsec;
+		} else {
+			cyccnt += cyccnt_step;
+		}
+		return &cyccnt;
+	}
+	if (addr >= ITM_BASE && addr < ITM_BASE + 32 * 4) {
+		if (stim_count == STIM_LOG) {
+			printf("stimulus log full\n");
+			exit(1);
+		}
+		stim_log[stim_count] = ITM_STIM_FIFOREADY;
+		return &stim_log[stim_count++];
+	}
+	return NULL;
+}
+
+/* Every word is sent by one read of FIFOREADY and one write */
+static unsigned stim_words(uint32_t *words)
+{
+	unsigned i, n = 0;
+
+	for (i = 0; i + 1 < stim_count; i += 2) {
+		CHECK(stim_log[i] == ITM_STIM_FIFOREADY);
+		words[n++] = stim_log[i + 1];
+	}
+	CHECK(!(stim_count & 1));
+	stim_count = 0;
+	return n;
+}
+
+static void test_init(void)
+{
+	cyccnt_mode = CYCCNT_STEP;
+	cyccnt_step = 7;
+	CHECK(profile_init());
+	CHECK(SCS_DEMCR & SCS_DEMCR_TRCENA);
+	CHECK((DWT_CTRL & (DWT_CTRL_CYCCNTENA | DWT_CTRL_CPIEVTENA |
+			   DWT_CTRL_FOLDEVTENA)) ==
+	      (DWT_CTRL_CYCCNTENA | DWT_CTRL_CPIEVTENA | DWT_CTRL_FOLDEVTENA));
+}
+
+/* The reads of the counter are taken off as the overhead, what the region
+ * adds is counted, across the wrap of the counter as well */
+static void test_stats(void)
+{
+	static struct profile_region region = PROFILE_REGION(9, "stats");
+	static const uint32_t runs[] = { 0, 1, 100, 3, 100000 };
+	struct profile_scope scope;
+	unsigned i;
+
+	cyccnt = 0xfffffff0;
+	for (i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+		profile_begin(&scope, &region);
+		cyccnt += runs[i];
+		DWT_CPICNT += 300;
+		profile_end(&scope);
+	}
+	CHECK(region.count == 5);
+	CHECK(region.min == 0);
+	CHECK(region.max == 100000);
+	CHECK(region.total == 100104);
+	CHECK(profile_mean(&region) == 20020);
+	CHECK(region.histogram[0] == 2);
+	CHECK(region.histogram[1] == 1);
+	CHECK(region.histogram[6] == 1);
+	CHECK(region.histogram[16] == 1);
+	/* The CPI counter is 8 bits */
+	CHECK(region.cpi == 5 * (300 - 256));
+
+	profile_reset(&region);
+	CHECK(region.count == 0 && region.min == UINT32_MAX &&
+	      region.cpi == 0 && region.histogram[16] == 0);
+}
+
+/* Nothing goes to a stimulus port that is not enabled */
+static void test_disabled(void)
+{
+	static struct profile_region region = PROFILE_REGION(3, "off");
+
+	ITM_TCR = 0;
+	profile_announce(&region, BENCH_PORT);
+	profile_report(&region, BENCH_PORT);
+	CHECK(stim_count == 0);
+
+	ITM_TCR = ITM_TCR_ITMENA;
+	ITM_TER[0] = 1 << (BENCH_PORT + 1);
+	profile_report(&region, BENCH_PORT);
+	CHECK(stim_count == 0);
+}
+
+static void test_packets(void)
+{
+	static struct profile_region region = PROFILE_REGION(5, "packet");
+	struct profile_scope scope;
+	uint32_t words[64];
+	unsigned n;
+
+	ITM_TCR = ITM_TCR_ITMENA;
+	ITM_TER[0] = 1 << BENCH_PORT;
+
+	profile_announce(&region, BENCH_PORT);
+	n = stim_words(words);
+	CHECK(n == 3);
+	CHECK(words[0] == ((PROFILE_PACKET_NAME << 24) | (5 << 16) | 6));
+	CHECK(memcmp(&words[1], "packet\0\0", 8) == 0);
+
+	profile_report(&region, BENCH_PORT);
+	n = stim_words(words);
+	CHECK(n == 11);
+	CHECK(words[0] == ((PROFILE_PACKET_STATS << 24) | (5 << 16) | 0x0100));
+
+	profile_begin(&scope, &region);
+	cyccnt += 40;
+	profile_end(&scope);
+	profile_begin(&scope, &region);
+	cyccnt += 300;
+	profile_end(&scope);
+	profile_report(&region, BENCH_PORT);
+	n = stim_words(words);
+	CHECK(n == 11 + 4);
+	CHECK(words[0] == ((PROFILE_PACKET_STATS << 24) | (5 << 16) | 0x0508));
+	CHECK(words[1] == 2 && words[2] == 40 && words[3] == 300);
+	CHECK(words[4] == 340 && words[5] == 0);
+	CHECK(words[11] == 1 && words[12] == 0 && words[14] == 1);
+}
+
+static struct profile_region copy_memcpy = PROFILE_REGION(1, "memcpy_64b");
+static struct profile_region copy_to_pm =
+	PROFILE_REGION(2, "st_usbfs_to_pm_64b");
+static struct profile_region copy_from_pm =
+	PROFILE_REGION(3, "st_usbfs_from_pm_64b");
+
+/* The copies of a full speed bulk packet, in nanoseconds of the build
+ * machine: only the relative cost means anything */
+static void bench_packet_copy(void)
+{
+	static uint8_t src[64], dst[64];
+	volatile void *pm = &MMIO32(USB_PMA_BASE);
+	int i;
+
+	cyccnt_mode = CYCCNT_CLOCK;
+	for (i = 0; i < 64; i++) {
+		src[i] = i;
+	}
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&copy_memcpy);
+		memcpy(dst, src, sizeof(dst));
+	}
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&copy_to_pm);
+		st_usbfs_copy_to_pm(pm, src, sizeof(src));
+	}
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&copy_from_pm);
+		st_usbfs_copy_from_pm(dst, pm, sizeof(dst));
+	}
+	CHECK(memcmp(src, dst, sizeof(dst)) == 0);
+	cyccnt_mode = CYCCNT_STEP;
+}
+
+/* Writes the packets in the framing of the ITM: a header byte with the port
+ * and the size, then the word */
+static void bench_report(FILE *f, struct profile_region *region)
+{
+	uint32_t words[STIM_LOG / 2];
+	uint8_t packet[5];
+	unsigned n, i;
+
+	profile_announce(region, BENCH_PORT);
+	profile_report(region, BENCH_PORT);
+	n = stim_words(words);
+	for (i = 0; i < n; i++) {
+		packet[0] = (BENCH_PORT << 3) | 3;
+		packet[1] = words[i];
+		packet[2] = words[i] >> 8;
+		packet[3] = words[i] >> 16;
+		packet[4] = words[i] >> 24;
+		fwrite(packet, 1, sizeof(packet), f);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const char *capture = argc > 1 ? argv[1] : "itm-host.bin";
+	FILE *f;
+
+	test_init();
+	test_stats();
+	test_disabled();
+	test_packets();
+	bench_packet_copy();
+
+	f = fopen(capture, "wb");
+	if (!f) {
+		perror(capture);
+		return 1;
+	}
+	bench_report(f, &copy_memcpy);
+	bench_report(f, &copy_to_pm);
+	bench_report(f, &copy_from_pm);
+	fclose(f);
+
+	if (failures) {
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("passed, packets in %s\n", capture);
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <libopencm3/cm3/profile.h>
+#include <libopencm3/stm32/crc.h>
+#include <libopencm3/stm32/flash.h>
+#include <libopencm3/stm32/gpio.h>
+#include <libopencm3/stm32/rcc.h>
+
+/* Stimulus port of the profile packets */
+#define BENCH_PORT	1
+#define BENCH_RUNS	1000
+
+/* Last 128K sector of the 1M flash, only programmed with BENCH_FLASH */
+#define BENCH_FLASH_SECTOR	11
+#define BENCH_FLASH_ADDRESS	0x080e0000
+
+static struct profile_region gpio_pulse =
+	PROFILE_REGION(1, "gpio_set_clear");
+static struct profile_region gpio_flip =
+	PROFILE_REGION(2, "gpio_toggle");
+static struct profile_region crc_block =
+	PROFILE_REGION(3, "crc_block_256w");
+static struct profile_region packet_copy =
+	PROFILE_REGION(4, "memcpy_64b");
+#if defined(BENCH_FLASH)
+static struct profile_region flash_word =
+	PROFILE_REGION(5, "flash_program_word");
+static struct profile_region flash_block =
+	PROFILE_REGION(6, "flash_program_1k");
+#endif
+
+static uint32_t crc_data[256];
+static uint8_t packet_src[64], packet_dst[64];
+
+static void bench_gpio(void)
+{
+	int i;
+
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&gpio_pulse);
+		gpio_set(GPIOD, GPIO12);
+		gpio_clear(GPIOD, GPIO12);
+	}
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&gpio_flip);
+		gpio_toggle(GPIOD, GPIO13);
+	}
+}
+
+static void bench_crc(void)
+{
+	int i;
+
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&crc_block);
+		crc_reset();
+		crc_calculate_block(crc_data, 256);
+	}
+}
+
+/* The copy of a full speed bulk packet in RAM, the baseline of the copies
+ * to and from the USB packet memory, which main-host.c times for the
+ * st_usbfs driver */
+static void bench_packet_copy(void)
+{
+	int i;
+
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&packet_copy);
+		memcpy(packet_dst, packet_src, sizeof(packet_dst));
+	}
+}
+
+static void bench_flash(void)
+{
+#if defined(BENCH_FLASH)
+	uint32_t i;
+
+	flash_unlock();
+	flash_erase_sector(BENCH_FLASH_SECTOR, FLASH_CR_PROGRAM_X32);
+	for (i = 0; i < BENCH_RUNS; i++) {
+		PROFILE_SCOPE(&flash_word);
+		flash_program_word(BENCH_FLASH_ADDRESS + i * 4, i);
+	}
+	/* Blocks of 1K after the words */
+	for (i = 0; i < 16; i++) {
+		PROFILE_SCOPE(&flash_block);
+		flash_program(BENCH_FLASH_ADDRESS + (i + 4) * 1024,
+			      (const uint8_t *)crc_data, sizeof(crc_data));
+	}
+	flash_lock();
+#endif
+}
+
+static void bench_report(struct profile_region *region)
+{
+	profile_announce(region, BENCH_PORT);
+	profile_report(region, BENCH_PORT);
+	profile_reset(region);
+}
+
+int main(void)
+{
+	unsigned i;
+
+	rcc_clock_setup_pll(&rcc_hse_8mhz_3v3[RCC_CLOCK_3V3_168MHZ]);
+	rcc_periph_clock_enable(RCC_GPIOD);
+	rcc_periph_clock_enable(RCC_CRC);
+	gpio_mode_setup(GPIOD, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE,
+			GPIO12 | GPIO13);
+
+	for (i = 0; i < 256; i++) {
+		crc_data[i] = i * 0x01010101;
+	}
+	for (i = 0; i < sizeof(packet_src); i++) {
+		packet_src[i] = i;
+	}
+
+	if (!profile_init()) {
+		while (1);
+	}
+
+	bench_gpio();
+	bench_crc();
+	bench_packet_copy();
+	bench_flash();
+
+	bench_report(&gpio_pulse);
+	bench_report(&gpio_flip);
+	bench_report(&crc_block);
+	bench_report(&packet_copy);
+#if defined(BENCH_FLASH)
+	bench_report(&flash_word);
+	bench_report(&flash_block);
+#endif
+
+	while (1);
+	return 0;
+}
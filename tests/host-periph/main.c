@@ -0,0 +1,444 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Runs the CRC and ethernet MAC code of the library on the build machine,
+ * built by lib/host with the register layout of the STM32F7. The CRC unit
+ * is played by host_mmio_model(), the DMA of the MAC by the test walking
+ * the descriptor rings the way the hardware does.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <libopencm3/stm32/crc.h>
+#include <libopencm3/ethernet/mac.h>
+#include <libopencm3/ethernet/phy.h>
+
+#define CHECK(cond)							\
+	do {								\
+		if (!(cond)) {						\
+			printf("%s:%d: check failed: %s\n",		\
+			       __FILE__, __LINE__, #cond);		\
+			failures++;					\
+		}							\
+	} while (0)
+
+static int failures;
+
+/*-- CRC unit ----------------------------------------------------------------*/
+
+/*
+ * MMIO32() only hands out the address of a register, so every access to DR
+ * and CR gets a slot of its own holding what a read returns, and the next
+ * access sees whether the slot was written. A write of the value a read
+ * would have returned is taken for a read; the data below avoids that.
+ * INIT and POL are plain registers.
+ */
+static struct {
+	uint32_t cr;
+	uint32_t dr;
+	uint32_t slot;
+	uint32_t addr;
+	unsigned size;
+	bool busy;
+} crc_unit;
+
+static uint32_t crc_unit_reflect(uint32_t value, unsigned bits)
+{
+	uint32_t ret = 0;
+
+	while (bits--) {
+		ret = (ret << 1) | (value & 1);
+		value >>= 1;
+	}
+	return ret;
+}
+
+static unsigned crc_unit_width(void)
+{
+	switch (crc_unit.cr & CRC_CR_POLYSIZE) {
+	case CRC_CR_POLYSIZE_16:
+		return 16;
+	case CRC_CR_POLYSIZE_8:
+		return 8;
+	case CRC_CR_POLYSIZE_7:
+		return 7;
+	default:
+		return 32;
+	}
+}
+
+static uint32_t crc_unit_read(void)
+{
+	if (crc_unit.cr & CRC_CR_REV_OUT) {
+		return crc_unit_reflect(crc_unit.dr, 32);
+	}
+	return crc_unit.dr;
+}
+
+/* The input is reversed by the unit of REV_IN, then shifted in MSB first */
+static void crc_unit_feed(uint32_t data, unsigned size)
+{
+	static const unsigned rev_unit[] = { 0, 1, 2, 4 };
+	unsigned unit = rev_unit[(crc_unit.cr & CRC_CR_REV_IN) >>
+				 CRC_CR_REV_IN_SHIFT];
+	unsigned width = crc_unit_width();
+	uint32_t mask = (width == 32) ? 0xFFFFFFFF : (1UL << width) - 1;
+	uint32_t in = data;
+	unsigned i;
+	bool fb;
+
+	if (unit) {
+		unit = (unit < size) ? unit : size;
+		in = 0;
+		for (i = 0; i < size; i += unit) {
+			in |= crc_unit_reflect(data >> (i * 8), unit * 8) <<
+			      (i * 8);
+		}
+	}
+	for (i = size * 8; i-- > 0;) {
+		fb = ((crc_unit.dr >> (width - 1)) ^ (in >> i)) & 1;
+		crc_unit.dr = (crc_unit.dr << 1) & mask;
+		if (fb) {
+			crc_unit.dr ^= CRC_POL & mask;
+		}
+	}
+}
+
+/* Act on the previous access, if it wrote */
+static void crc_unit_retire(void)
+{
+	uint32_t mask;
+
+	if (!crc_unit.busy) {
+		return;
+	}
+	crc_unit.busy = false;
+	if (crc_unit.addr == CRC_BASE + 0x08) {
+		if (crc_unit.slot != crc_unit.cr) {
+			crc_unit.cr = crc_unit.slot & ~CRC_CR_RESET;
+			if (crc_unit.slot & CRC_CR_RESET) {
+				crc_unit.dr = CRC_INIT;
+			}
+		}
+	} else if (crc_unit.slot != crc_unit_read()) {
+		mask = (crc_unit.size == 4) ? 0xFFFFFFFF :
+		       (1UL << (crc_unit.size * 8)) - 1;
+		crc_unit_feed(crc_unit.slot & mask, crc_unit.size);
+	}
+}
+
+volatile void *host_mmio_model(uint32_t addr, unsigned size)
+{
+	if ((addr != CRC_BASE) && (addr != CRC_BASE + 0x08)) {
+		return NULL;
+	}
+	crc_unit_retire();
+	crc_unit.addr = addr;
+	crc_unit.size = size;
+	crc_unit.slot = (addr == CRC_BASE) ? crc_unit_read() : crc_unit.cr;
+	crc_unit.busy = true;
+	return &crc_unit.slot;
+}
+
+/* The state after a reset of the unit */
+static void crc_unit_reset(void)
+{
+	crc_unit_retire();
+	CRC_INIT = 0xFFFFFFFF;
+	CRC_POL = 0x04C11DB7;
+	crc_unit.cr = 0;
+	crc_unit.dr = 0xFFFFFFFF;
+}
+
+static const char crc_check[] = "123456789";
+
+/* CRC-32 of the check string: the words reversed as a whole, the last
+ * byte on its own, the result reversed and inverted by the caller */
+static void test_crc_calculate(void)
+{
+	uint32_t words[2];
+	uint32_t crc;
+
+	memcpy(words, crc_check, sizeof(words));
+
+	crc_unit_reset();
+	crc_set_reverse_input(CRC_CR_REV_IN_WORD);
+	crc_reverse_output_enable();
+	crc_reset();
+	crc_calculate(words[0]);
+	crc_calculate(words[1]);
+	crc_set_reverse_input(CRC_CR_REV_IN_BYTE);
+	CRC_DR8 = crc_check[8];
+	crc = CRC_DR;
+	CHECK((crc ^ 0xFFFFFFFF) == 0xCBF43926);
+
+	crc_set_reverse_input(CRC_CR_REV_IN_WORD);
+	crc_reset();
+	crc_calculate_block(words, 2);
+	crc_set_reverse_input(CRC_CR_REV_IN_BYTE);
+	CRC_DR8 = crc_check[8];
+	crc = CRC_DR;
+	CHECK((crc ^ 0xFFFFFFFF) == 0xCBF43926);
+
+	/* Without reversal the same bytes give CRC-32/MPEG-2 */
+	crc_reverse_output_disable();
+	crc_set_reverse_input(CRC_CR_REV_IN_NONE);
+	crc_reset();
+	crc_calculate_block(words, 0);
+	CHECK(CRC_DR == 0xFFFFFFFF);
+	crc_calculate(__builtin_bswap32(words[0]));
+	crc_calculate(__builtin_bswap32(words[1]));
+	CRC_DR8 = crc_check[8];
+	CHECK(CRC_DR == 0x0376E6E7);
+}
+
+/* The presets through the unit, with the check values of the catalogue */
+static void test_crc_compute(void)
+{
+	static const struct {
+		const struct crc_params *params;
+		uint32_t check;
+	} presets[] = {
+		{ &crc_params_crc32, 0xCBF43926 },
+		{ &crc_params_crc32_mpeg2, 0x0376E6E7 },
+		{ &crc_params_crc16_ccitt, 0x29B1 },
+		{ &crc_params_crc16_kermit, 0x2189 },
+		{ &crc_params_crc16_modbus, 0x4B37 },
+		{ &crc_params_crc8, 0xF4 },
+		{ &crc_params_crc7_mmc, 0x75 },
+	};
+	unsigned i;
+
+	crc_unit_reset();
+	for (i = 0; i < sizeof(presets) / sizeof(presets[0]); i++) {
+		if (crc_compute(presets[i].params, crc_check, 9) !=
+		    presets[i].check) {
+			printf("crc preset %u: %08x\n", i,
+			       (unsigned)crc_compute(presets[i].params,
+						     crc_check, 9));
+			failures++;
+		}
+	}
+}
+
+/*-- Ethernet DMA --------------------------------------------------------------*/
+
+#define ETH_PHY		1
+#define ETH_RING	4
+#define ETH_BUF		128
+
+static uint8_t eth_mem[2 * ETH_RING * (ETH_DES_STD_SIZE + ETH_BUF)]
+	__attribute__((aligned(4)));
+static unsigned phy_resets;
+
+/* The PHY, eth_init() only resets it */
+void phy_reset(uint8_t phy)
+{
+	CHECK(phy == ETH_PHY);
+	phy_resets++;
+}
+
+/* Where the DMA goes on in either ring */
+static uint32_t dma_tx, dma_rx;
+
+/* Sends the frames the CPU owns no more, one descriptor per buffer, and
+ * hands the descriptors back. Returns the count of frames. */
+static unsigned dma_send(uint8_t *frames, uint32_t *lens, unsigned max)
+{
+	unsigned n = 0;
+	uint32_t len = 0, l;
+
+	while ((ETH_DES0(dma_tx) & ETH_TDES0_OWN) && (n < max)) {
+		if (ETH_DES0(dma_tx) & ETH_TDES0_FS) {
+			len = 0;
+		}
+		l = ETH_DES1(dma_tx) & ETH_TDES1_TBS1;
+		if (len + l <= ETH_BUF) {
+			memcpy(frames + n * ETH_BUF + len,
+			       (void *)(uintptr_t)ETH_DES2(dma_tx), l);
+		}
+		len += l;
+		if (ETH_DES0(dma_tx) & ETH_TDES0_LS) {
+			lens[n++] = len;
+		}
+		ETH_DES0(dma_tx) &= ~ETH_TDES0_OWN;
+		dma_tx = ETH_DES3(dma_tx);
+	}
+	return n;
+}
+
+/* Stores a frame into the next descriptor, if the DMA owns it */
+static bool dma_receive(const uint8_t *frame, uint32_t len)
+{
+	if (!(ETH_DES0(dma_rx) & ETH_RDES0_OWN)) {
+		return false;
+	}
+	memcpy((void *)(uintptr_t)ETH_DES2(dma_rx), frame, len);
+	ETH_DES0(dma_rx) = ETH_RDES0_FS | ETH_RDES0_LS |
+			   (len << ETH_RDES0_FL_SHIFT);
+	dma_rx = ETH_DES3(dma_rx);
+	return true;
+}
+
+static void eth_frame(uint8_t *frame, uint32_t len, unsigned seq)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		frame[i] = seq * 31 + i;
+	}
+}
+
+/* The copying ring of eth_desc_init(), twice around in each direction.
+ * A full ring refuses the next frame until the DMA hands a descriptor
+ * back. */
+static void test_eth_copy(void)
+{
+	uint8_t frame[ETH_BUF], sent[ETH_RING * ETH_BUF];
+	uint32_t lens[ETH_RING], len;
+	unsigned seq, i, n;
+
+	eth_init(ETH_PHY, ETH_CLK_025_035MHZ);
+	CHECK(phy_resets == 1);
+	eth_desc_init(eth_mem, ETH_RING, ETH_RING, ETH_BUF, ETH_BUF, false);
+	eth_start();
+	dma_tx = ETH_DMATDLAR;
+	dma_rx = ETH_DMARDLAR;
+
+	for (seq = 0; seq < 2 * ETH_RING; seq += ETH_RING) {
+		for (i = 0; i < ETH_RING; i++) {
+			eth_frame(frame, 60 + i, seq + i);
+			CHECK(eth_tx(frame, 60 + i));
+		}
+		CHECK(!eth_tx(frame, 60));
+		n = dma_send(sent, lens, ETH_RING + 1);
+		CHECK(n == ETH_RING);
+		CHECK(dma_tx == ETH_DMATDLAR);
+		for (i = 0; i < n; i++) {
+			eth_frame(frame, 60 + i, seq + i);
+			CHECK(lens[i] == 60 + i);
+			CHECK(memcmp(sent + i * ETH_BUF, frame, 60 + i) == 0);
+		}
+	}
+
+	for (seq = 0; seq < 2 * ETH_RING; seq += ETH_RING) {
+		for (i = 0; i < ETH_RING; i++) {
+			eth_frame(frame, 64 + i, seq + i);
+			CHECK(dma_receive(frame, 64 + i));
+		}
+		CHECK(!dma_receive(frame, 64));
+		CHECK(dma_rx == ETH_DMARDLAR);
+		for (i = 0; i < ETH_RING; i++) {
+			len = 0;
+			CHECK(eth_rx(sent, &len, sizeof(sent)));
+			eth_frame(frame, 64 + i, seq + i);
+			CHECK(len == 64 + i);
+			CHECK(memcmp(sent, frame, 64 + i) == 0);
+		}
+		len = 0;
+		CHECK(!eth_rx(sent, &len, sizeof(sent)));
+		CHECK(len == 0);
+	}
+}
+
+/* The zero-copy ring: frames of several buffers wrap around it, and a
+ * frame the free descriptors cannot take leaves the ring untouched */
+static void test_eth_frags(void)
+{
+	static uint8_t bufs[ETH_RING][ETH_BUF] __attribute__((aligned(4)));
+	static uint8_t before[ETH_RING * ETH_DES_STD_SIZE];
+	uint8_t sent[ETH_RING * ETH_BUF], frame[ETH_RING * ETH_BUF];
+	struct eth_frag frags[ETH_RING + 1];
+	uint32_t lens[ETH_RING], hwm;
+	void *back[ETH_RING + 1];
+	unsigned i, n, seq;
+
+	eth_init(ETH_PHY, ETH_CLK_025_035MHZ);
+	eth_desc_init_zerocopy(eth_mem, ETH_RING, ETH_RING, false);
+	eth_clear_stats();
+	dma_tx = ETH_DMATDLAR;
+
+	for (i = 0; i <= ETH_RING; i++) {
+		frags[i].buf = bufs[i % ETH_RING];
+		frags[i].len = 20 + i;
+		eth_frame(bufs[i % ETH_RING], ETH_BUF, i);
+	}
+
+	memcpy(before, eth_mem, sizeof(before));
+	CHECK(!eth_tx_frags(frags, 0));
+	CHECK(!eth_tx_frags(frags, ETH_RING + 1));
+	CHECK(memcmp(before, eth_mem, sizeof(before)) == 0);
+
+	/* A frame of three buffers, then one of two with a single
+	 * descriptor free */
+	CHECK(eth_tx_frags(frags, 3));
+	CHECK(ETH_DES0(ETH_DMATDLAR) & ETH_TDES0_OWN);
+	CHECK(ETH_DES0(ETH_DMATDLAR) & ETH_TDES0_FS);
+	memcpy(before, eth_mem, sizeof(before));
+	CHECK(!eth_tx_frags(frags, 2));
+	CHECK(memcmp(before, eth_mem, sizeof(before)) == 0);
+
+	n = dma_send(sent, lens, ETH_RING);
+	CHECK(n == 1);
+	CHECK(lens[0] == 20 + 21 + 22);
+	CHECK(memcmp(sent, bufs[0], 20) == 0);
+	CHECK(memcmp(sent + 20, bufs[1], 21) == 0);
+	CHECK(memcmp(sent + 41, bufs[2], 22) == 0);
+
+	/* Sent is not free yet, the buffers come back oldest first */
+	CHECK(!eth_tx_frags(frags, 2));
+	CHECK(eth_tx_reclaim(back, ETH_RING + 1) == 3);
+	for (i = 0; i < 3; i++) {
+		CHECK(back[i] == bufs[i]);
+	}
+	CHECK(eth_tx_reclaim(back, ETH_RING + 1) == 0);
+
+	/* Around the ring a few times, the whole ring in one frame too */
+	for (seq = 0; seq < 3; seq++) {
+		for (n = 2; n <= ETH_RING; n += ETH_RING - 2) {
+			CHECK(eth_tx_frags(frags, n));
+			CHECK(!eth_tx_frags(frags, ETH_RING - n + 1));
+			CHECK(dma_send(sent, lens, ETH_RING) == 1);
+			for (i = 0, lens[1] = 0; i < n; i++) {
+				memcpy(frame + lens[1], bufs[i], 20 + i);
+				lens[1] += 20 + i;
+			}
+			CHECK(lens[0] == lens[1]);
+			CHECK(memcmp(sent, frame, lens[0]) == 0);
+			CHECK(eth_tx_reclaim(back, ETH_RING + 1) == n);
+			CHECK(back[0] == bufs[0] && back[n - 1] == bufs[n - 1]);
+		}
+	}
+	CHECK(eth_get_stats()->tx_frames == 1 + 3 * 2);
+	hwm = eth_get_stats()->tx_hwm;
+	CHECK(hwm == ETH_RING);
+}
+
+int main(void)
+{
+	test_crc_calculate();
+	test_crc_compute();
+	printf("crc: check values of %s\n", crc_check);
+
+	test_eth_copy();
+	test_eth_frags();
+	printf("eth: rings of %u descriptors\n", ETH_RING);
+
+	printf("%s\n", failures ? "FAILED" : "passed");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,955 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Runs the USB stack against usb_model.c on the build machine, on the plain
+ * model and on the st_usbfs driver: enumeration, a mass storage device on a
+ * RAM disk, a stream of random setup packets, and the asynchronous mass
+ * storage ring on a backend that completes when the test says so.
+ *
+ * usage: host-usb [seed [fuzz iterations]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <libopencm3/usb/usbd.h>
+#include <libopencm3/usb/msc.h>
+#include "usb_model.h"
+
+#define EP0_MAXPACKET	64
+#define MSC_EP_OUT	0x01
+#define MSC_EP_IN	0x82
+#define MSC_MAXPACKET	64
+
+#define DISK_BLOCKS	256
+#define DEVICE_ADDRESS	5
+
+#define ENUM_RUNS	10000
+#define READ_BLOCKS	64
+#define READ_BYTES	(64 * 1024 * 1024)
+
+#define RING_MAX	4
+#define IO_MAX		4
+
+/* Endpoints beside the mass storage ones, in the packet memory left */
+#define DBL_EP_OUT	0x03
+#define ISO_EP_OUT	0x04
+#define DBL_EP_IN	0x85
+#define DBL_MAXPACKET	32
+#define DBL_PACKETS	8
+/* Endpoints of the usbd_ep_transfer() tests */
+#define XFER_EP_OUT	0x06
+#define XFER_EP_IN	0x87
+#define XFER_MAXPACKET	16
+
+#define CHECK(cond)							\
+	do {								\
+		if (!(cond)) {						\
+			printf("%s:%d: check failed: %s\n",		\
+			       __FILE__, __LINE__, #cond);		\
+			failures++;					\
+		}							\
+	} while (0)
+
+static const struct usb_device_descriptor dev_desc = {
+	.bLength = USB_DT_DEVICE_SIZE,
+	.bDescriptorType = USB_DT_DEVICE,
+	.bcdUSB = 0x0200,
+	.bDeviceClass = 0,
+	.bDeviceSubClass = 0,
+	.bDeviceProtocol = 0,
+	.bMaxPacketSize0 = EP0_MAXPACKET,
+	.idVendor = 0xcafe,
+	.idProduct = 0xcafe,
+	.bcdDevice = 0x0001,
+	.iManufacturer = 1,
+	.iProduct = 2,
+	.iSerialNumber = 3,
+	.bNumConfigurations = 1,
+};
+
+static const struct usb_endpoint_descriptor msc_endp[] = {
+	{
+		.bLength = USB_DT_ENDPOINT_SIZE,
+		.bDescriptorType = USB_DT_ENDPOINT,
+		.bEndpointAddress = MSC_EP_OUT,
+		.bmAttributes = USB_ENDPOINT_ATTR_BULK,
+		.wMaxPacketSize = MSC_MAXPACKET,
+		.bInterval = 0,
+	},
+	{
+		.bLength = USB_DT_ENDPOINT_SIZE,
+		.bDescriptorType = USB_DT_ENDPOINT,
+		.bEndpointAddress = MSC_EP_IN,
+		.bmAttributes = USB_ENDPOINT_ATTR_BULK,
+		.wMaxPacketSize = MSC_MAXPACKET,
+		.bInterval = 0,
+	},
+};
+
+static const struct usb_interface_descriptor msc_iface[] = {
+	{
+		.bLength = USB_DT_INTERFACE_SIZE,
+		.bDescriptorType = USB_DT_INTERFACE,
+		.bInterfaceNumber = 0,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 2,
+		.bInterfaceClass = USB_CLASS_MSC,
+		.bInterfaceSubClass = USB_MSC_SUBCLASS_SCSI,
+		.bInterfaceProtocol = USB_MSC_PROTOCOL_BBB,
+		.iInterface = 0,
+		.endpoint = msc_endp,
+	}
+};
+
+static const struct usb_interface ifaces[] = {
+	{
+		.num_altsetting = 1,
+		.altsetting = msc_iface,
+	}
+};
+
+static const struct usb_config_descriptor config_desc = {
+	.bLength = USB_DT_CONFIGURATION_SIZE,
+	.bDescriptorType = USB_DT_CONFIGURATION,
+	.wTotalLength = 0,
+	.bNumInterfaces = 1,
+	.bConfigurationValue = 1,
+	.iConfiguration = 0,
+	.bmAttributes = 0x80,
+	.bMaxPower = 0x32,
+	.interface = ifaces,
+};
+
+static const char * const usb_strings[] = {
+	"libopencm3",
+	"host model",
+	"0001",
+};
+
+static uint8_t usbd_control_buffer[128];
+static uint8_t disk[DISK_BLOCKS][512];
+static usbd_device *usbd_dev;
+static const struct usb_model_hw *model_hw;
+static int failures;
+
+static int disk_read(uint32_t lba, uint8_t *copy_to)
+{
+	memcpy(copy_to, disk[lba % DISK_BLOCKS], 512);
+	return 0;
+}
+
+static int disk_write(uint32_t lba, const uint8_t *copy_from)
+{
+	memcpy(disk[lba % DISK_BLOCKS], copy_from, 512);
+	return 0;
+}
+
+/*
+ * Backend of usb_msc_init_async(). Requests complete at once, or while
+ * deferred when io_complete() is called, as the host keeps being NAKed or
+ * the test says so. The data is copied at completion, so a ring slot that
+ * the stack hands out again too early shows up as corrupted data.
+ */
+static struct {
+	struct {
+		uint32_t lba;
+		uint32_t count;
+		uint8_t *copy_to;
+		const uint8_t *copy_from;
+		usb_msc_io_done_callback done;
+	} req[IO_MAX];
+	unsigned head, tail;
+	bool defer;
+} io;
+
+static unsigned io_pending(void)
+{
+	return io.tail - io.head;
+}
+
+static bool io_complete(void)
+{
+	uint32_t i, lba;
+	unsigned slot;
+
+	if (io.head == io.tail) {
+		return false;
+	}
+	slot = io.head++ % IO_MAX;
+	for (i = 0; i < io.req[slot].count; i++) {
+		lba = (io.req[slot].lba + i) % DISK_BLOCKS;
+		if (io.req[slot].copy_to) {
+			memcpy(io.req[slot].copy_to + i * 512, disk[lba], 512);
+		} else {
+			memcpy(disk[lba], io.req[slot].copy_from + i * 512,
+			       512);
+		}
+	}
+	io.req[slot].done(0);
+	usb_model_run(usbd_dev);
+	return true;
+}
+
+static int io_start(uint32_t lba, uint32_t count, uint8_t *copy_to,
+		    const uint8_t *copy_from, usb_msc_io_done_callback done)
+{
+	unsigned slot;
+
+	if (io.tail - io.head == IO_MAX) {
+		CHECK(!"backend overrun");
+		return -1;
+	}
+	slot = io.tail++ % IO_MAX;
+	io.req[slot].lba = lba;
+	io.req[slot].count = count;
+	io.req[slot].copy_to = copy_to;
+	io.req[slot].copy_from = copy_from;
+	io.req[slot].done = done;
+	if (!io.defer) {
+		io_complete();
+	}
+	return 0;
+}
+
+static int io_read(uint32_t lba, uint32_t count, uint8_t *copy_to,
+		   usb_msc_io_done_callback done)
+{
+	return io_start(lba, count, copy_to, NULL, done);
+}
+
+static int io_write(uint32_t lba, uint32_t count, const uint8_t *copy_from,
+		    usb_msc_io_done_callback done)
+{
+	return io_start(lba, count, NULL, copy_from, done);
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+	/* xorshift32 */
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+	return rnd_state;
+}
+
+static int control(uint8_t type, uint8_t request, uint16_t value,
+		   uint16_t index, uint16_t length, void *data)
+{
+	struct usb_setup_data req = {
+		.bmRequestType = type,
+		.bRequest = request,
+		.wValue = value,
+		.wIndex = index,
+		.wLength = length,
+	};
+
+	return usb_model_control(usbd_dev, &req, data);
+}
+
+static int get_descriptor(uint8_t type, uint8_t index, uint16_t length,
+			  uint8_t *buf)
+{
+	uint16_t langid = 0;
+
+	if ((type == USB_DT_STRING) && index) {
+		langid = USB_LANGID_ENGLISH_US;
+	}
+	return control(USB_REQ_TYPE_IN, USB_REQ_GET_DESCRIPTOR,
+		       (type << 8) | index, langid, length, buf);
+}
+
+/* The requests of a Linux host plugging in the device */
+static bool enumerate(void)
+{
+	int before = failures;
+	uint8_t buf[256];
+	uint16_t total;
+
+	usb_model_bus_reset(usbd_dev);
+
+	CHECK(get_descriptor(USB_DT_DEVICE, 0, 64, buf) == USB_DT_DEVICE_SIZE);
+	CHECK(memcmp(buf, &dev_desc, USB_DT_DEVICE_SIZE) == 0);
+
+	usb_model_bus_reset(usbd_dev);
+	CHECK(control(0, USB_REQ_SET_ADDRESS, DEVICE_ADDRESS, 0, 0,
+		      NULL) == 0);
+	CHECK(usb_model_address() == DEVICE_ADDRESS);
+
+	CHECK(get_descriptor(USB_DT_DEVICE, 0, USB_DT_DEVICE_SIZE, buf) ==
+	      USB_DT_DEVICE_SIZE);
+	CHECK(get_descriptor(USB_DT_CONFIGURATION, 0, 9, buf) == 9);
+	total = buf[2] | (buf[3] << 8);
+	CHECK(total == 9 + 9 + 2 * 7);
+	CHECK(get_descriptor(USB_DT_CONFIGURATION, 0, total, buf) == total);
+	CHECK(buf[9 + 5] == USB_CLASS_MSC);
+
+	CHECK(get_descriptor(USB_DT_STRING, 0, 255, buf) == 4);
+	CHECK(get_descriptor(USB_DT_STRING, 2, 255, buf) ==
+	      2 + 2 * (int)strlen(usb_strings[1]));
+	CHECK(get_descriptor(USB_DT_STRING, 9, 255, buf) == USB_MODEL_STALL);
+
+	CHECK(control(0, USB_REQ_SET_CONFIGURATION, 1, 0, 0, NULL) == 0);
+	CHECK(control(USB_REQ_TYPE_IN, USB_REQ_GET_CONFIGURATION, 0, 0, 1,
+		      buf) == 1);
+	CHECK(buf[0] == 1);
+	CHECK(control(USB_REQ_TYPE_IN | USB_REQ_TYPE_CLASS |
+		      USB_REQ_TYPE_INTERFACE, USB_MSC_REQ_GET_MAX_LUN, 0, 0,
+		      1, buf) == 1);
+	CHECK(buf[0] == 0);
+
+	return failures == before;
+}
+
+static int bulk_in(void *buf, uint16_t len)
+{
+	int i, ret = USB_MODEL_NAK;
+
+	for (i = 0; (i < 8) && (ret == USB_MODEL_NAK); i++) {
+		ret = usb_model_in(usbd_dev, MSC_EP_IN, buf, len);
+		if (ret == USB_MODEL_NAK) {
+			io_complete();
+		}
+	}
+	return ret;
+}
+
+static int bulk_out(const void *buf, uint16_t len)
+{
+	int i, ret = USB_MODEL_NAK;
+
+	for (i = 0; (i < 8) && (ret == USB_MODEL_NAK); i++) {
+		ret = usb_model_out(usbd_dev, MSC_EP_OUT, buf, len);
+		if (ret == USB_MODEL_NAK) {
+			io_complete();
+		}
+	}
+	return ret;
+}
+
+/* Sends the CBW of a READ(10) or WRITE(10) of the bulk only transport */
+static bool msc_cbw(bool read, uint32_t tag, uint32_t lba, uint16_t count)
+{
+	uint32_t length = count * 512;
+	uint8_t cbw[31] = { 'U', 'S', 'B', 'C' };
+
+	cbw[4] = tag;
+	cbw[5] = tag >> 8;
+	cbw[6] = tag >> 16;
+	cbw[7] = tag >> 24;
+	cbw[8] = length;
+	cbw[9] = length >> 8;
+	cbw[10] = length >> 16;
+	cbw[11] = length >> 24;
+	cbw[12] = read ? 0x80 : 0x00;
+	cbw[14] = 10;
+	cbw[15] = read ? 0x28 : 0x2a;
+	cbw[17] = lba >> 24;
+	cbw[18] = lba >> 16;
+	cbw[19] = lba >> 8;
+	cbw[20] = lba;
+	cbw[22] = count >> 8;
+	cbw[23] = count;
+
+	return bulk_out(cbw, sizeof(cbw)) == sizeof(cbw);
+}
+
+/* Receives the CSW, returns its status or -1 on a transport failure */
+static int msc_csw(uint32_t tag)
+{
+	uint8_t csw[13];
+
+	if (bulk_in(csw, sizeof(csw)) != sizeof(csw) ||
+	    memcmp(csw, "USBS", 4) != 0 || csw[4] != (uint8_t)tag ||
+	    csw[5] != (uint8_t)(tag >> 8) || csw[6] != (uint8_t)(tag >> 16) ||
+	    csw[7] != (uint8_t)(tag >> 24)) {
+		return -1;
+	}
+	return csw[12];
+}
+
+/* Runs a READ(10) or WRITE(10) of the bulk only transport, returns the
+ * CSW status or -1 on a transport failure */
+static int msc_rw(bool read, uint32_t tag, uint32_t lba, uint16_t count,
+		  uint8_t *data)
+{
+	uint32_t length = count * 512, done;
+	int ret;
+
+	if (!msc_cbw(read, tag, lba, count)) {
+		return -1;
+	}
+
+	for (done = 0; done < length; done += ret) {
+		if (read) {
+			ret = bulk_in(data + done, MSC_MAXPACKET);
+		} else {
+			ret = bulk_out(data + done, MSC_MAXPACKET);
+		}
+		if (ret <= 0) {
+			return -1;
+		}
+	}
+
+	return msc_csw(tag);
+}
+
+static void test_enumeration(void)
+{
+	double start, time;
+	int i;
+
+	CHECK(enumerate());
+
+	start = now();
+	for (i = 0; i < ENUM_RUNS; i++) {
+		enumerate();
+	}
+	time = now() - start;
+	printf("enumeration: %.2f us\n", time * 1e6 / ENUM_RUNS);
+}
+
+static void test_msc(void)
+{
+	static uint8_t data[READ_BLOCKS * 512], check[READ_BLOCKS * 512];
+	double start, time;
+	uint32_t tag = 1;
+	unsigned i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = rnd();
+	}
+	CHECK(msc_rw(false, tag++, 16, READ_BLOCKS, data) == 0);
+	CHECK(memcmp(disk[16], data, sizeof(data)) == 0);
+	CHECK(msc_rw(true, tag++, 16, READ_BLOCKS, check) == 0);
+	CHECK(memcmp(check, data, sizeof(data)) == 0);
+
+	start = now();
+	for (i = 0; i < READ_BYTES / sizeof(data); i++) {
+		if (msc_rw(true, tag++, 0, READ_BLOCKS, data) != 0) {
+			CHECK(!"READ(10) failed");
+			break;
+		}
+	}
+	time = now() - start;
+	printf("msc read: %.1f MB/s\n", READ_BYTES / time / 1e6);
+
+	start = now();
+	for (i = 0; i < READ_BYTES / sizeof(data); i++) {
+		if (msc_rw(false, tag++, 0, READ_BLOCKS, data) != 0) {
+			CHECK(!"WRITE(10) failed");
+			break;
+		}
+	}
+	time = now() - start;
+	printf("msc write: %.1f MB/s\n", READ_BYTES / time / 1e6);
+}
+
+/* Random requests, mostly near the standard ones. After each the device
+ * must still answer GET_DESCRIPTOR. */
+static void test_fuzz(unsigned iterations)
+{
+	static const uint8_t types[] = {
+		0x00, 0x80, 0x01, 0x81, 0x02, 0x82, 0x21, 0xa1,
+	};
+	static const uint8_t requests[] = {
+		USB_REQ_GET_STATUS, USB_REQ_CLEAR_FEATURE,
+		USB_REQ_SET_FEATURE, USB_REQ_SET_ADDRESS,
+		USB_REQ_GET_DESCRIPTOR, USB_REQ_SET_DESCRIPTOR,
+		USB_REQ_GET_CONFIGURATION, USB_REQ_SET_CONFIGURATION,
+		USB_REQ_GET_INTERFACE, USB_REQ_SET_INTERFACE,
+		USB_REQ_SET_SYNCH_FRAME, USB_REQ_GET_DESCRIPTOR,
+		USB_REQ_GET_DESCRIPTOR, USB_REQ_SET_CONFIGURATION,
+		USB_MSC_REQ_GET_MAX_LUN, USB_MSC_REQ_BULK_ONLY_RESET,
+	};
+	unsigned i, acked = 0, stalled = 0, other = 0;
+	struct usb_setup_data req;
+	uint8_t data[512], desc[USB_DT_DEVICE_SIZE];
+	int ret;
+
+	for (i = 0; i < iterations; i++) {
+		req.bmRequestType = (rnd() & 3) ? types[rnd() & 7] : rnd();
+		req.bRequest = (rnd() & 3) ? requests[rnd() & 15] : rnd();
+		req.wValue = (rnd() & 1) ? ((rnd() % 4) << 8) | (rnd() % 4) :
+			     rnd();
+		req.wIndex = (rnd() & 1) ? rnd() % 4 : rnd();
+		req.wLength = (rnd() & 1) ? rnd() % 300 : rnd() % 8;
+		memset(data, rnd(), sizeof(data));
+
+		ret = usb_model_control(usbd_dev, &req, data);
+		if (ret >= 0) {
+			acked++;
+		} else if (ret == USB_MODEL_STALL) {
+			stalled++;
+		} else {
+			other++;
+		}
+
+		if (get_descriptor(USB_DT_DEVICE, 0, sizeof(desc), desc) !=
+		    sizeof(desc) || memcmp(desc, &dev_desc, sizeof(desc))) {
+			printf("fuzz %u: no response after %02x %02x %04x "
+			       "%04x %04x\n", i, req.bmRequestType,
+			       req.bRequest, req.wValue, req.wIndex,
+			       req.wLength);
+			failures++;
+			enumerate();
+		}
+	}
+	printf("fuzz: %u requests, %u acked, %u stalled, %u other, "
+	       "%u unread receptions\n", iterations, acked, stalled, other,
+	       usb_model_stuck_events());
+
+	/* Still usable as a disk afterwards */
+	CHECK(enumerate());
+	CHECK(msc_rw(true, 0xf000, 0, 1, data) == 0);
+}
+
+/* Reads and writes through the ring while the backend takes its time */
+static void test_async_rw(void)
+{
+	static uint8_t data[16 * 512], check[16 * 512];
+	unsigned i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = rnd();
+	}
+	io.defer = true;
+	CHECK(msc_rw(false, 0xa001, 32, 16, data) == 0);
+	CHECK(memcmp(disk[32], data, sizeof(data)) == 0);
+	CHECK(msc_rw(true, 0xa002, 32, 16, check) == 0);
+	CHECK(memcmp(check, data, sizeof(data)) == 0);
+	CHECK(msc_rw(true, 0xa003, 32, 1, check) == 0);
+	CHECK(memcmp(check, data, 512) == 0);
+	CHECK(io_pending() == 0);
+	io.defer = false;
+}
+
+/* The host sends the data of a WRITE back to back, every packet going in
+ * as soon as the OUT endpoint is VALID, while the backend holds on to the
+ * first sector. The endpoint has to NAK once the ring is full, before
+ * taking a packet it has no room for. */
+static void test_async_ring_full(unsigned ring_size)
+{
+	static uint8_t data[8 * 512];
+	unsigned i, accepted;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = rnd();
+	}
+	io.defer = true;
+	CHECK(msc_cbw(false, 0xb001, 64, 8));
+	for (i = 0; i < sizeof(data) / MSC_MAXPACKET; i++) {
+		usb_model_queue_out(usbd_dev, MSC_EP_OUT,
+				    data + i * MSC_MAXPACKET, MSC_MAXPACKET);
+	}
+
+	/* One packet may wait in the endpoint buffer behind a full ring */
+	accepted = sizeof(data) - usb_model_queued() * MSC_MAXPACKET;
+	CHECK(accepted <= ring_size * 512 + MSC_MAXPACKET);
+	CHECK(io_pending() == 1);
+
+	for (i = 0; (i < 64) && (usb_model_queued() || io_pending()); i++) {
+		io_complete();
+	}
+	CHECK(usb_model_queued() == 0);
+	CHECK(msc_csw(0xb001) == 0);
+	CHECK(memcmp(disk[64], data, sizeof(data)) == 0);
+	io.defer = false;
+}
+
+/* A Bulk-Only Mass Storage Reset while the backend still writes a sector.
+ * Its completion has to be dropped, the next command to wait for it. */
+static void test_async_reset(void)
+{
+	static uint8_t data[512], check[2 * 512];
+	unsigned i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = rnd();
+	}
+	io.defer = true;
+	CHECK(msc_cbw(false, 0xc001, 80, 4));
+	for (i = 0; i < sizeof(data) / MSC_MAXPACKET; i++) {
+		CHECK(bulk_out(data + i * MSC_MAXPACKET, MSC_MAXPACKET) ==
+		      MSC_MAXPACKET);
+	}
+	CHECK(io_pending() == 1);
+
+	CHECK(control(USB_REQ_TYPE_CLASS | USB_REQ_TYPE_INTERFACE,
+		      USB_MSC_REQ_BULK_ONLY_RESET, 0, 0, 0, NULL) == 0);
+
+	/* No new request while the old one runs */
+	CHECK(msc_cbw(true, 0xc002, 0, 2));
+	CHECK(io_pending() == 1);
+	for (i = 0; i < sizeof(check); i += MSC_MAXPACKET) {
+		if (bulk_in(check + i, MSC_MAXPACKET) != MSC_MAXPACKET) {
+			CHECK(!"READ(10) after reset failed");
+			break;
+		}
+	}
+	CHECK(msc_csw(0xc002) == 0);
+	CHECK(memcmp(check, disk[0], sizeof(check)) == 0);
+	CHECK(io_pending() == 0);
+	io.defer = false;
+
+	/* Still in step afterwards */
+	CHECK(msc_rw(true, 0xc003, 80, 1, check) == 0);
+	CHECK(memcmp(check, data, sizeof(data)) == 0);
+}
+
+static struct {
+	uint8_t data[DBL_PACKETS][DBL_MAXPACKET];
+	uint16_t len[DBL_PACKETS];
+	unsigned count;
+} dbl_rx;
+
+static void dbl_rx_cb(usbd_device *dev, uint8_t ep)
+{
+	uint8_t buf[DBL_MAXPACKET];
+	uint16_t len = usbd_ep_read_packet(dev, ep, buf, sizeof(buf));
+
+	if (dbl_rx.count < DBL_PACKETS) {
+		memcpy(dbl_rx.data[dbl_rx.count], buf, len);
+		dbl_rx.len[dbl_rx.count++] = len;
+	}
+}
+
+static void dbl_fill(uint8_t data[DBL_PACKETS][DBL_MAXPACKET],
+		     uint16_t *len)
+{
+	unsigned i, j;
+
+	for (i = 0; i < DBL_PACKETS; i++) {
+		len[i] = (i & 1) ? 1 + rnd() % DBL_MAXPACKET : DBL_MAXPACKET;
+		for (j = 0; j < len[i]; j++) {
+			data[i][j] = rnd();
+		}
+	}
+}
+
+static bool dbl_rx_match(uint8_t data[DBL_PACKETS][DBL_MAXPACKET],
+			 const uint16_t *len)
+{
+	unsigned i;
+
+	if (dbl_rx.count != DBL_PACKETS) {
+		return false;
+	}
+	for (i = 0; i < DBL_PACKETS; i++) {
+		if ((dbl_rx.len[i] != len[i]) ||
+		    memcmp(dbl_rx.data[i], data[i], len[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* The double buffered and isochronous endpoints of st_usbfs, whose
+ * packets have to come out in the order they went in while the two
+ * buffers take turns. The host sends the next OUT packet the moment the
+ * driver hands a buffer back, before it has copied out the packet in the
+ * other one. */
+static void test_double_buffer(void)
+{
+	uint8_t data[DBL_PACKETS][DBL_MAXPACKET], buf[DBL_MAXPACKET];
+	uint16_t len[DBL_PACKETS];
+	unsigned i;
+
+	usbd_ep_setup(usbd_dev, DBL_EP_OUT,
+		      USB_ENDPOINT_ATTR_BULK | USBD_EP_DOUBLE_BUFFER,
+		      DBL_MAXPACKET, dbl_rx_cb);
+	usbd_ep_setup(usbd_dev, ISO_EP_OUT, USB_ENDPOINT_ATTR_ISOCHRONOUS,
+		      DBL_MAXPACKET, dbl_rx_cb);
+	usbd_ep_setup(usbd_dev, DBL_EP_IN,
+		      USB_ENDPOINT_ATTR_BULK | USBD_EP_DOUBLE_BUFFER,
+		      DBL_MAXPACKET, NULL);
+
+	/* All packets wait at the host until the endpoint turns VALID */
+	memset(&dbl_rx, 0, sizeof(dbl_rx));
+	dbl_fill(data, len);
+	usbd_ep_nak_set(usbd_dev, DBL_EP_OUT, 1);
+	for (i = 0; i < DBL_PACKETS; i++) {
+		usb_model_queue_out(usbd_dev, DBL_EP_OUT, data[i], len[i]);
+	}
+	CHECK(usb_model_queued() == DBL_PACKETS);
+	usbd_ep_nak_set(usbd_dev, DBL_EP_OUT, 0);
+	usb_model_run(usbd_dev);
+	CHECK(usb_model_queued() == 0);
+	CHECK(dbl_rx_match(data, len));
+
+	memset(&dbl_rx, 0, sizeof(dbl_rx));
+	dbl_fill(data, len);
+	for (i = 0; i < DBL_PACKETS; i++) {
+		CHECK(usb_model_out(usbd_dev, ISO_EP_OUT, data[i], len[i]) ==
+		      len[i]);
+	}
+	CHECK(dbl_rx_match(data, len));
+
+	/* Two packets go in, the second waiting behind the first, and the
+	 * host takes them in that order */
+	dbl_fill(data, len);
+	for (i = 0; i < DBL_PACKETS; i += 2) {
+		CHECK(usbd_ep_write_packet(usbd_dev, DBL_EP_IN, data[i],
+					   len[i]) == len[i]);
+		CHECK(usbd_ep_write_packet(usbd_dev, DBL_EP_IN, data[i + 1],
+					   len[i + 1]) == len[i + 1]);
+		CHECK(usbd_ep_write_packet(usbd_dev, DBL_EP_IN, data[i],
+					   len[i]) == 0);
+		CHECK(usb_model_in(usbd_dev, DBL_EP_IN, buf, sizeof(buf)) ==
+		      len[i]);
+		CHECK(memcmp(buf, data[i], len[i]) == 0);
+		CHECK(usb_model_in(usbd_dev, DBL_EP_IN, buf, sizeof(buf)) ==
+		      len[i + 1]);
+		CHECK(memcmp(buf, data[i + 1], len[i + 1]) == 0);
+		CHECK(usb_model_in(usbd_dev, DBL_EP_IN, buf, sizeof(buf)) ==
+		      USB_MODEL_NAK);
+	}
+}
+
+static struct {
+	unsigned count;
+	uint32_t len;
+	unsigned packets;
+} xfer_done;
+
+static void xfer_cb(usbd_device *dev, uint8_t ep, uint32_t len)
+{
+	(void)dev;
+	(void)ep;
+	xfer_done.count++;
+	xfer_done.len = len;
+}
+
+/* The endpoint callback, only called outside transfers */
+static void xfer_rx_cb(usbd_device *dev, uint8_t ep)
+{
+	uint8_t buf[XFER_MAXPACKET];
+
+	usbd_ep_read_packet(dev, ep, buf, sizeof(buf));
+	xfer_done.packets++;
+}
+
+/* Reads an IN transfer packet by packet, checking the callback only comes
+ * with the last one */
+static bool xfer_in(const uint8_t *data, const uint16_t *packets,
+		    unsigned count)
+{
+	uint8_t buf[XFER_MAXPACKET];
+	uint32_t offset = 0;
+	unsigned i;
+	int before = failures;
+
+	for (i = 0; i < count; i++) {
+		CHECK(xfer_done.count == 0);
+		CHECK(usb_model_in(usbd_dev, XFER_EP_IN, buf, sizeof(buf)) ==
+		      packets[i]);
+		CHECK(memcmp(buf, data + offset, packets[i]) == 0);
+		offset += packets[i];
+	}
+	CHECK(xfer_done.count == 1 && xfer_done.len == offset);
+	CHECK(usb_model_in(usbd_dev, XFER_EP_IN, buf, sizeof(buf)) ==
+	      USB_MODEL_NAK);
+	return failures == before;
+}
+
+/* usbd_ep_transfer() in both directions: IN split into packets and ended by
+ * a zero length packet where needed, OUT ended by a full buffer, a short
+ * packet or a zero length one, after which the endpoint NAKs until told
+ * otherwise and its own callback is back. */
+static void test_transfer(void)
+{
+	static const uint16_t in_short[] = { 16, 16, 16, 8 };
+	static const uint16_t in_zlp[] = { 16, 16, 0 };
+	static const uint16_t in_no_zlp[] = { 16, 16 };
+	static const uint16_t in_empty[] = { 0 };
+	uint8_t data[4 * XFER_MAXPACKET], buf[4 * XFER_MAXPACKET];
+	struct usbd_transfer xfer;
+	unsigned i;
+
+	usbd_ep_setup(usbd_dev, XFER_EP_OUT, USB_ENDPOINT_ATTR_BULK,
+		      XFER_MAXPACKET, xfer_rx_cb);
+	usbd_ep_setup(usbd_dev, XFER_EP_IN, USB_ENDPOINT_ATTR_BULK,
+		      XFER_MAXPACKET, NULL);
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = rnd();
+	}
+
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_IN, data, 56, 0,
+			       xfer_cb) == 0);
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_IN, data, 56, 0,
+			       xfer_cb) == -1);
+	CHECK(xfer_in(data, in_short, 4));
+
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_IN, data, 32, 0,
+			       xfer_cb) == 0);
+	CHECK(xfer_in(data, in_zlp, 3));
+
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_IN, data, 32,
+			       USBD_TRANSFER_NO_ZLP, xfer_cb) == 0);
+	CHECK(xfer_in(data, in_no_zlp, 2));
+
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_IN, data, 0, 0,
+			       xfer_cb) == 0);
+	CHECK(xfer_in(data, in_empty, 1));
+
+	/* A short packet ends it, the rest of the buffer untouched */
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	memset(buf, 0, sizeof(buf));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_OUT, buf, sizeof(buf),
+			       0, xfer_cb) == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data, 16) == 16);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data + 16, 16) == 16);
+	CHECK(xfer_done.count == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data + 32, 5) == 5);
+	CHECK(xfer_done.count == 1 && xfer_done.len == 37);
+	CHECK(memcmp(buf, data, 37) == 0 && buf[37] == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data, 16) ==
+	      USB_MODEL_NAK);
+
+	/* A zero length packet ends it too */
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_OUT, buf, sizeof(buf),
+			       0, xfer_cb) == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data + 8, 16) == 16);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data, 0) == 0);
+	CHECK(xfer_done.count == 1 && xfer_done.len == 16);
+	CHECK(memcmp(buf, data + 8, 16) == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data, 16) ==
+	      USB_MODEL_NAK);
+
+	/* As does a full buffer, the host's next packet left waiting */
+	memset(&xfer_done, 0, sizeof(xfer_done));
+	CHECK(usbd_ep_transfer(usbd_dev, &xfer, XFER_EP_OUT, buf, 32, 0,
+			       xfer_cb) == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data + 1, 16) == 16);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data + 17, 16) == 16);
+	CHECK(xfer_done.count == 1 && xfer_done.len == 32);
+	CHECK(memcmp(buf, data + 1, 32) == 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data, 16) ==
+	      USB_MODEL_NAK);
+
+	/* Letting the host in again goes to the endpoint callback */
+	usbd_ep_nak_set(usbd_dev, XFER_EP_OUT, 0);
+	CHECK(usb_model_out(usbd_dev, XFER_EP_OUT, data, 16) == 16);
+	CHECK(xfer_done.packets == 1 && xfer_done.count == 1);
+}
+
+static void init(bool async, unsigned ring_size)
+{
+	static uint8_t ring[RING_MAX * 512];
+
+	memset(&io, 0, sizeof(io));
+	usbd_dev = usbd_init(model_hw->driver, &dev_desc, &config_desc,
+			     usb_strings, 3, usbd_control_buffer,
+			     sizeof(usbd_control_buffer));
+	if (async) {
+		CHECK(!usb_msc_init_async(usbd_dev, MSC_EP_IN, MSC_MAXPACKET,
+					  MSC_EP_OUT, MSC_MAXPACKET, "VendorID",
+					  "ProductID", "0.00", DISK_BLOCKS,
+					  NULL, ring_size, io_read, io_write));
+		CHECK(!usb_msc_init_async(usbd_dev, MSC_EP_IN, MSC_MAXPACKET,
+					  MSC_EP_OUT, MSC_MAXPACKET, "VendorID",
+					  "ProductID", "0.00", DISK_BLOCKS,
+					  ring, 0, io_read, io_write));
+		usb_msc_init_async(usbd_dev, MSC_EP_IN, MSC_MAXPACKET,
+				   MSC_EP_OUT, MSC_MAXPACKET, "VendorID",
+				   "ProductID", "0.00", DISK_BLOCKS, ring,
+				   ring_size, io_read, io_write);
+	} else {
+		usb_msc_init(usbd_dev, MSC_EP_IN, MSC_MAXPACKET, MSC_EP_OUT,
+			     MSC_MAXPACKET, "VendorID", "ProductID", "0.00",
+			     DISK_BLOCKS, disk_read, disk_write);
+	}
+}
+
+static void run(const struct usb_model_hw *hw, unsigned iterations)
+{
+	unsigned ring_size, stuck;
+
+	printf("%s:\n", hw->name);
+	model_hw = hw;
+	usb_model_select(hw);
+
+	init(false, 0);
+	test_enumeration();
+	test_msc();
+	CHECK(usb_model_stuck_events() == 0);
+	test_fuzz(iterations);
+
+	for (ring_size = 2; ring_size <= RING_MAX; ring_size += 2) {
+		stuck = usb_model_stuck_events();
+		init(true, ring_size);
+		CHECK(enumerate());
+		test_async_rw();
+		test_async_ring_full(ring_size);
+		test_async_reset();
+		CHECK(usb_model_stuck_events() == stuck);
+	}
+	printf("async: ring of 2 and %u sectors\n", RING_MAX);
+
+	stuck = usb_model_stuck_events();
+	init(false, 0);
+	CHECK(enumerate());
+	test_transfer();
+	CHECK(usb_model_stuck_events() == stuck);
+	printf("transfers: multi-packet, short and zero length packets\n");
+
+	if (hw == &usb_model_st_usbfs) {
+		stuck = usb_model_stuck_events();
+		init(false, 0);
+		CHECK(enumerate());
+		test_double_buffer();
+		CHECK(usb_model_stuck_events() == stuck);
+		printf("double buffered: %u packets each way\n",
+		       DBL_PACKETS);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	unsigned seed = 1, iterations = 100000;
+
+	if (argc > 1) {
+		seed = strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		iterations = strtoul(argv[2], NULL, 0);
+	}
+	rnd_state = seed ? seed : 1;
+
+	run(&usb_model_plain, iterations);
+	run(&usb_model_st_usbfs, iterations);
+
+	printf("seed %u: %s\n", seed, failures ? "FAILED" : "passed");
+	return failures ? 1 : 0;
+}
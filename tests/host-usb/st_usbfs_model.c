@@ -0,0 +1,323 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The USB FS device of the STM32F1 for the st_usbfs driver of the library,
+ * built with LIBOPENCM3_HOST: the registers and the packet memory are in
+ * the register file of lib/host/host_mmio.c, and SET_REG() comes here to
+ * give the endpoint registers their toggle and write 0 to clear bits. The
+ * bus side plays the peripheral to the host of usb_model.c. Double
+ * buffered bulk and isochronous endpoints take buffer 0 from the TX and
+ * buffer 1 from the RX half of the buffer descriptor, the DTOG of the
+ * direction in use picking the one the peripheral takes next.
+ */
+
+#include <stddef.h>
+#include <libopencm3/cm3/common.h>
+#include <libopencm3/stm32/tools.h>
+#include <libopencm3/stm32/st_usbfs.h>
+#include <libopencm3/usb/usbd.h>
+#include "../../lib/usb/usb_private.h"
+#include "usb_model.h"
+
+/* Bits of an endpoint register the driver toggles by writing 1 */
+#define EP_TOGGLE	(USB_EP_RX_DTOG | USB_EP_RX_STAT | \
+			 USB_EP_TX_DTOG | USB_EP_TX_STAT)
+/* Bits it clears by writing 0 */
+#define EP_CLEAR	(USB_EP_RX_CTR | USB_EP_TX_CTR)
+/* Bits it writes as they are */
+#define EP_PLAIN	(USB_EP_TYPE | USB_EP_KIND | USB_EP_ADDR)
+/* Bits of ISTR that follow the endpoints */
+#define ISTR_EP		(USB_ISTR_CTR | USB_ISTR_DIR | USB_ISTR_EP_ID)
+
+static volatile uint32_t *ep_reg(uint8_t ep)
+{
+	return USB_EP_REG(ep);
+}
+
+/* Put the lowest endpoint with a completed transaction in ISTR, reception
+ * first */
+static void st_usbfs_update_istr(void)
+{
+	uint32_t istr = *USB_ISTR_REG & ~ISTR_EP;
+	uint32_t epr;
+	uint8_t i;
+
+	for (i = 0; i < 8; i++) {
+		epr = *ep_reg(i);
+		if (epr & USB_EP_RX_CTR) {
+			istr |= USB_ISTR_CTR | USB_ISTR_DIR | i;
+			break;
+		}
+		if (epr & USB_EP_TX_CTR) {
+			istr |= USB_ISTR_CTR | i;
+			break;
+		}
+	}
+	*USB_ISTR_REG = istr;
+}
+
+static bool st_usbfs_is_dbl(uint32_t epr)
+{
+	return (epr & (USB_EP_TYPE | USB_EP_KIND)) ==
+	       (USB_EP_TYPE_BULK | USB_EP_KIND);
+}
+
+static bool st_usbfs_is_iso(uint32_t epr)
+{
+	return (epr & USB_EP_TYPE) == USB_EP_TYPE_ISO;
+}
+
+/* A double buffered endpoint NAKs while SW_BUF is its own DTOG */
+static bool st_usbfs_rx_ready(uint32_t epr)
+{
+	if ((epr & USB_EP_RX_STAT) != USB_EP_RX_STAT_VALID) {
+		return false;
+	}
+	return !st_usbfs_is_dbl(epr) ||
+	       (!(epr & USB_EP_RX_DTOG) != !(epr & USB_EP_RX_SW_BUF));
+}
+
+static bool st_usbfs_tx_ready(uint32_t epr)
+{
+	return !st_usbfs_is_dbl(epr) ||
+	       (!(epr & USB_EP_TX_DTOG) != !(epr & USB_EP_TX_SW_BUF));
+}
+
+static void st_usbfs_set_ep(uint8_t ep, uint32_t clear, uint32_t set)
+{
+	*ep_reg(ep) = (*ep_reg(ep) & ~clear) | set;
+	st_usbfs_update_istr();
+}
+
+/* Overrides the plain store of lib/host */
+void host_set_reg(volatile uint32_t *reg, uint16_t val)
+{
+	uint32_t old = *reg, new;
+	ptrdiff_t ep = reg - USB_EP_REG(0);
+
+	if ((ep >= 0) && (ep < 8)) {
+		new = ((old ^ val) & EP_TOGGLE) | (old & val & EP_CLEAR) |
+		      (old & USB_EP_SETUP) | (val & EP_PLAIN);
+		*reg = new;
+		st_usbfs_update_istr();
+		if (!st_usbfs_rx_ready(old) && st_usbfs_rx_ready(new)) {
+			usb_model_rx_valid(ep);
+		}
+	} else if (reg == USB_ISTR_REG) {
+		*reg = (old & val & ~ISTR_EP) | (old & ISTR_EP);
+	} else {
+		*reg = val;
+	}
+}
+
+/* Packet memory holds 16 bits in every 32 bit word */
+static volatile uint8_t *pma_byte(uint16_t addr, uint16_t i)
+{
+	return &MMIO8(USB_PMA_BASE + addr * 2 + (i / 2) * 4 + (i & 1));
+}
+
+/* Size of the receive buffer from the BL_SIZE and NUM_BLOCK fields */
+static uint16_t st_usbfs_rx_size(uint8_t ep)
+{
+	uint16_t count = USB_GET_EP_RX_COUNT(ep);
+	uint16_t blocks = (count >> 10) & 0x1f;
+
+	return (count & 0x8000) ? (blocks + 1) * 32 : blocks * 2;
+}
+
+/* Into buffer 0 (the TX half) or 1 (the RX half) of the descriptor */
+static void st_usbfs_receive(uint8_t ep, bool buf0, const void *buf,
+			     uint16_t len)
+{
+	const uint8_t *p = buf;
+	volatile uint32_t *count = buf0 ? USB_EP_TX_COUNT(ep) :
+				   USB_EP_RX_COUNT(ep);
+	uint16_t addr = buf0 ? USB_GET_EP_TX_ADDR(ep) : USB_GET_EP_RX_ADDR(ep);
+	uint16_t i;
+
+	for (i = 0; i < len; i++) {
+		*pma_byte(addr, i) = p[i];
+	}
+	*count = (*count & ~0x3ff) | len;
+}
+
+static uint16_t st_usbfs_transmit(uint8_t ep, bool buf0, void *buf,
+				  uint16_t len)
+{
+	uint8_t *p = buf;
+	uint16_t addr = buf0 ? USB_GET_EP_TX_ADDR(ep) : USB_GET_EP_RX_ADDR(ep);
+	uint16_t count = buf0 ? USB_GET_EP_TX_COUNT(ep) :
+			 USB_GET_EP_RX_COUNT(ep);
+	uint16_t i;
+
+	len = MIN(len, count & 0x3ff);
+	for (i = 0; i < len; i++) {
+		p[i] = *pma_byte(addr, i);
+	}
+	return len;
+}
+
+static int st_usbfs_handshake(uint32_t stat)
+{
+	switch (stat) {
+	case USB_EP_RX_STAT_DISABLED:
+		return USB_MODEL_TIMEOUT;
+	case USB_EP_RX_STAT_STALL:
+		return USB_MODEL_STALL;
+	case USB_EP_RX_STAT_NAK:
+		return USB_MODEL_NAK;
+	default:
+		return 0;
+	}
+}
+
+/*-- Bus side, called by the host ------------------------------------------*/
+
+static void st_usbfs_bus_reset(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < 8; i++) {
+		*ep_reg(i) = 0;
+	}
+	*USB_DADDR_REG = 0;
+	*USB_ISTR_REG = USB_ISTR_RESET;
+}
+
+/* A SETUP is taken even by a NAKing or stalled control endpoint, which then
+ * NAKs both directions */
+static int st_usbfs_setup(uint8_t ep, const struct usb_setup_data *req)
+{
+	uint32_t epr;
+
+	ep &= 0x7f;
+	epr = *ep_reg(ep);
+	if ((epr & USB_EP_RX_STAT) == USB_EP_RX_STAT_DISABLED) {
+		return USB_MODEL_TIMEOUT;
+	}
+	st_usbfs_receive(ep, false, req, 8);
+	st_usbfs_set_ep(ep, USB_EP_RX_STAT | USB_EP_TX_STAT,
+			USB_EP_SETUP | USB_EP_RX_CTR | USB_EP_RX_STAT_NAK |
+			USB_EP_TX_STAT_NAK);
+	return 0;
+}
+
+/* The buffer DTOG points at is filled and DTOG moves on to the other one,
+ * STAT stays as it is */
+static int st_usbfs_out_dbl(uint8_t ep, const void *buf, uint16_t len)
+{
+	uint32_t epr = *ep_reg(ep);
+
+	if (!st_usbfs_rx_ready(epr)) {
+		return USB_MODEL_NAK;
+	}
+	len = MIN(len, st_usbfs_rx_size(ep));
+	st_usbfs_receive(ep, !(epr & USB_EP_RX_DTOG), buf, len);
+	st_usbfs_set_ep(ep, USB_EP_RX_DTOG, USB_EP_RX_CTR |
+			((epr ^ USB_EP_RX_DTOG) & USB_EP_RX_DTOG));
+	return len;
+}
+
+static int st_usbfs_out(uint8_t ep, const void *buf, uint16_t len)
+{
+	uint32_t epr;
+	int ret;
+
+	ep &= 0x7f;
+	epr = *ep_reg(ep);
+	ret = st_usbfs_handshake(epr & USB_EP_RX_STAT);
+	if (ret < 0) {
+		return ret;
+	}
+	if (st_usbfs_is_dbl(epr) || st_usbfs_is_iso(epr)) {
+		return st_usbfs_out_dbl(ep, buf, len);
+	}
+	len = MIN(len, st_usbfs_rx_size(ep));
+	st_usbfs_receive(ep, false, buf, len);
+	st_usbfs_set_ep(ep, USB_EP_SETUP | USB_EP_RX_STAT | USB_EP_RX_DTOG,
+			USB_EP_RX_CTR | USB_EP_RX_STAT_NAK |
+			((*ep_reg(ep) ^ USB_EP_RX_DTOG) & USB_EP_RX_DTOG));
+	return len;
+}
+
+static int st_usbfs_in_dbl(uint8_t ep, void *buf, uint16_t len)
+{
+	uint32_t epr = *ep_reg(ep);
+
+	if (!st_usbfs_tx_ready(epr)) {
+		return USB_MODEL_NAK;
+	}
+	len = st_usbfs_transmit(ep, !(epr & USB_EP_TX_DTOG), buf, len);
+	st_usbfs_set_ep(ep, USB_EP_TX_DTOG, USB_EP_TX_CTR |
+			((epr ^ USB_EP_TX_DTOG) & USB_EP_TX_DTOG));
+	return len;
+}
+
+static int st_usbfs_in(uint8_t ep, void *buf, uint16_t len)
+{
+	uint32_t epr;
+	int ret;
+
+	ep &= 0x7f;
+	epr = *ep_reg(ep);
+	ret = st_usbfs_handshake((epr & USB_EP_TX_STAT) << 8);
+	if (ret < 0) {
+		return ret;
+	}
+	if (st_usbfs_is_dbl(epr) || st_usbfs_is_iso(epr)) {
+		return st_usbfs_in_dbl(ep, buf, len);
+	}
+	len = st_usbfs_transmit(ep, true, buf, len);
+	st_usbfs_set_ep(ep, USB_EP_TX_STAT | USB_EP_TX_DTOG,
+			USB_EP_TX_CTR | USB_EP_TX_STAT_NAK |
+			((*ep_reg(ep) ^ USB_EP_TX_DTOG) & USB_EP_TX_DTOG));
+	return len;
+}
+
+static bool st_usbfs_pending(void)
+{
+	return *USB_ISTR_REG & (USB_ISTR_CTR | USB_ISTR_RESET);
+}
+
+static void st_usbfs_drop(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < 8; i++) {
+		*ep_reg(i) &= ~EP_CLEAR;
+	}
+	*USB_ISTR_REG &= ~USB_ISTR_RESET;
+	st_usbfs_update_istr();
+}
+
+static uint8_t st_usbfs_address(void)
+{
+	return *USB_DADDR_REG & USB_DADDR_ADDR;
+}
+
+const struct usb_model_hw usb_model_st_usbfs = {
+	.name = "st_usbfs",
+	.driver = &st_usbfs_v1_usb_driver,
+	.bus_reset = st_usbfs_bus_reset,
+	.setup = st_usbfs_setup,
+	.out = st_usbfs_out,
+	.in = st_usbfs_in,
+	.pending = st_usbfs_pending,
+	.drop = st_usbfs_drop,
+	.address = st_usbfs_address,
+};
@@ -0,0 +1,581 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <libopencm3/usb/usbd.h>
+#include "../../lib/usb/usb_private.h"
+#include "usb_model.h"
+
+/* Retries of a NAKed packet before the host gives up */
+#define USB_MODEL_RETRIES	8
+/* Events handled after one transaction before the model calls it stuck */
+#define USB_MODEL_MAX_EVENTS	64
+
+/* Values of the STAT_RX and STAT_TX fields */
+enum usb_model_stat {
+	STAT_DISABLED,
+	STAT_STALL,
+	STAT_NAK,
+	STAT_VALID,
+};
+
+struct usb_model_ep {
+	enum usb_model_stat stat_rx;
+	enum usb_model_stat stat_tx;
+	bool ctr_rx;
+	bool ctr_tx;
+	bool setup;
+	bool force_nak;
+	uint16_t rx_max;
+	uint16_t tx_max;
+	uint16_t rx_count;
+	uint16_t tx_count;
+	uint8_t rx_buf[USB_MODEL_MAX_PACKET];
+	uint8_t tx_buf[USB_MODEL_MAX_PACKET];
+};
+
+static struct {
+	struct usb_model_ep ep[8];
+	bool reset;
+	uint8_t address;
+} model;
+
+static usbd_device model_dev;
+
+/* The selected hardware and the host on the bus */
+static struct {
+	const struct usb_model_hw *hw;
+	unsigned stuck;
+	/* OUT packets sent as soon as the endpoint takes them */
+	uint8_t ep;
+	unsigned head, tail;
+	bool sending;
+	uint16_t len[USB_MODEL_QUEUE];
+	uint8_t buf[USB_MODEL_QUEUE][USB_MODEL_MAX_PACKET];
+} host = { .hw = &usb_model_plain };
+
+/*-- Device side, called by the stack ---------------------------------------*/
+
+static void model_set_stat_rx(uint8_t addr, enum usb_model_stat stat)
+{
+	model.ep[addr].stat_rx = stat;
+	if (stat == STAT_VALID) {
+		usb_model_rx_valid(addr);
+	}
+}
+
+static usbd_device *model_init(void)
+{
+	memset(&model, 0, sizeof(model));
+	memset(&model_dev, 0, sizeof(model_dev));
+	return &model_dev;
+}
+
+static void model_set_address(usbd_device *dev, uint8_t addr)
+{
+	(void)dev;
+	model.address = addr;
+}
+
+static void model_ep_setup(usbd_device *dev, uint8_t addr, uint8_t type,
+			   uint16_t max_size, usbd_endpoint_callback callback)
+{
+	bool dir = addr & 0x80;
+	struct usb_model_ep *ep;
+
+	(void)type;
+	addr &= 0x7f;
+	ep = &model.ep[addr];
+	if (max_size > USB_MODEL_MAX_PACKET) {
+		max_size = USB_MODEL_MAX_PACKET;
+	}
+
+	/* Endpoint 0 is set up in both directions at once */
+	if (dir || (addr == 0)) {
+		ep->tx_max = max_size;
+		ep->stat_tx = STAT_NAK;
+		ep->ctr_tx = false;
+		if (callback) {
+			dev->user_callback_ctr[addr][USB_TRANSACTION_IN] =
+				callback;
+		}
+	}
+	if (!dir) {
+		ep->rx_max = max_size;
+		ep->ctr_rx = false;
+		ep->force_nak = false;
+		if (callback) {
+			dev->user_callback_ctr[addr][USB_TRANSACTION_OUT] =
+				callback;
+		}
+		model_set_stat_rx(addr, STAT_VALID);
+	}
+}
+
+static void model_ep_reset(usbd_device *dev)
+{
+	int i;
+
+	(void)dev;
+	for (i = 1; i < 8; i++) {
+		memset(&model.ep[i], 0, sizeof(model.ep[i]));
+	}
+}
+
+static void model_ep_stall_set(usbd_device *dev, uint8_t addr, uint8_t stall)
+{
+	struct usb_model_ep *ep = &model.ep[addr & 0x7f];
+
+	(void)dev;
+	/* Endpoint 0 stalls in both directions */
+	if ((addr & 0x80) || ((addr & 0x7f) == 0)) {
+		ep->stat_tx = stall ? STAT_STALL : STAT_NAK;
+	}
+	if (!(addr & 0x80)) {
+		model_set_stat_rx(addr & 0x7f, stall ? STAT_STALL : STAT_VALID);
+	}
+}
+
+static uint8_t model_ep_stall_get(usbd_device *dev, uint8_t addr)
+{
+	struct usb_model_ep *ep = &model.ep[addr & 0x7f];
+
+	(void)dev;
+	if (addr & 0x80) {
+		return ep->stat_tx == STAT_STALL;
+	}
+	return ep->stat_rx == STAT_STALL;
+}
+
+static void model_ep_nak_set(usbd_device *dev, uint8_t addr, uint8_t nak)
+{
+	struct usb_model_ep *ep = &model.ep[addr & 0x7f];
+
+	(void)dev;
+	/* It does not make sense to force NAK on IN endpoints. */
+	if (addr & 0x80) {
+		return;
+	}
+	ep->force_nak = nak;
+	model_set_stat_rx(addr, nak ? STAT_NAK : STAT_VALID);
+}
+
+static uint16_t model_ep_write_packet(usbd_device *dev, uint8_t addr,
+				      const void *buf, uint16_t len)
+{
+	struct usb_model_ep *ep = &model.ep[addr & 0x7f];
+
+	(void)dev;
+	if (ep->stat_tx == STAT_VALID) {
+		/* Previous packet not taken by the host yet */
+		return 0;
+	}
+	len = MIN(len, USB_MODEL_MAX_PACKET);
+	if (len) {
+		memcpy(ep->tx_buf, buf, len);
+	}
+	ep->tx_count = len;
+	ep->stat_tx = STAT_VALID;
+	return len;
+}
+
+static uint16_t model_ep_read_packet(usbd_device *dev, uint8_t addr,
+				     void *buf, uint16_t len)
+{
+	struct usb_model_ep *ep = &model.ep[addr & 0x7f];
+
+	(void)dev;
+	if (ep->stat_rx == STAT_VALID) {
+		/* Nothing received */
+		return 0;
+	}
+	len = MIN(len, ep->rx_count);
+	if (len) {
+		memcpy(buf, ep->rx_buf, len);
+	}
+	ep->ctr_rx = false;
+	if (!ep->force_nak) {
+		model_set_stat_rx(addr & 0x7f, STAT_VALID);
+	}
+	return len;
+}
+
+/* One event per call, in the order of the USB FS core: the reset, then the
+ * lowest endpoint with a completed transaction, reception first */
+static void model_poll(usbd_device *dev)
+{
+	struct usb_model_ep *ep;
+	usbd_endpoint_callback cb;
+	uint8_t i, type;
+
+	if (model.reset) {
+		model.reset = false;
+		_usbd_reset(dev);
+		return;
+	}
+
+	for (i = 0; i < 8; i++) {
+		ep = &model.ep[i];
+		if (ep->ctr_rx) {
+			if (ep->setup) {
+				ep->setup = false;
+				type = USB_TRANSACTION_SETUP;
+				model_ep_read_packet(dev, i,
+						     &dev->control_state.req,
+						     8);
+			} else {
+				type = USB_TRANSACTION_OUT;
+			}
+		} else if (ep->ctr_tx) {
+			ep->ctr_tx = false;
+			type = USB_TRANSACTION_IN;
+		} else {
+			continue;
+		}
+
+		cb = dev->user_callback_ctr[i][type];
+		if (cb) {
+			cb(dev, i);
+		} else {
+			ep->ctr_rx = false;
+		}
+		return;
+	}
+}
+
+static const usbd_driver model_driver = {
+	.init = model_init,
+	.set_address = model_set_address,
+	.ep_setup = model_ep_setup,
+	.ep_reset = model_ep_reset,
+	.ep_stall_set = model_ep_stall_set,
+	.ep_stall_get = model_ep_stall_get,
+	.ep_nak_set = model_ep_nak_set,
+	.ep_write_packet = model_ep_write_packet,
+	.ep_read_packet = model_ep_read_packet,
+	.poll = model_poll,
+};
+
+/*-- Bus side, called by the host ------------------------------------------*/
+
+static void model_bus_reset(void)
+{
+	memset(model.ep, 0, sizeof(model.ep));
+	model.address = 0;
+	model.reset = true;
+}
+
+/* A SETUP packet is always taken by a control endpoint, which then NAKs
+ * both directions until the stack has decoded it. */
+static int model_setup(uint8_t ep, const struct usb_setup_data *req)
+{
+	struct usb_model_ep *e = &model.ep[ep & 0x7f];
+
+	if (e->stat_rx == STAT_DISABLED) {
+		return USB_MODEL_TIMEOUT;
+	}
+	memcpy(e->rx_buf, req, 8);
+	e->rx_count = 8;
+	e->setup = true;
+	e->ctr_rx = true;
+	e->stat_rx = STAT_NAK;
+	e->stat_tx = STAT_NAK;
+	return 0;
+}
+
+static int model_out(uint8_t ep, const void *buf, uint16_t len)
+{
+	struct usb_model_ep *e = &model.ep[ep & 0x7f];
+
+	switch (e->stat_rx) {
+	case STAT_DISABLED:
+		return USB_MODEL_TIMEOUT;
+	case STAT_STALL:
+		return USB_MODEL_STALL;
+	case STAT_NAK:
+		return USB_MODEL_NAK;
+	case STAT_VALID:
+		break;
+	}
+
+	len = MIN(len, e->rx_max);
+	if (len) {
+		memcpy(e->rx_buf, buf, len);
+	}
+	e->rx_count = len;
+	e->ctr_rx = true;
+	e->stat_rx = STAT_NAK;
+	return len;
+}
+
+static int model_in(uint8_t ep, void *buf, uint16_t len)
+{
+	struct usb_model_ep *e = &model.ep[ep & 0x7f];
+
+	switch (e->stat_tx) {
+	case STAT_DISABLED:
+		return USB_MODEL_TIMEOUT;
+	case STAT_STALL:
+		return USB_MODEL_STALL;
+	case STAT_NAK:
+		return USB_MODEL_NAK;
+	case STAT_VALID:
+		break;
+	}
+
+	len = MIN(len, e->tx_count);
+	if (len) {
+		memcpy(buf, e->tx_buf, len);
+	}
+	e->ctr_tx = true;
+	e->stat_tx = STAT_NAK;
+	return len;
+}
+
+static bool model_pending(void)
+{
+	int i;
+
+	if (model.reset) {
+		return true;
+	}
+	for (i = 0; i < 8; i++) {
+		if (model.ep[i].ctr_rx || model.ep[i].ctr_tx) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void model_drop(void)
+{
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		model.ep[i].ctr_rx = false;
+		model.ep[i].ctr_tx = false;
+	}
+}
+
+static uint8_t model_address(void)
+{
+	return model.address;
+}
+
+const struct usb_model_hw usb_model_plain = {
+	.name = "plain",
+	.driver = &model_driver,
+	.bus_reset = model_bus_reset,
+	.setup = model_setup,
+	.out = model_out,
+	.in = model_in,
+	.pending = model_pending,
+	.drop = model_drop,
+	.address = model_address,
+};
+
+/*-- Host side ---------------------------------------------------------------*/
+
+/** Selects the hardware the host side works on, the stack is handed
+ * hw->driver by usbd_init(). */
+void usb_model_select(const struct usb_model_hw *hw)
+{
+	memset(&host, 0, sizeof(host));
+	host.hw = hw;
+}
+
+/** Called by the hardware when OUT endpoint @a ep turns VALID. A queued
+ * packet goes in at once, before the stack gets to run again, as a host
+ * sending back to back would do. */
+void usb_model_rx_valid(uint8_t ep)
+{
+	unsigned slot;
+
+	if (host.sending || (ep != host.ep) || (host.head == host.tail)) {
+		return;
+	}
+	slot = host.head % USB_MODEL_QUEUE;
+	host.sending = true;
+	if (host.hw->out(ep, host.buf[slot], host.len[slot]) >= 0) {
+		host.head++;
+	}
+	host.sending = false;
+}
+
+/** Polls until all events are handled. A reception the stack never reads
+ * keeps its CTR flag set, like on the hardware, which would run the
+ * interrupt handler forever; the model counts and drops it. */
+void usb_model_run(usbd_device *dev)
+{
+	int n = 0;
+
+	while (host.hw->pending()) {
+		if (++n > USB_MODEL_MAX_EVENTS) {
+			host.stuck++;
+			host.hw->drop();
+			break;
+		}
+		usbd_poll(dev);
+	}
+}
+
+/** Signals a bus reset. All endpoints are disabled until the stack sets
+ * them up again. */
+void usb_model_bus_reset(usbd_device *dev)
+{
+	host.head = host.tail;
+	host.hw->bus_reset();
+	usb_model_run(dev);
+}
+
+/** Sends a SETUP packet. */
+int usb_model_setup(usbd_device *dev, uint8_t ep,
+		    const struct usb_setup_data *req)
+{
+	int ret = host.hw->setup(ep, req);
+
+	if (ret == 0) {
+		usb_model_run(dev);
+	}
+	return ret;
+}
+
+/** Sends an OUT packet, returns its length or the handshake. */
+int usb_model_out(usbd_device *dev, uint8_t ep, const void *buf,
+		  uint16_t len)
+{
+	int ret = host.hw->out(ep, buf, len);
+
+	if (ret >= 0) {
+		usb_model_run(dev);
+	}
+	return ret;
+}
+
+/** Asks for an IN packet of at most @a len bytes, returns the number of
+ * bytes received or the handshake. */
+int usb_model_in(usbd_device *dev, uint8_t ep, void *buf, uint16_t len)
+{
+	int ret = host.hw->in(ep, buf, len);
+
+	if (ret >= 0) {
+		usb_model_run(dev);
+	}
+	return ret;
+}
+
+static int model_retry_out(usbd_device *dev, const void *buf, uint16_t len)
+{
+	int i, ret = USB_MODEL_NAK;
+
+	for (i = 0; (i < USB_MODEL_RETRIES) && (ret == USB_MODEL_NAK); i++) {
+		ret = usb_model_out(dev, 0, buf, len);
+	}
+	return ret;
+}
+
+static int model_retry_in(usbd_device *dev, void *buf, uint16_t len)
+{
+	int i, ret = USB_MODEL_NAK;
+
+	for (i = 0; (i < USB_MODEL_RETRIES) && (ret == USB_MODEL_NAK); i++) {
+		ret = usb_model_in(dev, 0, buf, len);
+	}
+	return ret;
+}
+
+/** Runs a control transfer on endpoint 0 as a host does: setup, data and
+ * status stages, retrying NAKed packets. @a data holds wLength bytes.
+ * The host takes bMaxPacketSize0 to be USB_MODEL_MAX_PACKET. Returns the
+ * length of the data stage or the failing handshake. */
+int usb_model_control(usbd_device *dev, const struct usb_setup_data *req,
+		      void *data)
+{
+	uint16_t max = USB_MODEL_MAX_PACKET;
+	uint16_t done = 0, n;
+	uint8_t *p = data;
+	int ret;
+
+	ret = usb_model_setup(dev, 0, req);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (req->wLength && (req->bmRequestType & USB_REQ_TYPE_IN)) {
+		do {
+			n = MIN(max, req->wLength - done);
+			ret = model_retry_in(dev, p + done, n);
+			if (ret < 0) {
+				return ret;
+			}
+			done += ret;
+		} while ((ret == max) && (done < req->wLength));
+		ret = model_retry_out(dev, NULL, 0);
+	} else {
+		while (done < req->wLength) {
+			n = MIN(max, req->wLength - done);
+			ret = model_retry_out(dev, p + done, n);
+			if (ret < 0) {
+				return ret;
+			}
+			done += n;
+		}
+		ret = model_retry_in(dev, NULL, 0);
+	}
+
+	return ret < 0 ? ret : done;
+}
+
+/** Queues an OUT packet for endpoint @a ep, which is sent whenever the
+ * endpoint turns VALID, also from within the calls of the stack to the
+ * driver, then polls. Packets queued for another endpoint are dropped. */
+void usb_model_queue_out(usbd_device *dev, uint8_t ep, const void *buf,
+			 uint16_t len)
+{
+	unsigned slot;
+
+	if (ep != host.ep) {
+		host.head = host.tail;
+		host.ep = ep;
+	}
+	if (host.tail - host.head < USB_MODEL_QUEUE) {
+		slot = host.tail++ % USB_MODEL_QUEUE;
+		len = MIN(len, USB_MODEL_MAX_PACKET);
+		memcpy(host.buf[slot], buf, len);
+		host.len[slot] = len;
+	}
+	usb_model_rx_valid(ep);
+	usb_model_run(dev);
+}
+
+/** OUT packets still queued */
+unsigned usb_model_queued(void)
+{
+	return host.tail - host.head;
+}
+
+/** The address given to the hardware by the stack */
+uint8_t usb_model_address(void)
+{
+	return host.hw->address();
+}
+
+/** Number of times the stack left a reception unread */
+unsigned usb_model_stuck_events(void)
+{
+	return host.stuck;
+}
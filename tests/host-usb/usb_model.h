@@ -0,0 +1,86 @@
+/*
+ * This file is part of the libopencm3 project.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef USB_MODEL_H
+#define USB_MODEL_H
+
+#include <libopencm3/usb/usbd.h>
+
+/*
+ * A USB device peripheral for the stack to drive, and a host for the test to
+ * drive it with. The host side functions below run one transaction on the
+ * selected hardware and then poll until all the events are handled.
+ *
+ * usb_model_plain is a usbd_driver in plain memory, after the endpoint
+ * registers of the STM32 USB FS core: every endpoint has a STAT_RX and a
+ * STAT_TX field and a CTR flag for each direction. usb_model_st_usbfs runs
+ * the st_usbfs driver of the library on a model of those registers and of
+ * the packet memory, see st_usbfs_model.c.
+ */
+
+/* Largest packet of the model, full speed bulk */
+#define USB_MODEL_MAX_PACKET	64
+/* OUT packets the host can queue, see usb_model_queue_out() */
+#define USB_MODEL_QUEUE		128
+
+/* Handshakes of a transaction, a byte count >= 0 is an ACK */
+#define USB_MODEL_NAK		-1
+#define USB_MODEL_STALL		-2
+/* Endpoint not enabled, the host would time out */
+#define USB_MODEL_TIMEOUT	-3
+
+/* The peripheral as seen from the bus. The transactions only change the
+ * endpoint state, the events are handled by usbd_poll() afterwards. */
+struct usb_model_hw {
+	const char *name;
+	const usbd_driver *driver;
+	/* Disable all endpoints and flag a bus reset */
+	void (*bus_reset)(void);
+	/* Returns 0 or USB_MODEL_TIMEOUT */
+	int (*setup)(uint8_t ep, const struct usb_setup_data *req);
+	/* Return the byte count or the handshake */
+	int (*out)(uint8_t ep, const void *buf, uint16_t len);
+	int (*in)(uint8_t ep, void *buf, uint16_t len);
+	/* An event waits for usbd_poll() */
+	bool (*pending)(void);
+	/* Forget the events waiting */
+	void (*drop)(void);
+	uint8_t (*address)(void);
+};
+
+extern const struct usb_model_hw usb_model_plain;
+extern const struct usb_model_hw usb_model_st_usbfs;
+
+void usb_model_select(const struct usb_model_hw *hw);
+void usb_model_rx_valid(uint8_t ep);
+
+void usb_model_run(usbd_device *dev);
+void usb_model_bus_reset(usbd_device *dev);
+int usb_model_setup(usbd_device *dev, uint8_t ep,
+		    const struct usb_setup_data *req);
+int usb_model_out(usbd_device *dev, uint8_t ep, const void *buf,
+		  uint16_t len);
+int usb_model_in(usbd_device *dev, uint8_t ep, void *buf, uint16_t len);
+int usb_model_control(usbd_device *dev, const struct usb_setup_data *req,
+		      void *data);
+void usb_model_queue_out(usbd_device *dev, uint8_t ep, const void *buf,
+			 uint16_t len);
+unsigned usb_model_queued(void);
+uint8_t usb_model_address(void);
+unsigned usb_model_stuck_events(void);
+
+#endif